@@ -19,7 +19,7 @@ namespace nzsl::Ast
 		{
 			case NodeType::None: break;
 
-#define NZSL_SHADERAST_EXPRESSION(Node) case NodeType::Node##Expression: return Compare(static_cast<const Node##Expression&>(lhs), static_cast<const Node##Expression&>(lhs));
+#define NZSL_SHADERAST_EXPRESSION(Node) case NodeType::Node##Expression: return Compare(static_cast<const Node##Expression&>(lhs), static_cast<const Node##Expression&>(rhs));
 #include <NZSL/Ast/NodeList.hpp>
 
 			default: throw std::runtime_error("unexpected node type");
@@ -88,7 +88,7 @@ namespace nzsl::Ast
 		{
 			case NodeType::None: break;
 
-#define NZSL_SHADERAST_STATEMENT(Node) case NodeType::Node##Statement: return Compare(static_cast<const Node##Statement&>(lhs), static_cast<const Node##Statement&>(lhs));
+#define NZSL_SHADERAST_STATEMENT(Node) case NodeType::Node##Statement: return Compare(static_cast<const Node##Statement&>(lhs), static_cast<const Node##Statement&>(rhs));
 #include <NZSL/Ast/NodeList.hpp>
 
 			default: throw std::runtime_error("unexpected node type");
@@ -202,15 +202,27 @@ namespace nzsl::Ast
 
 	inline bool Compare(const DeclareExternalStatement::ExternalVar& lhs, const DeclareExternalStatement::ExternalVar& rhs)
 	{
+		if (!Compare(lhs.accessPolicy, rhs.accessPolicy))
+			return false;
+
 		if (!Compare(lhs.bindingIndex, rhs.bindingIndex))
 			return false;
 
 		if (!Compare(lhs.bindingSet, rhs.bindingSet))
 			return false;
 
+		if (!Compare(lhs.isRestrict, rhs.isRestrict))
+			return false;
+
+		if (!Compare(lhs.isWorkgroupShared, rhs.isWorkgroupShared))
+			return false;
+
 		if (!Compare(lhs.name, rhs.name))
 			return false;
 
+		if (!Compare(lhs.precision, rhs.precision))
+			return false;
+
 		if (!Compare(lhs.type, rhs.type))
 			return false;
 
@@ -225,6 +237,9 @@ namespace nzsl::Ast
 		if (!Compare(lhs.name, rhs.name))
 			return false;
 
+		if (!Compare(lhs.precision, rhs.precision))
+			return false;
+
 		if (!Compare(lhs.type, rhs.type))
 			return false;
 
@@ -299,6 +314,9 @@ namespace nzsl::Ast
 		if (!Compare(lhs.name, rhs.name))
 			return false;
 
+		if (!Compare(lhs.precision, rhs.precision))
+			return false;
+
 		if (!Compare(lhs.type, rhs.type))
 			return false;
 
@@ -621,6 +639,9 @@ namespace nzsl::Ast
 		if (!Compare(lhs.statements, rhs.statements))
 			return false;
 
+		if (!Compare(lhs.workgroupSize, rhs.workgroupSize))
+			return false;
+
 		return true;
 	}
 
@@ -654,6 +675,9 @@ namespace nzsl::Ast
 		if (!Compare(lhs.varType, rhs.varType))
 			return false;
 
+		if (!Compare(lhs.precision, rhs.precision))
+			return false;
+
 		if (!Compare(lhs.initialExpression, rhs.initialExpression))
 			return false;
 
@@ -11,6 +11,8 @@
 #include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/Module.hpp>
 #include <NZSL/Lang/SourceLocation.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace nzsl::Ast
 {
@@ -24,6 +26,8 @@ namespace nzsl::Ast
 			ConstantPropagationVisitor(ConstantPropagationVisitor&&) = delete;
 			~ConstantPropagationVisitor() = default;
 
+			inline bool HasChanged() const;
+
 			inline ExpressionPtr Process(Expression& expression);
 			inline ExpressionPtr Process(Expression& expression, const Options& options);
 			ModulePtr Process(const Module& shaderModule);
@@ -31,15 +35,21 @@ namespace nzsl::Ast
 			inline StatementPtr Process(Statement& statement);
 			inline StatementPtr Process(Statement& statement, const Options& options);
 
+			static bool CanTransform(const Module& shaderModule, const Options& options); //< quick check without cloning, may return true even if Process wouldn't change anything
+
 			ConstantPropagationVisitor& operator=(const ConstantPropagationVisitor&) = delete;
 			ConstantPropagationVisitor& operator=(ConstantPropagationVisitor&&) = delete;
 
 			struct Options
 			{
 				std::function<const ConstantValue*(std::size_t constantId)> constantQueryCallback;
+				bool allowUnsafeMathOptimizations = false; //< allows rewrites which aren't bit-exact on floating-point values (x + 0.0 => x, x / c => x * (1.0 / c))
 			};
 
 		protected:
+			using VariableValues = std::unordered_map<std::size_t, ConstantSingleValue>;
+
+			ExpressionPtr Clone(AssignExpression& node) override;
 			ExpressionPtr Clone(BinaryExpression& node) override;
 			ExpressionPtr Clone(CastExpression& node) override;
 			ExpressionPtr Clone(ConditionalExpression& node) override;
@@ -47,8 +57,14 @@ namespace nzsl::Ast
 			ExpressionPtr Clone(IntrinsicExpression& node) override;
 			ExpressionPtr Clone(SwizzleExpression& node) override;
 			ExpressionPtr Clone(UnaryExpression& node) override;
+			ExpressionPtr Clone(VariableValueExpression& node) override;
 			StatementPtr Clone(BranchStatement& node) override;
 			StatementPtr Clone(ConditionalStatement& node) override;
+			StatementPtr Clone(DeclareFunctionStatement& node) override;
+			StatementPtr Clone(DeclareVariableStatement& node) override;
+			StatementPtr Clone(ForStatement& node) override;
+			StatementPtr Clone(ForEachStatement& node) override;
+			StatementPtr Clone(WhileStatement& node) override;
 
 			template<BinaryType Type> ExpressionPtr PropagateBinaryConstant(const ConstantValueExpression& lhs, const ConstantValueExpression& rhs, const SourceLocation& sourceLocation);
 			template<typename TargetType> ExpressionPtr PropagateSingleValueCast(const ConstantValueExpression& operand, const SourceLocation& sourceLocation);
@@ -58,10 +74,20 @@ namespace nzsl::Ast
 			template<typename TargetType> ExpressionPtr PropagateVec3Cast(TargetType v1, TargetType v2, TargetType v3, const SourceLocation& sourceLocation);
 			template<typename TargetType> ExpressionPtr PropagateVec4Cast(TargetType v1, TargetType v2, TargetType v3, TargetType v4, const SourceLocation& sourceLocation);
 
+			ExpressionPtr SimplifyBinary(BinaryExpression& node, ExpressionPtr& lhs, ExpressionPtr& rhs);
+			ExpressionPtr SimplifyIntrinsic(IntrinsicExpression& node, std::vector<ExpressionPtr>& parameters);
+
+			void InvalidateAssignedVariables(Statement& statement);
+			void SetVariableValue(std::size_t variableIndex, const Expression& value);
 			StatementPtr Unscope(StatementPtr node);
 
+			static void MergeVariableValues(VariableValues& values, const VariableValues& otherValues);
+
 		private:
 			Options m_options;
+			VariableValues m_variableValues; //< known values of local variables at the current point of the function being processed
+			std::unordered_set<std::size_t> m_localVariables; //< variables declared in the function being processed (and its parameters), only those values are tracked
+			bool m_changed = false; //< whether the last Process call transformed anything
 	};
 
 	inline ExpressionPtr PropagateConstants(Expression& expr);
@@ -6,27 +6,44 @@
 
 namespace nzsl::Ast
 {
+	inline bool ConstantPropagationVisitor::HasChanged() const
+	{
+		return m_changed;
+	}
+
 	inline ExpressionPtr ConstantPropagationVisitor::Process(Expression& expression)
 	{
 		m_options = {};
+		m_variableValues.clear();
+		m_changed = false;
+
 		return CloneExpression(expression);
 	}
 
 	inline ExpressionPtr ConstantPropagationVisitor::Process(Expression& expression, const Options& options)
 	{
 		m_options = options;
+		m_variableValues.clear();
+		m_changed = false;
+
 		return CloneExpression(expression);
 	}
 
 	inline StatementPtr ConstantPropagationVisitor::Process(Statement& statement)
 	{
 		m_options = {};
+		m_variableValues.clear();
+		m_changed = false;
+
 		return CloneStatement(statement);
 	}
 
 	inline StatementPtr ConstantPropagationVisitor::Process(Statement& statement, const Options& options)
 	{
 		m_options = options;
+		m_variableValues.clear();
+		m_changed = false;
+
 		return CloneStatement(statement);
 	}
 
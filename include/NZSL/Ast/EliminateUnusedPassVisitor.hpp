@@ -23,9 +23,13 @@ namespace nzsl::Ast
 			EliminateUnusedPassVisitor(EliminateUnusedPassVisitor&&) = delete;
 			~EliminateUnusedPassVisitor() = default;
 
+			inline bool HasChanged() const;
+
 			ModulePtr Process(const Module& shaderModule, const DependencyCheckerVisitor::UsageSet& usageSet);
 			StatementPtr Process(Statement& statement, const DependencyCheckerVisitor::UsageSet& usageSet);
 
+			static bool CanTransform(const Module& shaderModule, const DependencyCheckerVisitor::UsageSet& usageSet); //< whether Process would remove anything, without cloning
+
 			EliminateUnusedPassVisitor& operator=(const EliminateUnusedPassVisitor&) = delete;
 			EliminateUnusedPassVisitor& operator=(EliminateUnusedPassVisitor&&) = delete;
 
@@ -46,6 +50,7 @@ namespace nzsl::Ast
 
 			struct Context;
 			Context* m_context;
+			bool m_changed = false; //< whether the last Process call removed anything
 	};
 
 	inline ModulePtr EliminateUnusedPass(const Module& shaderModule);
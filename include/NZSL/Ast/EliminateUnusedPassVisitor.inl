@@ -6,6 +6,11 @@
 
 namespace nzsl::Ast
 {
+	inline bool EliminateUnusedPassVisitor::HasChanged() const
+	{
+		return m_changed;
+	}
+
 	inline ModulePtr EliminateUnusedPass(const Module& shaderModule)
 	{
 		DependencyCheckerVisitor::Config defaultConfig;
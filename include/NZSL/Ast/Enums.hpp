@@ -12,20 +12,33 @@
 
 namespace nzsl::Ast
 {
+	enum class AccessPolicy
+	{
+		Read      = 0, //< readonly
+		ReadWrite = 1, //< readwrite (default)
+		Write     = 2, //< writeonly
+	};
+
 	enum class AssignType
 	{
-		Simple             = 0, //< a = b
-		CompoundAdd        = 1, //< a += b
-		CompoundDivide     = 2, //< a /= b
-		CompoundModulo     = 7, //< a %= b
-		CompoundMultiply   = 3, //< a *= b
-		CompoundLogicalAnd = 4, //< a &&= b
-		CompoundLogicalOr  = 5, //< a ||= b
-		CompoundSubtract   = 6, //< a -= b
+		Simple             = 0,  //< a = b
+		CompoundAdd        = 1,  //< a += b
+		CompoundBitwiseAnd = 8,  //< a &= b
+		CompoundBitwiseOr  = 9,  //< a |= b
+		CompoundBitwiseXor = 10, //< a ^= b
+		CompoundDivide     = 2,  //< a /= b
+		CompoundModulo     = 7,  //< a %= b
+		CompoundMultiply   = 3,  //< a *= b
+		CompoundLogicalAnd = 4,  //< a &&= b
+		CompoundLogicalOr  = 5,  //< a ||= b
+		CompoundShiftLeft  = 11, //< a <<= b
+		CompoundShiftRight = 12, //< a >>= b
+		CompoundSubtract   = 6,  //< a -= b
 	};
 
 	enum class AttributeType
 	{
+		Access             = 18, //< Memory access policy (external storage var only) - has argument policy
 		Author             = 12, //< Module author (module statement only) - has argument version string
 		Binding            =  0, //< Binding (external var only) - has argument index
 		Builtin            =  1, //< Builtin (struct member only) - has argument type
@@ -40,13 +53,19 @@ namespace nzsl::Ast
 		License            = 14, //< Module license (module statement) - has argument version string
 		Layout             =  7, //< Struct layout (struct only) - has argument style
 		Location           =  8, //< Location (struct member only) - has argument index
+		Precision          = 16, //< Precision (struct member, external var, function parameter and variable only) - has argument precision
+		Restrict           = 19, //< No memory aliasing (external storage var only)
 		Set                = 10, //< Binding set (external var only) - has argument index
 		Unroll             = 11, //< Unroll (for/for each only) - has argument mode
+		Workgroup          = 17, //< Workgroup size (function only) - has arguments x, y and z, or workgroup-shared (external var only)
 	};
 
 	enum class BinaryType
 	{
 		Add        = 0,  //< +
+		BitwiseAnd = 13, //< &
+		BitwiseOr  = 14, //< |
+		BitwiseXor = 15, //< ^
 		CompEq     = 1,  //< ==
 		CompGe     = 2,  //< >=
 		CompGt     = 3,  //< >
@@ -58,19 +77,27 @@ namespace nzsl::Ast
 		LogicalOr  = 10, //< ||
 		Modulo     = 12, //< %
 		Multiply   = 8,  //< *
+		ShiftLeft  = 16, //< <<
+		ShiftRight = 17, //< >>
 		Subtract   = 11, //< -
 	};
 
 	enum class BuiltinEntry
 	{
-		BaseInstance   = 3, // gl_BaseInstance (GLSL 450) / BaseInstance (SPIR-V 1.3)
-		BaseVertex     = 4, // gl_BaseVertex (GLSL 450) / BaseVertex (SPIR-V 1.3)
-		DrawIndex      = 5, // gl_DrawID (GLSL 450) / DrawIndex (SPIR-V 1.3)
-		FragCoord      = 1, // gl_FragCoord / FragCoord
-		FragDepth      = 2, // gl_FragDepth / FragDepth
-		InstanceIndex  = 6, // gl_InstanceIndex (or gl_BaseInstance + gl_InstanceID) / InstanceId
-		VertexIndex    = 7, // gl_VertexID/gl_VertexIndex / VertexId
-		VertexPosition = 0, // gl_Position / Position
+		BaseInstance              = 3,  // gl_BaseInstance (GLSL 450) / BaseInstance (SPIR-V 1.3)
+		BaseVertex                = 4,  // gl_BaseVertex (GLSL 450) / BaseVertex (SPIR-V 1.3)
+		DrawIndex                 = 5,  // gl_DrawID (GLSL 450) / DrawIndex (SPIR-V 1.3)
+		FragCoord                 = 1,  // gl_FragCoord / FragCoord
+		FragDepth                 = 2,  // gl_FragDepth / FragDepth
+		GlobalInvocationId        = 8,  // gl_GlobalInvocationID / GlobalInvocationId
+		InstanceIndex             = 6,  // gl_InstanceIndex (or gl_BaseInstance + gl_InstanceID) / InstanceId
+		LocalInvocationId         = 9,  // gl_LocalInvocationID / LocalInvocationId
+		LocalInvocationIndex      = 10, // gl_LocalInvocationIndex / LocalInvocationIndex
+		SubgroupLocalInvocationId = 12, // gl_SubgroupInvocationID / SubgroupLocalInvocationId (SPIR-V 1.3)
+		SubgroupSize              = 13, // gl_SubgroupSize / SubgroupSize (SPIR-V 1.3)
+		VertexIndex               = 7,  // gl_VertexID/gl_VertexIndex / VertexId
+		VertexPosition            = 0,  // gl_Position / Position
+		WorkgroupId               = 11, // gl_WorkGroupID / WorkgroupId
 	};
 
 	enum class DepthWriteMode
@@ -89,19 +116,63 @@ namespace nzsl::Ast
 
 	enum class IntrinsicType
 	{
-		ArraySize     = 10,
-		CrossProduct  = 0,
-		DotProduct    = 1,
-		Exp           = 7,
-		Inverse       = 11,
-		Length        = 3,
-		Max           = 4,
-		Min           = 5,
-		Normalize     = 9,
-		Pow           = 6,
-		Reflect       = 8,
-		SampleTexture = 2,
-		Transpose     = 12
+		ArraySize              = 10,
+		AtomicAdd              = 13,
+		AtomicAnd              = 14,
+		AtomicCompareExchange  = 15,
+		AtomicExchange         = 16,
+		AtomicMax              = 17,
+		AtomicMin              = 18,
+		AtomicOr               = 19,
+		AtomicXor              = 20,
+		Barrier                = 21,
+		BitCount               = 26,
+		BitFieldExtract        = 27,
+		BitFieldInsert         = 28,
+		CrossProduct           = 0,
+		DotProduct             = 1,
+		Exp                    = 7,
+		FirstBitHigh           = 29,
+		FirstBitLow            = 30,
+		ImageAtomicAdd         = 48,
+		ImageAtomicAnd         = 49,
+		ImageAtomicExchange    = 50,
+		ImageAtomicMax         = 51,
+		ImageAtomicMin         = 52,
+		ImageAtomicOr          = 53,
+		ImageAtomicXor         = 54,
+		ImageLoad              = 55,
+		ImageStore             = 56,
+		Inverse                = 11,
+		Length                 = 3,
+		Max                    = 4,
+		MemoryBarrier          = 22,
+		MemoryBarrierBuffer    = 23,
+		MemoryBarrierImage     = 24,
+		MemoryBarrierShared    = 25,
+		Min                    = 5,
+		NonUniform             = 47,
+		Normalize              = 9,
+		PackHalf2x16           = 31,
+		PackUnorm4x8           = 32,
+		Pow                    = 6,
+		Reflect                = 8,
+		SampleTexture          = 2,
+		SampleTextureGrad      = 35,
+		SampleTextureLod       = 36,
+		SubgroupAdd            = 40,
+		SubgroupBallot         = 41,
+		SubgroupBroadcastFirst = 42,
+		SubgroupElect          = 43,
+		SubgroupMax            = 44,
+		SubgroupMin            = 45,
+		SubgroupShuffle        = 46,
+		TextureFetch           = 37,
+		TextureGather          = 38,
+		TextureSize            = 39,
+		Transpose              = 12,
+		UnpackHalf2x16         = 33,
+		UnpackUnorm4x8         = 34
 	};
 
 	enum class LoopUnroll
@@ -113,12 +184,15 @@ namespace nzsl::Ast
 
 	enum class MemoryLayout
 	{
-		Std140 = 0
+		Std140 = 0,
+		Std430 = 1,
+		Scalar = 2
 	};
 
 	enum class ModuleFeature
 	{
-		PrimitiveExternals = 0
+		PrimitiveExternals = 0,
+		Subgroups          = 1
 	};
 
 	enum class NodeType
@@ -175,17 +249,27 @@ namespace nzsl::Ast
 		Max = ContinueStatement
 	};
 
+	enum class Precision
+	{
+		High   = 0, //< highp / full 32-bits precision (default)
+		Medium = 1  //< mediump / RelaxedPrecision, allows the driver to use 16-bits arithmetic
+	};
+
 	enum class PrimitiveType
 	{
 		Boolean = 0, //< bool
 		Float32 = 1, //< f32
 		Int32   = 2, //< i32
 		UInt32  = 3, //< u32
-		String  = 4  //< str
+		String  = 4, //< str
+		Float16 = 5, //< f16
+		Int16   = 6, //< i16
+		UInt16  = 7  //< u16
 	};
 
 	enum class UnaryType
 	{
+		BitwiseNot = 3, //< ~v
 		LogicalNot = 0, //< !v
 		Minus      = 1, //< -v
 		Plus       = 2, //< +v
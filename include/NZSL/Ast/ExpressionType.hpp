@@ -146,6 +146,16 @@ namespace nzsl::Ast
 		inline bool operator!=(const SamplerType& rhs) const;
 	};
 
+	struct StorageImageType
+	{
+		ImageType dim;
+		ImageFormat format;
+		PrimitiveType sampledType;
+
+		inline bool operator==(const StorageImageType& rhs) const;
+		inline bool operator!=(const StorageImageType& rhs) const;
+	};
+
 	struct StructType
 	{
 		std::size_t structIndex;
@@ -172,6 +182,14 @@ namespace nzsl::Ast
 	};
 
 
+	struct PushConstantType
+	{
+		StructType containedType;
+
+		inline bool operator==(const PushConstantType& rhs) const;
+		inline bool operator!=(const PushConstantType& rhs) const;
+	};
+
 	struct StorageType
 	{
 		StructType containedType;
@@ -188,7 +206,7 @@ namespace nzsl::Ast
 		inline bool operator!=(const UniformType& rhs) const;
 	};
 
-	using ExpressionType = std::variant<NoType, AliasType, ArrayType, DynArrayType, FunctionType, IntrinsicFunctionType, MatrixType, MethodType, PrimitiveType, SamplerType, StorageType, StructType, Type, UniformType, VectorType>;
+	using ExpressionType = std::variant<NoType, AliasType, ArrayType, DynArrayType, FunctionType, IntrinsicFunctionType, MatrixType, MethodType, PrimitiveType, PushConstantType, SamplerType, StorageImageType, StorageType, StructType, Type, UniformType, VectorType>;
 
 	struct ContainedType
 	{
@@ -203,6 +221,7 @@ namespace nzsl::Ast
 			ExpressionValue<bool> cond;
 			ExpressionValue<std::uint32_t> locationIndex;
 			ExpressionValue<ExpressionType> type;
+			ExpressionValue<Precision> precision;
 			std::string name;
 			SourceLocation sourceLocation;
 		};
@@ -222,7 +241,9 @@ namespace nzsl::Ast
 	inline bool IsMethodType(const ExpressionType& type);
 	inline bool IsNoType(const ExpressionType& type);
 	inline bool IsPrimitiveType(const ExpressionType& type);
+	inline bool IsPushConstantType(const ExpressionType& type);
 	inline bool IsSamplerType(const ExpressionType& type);
+	inline bool IsStorageImageType(const ExpressionType& type);
 	inline bool IsStorageType(const ExpressionType& type);
 	inline bool IsStructType(const ExpressionType& type);
 	inline bool IsTypeExpression(const ExpressionType& type);
@@ -246,7 +267,9 @@ namespace nzsl::Ast
 	std::string ToString(const MethodType& type, const Stringifier& stringifier = {});
 	std::string ToString(NoType type, const Stringifier& stringifier = {});
 	std::string ToString(PrimitiveType type, const Stringifier& stringifier = {});
+	std::string ToString(const PushConstantType& type, const Stringifier& stringifier = {});
 	std::string ToString(const SamplerType& type, const Stringifier& stringifier = {});
+	std::string ToString(const StorageImageType& type, const Stringifier& stringifier = {});
 	std::string ToString(const StorageType& type, const Stringifier& stringifier = {});
 	std::string ToString(const StructType& type, const Stringifier& stringifier = {});
 	std::string ToString(const Type& type, const Stringifier& stringifier = {});
@@ -104,6 +104,17 @@ namespace nzsl::Ast
 	{
 		return !operator==(rhs);
 	}
+
+
+	inline bool StorageImageType::operator==(const StorageImageType& rhs) const
+	{
+		return dim == rhs.dim && format == rhs.format && sampledType == rhs.sampledType;
+	}
+
+	inline bool StorageImageType::operator!=(const StorageImageType& rhs) const
+	{
+		return !operator==(rhs);
+	}
 	
 	inline bool StructType::operator==(const StructType& rhs) const
 	{
@@ -137,6 +148,17 @@ namespace nzsl::Ast
 	}
 
 
+	inline bool PushConstantType::operator==(const PushConstantType& rhs) const
+	{
+		return containedType == rhs.containedType;
+	}
+
+	inline bool PushConstantType::operator!=(const PushConstantType& rhs) const
+	{
+		return !operator==(rhs);
+	}
+
+
 	inline bool StorageType::operator==(const StorageType& rhs) const
 	{
 		return containedType == rhs.containedType;
@@ -204,11 +226,21 @@ namespace nzsl::Ast
 		return std::holds_alternative<PrimitiveType>(type);
 	}
 
+	inline bool IsPushConstantType(const ExpressionType& type)
+	{
+		return std::holds_alternative<PushConstantType>(type);
+	}
+
 	inline bool IsSamplerType(const ExpressionType& type)
 	{
 		return std::holds_alternative<SamplerType>(type);
 	}
 
+	bool IsStorageImageType(const ExpressionType& type)
+	{
+		return std::holds_alternative<StorageImageType>(type);
+	}
+
 	bool IsStorageType(const ExpressionType& type)
 	{
 		return std::holds_alternative<StorageType>(type);
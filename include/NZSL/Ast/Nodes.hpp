@@ -61,6 +61,7 @@ namespace nzsl::Ast
 		Expression& operator=(Expression&&) noexcept = default;
 
 		std::optional<ExpressionType> cachedExpressionType;
+		std::optional<Precision> cachedPrecision; //< only set on floating-point expressions, from the precision of the variables they use
 	};
 
 	struct NZSL_API AccessIdentifierExpression : Expression
@@ -343,6 +344,10 @@ namespace nzsl::Ast
 			ExpressionValue<std::uint32_t> bindingIndex;
 			ExpressionValue<std::uint32_t> bindingSet;
 			ExpressionValue<ExpressionType> type;
+			ExpressionValue<Precision> precision;
+			ExpressionValue<bool> isWorkgroupShared; //< workgroup-shared variables have no binding
+			ExpressionValue<AccessPolicy> accessPolicy; //< storage variables only
+			ExpressionValue<bool> isRestrict; //< storage variables only
 			SourceLocation sourceLocation;
 		};
 
@@ -360,6 +365,7 @@ namespace nzsl::Ast
 			std::optional<std::size_t> varIndex;
 			std::string name;
 			ExpressionValue<ExpressionType> type;
+			ExpressionValue<Precision> precision;
 			SourceLocation sourceLocation;
 		};
 
@@ -372,6 +378,7 @@ namespace nzsl::Ast
 		ExpressionValue<ExpressionType> returnType;
 		ExpressionValue<bool> earlyFragmentTests;
 		ExpressionValue<bool> isExported;
+		std::array<ExpressionValue<std::uint32_t>, 3> workgroupSize;
 	};
 
 	struct NZSL_API DeclareOptionStatement : Statement
@@ -404,6 +411,7 @@ namespace nzsl::Ast
 		std::string varName;
 		ExpressionPtr initialExpression;
 		ExpressionValue<ExpressionType> varType;
+		ExpressionValue<Precision> precision;
 	};
 
 	struct NZSL_API DiscardStatement : Statement
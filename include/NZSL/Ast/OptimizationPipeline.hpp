@@ -0,0 +1,91 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_OPTIMIZATIONPIPELINE_HPP
+#define NZSL_AST_OPTIMIZATIONPIPELINE_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Enums.hpp>
+#include <NZSL/Ast/ConstantPropagationVisitor.hpp>
+#include <NZSL/Ast/DependencyCheckerVisitor.hpp>
+#include <NZSL/Ast/Module.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace nzsl::Ast
+{
+	class NZSL_API OptimizationPipeline
+	{
+		public:
+			struct Options;
+			struct PassStatistics;
+			struct Statistics;
+
+			// Returns the transformed module, or a null pointer if the pass didn't change anything
+			using PassCallback = std::function<ModulePtr(const Module& shaderModule)>;
+
+			OptimizationPipeline() = default;
+			inline OptimizationPipeline(OptimizationLevel optimizationLevel);
+			OptimizationPipeline(OptimizationLevel optimizationLevel, const Options& options);
+			OptimizationPipeline(const OptimizationPipeline&) = default;
+			OptimizationPipeline(OptimizationPipeline&&) noexcept = default;
+			~OptimizationPipeline() = default;
+
+			void AddPass(std::string name, PassCallback callback);
+
+			inline std::size_t GetMaxIterationCount() const;
+			inline std::size_t GetPassCount() const;
+			inline const std::string& GetPassName(std::size_t passIndex) const;
+
+			ModulePtr Process(const Module& shaderModule, Statistics* statistics = nullptr) const;
+
+			inline void SetMaxIterationCount(std::size_t maxIterationCount);
+
+			OptimizationPipeline& operator=(const OptimizationPipeline&) = default;
+			OptimizationPipeline& operator=(OptimizationPipeline&&) noexcept = default;
+
+			static std::size_t CountNodes(const Module& shaderModule);
+
+			struct Options
+			{
+				ConstantPropagationVisitor::Options constantPropagation;
+				DependencyCheckerVisitor::Config dependencyConfig;
+			};
+
+			struct PassStatistics
+			{
+				std::chrono::nanoseconds duration;
+				std::size_t iteration;
+				std::size_t nodeCountAfter;
+				std::size_t nodeCountBefore;
+				std::size_t passIndex;
+				bool changed;
+			};
+
+			struct Statistics
+			{
+				std::vector<PassStatistics> passes;
+				std::size_t iterationCount = 0;
+				bool reachedFixedPoint = false;
+			};
+
+		private:
+			struct Pass
+			{
+				std::string name;
+				PassCallback callback;
+			};
+
+			std::size_t m_maxIterationCount = 1;
+			std::vector<Pass> m_passes;
+	};
+}
+
+#include <NZSL/Ast/OptimizationPipeline.inl>
+
+#endif // NZSL_AST_OPTIMIZATIONPIPELINE_HPP
@@ -0,0 +1,36 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/OptimizationPipeline.hpp>
+#include <cassert>
+
+namespace nzsl::Ast
+{
+	inline OptimizationPipeline::OptimizationPipeline(OptimizationLevel optimizationLevel) :
+	OptimizationPipeline(optimizationLevel, Options{})
+	{
+	}
+
+	inline std::size_t OptimizationPipeline::GetMaxIterationCount() const
+	{
+		return m_maxIterationCount;
+	}
+
+	inline std::size_t OptimizationPipeline::GetPassCount() const
+	{
+		return m_passes.size();
+	}
+
+	inline const std::string& OptimizationPipeline::GetPassName(std::size_t passIndex) const
+	{
+		assert(passIndex < m_passes.size());
+		return m_passes[passIndex].name;
+	}
+
+	inline void OptimizationPipeline::SetMaxIterationCount(std::size_t maxIterationCount)
+	{
+		m_maxIterationCount = maxIterationCount;
+	}
+}
+
@@ -42,6 +42,7 @@ namespace nzsl::Ast
 			{
 				std::shared_ptr<ModuleResolver> moduleResolver;
 				std::unordered_map<std::uint32_t, ConstantValue> optionValues;
+				std::uint32_t maxPushConstantSize = 128; //< minimum guaranteed by Vulkan
 				bool allowPartialSanitization = false;
 				bool makeVariableNameUnique = false;
 				bool reduceLoopsToWhile = false;
@@ -115,6 +116,7 @@ namespace nzsl::Ast
 
 			const ExpressionType* GetExpressionType(Expression& expr) const;
 			const ExpressionType& GetExpressionTypeSecure(Expression& expr) const;
+			std::optional<Precision> GetVariablePrecision(std::size_t varIndex) const;
 
 			ExpressionPtr HandleIdentifier(const IdentifierData* identifierData, const SourceLocation& sourceLocation);
 
@@ -147,11 +149,14 @@ namespace nzsl::Ast
 			std::size_t RegisterType(std::string name, std::optional<PartialType> partialType, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
 			void RegisterUnresolved(std::string name);
 			std::size_t RegisterVariable(std::string name, std::optional<ExpressionType> type, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
+			void RegisterVariablePrecision(std::size_t varIndex, const ExpressionType& varType, const ExpressionValue<Precision>& precision);
+			void RegisterVariablePrecision(std::size_t varIndex, const ExpressionType& varType, std::optional<Precision> precision);
 
 			const Identifier* ResolveAliasIdentifier(const Identifier* identifier, const SourceLocation& sourceLocation) const;
 			void ResolveFunctions();
 			std::size_t ResolveStruct(const AliasType& aliasType, const SourceLocation& sourceLocation);
 			std::size_t ResolveStruct(const ExpressionType& exprType, const SourceLocation& sourceLocation);
+			std::size_t ResolveStruct(const PushConstantType& pushConstantType, const SourceLocation& sourceLocation);
 			std::size_t ResolveStruct(const StorageType& structType, const SourceLocation& sourceLocation);
 			std::size_t ResolveStruct(const StructType& structType, const SourceLocation& sourceLocation);
 			std::size_t ResolveStruct(const UniformType& uniformType, const SourceLocation& sourceLocation);
@@ -183,6 +188,8 @@ namespace nzsl::Ast
 			ValidationResult Validate(VariableValueExpression& node);
 			ExpressionType ValidateBinaryOp(BinaryType op, const ExpressionType& leftExprType, const ExpressionType& rightExprType, const SourceLocation& sourceLocation);
 			void ValidateConcreteType(const ExpressionType& exprType, const SourceLocation& sourceLocation);
+			ValidationResult ValidateIntrinsicSignature(IntrinsicExpression& node);
+			void ValidatePrecision(const ExpressionValue<Precision>& precision, const ExpressionType& exprType, const SourceLocation& sourceLocation);
 
 			template<std::size_t N> ValidationResult ValidateIntrinsicParamCount(IntrinsicExpression& node);
 			ValidationResult ValidateIntrinsicParamMatchingType(IntrinsicExpression& node);
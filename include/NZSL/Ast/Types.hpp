@@ -18,13 +18,14 @@ namespace nzsl::Ast
 	{
 		ConstantValue,
 		FullType,
+		ImageFormat,
 		PrimitiveType,
 		StructType
 	};
 
 	struct PartialType;
 
-	using TypeParameter = std::variant<ConstantValue, ExpressionType, PartialType>;
+	using TypeParameter = std::variant<ConstantValue, ExpressionType, ImageFormat, PartialType>;
 
 	struct PartialType
 	{
@@ -56,6 +56,8 @@ namespace nzsl::Ast
 	};
 
 	inline ExpressionCategory GetExpressionCategory(Expression& expression);
+	NZSL_API bool IsPureExpression(const Expression& expression); //< expression can be removed without changing the shader behavior (no function call nor assignment)
+	NZSL_API bool IsTrivialExpression(const Expression& expression); //< expression can be duplicated at no cost (reading a variable or a constant)
 }
 
 #include <NZSL/Ast/Utils.inl>
@@ -0,0 +1,60 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_VECTORIZATIONVISITOR_HPP
+#define NZSL_AST_VECTORIZATIONVISITOR_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/Module.hpp>
+#include <unordered_set>
+#include <vector>
+
+namespace nzsl::Ast
+{
+	// Combines isomorphic scalar operations on vector components into vector operations (superword-level parallelism)
+	class NZSL_API VectorizationVisitor : Cloner
+	{
+		public:
+			VectorizationVisitor() = default;
+			VectorizationVisitor(const VectorizationVisitor&) = delete;
+			VectorizationVisitor(VectorizationVisitor&&) = delete;
+			~VectorizationVisitor() = default;
+
+			inline bool HasChanged() const;
+
+			ModulePtr Process(const Module& shaderModule);
+			StatementPtr Process(Statement& statement);
+
+			static bool CanTransform(const Module& shaderModule); //< quick check without cloning, may return true even if Process wouldn't vectorize anything
+
+			VectorizationVisitor& operator=(const VectorizationVisitor&) = delete;
+			VectorizationVisitor& operator=(VectorizationVisitor&&) = delete;
+
+		private:
+			struct VectorizedExpression;
+
+			using Cloner::Clone;
+			ExpressionPtr Clone(CastExpression& node) override;
+			StatementPtr Clone(DeclareFunctionStatement& node) override;
+			StatementPtr Clone(DeclareVariableStatement& node) override;
+			StatementPtr Clone(MultiStatement& node) override;
+
+			bool IsLocalVariable(const Expression& expression) const;
+			VectorizedExpression VectorizeLanes(const std::vector<Expression*>& lanes);
+			void VectorizeStatements(std::vector<StatementPtr>& statements);
+
+			std::unordered_set<std::size_t> m_localVariables; //< variables declared in the function being processed (and its parameters)
+			bool m_changed = false; //< whether the last Process call vectorized anything
+	};
+
+	inline ModulePtr Vectorize(const Module& shaderModule);
+	inline StatementPtr Vectorize(Statement& ast);
+}
+
+#include <NZSL/Ast/VectorizationVisitor.inl>
+
+#endif // NZSL_AST_VECTORIZATIONVISITOR_HPP
@@ -0,0 +1,26 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/VectorizationVisitor.hpp>
+
+namespace nzsl::Ast
+{
+	inline bool VectorizationVisitor::HasChanged() const
+	{
+		return m_changed;
+	}
+
+	inline ModulePtr Vectorize(const Module& shaderModule)
+	{
+		VectorizationVisitor vectorizer;
+		return vectorizer.Process(shaderModule);
+	}
+
+	inline StatementPtr Vectorize(Statement& ast)
+	{
+		VectorizationVisitor vectorizer;
+		return vectorizer.Process(ast);
+	}
+}
+
@@ -11,6 +11,27 @@
 
 namespace nzsl
 {
+	enum class ImageFormat
+	{
+		R8,
+		R16f,
+		R32f,
+		R32i,
+		R32ui,
+		Rg8,
+		Rg16f,
+		Rg32f,
+		Rgba8,
+		Rgba16f,
+		Rgba32f,
+		Rgba32i,
+		Rgba32ui,
+
+		Max = Rgba32ui
+	};
+
+	constexpr std::size_t ImageFormatCount = static_cast<std::size_t>(ImageFormat::Max) + 1;
+
 	enum class ImageType
 	{
 		E1D,
@@ -25,12 +46,23 @@ namespace nzsl
 
 	constexpr std::size_t ImageTypeCount = static_cast<std::size_t>(ImageType::Max) + 1;
 
+	enum class OptimizationLevel
+	{
+		O0, //< no optimization
+		O1, //< single run of every optimization pass
+		O2, //< optimization passes are run until the module stops changing
+		Os, //< same as O2 but without passes increasing code size (vectorization)
+
+		Max = Os
+	};
+
 	enum class ShaderStageType
 	{
 		Fragment,
 		Vertex,
+		Compute,
 
-		Max = Vertex
+		Max = Compute
 	};
 
 	constexpr std::size_t ShaderStageTypeCount = static_cast<std::size_t>(ShaderStageType::Max) + 1;
@@ -57,16 +89,30 @@ namespace nzsl
 		UInt2,
 		UInt3,
 		UInt4,
-
-		Max = UInt4
+		Half1,
+		Half2,
+		Half3,
+		Half4,
+		Short1,
+		Short2,
+		Short3,
+		Short4,
+		UShort1,
+		UShort2,
+		UShort3,
+		UShort4,
+
+		Max = UShort4
 	};
 
 	enum class StructLayout
 	{
 		Packed,
 		Std140,
+		Std430,
+		Scalar,
 
-		Max = Std140
+		Max = Scalar
 	};
 }
 
@@ -83,7 +129,7 @@ namespace nzsl
 {
 	using ShaderStageTypeFlags = Nz::Flags<nzsl::ShaderStageType>;
 
-	constexpr ShaderStageTypeFlags ShaderStageType_All = nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex;
+	constexpr ShaderStageTypeFlags ShaderStageType_All = nzsl::ShaderStageType::Fragment | nzsl::ShaderStageType::Vertex | nzsl::ShaderStageType::Compute;
 }
 
 #endif // NZSL_ENUMS_HPP
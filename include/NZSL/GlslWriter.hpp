@@ -53,6 +53,7 @@ namespace nzsl
 			{
 				std::string code;
 				std::unordered_map<std::string, unsigned int> explicitUniformBlockBinding;
+				std::string pushConstantBlockName; //< uniform block emulating the push constant block (empty if none)
 				bool usesDrawParameterBaseInstanceUniform;
 				bool usesDrawParameterBaseVertexUniform;
 				bool usesDrawParameterDrawIndexUniform;
@@ -78,7 +79,9 @@ namespace nzsl
 			void Append(Ast::MemoryLayout layout);
 			void Append(Ast::NoType);
 			void Append(Ast::PrimitiveType type);
+			void Append(const Ast::PushConstantType& pushConstantType);
 			void Append(const Ast::SamplerType& samplerType);
+			void Append(const Ast::StorageImageType& storageImageType);
 			void Append(const Ast::StorageType& storageType);
 			void Append(const Ast::StructType& structType);
 			void Append(const Ast::Type& type);
@@ -95,6 +98,7 @@ namespace nzsl
 			void AppendLine(std::string_view txt = {});
 			template<typename... Args> void AppendLine(Args&&... params);
 			void AppendModuleComments(const Ast::Module::Metadata& metadata);
+			void AppendPrecisionQualifier(const Ast::ExpressionValue<Ast::Precision>& precision);
 			void AppendStatementList(std::vector<Ast::StatementPtr>& statements);
 			template<typename T> void AppendValue(const T& value);
 			void AppendVariableDeclaration(const Ast::ExpressionType& varType, const std::string& varName);
@@ -37,6 +37,7 @@ NZSL_SHADERLANG_PARSER_ERROR(AttributeInvalidParameter, "invalid parameter {} fo
 NZSL_SHADERLANG_PARSER_ERROR(AttributeMissingParameter, "attribute {} requires a parameter", Ast::AttributeType)
 NZSL_SHADERLANG_PARSER_ERROR(AttributeMultipleUnique, "attribute {} can only be present once", Ast::AttributeType)
 NZSL_SHADERLANG_PARSER_ERROR(AttributeParameterIdentifier, "attribute {} parameter can only be an identifier", Ast::AttributeType)
+NZSL_SHADERLANG_PARSER_ERROR(AttributeUnexpectedParameterCount, "attribute {} expects {} parameter(s), got {}", Ast::AttributeType, std::uint32_t, std::uint32_t)
 NZSL_SHADERLANG_PARSER_ERROR(ExpectedToken, "expected token {}, got {}", TokenType, TokenType)
 NZSL_SHADERLANG_PARSER_ERROR(DuplicateIdentifier, "duplicate identifier")
 NZSL_SHADERLANG_PARSER_ERROR(DuplicateModule, "duplicate module")
@@ -81,10 +82,18 @@ NZSL_SHADERLANG_COMPILER_ERROR(EntryPointAlreadyDefined, "the {} entry type has
 NZSL_SHADERLANG_COMPILER_ERROR(ExpectedFunction, "expected function expression")
 NZSL_SHADERLANG_COMPILER_ERROR(ExpectedIntrinsicFunction, "expected intrinsic function expression")
 NZSL_SHADERLANG_COMPILER_ERROR(ExpectedPartialType, "only partial types can be specialized, got {}", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtAccessNotAllowed, "external variable {} cannot have access or restrict attributes, which are only allowed for storage buffers and storage images (got {})", std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ExtAlreadyDeclared, "external variable {} is already declared", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ExtBindingAlreadyUsed, "binding (set={}, binding={}) is already in use", std::uint32_t, std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(ExtMissingBindingIndex, "external variable requires a binding index")
-NZSL_SHADERLANG_COMPILER_ERROR(ExtTypeNotAllowed, "external variable {} has unauthorized type ({}): only storage buffers, samplers and uniform buffers (and primitives, vectors and matrices if primitive external feature is enabled) are allowed in external blocks", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtPushConstantAlreadyDeclared, "push constant external variable {} cannot be declared, {} is already the push constant block", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtPushConstantBinding, "push constant external variable {} cannot have a binding", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtPushConstantTooLarge, "push constant external variable {} takes {} bytes, which exceeds the limit of {} bytes", std::string, std::uint32_t, std::uint32_t)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtWorkgroupBinding, "workgroup-shared external variable {} cannot have a binding", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtWorkgroupTypeNotAllowed, "workgroup-shared external variable {} cannot be a sampler, uniform or storage buffer (got {})", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtTypeNotAllowed, "external variable {} has unauthorized type ({}): only storage buffers, storage images, samplers and uniform buffers (and primitives, vectors and matrices if primitive external feature is enabled) are allowed in external blocks", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(ExtUniformLayoutNotAllowed, "uniform buffer {} cannot use {} layout, which is only allowed for storage buffers", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(FeatureRequired, "this requires the {} feature to be enabled", Ast::ModuleFeature)
 NZSL_SHADERLANG_COMPILER_ERROR(ForEachUnsupportedType, "for-each statements can only be called on array types, got {}", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ForFromTypeExpectIntegerType, "numerical for from expression must be an integer or unsigned integer, got {}", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ForStepUnmatchingType, "numerical for step expression type ({}) must match from expression type ({})", std::string, std::string)
@@ -96,6 +105,7 @@ NZSL_SHADERLANG_COMPILER_ERROR(FunctionCallUnexpectedEntryFunction, "{} is an en
 NZSL_SHADERLANG_COMPILER_ERROR(FunctionCallUnmatchingParameterCount, "function {} expects {} parameter(s), but got {}", std::string, std::uint32_t, std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(FunctionCallUnmatchingParameterType, "function {} parameter #{} type mismatch (expected {}, got {})", std::string, std::uint32_t, std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(FunctionDeclarationInsideFunction, "a function cannot be defined inside another function")
+NZSL_SHADERLANG_COMPILER_ERROR(FunctionParameterStorageImage, "function parameter {} cannot be a storage image, which must be accessed through its external variable (got {})", std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(IdentifierAlreadyUsed, "identifier {} is already used", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ImportIdentifierAlreadyPresent, "{} identifier was already imported", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(ImportMultipleWildcard, "only one wildcard can be present in an import directive")
@@ -106,6 +116,7 @@ NZSL_SHADERLANG_COMPILER_ERROR(IndexUnexpectedType, "unexpected type: only array
 NZSL_SHADERLANG_COMPILER_ERROR(IntegralDivisionByZero, "integral division by zero in expression ({} / {})", std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(IntegralModuloByZero, "integral modulo by zero in expression ({} % {})", std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(IntrinsicExpectedFloat, "expected scalar or vector floating-points")
+NZSL_SHADERLANG_COMPILER_ERROR(IntrinsicExpectedLValue, "expected a l-value for parameter #{}", std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(IntrinsicExpectedParameterCount, "expected {} parameter(s)", std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(IntrinsicExpectedType, "expected type {1} for parameter #{0}, got {2}", std::uint32_t, std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(IntrinsicUnexpectedBoolean, "boolean parameters are not allowed")
@@ -124,7 +135,16 @@ NZSL_SHADERLANG_COMPILER_ERROR(OptionDeclarationInsideFunction, "options must be
 NZSL_SHADERLANG_COMPILER_ERROR(PartialTypeExpect, "expected a {} type at #{}", std::string, std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(PartialTypeTooFewParameters, "parameter count mismatch (expected at least {}, got {})", std::uint32_t, std::uint32_t)
 NZSL_SHADERLANG_COMPILER_ERROR(PartialTypeTooManyParameters, "parameter count mismatch (expected at most {}, got {})", std::uint32_t, std::uint32_t)
+NZSL_SHADERLANG_COMPILER_ERROR(PrecisionUnexpectedType, "precision can only be set on floating-point types and samplers (got {})", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(SamplerGatherComponentOutOfRange, "gathered component must be between 0 and 3 (got {})", std::int32_t)
+NZSL_SHADERLANG_COMPILER_ERROR(SamplerUnexpectedDim, "sampler type {} does not support this operation", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(SamplerUnexpectedType, "for now only f32 samplers are supported (got {})", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(StorageImageAtomicFormat, "atomic operations on storage images require a r32i or r32ui format (got {})", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(StorageImageFormatType, "image format {} cannot be used with {} sampled type", std::string, std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(StorageImageUnknownFormat, "unknown image format {}", std::string)
+NZSL_SHADERLANG_COMPILER_ERROR(StorageReadOnlyStore, "read-only storage buffers and images cannot be written to")
+NZSL_SHADERLANG_COMPILER_ERROR(StorageWriteOnlyLoad, "write-only storage buffers and images cannot be read from")
+NZSL_SHADERLANG_COMPILER_ERROR(StorageWriteOnlySwizzleStore, "write-only storage buffers cannot be written through a multi-component swizzle")
 NZSL_SHADERLANG_COMPILER_ERROR(StructDeclarationInsideFunction, "structs must be declared outside of functions")
 NZSL_SHADERLANG_COMPILER_ERROR(StructExpected, "struct type expected, got {}", std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(StructFieldBuiltinLocation, "a struct field cannot have both builtin and location attributes")
@@ -142,6 +162,9 @@ NZSL_SHADERLANG_COMPILER_ERROR(VarDeclarationMissingTypeAndValue, "variable must
 NZSL_SHADERLANG_COMPILER_ERROR(VarDeclarationOutsideOfFunction, "global variables outside of external blocks are forbidden")
 NZSL_SHADERLANG_COMPILER_ERROR(VarDeclarationTypeUnmatching, "initial expression type ({}) doesn't match specified type ({})", std::string, std::string)
 NZSL_SHADERLANG_COMPILER_ERROR(WhileUnrollNotSupported, "unroll(always) is not yet supported on while, use a for loop")
+NZSL_SHADERLANG_COMPILER_ERROR(WorkgroupAttribute, "only compute entry-points can have the workgroup attribute")
+NZSL_SHADERLANG_COMPILER_ERROR(WorkgroupSizeMissing, "compute entry-points require the workgroup attribute")
+NZSL_SHADERLANG_COMPILER_ERROR(WorkgroupSizeZero, "workgroup size must be greater than zero")
 
 // AST errors
 NZSL_SHADERLANG_AST_ERROR(AlreadyUsedIndex, "index {} is already used", std::size_t)
@@ -16,6 +16,13 @@ NZSL_SHADERLANG_TOKEN(Alias)
 NZSL_SHADERLANG_TOKEN(Arrow)
 NZSL_SHADERLANG_TOKEN(As)
 NZSL_SHADERLANG_TOKEN(Assign)
+NZSL_SHADERLANG_TOKEN(BitwiseAnd)
+NZSL_SHADERLANG_TOKEN(BitwiseAndAssign)
+NZSL_SHADERLANG_TOKEN(BitwiseNot)
+NZSL_SHADERLANG_TOKEN(BitwiseOr)
+NZSL_SHADERLANG_TOKEN(BitwiseOrAssign)
+NZSL_SHADERLANG_TOKEN(BitwiseXor)
+NZSL_SHADERLANG_TOKEN(BitwiseXorAssign)
 NZSL_SHADERLANG_TOKEN(BoolFalse)
 NZSL_SHADERLANG_TOKEN(BoolTrue)
 NZSL_SHADERLANG_TOKEN(Break)
@@ -70,6 +77,10 @@ NZSL_SHADERLANG_TOKEN(OpenParenthesis)
 NZSL_SHADERLANG_TOKEN(Option)
 NZSL_SHADERLANG_TOKEN(Return)
 NZSL_SHADERLANG_TOKEN(Semicolon)
+NZSL_SHADERLANG_TOKEN(ShiftLeft)
+NZSL_SHADERLANG_TOKEN(ShiftLeftAssign)
+NZSL_SHADERLANG_TOKEN(ShiftRight)
+NZSL_SHADERLANG_TOKEN(ShiftRightAssign)
 NZSL_SHADERLANG_TOKEN(StringValue)
 NZSL_SHADERLANG_TOKEN(Struct)
 NZSL_SHADERLANG_TOKEN(While)
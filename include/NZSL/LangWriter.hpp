@@ -37,6 +37,7 @@ namespace nzsl
 			};
 
 		private:
+			struct AccessAttribute;
 			struct AuthorAttribute;
 			struct BindingAttribute;
 			struct BuiltinAttribute;
@@ -49,8 +50,12 @@ namespace nzsl
 			struct LayoutAttribute;
 			struct LicenseAttribute;
 			struct LocationAttribute;
+			struct PrecisionAttribute;
+			struct RestrictAttribute;
 			struct SetAttribute;
 			struct UnrollAttribute;
+			struct WorkgroupAttribute;
+			struct WorkgroupSharedAttribute;
 
 			void Append(const Ast::AliasType& type);
 			void Append(const Ast::ArrayType& type);
@@ -63,7 +68,9 @@ namespace nzsl
 			void Append(const Ast::MethodType& methodType);
 			void Append(Ast::NoType);
 			void Append(Ast::PrimitiveType type);
+			void Append(const Ast::PushConstantType& pushConstantType);
 			void Append(const Ast::SamplerType& samplerType);
+			void Append(const Ast::StorageImageType& storageImageType);
 			void Append(const Ast::StorageType& storageType);
 			void Append(const Ast::StructType& structType);
 			void Append(const Ast::Type& type);
@@ -74,6 +81,7 @@ namespace nzsl
 			template<typename... Args> void AppendAttributes(bool appendLine, Args&&... params);
 			template<typename T> void AppendAttributesInternal(bool& first, const T& param);
 			template<typename T1, typename T2, typename... Rest> void AppendAttributesInternal(bool& first, const T1& firstParam, const T2& secondParam, Rest&&... params);
+			void AppendAttribute(AccessAttribute attribute);
 			void AppendAttribute(AuthorAttribute attribute);
 			void AppendAttribute(BindingAttribute attribute);
 			void AppendAttribute(BuiltinAttribute attribute);
@@ -86,8 +94,12 @@ namespace nzsl
 			void AppendAttribute(LayoutAttribute attribute);
 			void AppendAttribute(LicenseAttribute attribute);
 			void AppendAttribute(LocationAttribute attribute);
+			void AppendAttribute(PrecisionAttribute attribute);
+			void AppendAttribute(RestrictAttribute attribute);
 			void AppendAttribute(SetAttribute seattributet);
 			void AppendAttribute(UnrollAttribute attribute);
+			void AppendAttribute(WorkgroupAttribute attribute);
+			void AppendAttribute(WorkgroupSharedAttribute attribute);
 			void AppendComment(std::string_view section);
 			void AppendCommentSection(std::string_view section);
 			void AppendHeader();
@@ -29,7 +29,7 @@ namespace nzsl
 
 	inline std::size_t FieldOffsets::GetAlignedSize() const
 	{
-		if (m_layout == StructLayout::Std140)
+		if (m_layout != StructLayout::Packed)
 			return Nz::Align(m_size, m_largestFieldAlignment);
 		else
 			return m_size;
@@ -47,7 +47,56 @@ namespace nzsl
 			case StructLayout::Packed:
 				return 1;
 
+			// Scalar layout aligns every field to its component size
+			case StructLayout::Scalar:
+			{
+				switch (fieldType)
+				{
+					case StructFieldType::Bool1:
+					case StructFieldType::Bool2:
+					case StructFieldType::Bool3:
+					case StructFieldType::Bool4:
+					case StructFieldType::Float1:
+					case StructFieldType::Float2:
+					case StructFieldType::Float3:
+					case StructFieldType::Float4:
+					case StructFieldType::Int1:
+					case StructFieldType::Int2:
+					case StructFieldType::Int3:
+					case StructFieldType::Int4:
+					case StructFieldType::UInt1:
+					case StructFieldType::UInt2:
+					case StructFieldType::UInt3:
+					case StructFieldType::UInt4:
+						return 4;
+
+					case StructFieldType::Double1:
+					case StructFieldType::Double2:
+					case StructFieldType::Double3:
+					case StructFieldType::Double4:
+						return 8;
+
+					case StructFieldType::Half1:
+					case StructFieldType::Half2:
+					case StructFieldType::Half3:
+					case StructFieldType::Half4:
+					case StructFieldType::Short1:
+					case StructFieldType::Short2:
+					case StructFieldType::Short3:
+					case StructFieldType::Short4:
+					case StructFieldType::UShort1:
+					case StructFieldType::UShort2:
+					case StructFieldType::UShort3:
+					case StructFieldType::UShort4:
+						return 2;
+				}
+
+				break;
+			}
+
+			// std430 only differs from std140 in array and struct rounding (see FieldOffsets.cpp)
 			case StructLayout::Std140:
+			case StructLayout::Std430:
 			{
 				switch (fieldType)
 				{
@@ -82,6 +131,24 @@ namespace nzsl
 					case StructFieldType::Double3:
 					case StructFieldType::Double4:
 						return 4 * 8;
+
+					case StructFieldType::Half1:
+					case StructFieldType::Short1:
+					case StructFieldType::UShort1:
+						return 2;
+
+					case StructFieldType::Half2:
+					case StructFieldType::Short2:
+					case StructFieldType::UShort2:
+						return 2 * 2;
+
+					case StructFieldType::Half3:
+					case StructFieldType::Short3:
+					case StructFieldType::UShort3:
+					case StructFieldType::Half4:
+					case StructFieldType::Short4:
+					case StructFieldType::UShort4:
+						return 4 * 2;
 				}
 			}
 		}
@@ -96,29 +163,41 @@ namespace nzsl
 			case StructFieldType::Bool1:
 			case StructFieldType::Double1:
 			case StructFieldType::Float1:
+			case StructFieldType::Half1:
 			case StructFieldType::Int1:
+			case StructFieldType::Short1:
 			case StructFieldType::UInt1:
+			case StructFieldType::UShort1:
 				return 1;
 
 			case StructFieldType::Bool2:
 			case StructFieldType::Double2:
 			case StructFieldType::Float2:
+			case StructFieldType::Half2:
 			case StructFieldType::Int2:
+			case StructFieldType::Short2:
 			case StructFieldType::UInt2:
+			case StructFieldType::UShort2:
 				return 2;
 
 			case StructFieldType::Bool3:
 			case StructFieldType::Double3:
 			case StructFieldType::Float3:
+			case StructFieldType::Half3:
 			case StructFieldType::Int3:
+			case StructFieldType::Short3:
 			case StructFieldType::UInt3:
+			case StructFieldType::UShort3:
 				return 3;
 
 			case StructFieldType::Bool4:
 			case StructFieldType::Double4:
 			case StructFieldType::Float4:
+			case StructFieldType::Half4:
 			case StructFieldType::Int4:
+			case StructFieldType::Short4:
 			case StructFieldType::UInt4:
+			case StructFieldType::UShort4:
 				return 4;
 		}
 
@@ -164,6 +243,26 @@ namespace nzsl
 
 			case StructFieldType::Double4:
 				return 4 * 8;
+
+			case StructFieldType::Half1:
+			case StructFieldType::Short1:
+			case StructFieldType::UShort1:
+				return 2;
+
+			case StructFieldType::Half2:
+			case StructFieldType::Short2:
+			case StructFieldType::UShort2:
+				return 2 * 2;
+
+			case StructFieldType::Half3:
+			case StructFieldType::Short3:
+			case StructFieldType::UShort3:
+				return 3 * 2;
+
+			case StructFieldType::Half4:
+			case StructFieldType::Short4:
+			case StructFieldType::UShort4:
+				return 4 * 2;
 		}
 
 		return 0;
@@ -28,7 +28,7 @@ namespace nzsl
 			struct Attribute
 			{
 				Ast::AttributeType type;
-				Ast::ExpressionPtr args;
+				std::vector<Ast::ExpressionPtr> args;
 				SourceLocation sourceLocation;
 			};
 
@@ -67,7 +67,7 @@ namespace nzsl
 			Ast::StatementPtr ParseStatement();
 			std::vector<Ast::StatementPtr> ParseStatementList(SourceLocation* sourceLocation);
 			Ast::StatementPtr ParseStructDeclaration(std::vector<Attribute> attributes = {});
-			Ast::StatementPtr ParseVariableDeclaration();
+			Ast::StatementPtr ParseVariableDeclaration(std::vector<Attribute> attributes = {});
 			Ast::StatementPtr ParseWhileStatement(std::vector<Attribute> attributes);
 
 			// Expressions
@@ -88,6 +88,7 @@ namespace nzsl
 			Ast::ExpressionPtr ParseType();
 
 			const std::string& ExtractStringAttribute(Attribute&& attribute);
+			Ast::ExpressionPtr ExtractSingleAttributeParameter(Attribute&& attribute);
 			template<typename T> void HandleUniqueAttribute(Ast::ExpressionValue<T>& targetAttribute, Attribute&& attribute);
 			template<typename T> void HandleUniqueAttribute(Ast::ExpressionValue<T>& targetAttribute, Attribute&& attribute, T defaultValue);
 			template<typename T, typename M> void HandleUniqueStringAttributeKey(Ast::ExpressionValue<T>& targetAttribute, Attribute&& attribute, const M& map, std::optional<T> defaultValue = {});
@@ -191,6 +191,11 @@ namespace nzsl::ShaderBuilder
 			case Ast::PrimitiveType::Int32:   return ShaderBuilder::ConstantValue(Nz::SafeCast<std::int32_t>(value));
 			case Ast::PrimitiveType::UInt32:  return ShaderBuilder::ConstantValue(Nz::SafeCast<std::uint32_t>(value));
 			case Ast::PrimitiveType::String:  return ShaderBuilder::ConstantValue(value);
+
+			case Ast::PrimitiveType::Float16:
+			case Ast::PrimitiveType::Int16:
+			case Ast::PrimitiveType::UInt16:
+				throw std::runtime_error("16-bit constants are not supported");
 		}
 
 		throw std::runtime_error("unexpected primitive type");
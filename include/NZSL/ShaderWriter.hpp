@@ -8,6 +8,7 @@
 #define NZSL_SHADERWRITER_HPP
 
 #include <NZSL/Config.hpp>
+#include <NZSL/Enums.hpp>
 #include <NZSL/Ast/ConstantValue.hpp>
 #include <memory>
 #include <string>
@@ -31,7 +32,8 @@ namespace nzsl
 			{
 				std::shared_ptr<ModuleResolver> shaderModuleResolver;
 				std::unordered_map<std::uint32_t, Ast::ConstantValue> optionValues;
-				bool optimize = false;
+				OptimizationLevel optimizationLevel = OptimizationLevel::O0;
+				bool optimize = false; //< same as OptimizationLevel::O1 (if optimizationLevel is O0)
 				bool sanitized = false;
 			};
 	};
@@ -11,9 +11,13 @@
 #include <NZSL/Ast/ExpressionType.hpp>
 #include <NZSL/Ast/ExpressionVisitorExcept.hpp>
 #include <NZSL/Ast/StatementVisitorExcept.hpp>
+#include <NZSL/Math/Vector.hpp>
 #include <NZSL/SpirV/SpirvBlock.hpp>
+#include <NZSL/SpirV/SpirvSection.hpp>
+#include <memory>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace nzsl
@@ -25,18 +29,30 @@ namespace nzsl
 		public:
 			struct EntryPoint;
 			struct FuncData;
+			struct FunctionCode;
 
-			inline SpirvAstVisitor(SpirvWriter& writer, SpirvSection& instructions, std::unordered_map<std::size_t, FuncData>& funcData);
+			inline SpirvAstVisitor(SpirvWriter& writer, std::vector<FunctionCode>& functions, std::unordered_map<std::size_t, FuncData>& funcData);
 			SpirvAstVisitor(const SpirvAstVisitor&) = delete;
 			SpirvAstVisitor(SpirvAstVisitor&&) = delete;
 			~SpirvAstVisitor() = default;
 
 			std::uint32_t AllocateResultId();
 
+			inline void CopyGlobals(const SpirvAstVisitor& visitor);
+
+			void DecorateNonUniform(std::uint32_t resultId);
+
 			std::uint32_t EvaluateExpression(Ast::Expression& expr);
 
 			const SpirvVariable& GetVariable(std::size_t varIndex) const;
 
+			// Scope and memory semantics used by atomic and barrier intrinsics
+			static SpirvScope GetIntrinsicMemoryScope(Ast::IntrinsicType intrinsic);
+			static std::uint32_t GetIntrinsicMemorySemantics(Ast::IntrinsicType intrinsic);
+
+			// When set, function declarations are collected instead of being generated (to be visited later by visitors sharing the same globals)
+			inline void SetDeferredFunctions(std::vector<Ast::DeclareFunctionStatement*>* deferredFunctions);
+
 			using ExpressionVisitorExcept::Visit;
 			using StatementVisitorExcept::Visit;
 
@@ -99,6 +115,7 @@ namespace nzsl
 				std::vector<Input> inputs;
 				std::vector<Output> outputs;
 				std::vector<SpirvExecutionMode> executionModes;
+				std::optional<Vector3u32> workgroupSize;
 			};
 
 			struct FuncData
@@ -122,7 +139,9 @@ namespace nzsl
 					std::uint32_t varId;
 				};
 
+				std::optional<SpirvLinkageType> linkageType; //< imported functions are declared without a body (to be resolved by SpirvLinker)
 				std::size_t funcIndex;
+				std::string linkageName;
 				std::string name;
 				std::vector<FuncCall> funcCalls;
 				std::vector<Parameter> parameters;
@@ -133,28 +152,45 @@ namespace nzsl
 				std::uint32_t returnTypeId;
 			};
 
+			// Blocks are kept apart instead of being appended to a single section, so they can be written directly to the output
+			struct FunctionCode
+			{
+				SpirvSection declaration; //< OpFunction and OpFunctionParameter instructions
+				SpirvSection decorations; //< decorations of the function ids, written with the module annotations
+				std::vector<std::unique_ptr<SpirvBlock>> blocks; //< function body, OpFunctionEnd is not included
+			};
+
 		private:
+			inline std::unique_ptr<SpirvBlock> CreateBlock();
+
+			void DecorateRelaxedPrecision(std::uint32_t resultId);
+
 			void HandleStatementList(const std::vector<Ast::StatementPtr>& statements);
 
 			void PushResultId(std::uint32_t value);
 			std::uint32_t PopResultId();
 
-			inline void RegisterExternalVariable(std::size_t varIndex, const Ast::ExpressionType& type);
+			inline void RegisterExternalVariable(std::size_t varIndex, const Ast::ExpressionType& type, bool isWorkgroupShared);
 			inline void RegisterStruct(std::size_t structIndex, Ast::StructDescription* structDesc);
 			inline void RegisterVariable(std::size_t varIndex, std::uint32_t typeId, std::uint32_t pointerId, SpirvStorageClass storageClass);
 
+			inline void SetSourceLocation(const SourceLocation& sourceLocation);
+
 			std::optional<std::uint32_t> m_breakTarget;
 			std::optional<std::uint32_t> m_continueTarget;
 			std::size_t m_funcCallIndex;
 			std::size_t m_funcIndex;
 			std::unordered_map<std::size_t, FuncData>& m_funcData;
+			std::vector<Ast::DeclareFunctionStatement*>* m_deferredFunctions;
+			std::vector<FunctionCode>& m_functions;
 			std::unordered_map<std::size_t, Ast::StructDescription*> m_structs;
 			std::unordered_map<std::size_t, SpirvVariable> m_variables;
+			std::unordered_set<std::uint32_t> m_relaxedPrecisionIds;
 			std::vector<std::size_t> m_scopeSizes;
 			std::vector<std::unique_ptr<SpirvBlock>> m_functionBlocks;
 			std::vector<std::uint32_t> m_resultIds;
+			SpirvBlock::DebugLine m_debugLine;
 			SpirvBlock* m_currentBlock;
-			SpirvSection& m_instructions;
 			SpirvWriter& m_writer;
 	};
 }
@@ -7,22 +7,54 @@
 
 namespace nzsl
 {
-	inline SpirvAstVisitor::SpirvAstVisitor(SpirvWriter& writer, SpirvSection& instructions, std::unordered_map<std::size_t, FuncData>& funcData) :
+	inline SpirvAstVisitor::SpirvAstVisitor(SpirvWriter& writer, std::vector<FunctionCode>& functions, std::unordered_map<std::size_t, FuncData>& funcData) :
 	m_funcIndex(0),
 	m_funcData(funcData),
+	m_deferredFunctions(nullptr),
+	m_functions(functions),
 	m_currentBlock(nullptr),
-	m_instructions(instructions),
 	m_writer(writer)
 	{
 	}
 
-	void SpirvAstVisitor::RegisterExternalVariable(std::size_t varIndex, const Ast::ExpressionType& type)
+	inline void SpirvAstVisitor::CopyGlobals(const SpirvAstVisitor& visitor)
+	{
+		m_structs = visitor.m_structs;
+		m_variables = visitor.m_variables;
+	}
+
+	inline std::unique_ptr<SpirvBlock> SpirvAstVisitor::CreateBlock()
+	{
+		auto block = std::make_unique<SpirvBlock>(m_writer);
+		block->SetDebugLineSource(&m_debugLine);
+
+		return block;
+	}
+
+	inline void SpirvAstVisitor::SetDeferredFunctions(std::vector<Ast::DeclareFunctionStatement*>* deferredFunctions)
+	{
+		m_deferredFunctions = deferredFunctions;
+	}
+
+	void SpirvAstVisitor::RegisterExternalVariable(std::size_t varIndex, const Ast::ExpressionType& type, bool isWorkgroupShared)
 	{
 		std::uint32_t pointerId = m_writer.GetExtVarPointerId(varIndex);
+
+		// Descriptor arrays share the storage class of their element
+		const Ast::ExpressionType* descriptorType = &type;
+		if (IsArrayType(type))
+			descriptorType = &std::get<Ast::ArrayType>(type).containedType->type;
+		else if (IsDynArrayType(type))
+			descriptorType = &std::get<Ast::DynArrayType>(type).containedType->type;
+
 		SpirvStorageClass storageClass;
-		if (IsSamplerType(type))
+		if (isWorkgroupShared)
+			storageClass = SpirvStorageClass::Workgroup;
+		else if (IsPushConstantType(*descriptorType))
+			storageClass = SpirvStorageClass::PushConstant;
+		else if (IsSamplerType(*descriptorType) || IsStorageImageType(*descriptorType))
 			storageClass = SpirvStorageClass::UniformConstant;
-		else if (IsStorageType(type) && m_writer.IsVersionGreaterOrEqual(1, 3))
+		else if (IsStorageType(*descriptorType) && m_writer.IsVersionGreaterOrEqual(1, 3))
 			// Starting from SPIR-V 1.3, Storage Buffer have their own separate storage class
 			storageClass = SpirvStorageClass::StorageBuffer;
 		else
@@ -46,5 +78,15 @@ namespace nzsl
 			storageClass
 		};
 	}
+
+	inline void SpirvAstVisitor::SetSourceLocation(const SourceLocation& sourceLocation)
+	{
+		// fileId is only set inside functions when debug line info is enabled
+		if (m_debugLine.fileId == 0 || !sourceLocation.IsValid())
+			return;
+
+		m_debugLine.line = sourceLocation.startLine;
+		m_debugLine.column = sourceLocation.startColumn;
+	}
 }
 
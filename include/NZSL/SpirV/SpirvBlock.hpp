@@ -18,6 +18,8 @@ namespace nzsl
 	class NZSL_API SpirvBlock : public SpirvSectionBase
 	{
 		public:
+			struct DebugLine;
+
 			inline SpirvBlock(SpirvWriter& writer);
 			SpirvBlock(const SpirvBlock&) = default;
 			SpirvBlock(SpirvBlock&&) = default;
@@ -31,14 +33,26 @@ namespace nzsl
 
 			inline bool IsTerminated() const;
 
+			// An OpLine is emitted before the next instruction each time the pointed line changes (it must outlive the block generation)
+			inline void SetDebugLineSource(const DebugLine* debugLine);
+
 			SpirvBlock& operator=(const SpirvBlock&) = delete;
 			SpirvBlock& operator=(SpirvBlock&&) = default;
 
 			static inline bool IsTerminationInstruction(SpirvOp op);
 
+			struct DebugLine
+			{
+				std::uint32_t fileId = 0; //< OpString id of the source file, no OpLine is emitted if zero
+				std::uint32_t line = 0;
+				std::uint32_t column = 0;
+			};
+
 		private:
 			inline void HandleSpirvOp(SpirvOp op);
 
+			const DebugLine* m_debugLineSource;
+			DebugLine m_lastDebugLine;
 			std::uint32_t m_labelId;
 			bool m_isTerminated;
 	};
@@ -7,6 +7,7 @@
 namespace nzsl
 {
 	inline SpirvBlock::SpirvBlock(SpirvWriter& writer) :
+	m_debugLineSource(nullptr),
 	m_isTerminated(false)
 	{
 		m_labelId = writer.AllocateResultId();
@@ -46,6 +47,11 @@ namespace nzsl
 		return m_isTerminated;
 	}
 
+	inline void SpirvBlock::SetDebugLineSource(const DebugLine* debugLine)
+	{
+		m_debugLineSource = debugLine;
+	}
+
 	inline bool SpirvBlock::IsTerminationInstruction(SpirvOp op)
 	{
 		switch (op)
@@ -68,7 +74,20 @@ namespace nzsl
 	{
 		assert(!m_isTerminated);
 		if (IsTerminationInstruction(op))
+		{
 			m_isTerminated = true;
+			return; //< merge instructions must be immediately followed by their branch
+		}
+
+		if (!m_debugLineSource || m_debugLineSource->fileId == 0 || op == SpirvOp::OpLabel || op == SpirvOp::OpPhi)
+			return;
+
+		const DebugLine& debugLine = *m_debugLineSource;
+		if (debugLine.fileId != m_lastDebugLine.fileId || debugLine.line != m_lastDebugLine.line || debugLine.column != m_lastDebugLine.column)
+		{
+			SpirvSectionBase::Append(SpirvOp::OpLine, debugLine.fileId, debugLine.line, debugLine.column);
+			m_lastDebugLine = debugLine;
+		}
 	}
 }
 
@@ -22,10 +22,12 @@ namespace nzsl
 {
 	class FieldOffsets;
 	class SpirvSection;
+	class SpirvTypeCache;
 
 	class NZSL_API SpirvConstantCache
 	{
 		public:
+			using CapabilityCallback = std::function<void(SpirvCapability capability)>;
 			using StructCallback = std::function<const Ast::StructDescription&(std::size_t structIndex)>;
 
 			SpirvConstantCache(std::uint32_t& resultId);
@@ -110,11 +112,13 @@ namespace nzsl
 					std::string name;
 					TypePtr type;
 					mutable std::optional<std::uint32_t> offset;
+					bool relaxedPrecision = false;
 				};
 
 				std::string name;
 				std::vector<Member> members;
 				std::vector<SpirvDecoration> decorations;
+				StructLayout layout = StructLayout::Std140;
 			};
 
 			using AnyType = std::variant<Array, Bool, Float, Function, Image, Integer, Matrix, Pointer, SampledImage, Structure, Vector, Void>;
@@ -160,6 +164,7 @@ namespace nzsl
 				}
 
 				AnyConstant constant;
+				mutable std::optional<std::size_t> hash; //< structural hash, computed on first lookup (constants must not be modified afterwards)
 			};
 
 			struct Type
@@ -170,6 +175,7 @@ namespace nzsl
 				}
 
 				AnyType type;
+				mutable std::optional<std::size_t> hash; //< structural hash, computed on first lookup (types must not be modified afterwards)
 			};
 
 			ConstantPtr BuildArrayConstant(const Ast::ConstantArrayValue& value) const;
@@ -186,13 +192,19 @@ namespace nzsl
 			TypePtr BuildType(const Ast::MatrixType& type) const;
 			TypePtr BuildType(const Ast::NoType& type) const;
 			TypePtr BuildType(const Ast::PrimitiveType& type) const;
+			TypePtr BuildType(const Ast::PushConstantType& type) const;
 			TypePtr BuildType(const Ast::SamplerType& type) const;
+			TypePtr BuildType(const Ast::StorageImageType& type) const;
 			TypePtr BuildType(const Ast::StorageType& type) const;
 			TypePtr BuildType(const Ast::StructType& type) const;
 			TypePtr BuildType(const Ast::StructDescription& structDesc, std::vector<SpirvDecoration> decorations = {}) const;
 			TypePtr BuildType(const Ast::VectorType& type) const;
 			TypePtr BuildType(const Ast::UniformType& type) const;
 
+			// Unlike GetId, doesn't throw on unregistered constants and types
+			std::optional<std::uint32_t> FindId(const Constant& c) const;
+			std::optional<std::uint32_t> FindId(const Type& t) const;
+
 			std::uint32_t GetId(const Constant& c);
 			std::uint32_t GetId(const Type& t);
 			std::uint32_t GetId(const Variable& v);
@@ -215,9 +227,11 @@ namespace nzsl
 			std::size_t RegisterArrayField(FieldOffsets& fieldOffsets, const Vector& type, std::size_t arrayLength) const;
 			std::size_t RegisterArrayField(FieldOffsets& fieldOffsets, const Void& type, std::size_t arrayLength) const;
 
+			void SetCapabilityCallback(CapabilityCallback callback); //< called for capabilities required by registered types
 			void SetStructCallback(StructCallback callback);
+			void SetTypeCache(std::shared_ptr<SpirvTypeCache> typeCache);
 
-			void Write(SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos);
+			void Write(SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos); //< debugInfos can be null to skip debug names
 
 			SpirvConstantCache& operator=(const SpirvConstantCache& cache) = delete;
 			SpirvConstantCache& operator=(SpirvConstantCache&& cache) noexcept;
@@ -225,15 +239,16 @@ namespace nzsl
 		private:
 			struct DepRegisterer;
 			struct Eq;
+			struct Hasher;
 			struct Internal;
 			template<typename T, typename Enable = void> struct TypeBuilder;
 
 			template<typename T> static Type BuildSingleType();
 
 			void Write(const AnyConstant& constant, std::uint32_t resultId, SpirvSection& constants);
-			void Write(const AnyType& type, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos);
+			void Write(const AnyType& type, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos);
 
-			void WriteStruct(const Structure& structData, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos);
+			void WriteStruct(const Structure& structData, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos);
 
 			std::unique_ptr<Internal> m_internal;
 	};
@@ -27,6 +27,7 @@ namespace nzsl
 			~SpirvExpressionLoad() = default;
 
 			std::uint32_t Evaluate(Ast::Expression& node);
+			std::uint32_t EvaluatePointer(Ast::Expression& node);
 
 			using ExpressionVisitorExcept::Visit;
 			void Visit(Ast::AccessIndexExpression& node) override;
@@ -51,6 +52,7 @@ namespace nzsl
 				SpirvStorageClass storage;
 				std::uint32_t pointerId;
 				std::uint32_t pointedTypeId;
+				bool isNonUniform = false; //< indexed by a non_uniform value (descriptor arrays)
 			};
 
 			struct Pointer
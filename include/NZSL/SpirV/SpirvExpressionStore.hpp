@@ -41,6 +41,7 @@ namespace nzsl
 			{
 				SpirvStorageClass storage;
 				std::uint32_t pointerId;
+				bool isNonUniform = false; //< derived from a non_uniform index (descriptor arrays)
 			};
 
 			struct SwizzledPointer : Pointer
@@ -0,0 +1,46 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVLINKER_HPP
+#define NZSL_SPIRV_SPIRVLINKER_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvDecoder.hpp>
+#include <vector>
+
+namespace nzsl
+{
+	// Merges SPIR-V modules into one, resolving functions with Import linkage to the functions exported by other modules
+	// (see SpirvWriter::Environment::exportFunctions and importModuleFunctions)
+	class NZSL_API SpirvLinker : SpirvDecoder
+	{
+		public:
+			inline SpirvLinker();
+			SpirvLinker(const SpirvLinker&) = default;
+			SpirvLinker(SpirvLinker&&) = default;
+			~SpirvLinker() = default;
+
+			inline std::vector<std::uint32_t> Link(const std::vector<std::vector<std::uint32_t>>& modules);
+			std::vector<std::uint32_t> Link(const std::vector<std::uint32_t>* const* modules, std::size_t moduleCount);
+
+			SpirvLinker& operator=(const SpirvLinker&) = default;
+			SpirvLinker& operator=(SpirvLinker&&) = default;
+
+		private:
+			struct Instruction;
+			struct Module;
+			struct State;
+
+			bool HandleHeader(const SpirvHeader& header) override;
+			bool HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount) override;
+
+			State* m_currentState;
+	};
+}
+
+#include <NZSL/SpirV/SpirvLinker.inl>
+
+#endif // NZSL_SPIRV_SPIRVLINKER_HPP
@@ -0,0 +1,23 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvLinker.hpp>
+
+namespace nzsl
+{
+	inline SpirvLinker::SpirvLinker() :
+	m_currentState(nullptr)
+	{
+	}
+
+	inline std::vector<std::uint32_t> SpirvLinker::Link(const std::vector<std::vector<std::uint32_t>>& modules)
+	{
+		std::vector<const std::vector<std::uint32_t>*> modulePtrs;
+		modulePtrs.reserve(modules.size());
+		for (const auto& module : modules)
+			modulePtrs.push_back(&module);
+
+		return Link(modulePtrs.data(), modulePtrs.size());
+	}
+}
@@ -0,0 +1,88 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVOPTIMIZER_HPP
+#define NZSL_SPIRV_SPIRVOPTIMIZER_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvDecoder.hpp>
+#include <vector>
+
+namespace nzsl
+{
+	class NZSL_API SpirvOptimizer : SpirvDecoder
+	{
+		public:
+			class OutputSink;
+			struct Settings;
+
+			inline SpirvOptimizer();
+			SpirvOptimizer(const SpirvOptimizer&) = default;
+			SpirvOptimizer(SpirvOptimizer&&) = default;
+			~SpirvOptimizer() = default;
+
+			inline std::vector<std::uint32_t> Optimize(const std::vector<std::uint32_t>& codepoints);
+			inline std::vector<std::uint32_t> Optimize(const std::uint32_t* codepoints, std::size_t count);
+			inline std::vector<std::uint32_t> Optimize(const std::vector<std::uint32_t>& codepoints, const Settings& settings);
+			std::vector<std::uint32_t> Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings);
+			void Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings, OutputSink& output);
+
+			SpirvOptimizer& operator=(const SpirvOptimizer&) = default;
+			SpirvOptimizer& operator=(SpirvOptimizer&&) = default;
+
+			class NZSL_API OutputSink
+			{
+				public:
+					OutputSink() = default;
+					OutputSink(const OutputSink&) = delete;
+					OutputSink(OutputSink&&) = delete;
+					virtual ~OutputSink();
+
+					// Called once with the optimized module size, the returned storage must hold wordCount words and is filled directly by the optimizer
+					virtual std::uint32_t* Allocate(std::size_t wordCount) = 0;
+
+					OutputSink& operator=(const OutputSink&) = delete;
+					OutputSink& operator=(OutputSink&&) = delete;
+			};
+
+			struct Settings
+			{
+				bool eliminateDeadCode = true;
+				bool forwardLoadStores = true;
+				bool promoteVariables = true;
+				bool removeRedundantAccessChains = true;
+			};
+
+		private:
+			struct Function;
+			struct Instruction;
+
+			bool HandleHeader(const SpirvHeader& header) override;
+			bool HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount) override;
+
+			std::uint32_t AllocateResultId();
+
+			void BuildControlFlow(Function& function);
+
+			void EliminateDeadGlobals();
+			void EliminateDeadInstructions(Function& function);
+			void ForwardLoadStores(Function& function);
+
+			std::uint32_t GetUndefId(std::uint32_t typeId);
+			std::uint32_t GetValueDecorations(std::uint32_t id) const;
+
+			bool IsPureInstruction(const Instruction& instruction) const;
+
+			void PromoteVariables(Function& function);
+
+			struct State;
+			State* m_currentState;
+	};
+}
+
+#include <NZSL/SpirV/SpirvOptimizer.inl>
+
+#endif // NZSL_SPIRV_SPIRVOPTIMIZER_HPP
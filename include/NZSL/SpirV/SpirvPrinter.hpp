@@ -9,8 +9,8 @@
 
 #include <NZSL/Config.hpp>
 #include <NZSL/SpirV/SpirvDecoder.hpp>
-#include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace nzsl
@@ -18,6 +18,7 @@ namespace nzsl
 	class NZSL_API SpirvPrinter : SpirvDecoder
 	{
 		public:
+			class OutputSink;
 			struct Settings;
 
 			inline SpirvPrinter();
@@ -29,20 +30,43 @@ namespace nzsl
 			inline std::string Print(const std::uint32_t* codepoints, std::size_t count);
 			inline std::string Print(const std::vector<std::uint32_t>& codepoints, const Settings& settings);
 			std::string Print(const std::uint32_t* codepoints, std::size_t count, const Settings& settings);
+			void Print(const std::uint32_t* codepoints, std::size_t count, const Settings& settings, OutputSink& output);
 
 			SpirvPrinter& operator=(const SpirvPrinter&) = default;
 			SpirvPrinter& operator=(SpirvPrinter&&) = default;
 
+			class NZSL_API OutputSink
+			{
+				public:
+					OutputSink() = default;
+					OutputSink(const OutputSink&) = delete;
+					OutputSink(OutputSink&&) = delete;
+					virtual ~OutputSink();
+
+					// Called with chunks of complete lines as the module is printed
+					virtual void Write(std::string_view text) = 0;
+
+					OutputSink& operator=(const OutputSink&) = delete;
+					OutputSink& operator=(OutputSink&&) = delete;
+			};
+
 			struct Settings
 			{
+				std::vector<std::string> functions; //< if not empty, only functions having one of these names (from OpName) are printed
+				bool printAnnotations = true;
+				bool printDebug = true; //< OpName, OpSource and such
+				bool printFunctions = true;
+				bool printGlobals = true; //< types, constants and global variables
 				bool printHeader = true;
 				bool printParameters = true;
+				bool printPreamble = true; //< capabilities, extensions, memory model, entry points and execution modes
 			};
 
 		private:
 			bool HandleHeader(const SpirvHeader& header) override;
 			bool HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount) override;
-			void PrintOperand(std::ostream& instructionStream, const SpirvOperand* operand);
+			void PrintOperand(const SpirvOperand* operand);
+			void PrintOperands(const SpirvOperand* operands, std::size_t minOperandCount, const std::uint32_t* endPtr);
 
 			enum class ExtensionSet
 			{
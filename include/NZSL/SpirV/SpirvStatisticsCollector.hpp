@@ -0,0 +1,78 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVSTATISTICSCOLLECTOR_HPP
+#define NZSL_SPIRV_SPIRVSTATISTICSCOLLECTOR_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvDecoder.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace nzsl
+{
+	class NZSL_API SpirvStatisticsCollector : SpirvDecoder
+	{
+		public:
+			struct Counters;
+			struct FunctionStatistics;
+			struct Statistics;
+
+			inline SpirvStatisticsCollector();
+			SpirvStatisticsCollector(const SpirvStatisticsCollector&) = default;
+			SpirvStatisticsCollector(SpirvStatisticsCollector&&) = default;
+			~SpirvStatisticsCollector() = default;
+
+			inline Statistics Collect(const std::vector<std::uint32_t>& codepoints);
+			Statistics Collect(const std::uint32_t* codepoints, std::size_t count);
+
+			SpirvStatisticsCollector& operator=(const SpirvStatisticsCollector&) = default;
+			SpirvStatisticsCollector& operator=(SpirvStatisticsCollector&&) = default;
+
+			struct Counters
+			{
+				std::map<SpirvOp, std::size_t> opCounts;
+				std::size_t accessChainCount = 0;
+				std::size_t branchCount = 0;
+				std::size_t constantCount = 0;
+				std::size_t instructionCount = 0;
+				std::size_t loadCount = 0;
+				std::size_t storeCount = 0;
+				std::size_t typeCount = 0;
+				std::size_t wordCount = 0;
+			};
+
+			struct FunctionStatistics
+			{
+				std::string name; //< from OpName, empty if the function has none
+				std::uint32_t id;
+				Counters counters; //< including OpFunction and OpFunctionEnd
+			};
+
+			struct Statistics
+			{
+				std::uint32_t idBound;
+				std::uint32_t versionNumber;
+				std::vector<FunctionStatistics> functions;
+				Counters module; //< whole module, except for the header words
+				std::size_t wordCount; //< including the header
+			};
+
+		private:
+			bool HandleHeader(const SpirvHeader& header) override;
+			bool HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount) override;
+
+			static void Count(Counters& counters, const SpirvInstruction& instruction, std::uint32_t wordCount);
+
+			struct State;
+			State* m_currentState;
+	};
+}
+
+#include <NZSL/SpirV/SpirvStatisticsCollector.inl>
+
+#endif // NZSL_SPIRV_SPIRVSTATISTICSCOLLECTOR_HPP
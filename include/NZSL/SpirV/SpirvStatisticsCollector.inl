@@ -0,0 +1,18 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvStatisticsCollector.hpp>
+
+namespace nzsl
+{
+	inline SpirvStatisticsCollector::SpirvStatisticsCollector() :
+	m_currentState(nullptr)
+	{
+	}
+
+	inline auto SpirvStatisticsCollector::Collect(const std::vector<std::uint32_t>& codepoints) -> Statistics
+	{
+		return Collect(codepoints.data(), codepoints.size());
+	}
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVTYPECACHE_HPP
+#define NZSL_SPIRV_SPIRVTYPECACHE_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvConstantCache.hpp>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace nzsl
+{
+	// Persistent struct types (with their layout) shared by multiple SpirvConstantCache, across generations and threads
+	// Structs are identified by their content (name, members and decorations), result ids are still assigned by each SpirvConstantCache
+	class NZSL_API SpirvTypeCache
+	{
+		friend SpirvConstantCache;
+
+		public:
+			SpirvTypeCache() = default;
+			SpirvTypeCache(const SpirvTypeCache&) = delete;
+			SpirvTypeCache(SpirvTypeCache&&) = delete;
+			~SpirvTypeCache() = default;
+
+			void Clear();
+
+			std::size_t GetStructCount() const;
+
+			SpirvTypeCache& operator=(const SpirvTypeCache&) = delete;
+			SpirvTypeCache& operator=(SpirvTypeCache&&) = delete;
+
+		private:
+			SpirvConstantCache::TypePtr FindStruct(const std::string& key) const;
+			SpirvConstantCache::TypePtr RegisterStruct(std::string key, SpirvConstantCache::TypePtr type);
+
+			mutable std::shared_mutex m_mutex;
+			std::unordered_map<std::string, SpirvConstantCache::TypePtr> m_structs;
+	};
+}
+
+#include <NZSL/SpirV/SpirvTypeCache.inl>
+
+#endif // NZSL_SPIRV_SPIRVTYPECACHE_HPP
@@ -13,13 +13,18 @@
 #include <NZSL/Ast/Module.hpp>
 #include <NZSL/SpirV/SpirvConstantCache.hpp>
 #include <NZSL/SpirV/SpirvVariable.hpp>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace nzsl
 {
+	class SpirvAstVisitor;
 	class SpirvSection;
+	class SpirvSectionBase;
+	class SpirvTypeCache;
 
 	class NZSL_API SpirvWriter : public ShaderWriter
 	{
@@ -32,6 +37,14 @@ namespace nzsl
 
 		public:
 			struct Environment;
+			class OutputSink;
+
+			enum class DebugNames
+			{
+				All,         //< names every function, struct (and members) and global variable
+				EntryPoints, //< only names entry point functions
+				None
+			};
 
 			SpirvWriter();
 			SpirvWriter(const SpirvWriter&) = delete;
@@ -39,6 +52,7 @@ namespace nzsl
 			~SpirvWriter() = default;
 
 			std::vector<std::uint32_t> Generate(const Ast::Module& module, const States& states = {});
+			void Generate(const Ast::Module& module, const States& states, OutputSink& output);
 
 			const SpirvVariable& GetConstantVariable(std::size_t constIndex) const;
 
@@ -48,6 +62,30 @@ namespace nzsl
 			{
 				std::uint32_t spvMajorVersion = 1;
 				std::uint32_t spvMinorVersion = 0;
+				bool optimizeSpirv = false; //< runs SpirvOptimizer on the generated module (SSA promotion, load/store forwarding and dead code elimination)
+				unsigned int functionThreadCount = 1; //< number of threads generating function bodies (0 = hardware concurrency), doesn't change the output
+				bool exportFunctions = false; //< adds Export linkage to exported functions, to link the module with others using SpirvLinker
+				bool importModuleFunctions = false; //< declares exported functions of imported modules with Import linkage instead of generating them (see SpirvLinker)
+				std::shared_ptr<SpirvTypeCache> typeCache; //< struct types and layouts reused across generations (may be shared between writers and threads)
+				DebugNames debugNames = DebugNames::All; //< which OpName/OpMemberName are emitted
+				bool compactIds = false; //< renumbers result ids densely after generation (and optimization) so the bound is minimal
+				bool debugLineInfo = false; //< emits OpString/OpSource for every source file and OpLine for statements and expressions (for profilers and debuggers)
+				std::unordered_map<std::string, std::string> debugSourceContents; //< source code embedded by OpSource when debugLineInfo is set, by file path (empty for sources parsed without one)
+			};
+
+			class NZSL_API OutputSink
+			{
+				public:
+					OutputSink() = default;
+					OutputSink(const OutputSink&) = delete;
+					OutputSink(OutputSink&&) = delete;
+					virtual ~OutputSink();
+
+					// Called once per generation with the final module size, the returned storage must hold wordCount words and is filled directly by the writer
+					virtual std::uint32_t* Allocate(std::size_t wordCount) = 0;
+
+					OutputSink& operator=(const OutputSink&) = delete;
+					OutputSink& operator=(OutputSink&&) = delete;
 			};
 			
 			static std::pair<std::uint32_t, std::uint32_t> GetMaximumSupportedVersion(std::uint32_t vkMajorVersion, std::uint32_t vkMinorVersion);
@@ -62,12 +100,16 @@ namespace nzsl
 
 			SpirvConstantCache::TypePtr BuildFunctionType(const Ast::DeclareFunctionStatement& functionNode);
 
+			void GenerateFunctions(const SpirvAstVisitor& globalVisitor, const std::vector<Ast::DeclareFunctionStatement*>& functions, unsigned int threadCount);
+
 			std::uint32_t GetArrayConstantId(const Ast::ConstantArrayValue& values) const;
 			std::uint32_t GetSingleConstantId(const Ast::ConstantSingleValue& value) const;
 			std::uint32_t GetExtendedInstructionSet(const std::string& instructionSetName) const;
 			std::uint32_t GetExtVarPointerId(std::size_t varIndex) const;
 			std::uint32_t GetFunctionTypeId(const Ast::DeclareFunctionStatement& functionNode);
+			std::uint32_t GetImageTypeId(const Ast::SamplerType& samplerType) const;
 			std::uint32_t GetPointerTypeId(const Ast::ExpressionType& type, SpirvStorageClass storageClass) const;
+			std::uint32_t GetSourceFileId(const std::shared_ptr<const std::string>& filePath) const;
 			std::uint32_t GetTypeId(const Ast::ExpressionType& type) const;
 
 			bool IsVersionGreaterOrEqual(std::uint32_t spvMajor, std::uint32_t spvMinor) const;
@@ -78,7 +120,10 @@ namespace nzsl
 			std::uint32_t RegisterPointerType(Ast::ExpressionType type, SpirvStorageClass storageClass);
 			std::uint32_t RegisterType(Ast::ExpressionType type);
 
-			static void MergeSections(std::vector<std::uint32_t>& output, const SpirvSection& from);
+			std::size_t ComputeOutputSize() const;
+			void WriteOutput(std::uint32_t* output) const;
+
+			static std::uint32_t* WriteSection(std::uint32_t* output, const SpirvSectionBase& section);
 
 			struct Context
 			{
@@ -12,7 +12,7 @@ namespace nzsl::Ast
 	namespace
 	{
 		constexpr std::uint32_t s_shaderAstMagicNumber = 0x4E534852;
-		constexpr std::uint32_t s_shaderAstCurrentVersion = 2;
+		constexpr std::uint32_t s_shaderAstCurrentVersion = 5;
 
 		class ShaderSerializerVisitor : public ExpressionVisitor, public StatementVisitor
 		{
@@ -320,6 +320,18 @@ namespace nzsl::Ast
 			ExprValue(extVar.type);
 			ExprValue(extVar.bindingIndex);
 			ExprValue(extVar.bindingSet);
+			if (IsVersionGreaterOrEqual(3))
+				ExprValue(extVar.precision);
+
+			if (IsVersionGreaterOrEqual(4))
+				ExprValue(extVar.isWorkgroupShared);
+
+			if (IsVersionGreaterOrEqual(5))
+			{
+				ExprValue(extVar.accessPolicy);
+				ExprValue(extVar.isRestrict);
+			}
+
 			SourceLoc(extVar.sourceLocation);
 		}
 	}
@@ -334,12 +346,21 @@ namespace nzsl::Ast
 		ExprValue(node.isExported);
 		OptVal(node.funcIndex);
 
+		if (IsVersionGreaterOrEqual(4))
+		{
+			for (auto& workgroupSize : node.workgroupSize)
+				ExprValue(workgroupSize);
+		}
+
 		Container(node.parameters);
 		for (auto& parameter : node.parameters)
 		{
 			Value(parameter.name);
 			ExprValue(parameter.type);
 			OptVal(parameter.varIndex);
+			if (IsVersionGreaterOrEqual(3))
+				ExprValue(parameter.precision);
+
 			SourceLoc(parameter.sourceLocation);
 		}
 
@@ -372,6 +393,9 @@ namespace nzsl::Ast
 			ExprValue(member.builtin);
 			ExprValue(member.cond);
 			ExprValue(member.locationIndex);
+			if (IsVersionGreaterOrEqual(3))
+				ExprValue(member.precision);
+
 			SourceLoc(member.sourceLocation);
 		}
 	}
@@ -381,6 +405,9 @@ namespace nzsl::Ast
 		OptVal(node.varIndex);
 		Value(node.varName);
 		ExprValue(node.varType);
+		if (IsVersionGreaterOrEqual(3))
+			ExprValue(node.precision);
+
 		Node(node.initialExpression);
 	}
 
@@ -459,6 +486,8 @@ namespace nzsl::Ast
 	void SerializerBase::SerializeExpressionCommon(Expression& expr)
 	{
 		OptType(expr.cachedExpressionType);
+		if (IsVersionGreaterOrEqual(3))
+			OptEnum(expr.cachedPrecision);
 	}
 
 	void SerializerBase::SerializeNodeCommon(Ast::Node& node)
@@ -633,6 +662,18 @@ namespace nzsl::Ast
 				m_serializer.Serialize(std::uint8_t(15));
 				Type(arg.containedType->type);
 			}
+			else if constexpr (std::is_same_v<T, Ast::PushConstantType>)
+			{
+				m_serializer.Serialize(std::uint8_t(16));
+				SizeT(arg.containedType.structIndex);
+			}
+			else if constexpr (std::is_same_v<T, Ast::StorageImageType>)
+			{
+				m_serializer.Serialize(std::uint8_t(17));
+				Enum(arg.dim);
+				Enum(arg.format);
+				Enum(arg.sampledType);
+			}
 			else
 				static_assert(Nz::AlwaysFalse<T>::value, "non-exhaustive visitor");
 		}, type);
@@ -1053,6 +1094,36 @@ namespace nzsl::Ast
 				break;
 			}
 
+			case 16: //< PushConstantType
+			{
+				std::size_t structIndex;
+				SizeT(structIndex);
+
+				type = PushConstantType{
+					StructType {
+						structIndex
+					}
+				};
+				break;
+			}
+
+			case 17: //< StorageImageType
+			{
+				ImageType dim;
+				ImageFormat format;
+				PrimitiveType sampledType;
+				Enum(dim);
+				Enum(format);
+				Enum(sampledType);
+
+				type = StorageImageType {
+					dim,
+					format,
+					sampledType
+				};
+				break;
+			}
+
 			default:
 				throw std::runtime_error("unexpected type index " + std::to_string(typeIndex));
 		}
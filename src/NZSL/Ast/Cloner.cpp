@@ -136,6 +136,10 @@ namespace nzsl::Ast
 			cloneVar.type = Clone(var.type);
 			cloneVar.bindingIndex = Clone(var.bindingIndex);
 			cloneVar.bindingSet = Clone(var.bindingSet);
+			cloneVar.precision = Clone(var.precision);
+			cloneVar.isWorkgroupShared = Clone(var.isWorkgroupShared);
+			cloneVar.accessPolicy = Clone(var.accessPolicy);
+			cloneVar.isRestrict = Clone(var.isRestrict);
 
 			cloneVar.sourceLocation = var.sourceLocation;
 		}
@@ -156,6 +160,9 @@ namespace nzsl::Ast
 		clone->name = node.name;
 		clone->returnType = Clone(node.returnType);
 
+		for (std::size_t i = 0; i < node.workgroupSize.size(); ++i)
+			clone->workgroupSize[i] = Clone(node.workgroupSize[i]);
+
 		clone->parameters.reserve(node.parameters.size());
 		for (auto& parameter : node.parameters)
 		{
@@ -163,6 +170,7 @@ namespace nzsl::Ast
 			cloneParam.name = parameter.name;
 			cloneParam.type = Clone(parameter.type);
 			cloneParam.varIndex = parameter.varIndex;
+			cloneParam.precision = Clone(parameter.precision);
 
 			cloneParam.sourceLocation = parameter.sourceLocation;
 		}
@@ -207,6 +215,7 @@ namespace nzsl::Ast
 			cloneMember.builtin = Clone(member.builtin);
 			cloneMember.cond = Clone(member.cond);
 			cloneMember.locationIndex = Clone(member.locationIndex);
+			cloneMember.precision = Clone(member.precision);
 
 			cloneMember.sourceLocation = member.sourceLocation;
 		}
@@ -223,6 +232,7 @@ namespace nzsl::Ast
 		clone->varIndex = node.varIndex;
 		clone->varName = node.varName;
 		clone->varType = Clone(node.varType);
+		clone->precision = Clone(node.precision);
 
 		clone->sourceLocation = node.sourceLocation;
 
@@ -346,6 +356,7 @@ namespace nzsl::Ast
 		clone->expr = CloneExpression(node.expr);
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -361,6 +372,7 @@ namespace nzsl::Ast
 			clone->indices.push_back(CloneExpression(parameter));
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -372,6 +384,7 @@ namespace nzsl::Ast
 		clone->aliasId = node.aliasId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -385,6 +398,7 @@ namespace nzsl::Ast
 		clone->right = CloneExpression(node.right);
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -398,6 +412,7 @@ namespace nzsl::Ast
 		clone->right = CloneExpression(node.right);
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -413,6 +428,7 @@ namespace nzsl::Ast
 			clone->parameters.push_back(CloneExpression(parameter));
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -430,6 +446,7 @@ namespace nzsl::Ast
 			clone->parameters.push_back(CloneExpression(parameter));
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -445,6 +462,7 @@ namespace nzsl::Ast
 			clone->expressions.push_back(CloneExpression(exprPtr));
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -458,6 +476,7 @@ namespace nzsl::Ast
 		clone->truePath = CloneExpression(node.truePath);
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -469,6 +488,7 @@ namespace nzsl::Ast
 		clone->constantId = node.constantId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -480,6 +500,7 @@ namespace nzsl::Ast
 		clone->values = node.values;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -491,6 +512,7 @@ namespace nzsl::Ast
 		clone->value = node.value;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -502,6 +524,7 @@ namespace nzsl::Ast
 		clone->funcId = node.funcId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -513,6 +536,7 @@ namespace nzsl::Ast
 		clone->identifier = node.identifier;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -528,6 +552,7 @@ namespace nzsl::Ast
 			clone->parameters.push_back(CloneExpression(parameter));
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -539,6 +564,7 @@ namespace nzsl::Ast
 		clone->intrinsicId = node.intrinsicId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -550,6 +576,7 @@ namespace nzsl::Ast
 		clone->structTypeId = node.structTypeId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -563,6 +590,7 @@ namespace nzsl::Ast
 		clone->expression = CloneExpression(node.expression);
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -574,6 +602,7 @@ namespace nzsl::Ast
 		clone->typeId = node.typeId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -585,6 +614,7 @@ namespace nzsl::Ast
 		clone->variableId = node.variableId;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
@@ -597,6 +627,7 @@ namespace nzsl::Ast
 		clone->op = node.op;
 
 		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
 		clone->sourceLocation = node.sourceLocation;
 
 		return clone;
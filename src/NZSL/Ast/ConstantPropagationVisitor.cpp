@@ -4,9 +4,12 @@
 
 #include <NZSL/Ast/ConstantPropagationVisitor.hpp>
 #include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
+#include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/Errors.hpp>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 namespace nzsl::Ast
@@ -197,7 +200,7 @@ namespace nzsl::Ast
 		template<typename T1, typename T2>
 		struct BinaryConstantPropagation<BinaryType::CompLt, T1, T2>
 		{
-			using Op = BinaryCompLe<T1, T2>;
+			using Op = BinaryCompLt<T1, T2>;
 		};
 
 		// CompNe
@@ -383,6 +386,109 @@ namespace nzsl::Ast
 			using Op = BinarySubtraction<T1, T2>;
 		};
 
+		// BitwiseAnd
+		template<typename T1, typename T2>
+		struct BinaryBitwiseAndBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T1& lhs, const T2& rhs, const SourceLocation& /*sourceLocation*/)
+			{
+				return ShaderBuilder::ConstantValue(T1(lhs & rhs));
+			}
+		};
+
+		template<typename T1, typename T2>
+		struct BinaryBitwiseAnd;
+
+		template<typename T1, typename T2>
+		struct BinaryConstantPropagation<BinaryType::BitwiseAnd, T1, T2>
+		{
+			using Op = BinaryBitwiseAnd<T1, T2>;
+		};
+
+		// BitwiseOr
+		template<typename T1, typename T2>
+		struct BinaryBitwiseOrBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T1& lhs, const T2& rhs, const SourceLocation& /*sourceLocation*/)
+			{
+				return ShaderBuilder::ConstantValue(T1(lhs | rhs));
+			}
+		};
+
+		template<typename T1, typename T2>
+		struct BinaryBitwiseOr;
+
+		template<typename T1, typename T2>
+		struct BinaryConstantPropagation<BinaryType::BitwiseOr, T1, T2>
+		{
+			using Op = BinaryBitwiseOr<T1, T2>;
+		};
+
+		// BitwiseXor
+		template<typename T1, typename T2>
+		struct BinaryBitwiseXorBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T1& lhs, const T2& rhs, const SourceLocation& /*sourceLocation*/)
+			{
+				return ShaderBuilder::ConstantValue(T1(lhs ^ rhs));
+			}
+		};
+
+		template<typename T1, typename T2>
+		struct BinaryBitwiseXor;
+
+		template<typename T1, typename T2>
+		struct BinaryConstantPropagation<BinaryType::BitwiseXor, T1, T2>
+		{
+			using Op = BinaryBitwiseXor<T1, T2>;
+		};
+
+		// ShiftLeft
+		template<typename T1, typename T2>
+		struct BinaryShiftLeftBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T1& lhs, const T2& rhs, const SourceLocation& /*sourceLocation*/)
+			{
+				// Out of range shifts are undefined, leave them to the runtime
+				if (std::int64_t(rhs) < 0 || std::int64_t(rhs) >= 32)
+					return nullptr;
+
+				return ShaderBuilder::ConstantValue(T1(std::uint32_t(lhs) << rhs));
+			}
+		};
+
+		template<typename T1, typename T2>
+		struct BinaryShiftLeft;
+
+		template<typename T1, typename T2>
+		struct BinaryConstantPropagation<BinaryType::ShiftLeft, T1, T2>
+		{
+			using Op = BinaryShiftLeft<T1, T2>;
+		};
+
+		// ShiftRight
+		template<typename T1, typename T2>
+		struct BinaryShiftRightBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T1& lhs, const T2& rhs, const SourceLocation& /*sourceLocation*/)
+			{
+				if (std::int64_t(rhs) < 0 || std::int64_t(rhs) >= 32)
+					return nullptr;
+
+				// Arithmetic shift for signed integers, logical shift for unsigned ones
+				return ShaderBuilder::ConstantValue(T1(lhs >> rhs));
+			}
+		};
+
+		template<typename T1, typename T2>
+		struct BinaryShiftRight;
+
+		template<typename T1, typename T2>
+		struct BinaryConstantPropagation<BinaryType::ShiftRight, T1, T2>
+		{
+			using Op = BinaryShiftRight<T1, T2>;
+		};
+
 		/*************************************************************************************************/
 
 		template<typename T, typename... Args>
@@ -435,6 +541,25 @@ namespace nzsl::Ast
 		template<UnaryType Type, typename T>
 		struct UnaryConstantPropagation;
 
+		// BitwiseNot
+		template<typename T>
+		struct UnaryBitwiseNotBase
+		{
+			std::unique_ptr<ConstantValueExpression> operator()(const T& arg, const SourceLocation& /*sourceLocation*/)
+			{
+				return ShaderBuilder::ConstantValue(T(~arg));
+			}
+		};
+
+		template<typename T>
+		struct UnaryBitwiseNot;
+
+		template<typename T>
+		struct UnaryConstantPropagation<UnaryType::BitwiseNot, T>
+		{
+			using Op = UnaryBitwiseNot<T>;
+		};
+
 		// LogicalNot
 		template<typename T>
 		struct UnaryLogicalNotBase
@@ -712,6 +837,25 @@ namespace nzsl::Ast
 		EnableOptimisation(BinarySubtraction, Vector3u32, Vector3u32);
 		EnableOptimisation(BinarySubtraction, Vector4u32, Vector4u32);
 
+		EnableOptimisation(BinaryBitwiseAnd, std::int32_t, std::int32_t);
+		EnableOptimisation(BinaryBitwiseAnd, std::uint32_t, std::uint32_t);
+
+		EnableOptimisation(BinaryBitwiseOr, std::int32_t, std::int32_t);
+		EnableOptimisation(BinaryBitwiseOr, std::uint32_t, std::uint32_t);
+
+		EnableOptimisation(BinaryBitwiseXor, std::int32_t, std::int32_t);
+		EnableOptimisation(BinaryBitwiseXor, std::uint32_t, std::uint32_t);
+
+		EnableOptimisation(BinaryShiftLeft, std::int32_t, std::int32_t);
+		EnableOptimisation(BinaryShiftLeft, std::int32_t, std::uint32_t);
+		EnableOptimisation(BinaryShiftLeft, std::uint32_t, std::int32_t);
+		EnableOptimisation(BinaryShiftLeft, std::uint32_t, std::uint32_t);
+
+		EnableOptimisation(BinaryShiftRight, std::int32_t, std::int32_t);
+		EnableOptimisation(BinaryShiftRight, std::int32_t, std::uint32_t);
+		EnableOptimisation(BinaryShiftRight, std::uint32_t, std::int32_t);
+		EnableOptimisation(BinaryShiftRight, std::uint32_t, std::uint32_t);
+
 		// Cast
 
 		EnableOptimisation(CastConstant, bool, bool);
@@ -817,6 +961,9 @@ namespace nzsl::Ast
 
 		// Unary
 
+		EnableOptimisation(UnaryBitwiseNot, std::int32_t);
+		EnableOptimisation(UnaryBitwiseNot, std::uint32_t);
+
 		EnableOptimisation(UnaryLogicalNot, bool);
 
 		EnableOptimisation(UnaryMinus, double);
@@ -840,158 +987,818 @@ namespace nzsl::Ast
 		EnableOptimisation(UnaryPlus, Vector4i32);
 
 #undef EnableOptimisation
-	}
 
-	ModulePtr ConstantPropagationVisitor::Process(const Module& shaderModule)
-	{
-		auto rootnode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode));
+		// Algebraic simplifications
+		template<typename T>
+		bool IsSameScalar(T scalar, std::int32_t value)
+		{
+			// -0.0 == 0.0 but they're not interchangeable (x - (-0.0) isn't x when x is -0.0), match the sign bit as well
+			if constexpr (std::is_same_v<T, float>)
+				return scalar == static_cast<T>(value) && std::signbit(scalar) == (value < 0);
+			else
+				return scalar == static_cast<T>(value);
+		}
 
-		return std::make_shared<Module>(shaderModule.metadata, std::move(rootnode), shaderModule.importedModules);
-	}
+		bool IsConstantValue(const Expression& expression, std::int32_t value)
+		{
+			if (expression.GetType() != NodeType::ConstantValueExpression)
+				return false;
 
-	ModulePtr ConstantPropagationVisitor::Process(const Module& shaderModule, const Options& options)
-	{
-		auto rootNode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode, options));
+			return std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+				using BaseType = typename VectorInfo<T>::Base;
+				constexpr std::size_t Dimensions = VectorInfo<T>::Dimensions;
 
-		return std::make_shared<Module>(shaderModule.metadata, std::move(rootNode), shaderModule.importedModules);
-	}
+				if constexpr (std::is_same_v<T, bool>)
+					return arg == (value != 0);
+				else if constexpr (std::is_same_v<BaseType, float> || std::is_same_v<BaseType, std::int32_t> || std::is_same_v<BaseType, std::uint32_t>)
+				{
+					if constexpr (Dimensions == 1)
+						return IsSameScalar(arg, value);
+					else
+					{
+						// Vectors have to be a splat of the value
+						for (std::size_t i = 0; i < Dimensions; ++i)
+						{
+							if (!IsSameScalar(arg[i], value))
+								return false;
+						}
 
-	ExpressionPtr ConstantPropagationVisitor::Clone(BinaryExpression& node)
-	{
-		auto lhs = CloneExpression(node.left);
-		auto rhs = CloneExpression(node.right);
+						return true;
+					}
+				}
+				else
+					return false;
+			}, static_cast<const ConstantValueExpression&>(expression).value);
+		}
 
-		if (lhs->GetType() == NodeType::ConstantValueExpression && rhs->GetType() == NodeType::ConstantValueExpression)
+		bool IsNegativeZero(const Expression& expression)
 		{
-			const ConstantValueExpression& lhsConstant = static_cast<const ConstantValueExpression&>(*lhs);
-			const ConstantValueExpression& rhsConstant = static_cast<const ConstantValueExpression&>(*rhs);
+			if (expression.GetType() != NodeType::ConstantValueExpression)
+				return false;
 
-			ExpressionPtr optimized;
-			switch (node.op)
+			return std::visit([&](auto&& arg)
 			{
-				case BinaryType::Add:
-					optimized = PropagateBinaryConstant<BinaryType::Add>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
-
-				case BinaryType::Subtract:
-					optimized = PropagateBinaryConstant<BinaryType::Subtract>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
-
-				case BinaryType::Modulo:
-					optimized = PropagateBinaryConstant<BinaryType::Modulo>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
-
-				case BinaryType::Multiply:
-					optimized = PropagateBinaryConstant<BinaryType::Multiply>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+				using T = std::decay_t<decltype(arg)>;
+				using BaseType = typename VectorInfo<T>::Base;
+				constexpr std::size_t Dimensions = VectorInfo<T>::Dimensions;
 
-				case BinaryType::Divide:
-					optimized = PropagateBinaryConstant<BinaryType::Divide>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+				if constexpr (std::is_same_v<BaseType, float>)
+				{
+					if constexpr (Dimensions == 1)
+						return arg == 0.f && std::signbit(arg);
+					else
+					{
+						for (std::size_t i = 0; i < Dimensions; ++i)
+						{
+							if (arg[i] != 0.f || !std::signbit(arg[i]))
+								return false;
+						}
 
-				case BinaryType::CompEq:
-					optimized = PropagateBinaryConstant<BinaryType::CompEq>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+						return true;
+					}
+				}
+				else
+					return false;
+			}, static_cast<const ConstantValueExpression&>(expression).value);
+		}
 
-				case BinaryType::CompGe:
-					optimized = PropagateBinaryConstant<BinaryType::CompGe>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+		bool IsFloatingPointType(const ExpressionType& type)
+		{
+			auto IsFloatingPoint = [](PrimitiveType primitiveType) { return primitiveType == PrimitiveType::Float16 || primitiveType == PrimitiveType::Float32; };
+
+			if (IsPrimitiveType(type))
+				return IsFloatingPoint(std::get<PrimitiveType>(type));
+			else if (IsVectorType(type))
+				return IsFloatingPoint(std::get<VectorType>(type).type);
+			else if (IsMatrixType(type))
+				return IsFloatingPoint(std::get<MatrixType>(type).type);
+			else
+				return false;
+		}
 
-				case BinaryType::CompGt:
-					optimized = PropagateBinaryConstant<BinaryType::CompGt>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+		bool IsIdentitySwizzle(const SwizzleExpression& swizzle)
+		{
+			const ExpressionType* exprType = GetExpressionType(*swizzle.expression);
+			if (!exprType)
+				return false;
+
+			std::size_t componentCount;
+			if (IsPrimitiveType(*exprType))
+				componentCount = 1;
+			else if (IsVectorType(*exprType))
+				componentCount = std::get<VectorType>(*exprType).componentCount;
+			else
+				return false;
 
-				case BinaryType::CompLe:
-					optimized = PropagateBinaryConstant<BinaryType::CompLe>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+			if (swizzle.componentCount != componentCount)
+				return false;
 
-				case BinaryType::CompLt:
-					optimized = PropagateBinaryConstant<BinaryType::CompLt>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+			for (std::size_t i = 0; i < componentCount; ++i)
+			{
+				if (swizzle.components[i] != i)
+					return false;
+			}
 
-				case BinaryType::CompNe:
-					optimized = PropagateBinaryConstant<BinaryType::CompNe>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+			return true;
+		}
 
-				case BinaryType::LogicalAnd:
-					optimized = PropagateBinaryConstant<BinaryType::LogicalAnd>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
+		std::unique_ptr<ConstantValueExpression> ComputeReciprocal(const ConstantValueExpression& constantExpr)
+		{
+			return std::visit([&](auto&& arg) -> std::unique_ptr<ConstantValueExpression>
+			{
+				using T = std::decay_t<decltype(arg)>;
+				using BaseType = typename VectorInfo<T>::Base;
+				constexpr std::size_t Dimensions = VectorInfo<T>::Dimensions;
 
-				case BinaryType::LogicalOr:
-					optimized = PropagateBinaryConstant<BinaryType::LogicalOr>(lhsConstant, rhsConstant, node.sourceLocation);
-					break;
-			}
+				if constexpr (std::is_same_v<BaseType, float>)
+				{
+					if constexpr (Dimensions == 1)
+					{
+						if (arg == 0.f)
+							return nullptr;
+					}
+					else
+					{
+						for (std::size_t i = 0; i < Dimensions; ++i)
+						{
+							if (arg[i] == 0.f)
+								return nullptr;
+						}
+					}
 
-			if (optimized)
-			{
-				optimized->cachedExpressionType = node.cachedExpressionType;
-				optimized->sourceLocation = node.sourceLocation;
-				
-				return optimized;
-			}
+					return ShaderBuilder::ConstantValue(1.f / arg);
+				}
+				else
+					return nullptr;
+			}, constantExpr.value);
 		}
 
-		auto binary = ShaderBuilder::Binary(node.op, std::move(lhs), std::move(rhs));
-		binary->cachedExpressionType = node.cachedExpressionType;
-		binary->sourceLocation = node.sourceLocation;
-
-		return binary;
-	}
+		// Returns the variable written by an assignment to this expression (a, a.x, a[i].y)
+		std::optional<std::size_t> GetAssignedVariable(const Expression& expression)
+		{
+			const Expression* expr = &expression;
+			for (;;)
+			{
+				switch (expr->GetType())
+				{
+					case NodeType::AccessIdentifierExpression:
+						expr = static_cast<const AccessIdentifierExpression*>(expr)->expr.get();
+						break;
 
-	ExpressionPtr ConstantPropagationVisitor::Clone(CastExpression& node)
-	{
-		NAZARA_USE_ANONYMOUS_NAMESPACE
+					case NodeType::AccessIndexExpression:
+						expr = static_cast<const AccessIndexExpression*>(expr)->expr.get();
+						break;
 
-		std::vector<ExpressionPtr> expressions;
+					case NodeType::SwizzleExpression:
+						expr = static_cast<const SwizzleExpression*>(expr)->expression.get();
+						break;
 
-		std::size_t expressionCount = node.expressions.size();
-		expressions.reserve(expressionCount);
+					case NodeType::VariableValueExpression:
+						return static_cast<const VariableValueExpression*>(expr)->variableId;
 
-		for (const auto& expression : node.expressions)
-			expressions.push_back(CloneExpression(expression));
+					default:
+						return std::nullopt;
+				}
+			}
+		}
 
-		const ExpressionType& targetType = node.targetType.GetResultingValue();
-		
-		ExpressionPtr optimized;
-		if (IsPrimitiveType(targetType))
+		bool IsSameConstant(const ConstantSingleValue& lhs, const ConstantSingleValue& rhs)
 		{
-			if (expressionCount == 1 && expressions.front()->GetType() == NodeType::ConstantValueExpression)
+			if (lhs.index() != rhs.index())
+				return false;
+
+			return std::visit([&](auto&& arg)
 			{
-				const ConstantValueExpression& constantExpr = static_cast<const ConstantValueExpression&>(*expressions.front());
+				using T = std::decay_t<decltype(arg)>;
 
-				switch (std::get<PrimitiveType>(targetType))
+				if constexpr (std::is_same_v<T, NoValue>)
+					return true;
+				else if constexpr (std::is_same_v<T, std::string>)
+					return arg == std::get<T>(rhs);
+				else
 				{
-					case PrimitiveType::Boolean: optimized = PropagateSingleValueCast<bool>(constantExpr, node.sourceLocation); break;
-					case PrimitiveType::Float32: optimized = PropagateSingleValueCast<float>(constantExpr, node.sourceLocation); break;
-					case PrimitiveType::Int32:   optimized = PropagateSingleValueCast<std::int32_t>(constantExpr, node.sourceLocation); break;
-					case PrimitiveType::UInt32:  optimized = PropagateSingleValueCast<std::uint32_t>(constantExpr, node.sourceLocation); break;
-					case PrimitiveType::String: break;
+					// Compare bit patterns so 0.0 and -0.0 are considered different (and NaN equal to itself)
+					return std::memcmp(&arg, &std::get<T>(rhs), sizeof(T)) == 0;
 				}
+			}, lhs);
+		}
+
+		bool IsAtomicIntrinsic(IntrinsicType intrinsic)
+		{
+			switch (intrinsic)
+			{
+				case IntrinsicType::AtomicAdd:
+				case IntrinsicType::AtomicAnd:
+				case IntrinsicType::AtomicCompareExchange:
+				case IntrinsicType::AtomicExchange:
+				case IntrinsicType::AtomicMax:
+				case IntrinsicType::AtomicMin:
+				case IntrinsicType::AtomicOr:
+				case IntrinsicType::AtomicXor:
+					return true;
+
+				default:
+					return false;
 			}
 		}
-		else if (IsVectorType(targetType))
+
+		class AssignedVariableCollector : public RecursiveVisitor
 		{
-			const auto& vecType = std::get<VectorType>(targetType);
+			public:
+				using RecursiveVisitor::Visit;
 
-			// Decompose vector into values (cast(vec3, float) => cast(float, float, float, float))
-			std::vector<ConstantSingleValue> constantValues;
-			for (std::size_t i = 0; i < expressionCount; ++i)
-			{
-				if (expressions[i]->GetType() != NodeType::ConstantValueExpression)
+				void Visit(AssignExpression& node) override
 				{
-					constantValues.clear();
-					break;
-				}
+					if (std::optional<std::size_t> variableIndex = GetAssignedVariable(*node.left))
+						assignedVariables.push_back(*variableIndex);
 
-				const auto& constantExpr = static_cast<ConstantValueExpression&>(*expressions[i]);
+					RecursiveVisitor::Visit(node);
+				}
 
-				if (!constantValues.empty() && GetConstantType(constantValues.front()) != GetConstantType(constantExpr.value))
+				void Visit(IntrinsicExpression& node) override
 				{
-					// Unhandled case, all cast parameters are expected to be of the same type
-					constantValues.clear();
+					// Atomic operations write their first parameter
+					if (IsAtomicIntrinsic(node.intrinsic) && !node.parameters.empty())
+					{
+						if (std::optional<std::size_t> variableIndex = GetAssignedVariable(*node.parameters.front()))
+							assignedVariables.push_back(*variableIndex);
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				std::vector<std::size_t> assignedVariables;
+		};
+
+		// Conservatively looks for nodes ConstantPropagationVisitor could transform, without cloning anything
+		class TransformationFinder : public RecursiveVisitor
+		{
+			public:
+				TransformationFinder(const ConstantPropagationVisitor::Options& options) :
+				m_options(options)
+				{
+				}
+
+				bool Find(Statement& statement)
+				{
+					// Reading a variable can only be replaced by a constant if a constant was stored in it
+					m_collectingConstantVariables = true;
+					statement.Visit(*this);
+
+					m_collectingConstantVariables = false;
+					statement.Visit(*this);
+
+					return m_found;
+				}
+
+				using RecursiveVisitor::Visit;
+
+				void Visit(AssignExpression& node) override
+				{
+					if (m_found)
+						return;
+
+					if (m_collectingConstantVariables)
+					{
+						if (node.left->GetType() == NodeType::VariableValueExpression && node.right->GetType() == NodeType::ConstantValueExpression)
+							m_constantVariables.insert(static_cast<VariableValueExpression&>(*node.left).variableId);
+
+						return RecursiveVisitor::Visit(node);
+					}
+
+					node.right->Visit(*this);
+
+					// The assigned variable itself is never replaced, only the indices used to access it
+					Expression* expr = node.left.get();
+					for (;;)
+					{
+						switch (expr->GetType())
+						{
+							case NodeType::AccessIdentifierExpression:
+								expr = static_cast<AccessIdentifierExpression*>(expr)->expr.get();
+								continue;
+
+							case NodeType::AccessIndexExpression:
+							{
+								auto& accessIndex = static_cast<AccessIndexExpression&>(*expr);
+								for (auto& indexExpr : accessIndex.indices)
+									indexExpr->Visit(*this);
+
+								expr = accessIndex.expr.get();
+								continue;
+							}
+
+							case NodeType::SwizzleExpression:
+								expr = static_cast<SwizzleExpression*>(expr)->expression.get();
+								continue;
+
+							case NodeType::VariableValueExpression:
+								break;
+
+							default:
+								expr->Visit(*this);
+								break;
+						}
+
+						break;
+					}
+				}
+
+				void Visit(BinaryExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found)
+						m_found = CanFoldBinary(node);
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(CastExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found && !node.expressions.empty())
+					{
+						bool isConstant = true;
+						for (const auto& expr : node.expressions)
+						{
+							if (expr->GetType() != NodeType::ConstantValueExpression)
+							{
+								isConstant = false;
+								break;
+							}
+						}
+
+						if (isConstant)
+							m_found = true;
+						else if (node.expressions.size() == 1 && node.targetType.IsResultingValue())
+						{
+							// Casting to the same type is a no-op
+							const ExpressionType* exprType = GetExpressionType(*node.expressions.front());
+							if (exprType && ResolveAlias(*exprType) == ResolveAlias(node.targetType.GetResultingValue()))
+								m_found = true;
+						}
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(ConditionalExpression& node) override
+				{
+					if (!m_collectingConstantVariables)
+						m_found = true;
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(ConstantExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found && m_options.constantQueryCallback)
+					{
+						if (const ConstantValue* constantValue = m_options.constantQueryCallback(node.constantId))
+						{
+							// Arrays are kept as constants
+							m_found = std::visit([](auto&& arg)
+							{
+								using T = std::decay_t<decltype(arg)>;
+								return !GetVectorInnerType<T>::IsVector;
+							}, *constantValue);
+						}
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(IntrinsicExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found)
+					{
+						switch (node.intrinsic)
+						{
+							case IntrinsicType::ArraySize:
+							{
+								if (node.parameters.size() == 1)
+								{
+									const ExpressionType* parameterType = GetExpressionType(*node.parameters.front());
+									if (parameterType && IsArrayType(*parameterType))
+										m_found = true;
+								}
+								break;
+							}
+
+							case IntrinsicType::Normalize:
+							{
+								if (node.parameters.size() == 1 && node.parameters.front()->GetType() == NodeType::IntrinsicExpression)
+									m_found = (static_cast<IntrinsicExpression&>(*node.parameters.front()).intrinsic == IntrinsicType::Normalize);
+								break;
+							}
+
+							case IntrinsicType::Pow:
+							{
+								if (node.parameters.size() == 2)
+									m_found = IsConstantValue(*node.parameters[1], 1) || IsConstantValue(*node.parameters[1], 2);
+								break;
+							}
+
+							default:
+								break;
+						}
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(SwizzleExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found)
+					{
+						NodeType exprType = node.expression->GetType();
+						m_found = (exprType == NodeType::ConstantValueExpression || exprType == NodeType::SwizzleExpression || IsIdentitySwizzle(node));
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(UnaryExpression& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found)
+					{
+						if (node.op == UnaryType::Plus || node.expression->GetType() == NodeType::ConstantValueExpression)
+							m_found = true;
+						else if (node.expression->GetType() == NodeType::UnaryExpression)
+							m_found = (static_cast<UnaryExpression&>(*node.expression).op == node.op);
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(VariableValueExpression& node) override
+				{
+					if (!m_collectingConstantVariables && m_constantVariables.find(node.variableId) != m_constantVariables.end())
+						m_found = true;
+				}
+
+				void Visit(BranchStatement& node) override
+				{
+					if (!m_collectingConstantVariables && !m_found)
+					{
+						for (const auto& condStatement : node.condStatements)
+						{
+							if (condStatement.condition->GetType() == NodeType::ConstantValueExpression)
+							{
+								m_found = true;
+								break;
+							}
+						}
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(ConditionalStatement& node) override
+				{
+					if (!m_collectingConstantVariables)
+						m_found = true;
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareVariableStatement& node) override
+				{
+					if (m_collectingConstantVariables && node.varIndex && node.initialExpression && node.initialExpression->GetType() == NodeType::ConstantValueExpression)
+						m_constantVariables.insert(*node.varIndex);
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(WhileStatement& node) override
+				{
+					if (!m_collectingConstantVariables && node.condition->GetType() == NodeType::ConstantValueExpression)
+						m_found = true;
+
+					RecursiveVisitor::Visit(node);
+				}
+
+			private:
+				bool CanFoldBinary(BinaryExpression& node) const
+				{
+					if (node.left->GetType() == NodeType::ConstantValueExpression && node.right->GetType() == NodeType::ConstantValueExpression)
+						return true;
+
+					// Algebraic simplifications (see ConstantPropagationVisitor::SimplifyBinary)
+					if (!node.cachedExpressionType)
+						return false;
+
+					const ExpressionType& resultType = ResolveAlias(*node.cachedExpressionType);
+					bool isFloatingPoint = IsFloatingPointType(resultType);
+
+					const Expression& lhs = *node.left;
+					const Expression& rhs = *node.right;
+
+					switch (node.op)
+					{
+						case BinaryType::Add:
+							if (isFloatingPoint && (IsNegativeZero(lhs) || IsNegativeZero(rhs)))
+								return true;
+
+							if (isFloatingPoint && !m_options.allowUnsafeMathOptimizations)
+								return false;
+
+							return IsConstantValue(lhs, 0) || IsConstantValue(rhs, 0);
+
+						case BinaryType::Subtract:
+							return IsConstantValue(rhs, 0);
+
+						case BinaryType::Multiply:
+							if (IsConstantValue(lhs, 1) || IsConstantValue(rhs, 1))
+								return true;
+
+							return !isFloatingPoint && (IsConstantValue(lhs, 0) || IsConstantValue(rhs, 0));
+
+						case BinaryType::Divide:
+							if (IsConstantValue(rhs, 1))
+								return true;
+
+							return isFloatingPoint && m_options.allowUnsafeMathOptimizations && rhs.GetType() == NodeType::ConstantValueExpression;
+
+						case BinaryType::Modulo:
+						{
+							if (rhs.GetType() != NodeType::ConstantValueExpression)
+								return false;
+
+							const ConstantSingleValue& divisor = static_cast<const ConstantValueExpression&>(rhs).value;
+							if (!std::holds_alternative<std::uint32_t>(divisor))
+								return false;
+
+							std::uint32_t divisorValue = std::get<std::uint32_t>(divisor);
+							return divisorValue != 0 && (divisorValue & (divisorValue - 1)) == 0;
+						}
+
+						case BinaryType::LogicalAnd:
+						case BinaryType::LogicalOr:
+							return lhs.GetType() == NodeType::ConstantValueExpression || rhs.GetType() == NodeType::ConstantValueExpression;
+
+						default:
+							return false;
+					}
+				}
+
+				const ConstantPropagationVisitor::Options& m_options;
+				std::unordered_set<std::size_t> m_constantVariables;
+				bool m_collectingConstantVariables = false;
+				bool m_found = false;
+		};
+	}
+
+	bool ConstantPropagationVisitor::CanTransform(const Module& shaderModule, const Options& options)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		TransformationFinder transformationFinder(options);
+		return transformationFinder.Find(*shaderModule.rootNode);
+	}
+
+	ModulePtr ConstantPropagationVisitor::Process(const Module& shaderModule)
+	{
+		auto rootnode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode));
+
+		return std::make_shared<Module>(shaderModule.metadata, std::move(rootnode), shaderModule.importedModules);
+	}
+
+	ModulePtr ConstantPropagationVisitor::Process(const Module& shaderModule, const Options& options)
+	{
+		auto rootNode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode, options));
+
+		return std::make_shared<Module>(shaderModule.metadata, std::move(rootNode), shaderModule.importedModules);
+	}
+
+	ExpressionPtr ConstantPropagationVisitor::Clone(AssignExpression& node)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		auto rhs = CloneExpression(node.right);
+
+		// The assigned variable value changes, forget it before cloning the left side so it's not replaced by its previous value
+		std::optional<ConstantSingleValue> previousValue;
+		std::optional<std::size_t> variableIndex = GetAssignedVariable(*node.left);
+		if (variableIndex)
+		{
+			auto it = m_variableValues.find(*variableIndex);
+			if (it != m_variableValues.end())
+			{
+				previousValue = std::move(it->second);
+				m_variableValues.erase(it);
+			}
+		}
+
+		auto lhs = CloneExpression(node.left);
+
+		// Only whole variable assignments are tracked
+		if (variableIndex && lhs->GetType() == NodeType::VariableValueExpression)
+		{
+			if (node.op == AssignType::Simple)
+				SetVariableValue(*variableIndex, *rhs);
+			else if (previousValue && rhs->GetType() == NodeType::ConstantValueExpression)
+			{
+				std::optional<BinaryType> binaryType;
+				switch (node.op)
+				{
+					case AssignType::Simple: break;
+					case AssignType::CompoundAdd:        binaryType = BinaryType::Add; break;
+					case AssignType::CompoundBitwiseAnd: binaryType = BinaryType::BitwiseAnd; break;
+					case AssignType::CompoundBitwiseOr:  binaryType = BinaryType::BitwiseOr; break;
+					case AssignType::CompoundBitwiseXor: binaryType = BinaryType::BitwiseXor; break;
+					case AssignType::CompoundDivide:     binaryType = BinaryType::Divide; break;
+					case AssignType::CompoundModulo:     binaryType = BinaryType::Modulo; break;
+					case AssignType::CompoundMultiply:   binaryType = BinaryType::Multiply; break;
+					case AssignType::CompoundLogicalAnd: binaryType = BinaryType::LogicalAnd; break;
+					case AssignType::CompoundLogicalOr:  binaryType = BinaryType::LogicalOr; break;
+					case AssignType::CompoundShiftLeft:  binaryType = BinaryType::ShiftLeft; break;
+					case AssignType::CompoundShiftRight: binaryType = BinaryType::ShiftRight; break;
+					case AssignType::CompoundSubtract:   binaryType = BinaryType::Subtract; break;
+				}
+
+				if (binaryType)
+				{
+					BinaryExpression newValue;
+					newValue.op = *binaryType;
+					newValue.left = ShaderBuilder::ConstantValue(std::move(*previousValue));
+					newValue.right = Cloner::Clone(*rhs);
+					newValue.cachedExpressionType = node.cachedExpressionType;
+					newValue.sourceLocation = node.sourceLocation;
+
+					SetVariableValue(*variableIndex, *Clone(newValue));
+				}
+			}
+		}
+
+		auto assign = ShaderBuilder::Assign(node.op, std::move(lhs), std::move(rhs));
+		assign->cachedExpressionType = node.cachedExpressionType;
+		assign->sourceLocation = node.sourceLocation;
+
+		return assign;
+	}
+
+	ExpressionPtr ConstantPropagationVisitor::Clone(BinaryExpression& node)
+	{
+		auto lhs = CloneExpression(node.left);
+		auto rhs = CloneExpression(node.right);
+
+		if (lhs->GetType() == NodeType::ConstantValueExpression && rhs->GetType() == NodeType::ConstantValueExpression)
+		{
+			const ConstantValueExpression& lhsConstant = static_cast<const ConstantValueExpression&>(*lhs);
+			const ConstantValueExpression& rhsConstant = static_cast<const ConstantValueExpression&>(*rhs);
+
+			ExpressionPtr optimized;
+			switch (node.op)
+			{
+				case BinaryType::Add:
+					optimized = PropagateBinaryConstant<BinaryType::Add>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::Subtract:
+					optimized = PropagateBinaryConstant<BinaryType::Subtract>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::Modulo:
+					optimized = PropagateBinaryConstant<BinaryType::Modulo>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::Multiply:
+					optimized = PropagateBinaryConstant<BinaryType::Multiply>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::Divide:
+					optimized = PropagateBinaryConstant<BinaryType::Divide>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompEq:
+					optimized = PropagateBinaryConstant<BinaryType::CompEq>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompGe:
+					optimized = PropagateBinaryConstant<BinaryType::CompGe>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompGt:
+					optimized = PropagateBinaryConstant<BinaryType::CompGt>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompLe:
+					optimized = PropagateBinaryConstant<BinaryType::CompLe>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompLt:
+					optimized = PropagateBinaryConstant<BinaryType::CompLt>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::CompNe:
+					optimized = PropagateBinaryConstant<BinaryType::CompNe>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::LogicalAnd:
+					optimized = PropagateBinaryConstant<BinaryType::LogicalAnd>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::LogicalOr:
+					optimized = PropagateBinaryConstant<BinaryType::LogicalOr>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::BitwiseAnd:
+					optimized = PropagateBinaryConstant<BinaryType::BitwiseAnd>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::BitwiseOr:
+					optimized = PropagateBinaryConstant<BinaryType::BitwiseOr>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::BitwiseXor:
+					optimized = PropagateBinaryConstant<BinaryType::BitwiseXor>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::ShiftLeft:
+					optimized = PropagateBinaryConstant<BinaryType::ShiftLeft>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+
+				case BinaryType::ShiftRight:
+					optimized = PropagateBinaryConstant<BinaryType::ShiftRight>(lhsConstant, rhsConstant, node.sourceLocation);
+					break;
+			}
+
+			if (optimized)
+			{
+				optimized->cachedExpressionType = node.cachedExpressionType;
+				optimized->sourceLocation = node.sourceLocation;
+
+				m_changed = true;
+				return optimized;
+			}
+		}
+
+		if (ExpressionPtr simplified = SimplifyBinary(node, lhs, rhs))
+		{
+			m_changed = true;
+			return simplified;
+		}
+
+		auto binary = ShaderBuilder::Binary(node.op, std::move(lhs), std::move(rhs));
+		binary->cachedExpressionType = node.cachedExpressionType;
+		binary->sourceLocation = node.sourceLocation;
+
+		return binary;
+	}
+
+	ExpressionPtr ConstantPropagationVisitor::Clone(CastExpression& node)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::vector<ExpressionPtr> expressions;
+
+		std::size_t expressionCount = node.expressions.size();
+		expressions.reserve(expressionCount);
+
+		for (const auto& expression : node.expressions)
+			expressions.push_back(CloneExpression(expression));
+
+		const ExpressionType& targetType = node.targetType.GetResultingValue();
+		
+		ExpressionPtr optimized;
+		if (IsPrimitiveType(targetType))
+		{
+			if (expressionCount == 1 && expressions.front()->GetType() == NodeType::ConstantValueExpression)
+			{
+				const ConstantValueExpression& constantExpr = static_cast<const ConstantValueExpression&>(*expressions.front());
+
+				switch (std::get<PrimitiveType>(targetType))
+				{
+					case PrimitiveType::Boolean: optimized = PropagateSingleValueCast<bool>(constantExpr, node.sourceLocation); break;
+					case PrimitiveType::Float32: optimized = PropagateSingleValueCast<float>(constantExpr, node.sourceLocation); break;
+					case PrimitiveType::Int32:   optimized = PropagateSingleValueCast<std::int32_t>(constantExpr, node.sourceLocation); break;
+					case PrimitiveType::UInt32:  optimized = PropagateSingleValueCast<std::uint32_t>(constantExpr, node.sourceLocation); break;
+					case PrimitiveType::String: break;
+
+					// No constant representation for 16-bit types, the cast is kept as is
+					case PrimitiveType::Float16:
+					case PrimitiveType::Int16:
+					case PrimitiveType::UInt16:
+						break;
+				}
+			}
+		}
+		else if (IsVectorType(targetType))
+		{
+			const auto& vecType = std::get<VectorType>(targetType);
+
+			// Decompose vector into values (cast(vec3, float) => cast(float, float, float, float))
+			std::vector<ConstantSingleValue> constantValues;
+			for (std::size_t i = 0; i < expressionCount; ++i)
+			{
+				if (expressions[i]->GetType() != NodeType::ConstantValueExpression)
+				{
+					constantValues.clear();
 					break;
 				}
 
+				const auto& constantExpr = static_cast<ConstantValueExpression&>(*expressions[i]);
 				std::visit([&](auto&& arg)
 				{
 					using T = std::decay_t<decltype(arg)>;
@@ -1023,6 +1830,21 @@ namespace nzsl::Ast
 				}, constantExpr.value);
 			}
 
+			// Scalars and vectors can be mixed (vec3[f32](vec2[f32](...), 1.0)) as long as they share the same base type
+			for (const ConstantSingleValue& value : constantValues)
+			{
+				if (value.index() != constantValues.front().index())
+				{
+					// Unhandled case, all cast parameters are expected to be of the same type
+					constantValues.clear();
+					break;
+				}
+			}
+
+			// Component-wise conversions (vec3[f32](vec3[i32](...))) are left to the backend
+			if (!constantValues.empty() && GetConstantType(constantValues.front()) != ExpressionType{ vecType.type })
+				constantValues.clear();
+
 			if (!constantValues.empty())
 			{
 				assert(constantValues.size() == vecType.componentCount);
@@ -1099,8 +1921,20 @@ namespace nzsl::Ast
 			optimized->cachedExpressionType = node.cachedExpressionType;
 			optimized->sourceLocation = node.sourceLocation;
 
+			m_changed = true;
 			return optimized;
 		}
+
+		// Casting to the same type is a no-op
+		if (expressionCount == 1)
+		{
+			const ExpressionType* exprType = GetExpressionType(*expressions.front());
+			if (exprType && ResolveAlias(*exprType) == ResolveAlias(targetType))
+			{
+				m_changed = true;
+				return std::move(expressions.front());
+			}
+		}
 		
 		auto cast = ShaderBuilder::Cast(node.targetType.GetResultingValue(), std::move(expressions));
 		cast->cachedExpressionType = node.cachedExpressionType;
@@ -1114,13 +1948,34 @@ namespace nzsl::Ast
 		std::vector<BranchStatement::ConditionalStatement> statements;
 		StatementPtr elseStatement;
 
+		// Each kept path starts with the variable values known before the branch, values known after the branch are the ones all paths agree on
+		VariableValues entryValues = m_variableValues;
+		std::optional<VariableValues> exitValues;
+
+		auto ClonePath = [&](const StatementPtr& statement)
+		{
+			m_variableValues = entryValues;
+			StatementPtr clone = CloneStatement(statement);
+
+			if (exitValues)
+				MergeVariableValues(*exitValues, m_variableValues);
+			else
+				exitValues = std::move(m_variableValues);
+
+			return clone;
+		};
+
 		bool continuePropagation = true;
 		for (auto& condStatement : node.condStatements)
 		{
+			m_variableValues = entryValues;
 			auto cond = CloneExpression(condStatement.condition);
 
 			if (continuePropagation && cond->GetType() == NodeType::ConstantValueExpression)
 			{
+				// Constant conditions are either removed or replace the whole branch
+				m_changed = true;
+
 				auto& constant = static_cast<ConstantValueExpression&>(*cond);
 
 				const ExpressionType* constantType = GetExpressionType(constant);
@@ -1146,7 +2001,7 @@ namespace nzsl::Ast
 				else
 				{
 					// Some condition after the first one is true, make it the else statement and stop there
-					elseStatement = CloneStatement(condStatement.statement);
+					elseStatement = ClonePath(condStatement.statement);
 					break;
 				}
 			}
@@ -1154,13 +2009,14 @@ namespace nzsl::Ast
 			{
 				auto& c = statements.emplace_back();
 				c.condition = std::move(cond);
-				c.statement = CloneStatement(condStatement.statement);
+				c.statement = ClonePath(condStatement.statement);
 			}
 		}
 
 		if (statements.empty())
 		{
 			// All conditions have been removed, replace by else statement or no-op
+			m_variableValues = std::move(entryValues);
 			if (node.elseStatement)
 				return Unscope(Cloner::Clone(*node.elseStatement));
 			else
@@ -1168,7 +2024,15 @@ namespace nzsl::Ast
 		}
 
 		if (!elseStatement)
-			elseStatement = CloneStatement(node.elseStatement);
+		{
+			if (node.elseStatement)
+				elseStatement = ClonePath(node.elseStatement);
+			else
+				MergeVariableValues(*exitValues, entryValues);
+		}
+
+		assert(exitValues);
+		m_variableValues = std::move(*exitValues);
 
 		auto branchStatement = ShaderBuilder::Branch(std::move(statements), std::move(elseStatement));
 		branchStatement->sourceLocation = node.sourceLocation;
@@ -1190,6 +2054,8 @@ namespace nzsl::Ast
 		if (!IsPrimitiveType(constantType) || std::get<PrimitiveType>(constantType) != PrimitiveType::Boolean)
 			throw std::runtime_error("conditional expression condition must resolve to a boolean");
 
+		m_changed = true;
+
 		bool cValue = std::get<bool>(constant.value);
 		if (cValue)
 			return Cloner::Clone(*node.truePath);
@@ -1222,6 +2088,7 @@ namespace nzsl::Ast
 				auto constant = ShaderBuilder::ConstantValue(arg);
 				constant->sourceLocation = node.sourceLocation;
 
+				m_changed = true;
 				return constant;
 			}
 		}, *constantValue);
@@ -1229,6 +2096,15 @@ namespace nzsl::Ast
 
 	ExpressionPtr ConstantPropagationVisitor::Clone(IntrinsicExpression& node)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Atomic operations write their first parameter, forget its value so it's not replaced by a constant
+		if (IsAtomicIntrinsic(node.intrinsic) && !node.parameters.empty())
+		{
+			if (std::optional<std::size_t> variableIndex = GetAssignedVariable(*node.parameters.front()))
+				m_variableValues.erase(*variableIndex);
+		}
+
 		std::vector<ExpressionPtr> parameters;
 
 		std::size_t parameterCount = node.parameters.size();
@@ -1251,6 +2127,7 @@ namespace nzsl::Ast
 						auto constant = ShaderBuilder::ConstantValue(arrayType.length);
 						constant->sourceLocation = node.sourceLocation;
 
+						m_changed = true;
 						return constant;
 					}
 				}
@@ -1273,16 +2150,67 @@ namespace nzsl::Ast
 			case IntrinsicType::Min:
 				break;
 			case IntrinsicType::Normalize:
-				break;
 			case IntrinsicType::Pow:
+			{
+				if (ExpressionPtr simplified = SimplifyIntrinsic(node, parameters))
+				{
+					m_changed = true;
+					return simplified;
+				}
+
 				break;
+			}
 			case IntrinsicType::Reflect:
 				break;
 			case IntrinsicType::Transpose:
 				break;
 
 			// Always runtime intrinsics
+			case IntrinsicType::AtomicAdd:
+			case IntrinsicType::AtomicAnd:
+			case IntrinsicType::AtomicCompareExchange:
+			case IntrinsicType::AtomicExchange:
+			case IntrinsicType::AtomicMax:
+			case IntrinsicType::AtomicMin:
+			case IntrinsicType::AtomicOr:
+			case IntrinsicType::AtomicXor:
+			case IntrinsicType::Barrier:
+			case IntrinsicType::BitCount:
+			case IntrinsicType::BitFieldExtract:
+			case IntrinsicType::BitFieldInsert:
+			case IntrinsicType::FirstBitHigh:
+			case IntrinsicType::FirstBitLow:
+			case IntrinsicType::ImageAtomicAdd:
+			case IntrinsicType::ImageAtomicAnd:
+			case IntrinsicType::ImageAtomicExchange:
+			case IntrinsicType::ImageAtomicMax:
+			case IntrinsicType::ImageAtomicMin:
+			case IntrinsicType::ImageAtomicOr:
+			case IntrinsicType::ImageAtomicXor:
+			case IntrinsicType::ImageLoad:
+			case IntrinsicType::ImageStore:
+			case IntrinsicType::MemoryBarrier:
+			case IntrinsicType::MemoryBarrierBuffer:
+			case IntrinsicType::MemoryBarrierImage:
+			case IntrinsicType::MemoryBarrierShared:
+			case IntrinsicType::NonUniform:
+			case IntrinsicType::PackHalf2x16:
+			case IntrinsicType::PackUnorm4x8:
 			case IntrinsicType::SampleTexture:
+			case IntrinsicType::SampleTextureGrad:
+			case IntrinsicType::SampleTextureLod:
+			case IntrinsicType::SubgroupAdd:
+			case IntrinsicType::SubgroupBallot:
+			case IntrinsicType::SubgroupBroadcastFirst:
+			case IntrinsicType::SubgroupElect:
+			case IntrinsicType::SubgroupMax:
+			case IntrinsicType::SubgroupMin:
+			case IntrinsicType::SubgroupShuffle:
+			case IntrinsicType::TextureFetch:
+			case IntrinsicType::TextureGather:
+			case IntrinsicType::TextureSize:
+			case IntrinsicType::UnpackHalf2x16:
+			case IntrinsicType::UnpackUnorm4x8:
 				break;
 		}
 
@@ -1295,6 +2223,8 @@ namespace nzsl::Ast
 
 	ExpressionPtr ConstantPropagationVisitor::Clone(SwizzleExpression& node)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		auto expr = CloneExpression(node.expression);
 
 		if (expr->GetType() == NodeType::ConstantValueExpression)
@@ -1324,6 +2254,8 @@ namespace nzsl::Ast
 			if (optimized)
 			{
 				optimized->sourceLocation = node.sourceLocation;
+
+				m_changed = true;
 				return optimized;
 			}
 		}
@@ -1337,6 +2269,14 @@ namespace nzsl::Ast
 			
 			constantExpr.componentCount = node.componentCount;
 			constantExpr.components = newComponents;
+			constantExpr.cachedExpressionType = node.cachedExpressionType;
+			constantExpr.sourceLocation = node.sourceLocation;
+
+			m_changed = true;
+
+			// Combined swizzle may end up being an identity (vec.zyx.zyx => vec)
+			if (IsIdentitySwizzle(constantExpr))
+				return std::move(constantExpr.expression);
 
 			return expr;
 		}
@@ -1345,6 +2285,13 @@ namespace nzsl::Ast
 		swizzle->cachedExpressionType = node.cachedExpressionType;
 		swizzle->sourceLocation = node.sourceLocation;
 
+		// vec.xyz on a vec3 is a no-op
+		if (IsIdentitySwizzle(*swizzle))
+		{
+			m_changed = true;
+			return std::move(swizzle->expression);
+		}
+
 		return swizzle;
 	}
 
@@ -1359,6 +2306,10 @@ namespace nzsl::Ast
 			ExpressionPtr optimized;
 			switch (node.op)
 			{
+				case UnaryType::BitwiseNot:
+					optimized = PropagateUnaryConstant<UnaryType::BitwiseNot>(constantExpr, node.sourceLocation);
+					break;
+
 				case UnaryType::LogicalNot:
 					optimized = PropagateUnaryConstant<UnaryType::LogicalNot>(constantExpr, node.sourceLocation);
 					break;
@@ -1375,10 +2326,38 @@ namespace nzsl::Ast
 			if (optimized)
 			{
 				optimized->sourceLocation = node.sourceLocation;
+
+				m_changed = true;
 				return optimized;
 			}
 		}
 
+		switch (node.op)
+		{
+			case UnaryType::BitwiseNot:
+			case UnaryType::LogicalNot:
+			case UnaryType::Minus:
+			{
+				// ~~x => x, !!x => x and -(-x) => x
+				if (expr->GetType() == NodeType::UnaryExpression)
+				{
+					UnaryExpression& unaryExpr = static_cast<UnaryExpression&>(*expr);
+					if (unaryExpr.op == node.op)
+					{
+						m_changed = true;
+						return std::move(unaryExpr.expression);
+					}
+				}
+
+				break;
+			}
+
+			case UnaryType::Plus:
+				// +x => x
+				m_changed = true;
+				return expr;
+		}
+
 		auto unary = ShaderBuilder::Unary(node.op, std::move(expr));
 		unary->cachedExpressionType = node.cachedExpressionType;
 		unary->sourceLocation = node.sourceLocation;
@@ -1386,6 +2365,20 @@ namespace nzsl::Ast
 		return unary;
 	}
 
+	ExpressionPtr ConstantPropagationVisitor::Clone(VariableValueExpression& node)
+	{
+		auto it = m_variableValues.find(node.variableId);
+		if (it == m_variableValues.end())
+			return Cloner::Clone(node);
+
+		auto constant = ShaderBuilder::ConstantValue(it->second);
+		constant->cachedExpressionType = node.cachedExpressionType;
+		constant->sourceLocation = node.sourceLocation;
+
+		m_changed = true;
+		return constant;
+	}
+
 	StatementPtr ConstantPropagationVisitor::Clone(ConditionalStatement& node)
 	{
 		auto cond = CloneExpression(node.condition);
@@ -1404,7 +2397,127 @@ namespace nzsl::Ast
 		if (cValue)
 			return Cloner::Clone(node);
 		else
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
+	}
+
+	StatementPtr ConstantPropagationVisitor::Clone(DeclareFunctionStatement& node)
+	{
+		// Variable values are tracked per function, externals (such as workgroup variables) may be written by other invocations and are never tracked
+		m_localVariables.clear();
+		m_variableValues.clear();
+
+		for (const auto& parameter : node.parameters)
+		{
+			if (parameter.varIndex)
+				m_localVariables.insert(*parameter.varIndex);
+		}
+
+		StatementPtr clone = Cloner::Clone(node);
+
+		m_localVariables.clear();
+		m_variableValues.clear();
+
+		return clone;
+	}
+
+	StatementPtr ConstantPropagationVisitor::Clone(DeclareVariableStatement& node)
+	{
+		auto clone = Cloner::Clone(node);
+
+		if (node.varIndex)
+		{
+			m_localVariables.insert(*node.varIndex);
+
+			const auto& declareVariable = static_cast<const DeclareVariableStatement&>(*clone);
+			if (declareVariable.initialExpression)
+				SetVariableValue(*node.varIndex, *declareVariable.initialExpression);
+			else
+				m_variableValues.erase(*node.varIndex);
+		}
+
+		return clone;
+	}
+
+	StatementPtr ConstantPropagationVisitor::Clone(ForStatement& node)
+	{
+		// Variables assigned in a loop may have a different value on each iteration
+		InvalidateAssignedVariables(node);
+
+		StatementPtr clone = Cloner::Clone(node);
+
+		// The loop may run zero times, values assigned in its body aren't known after it
+		InvalidateAssignedVariables(node);
+
+		return clone;
+	}
+
+	StatementPtr ConstantPropagationVisitor::Clone(ForEachStatement& node)
+	{
+		InvalidateAssignedVariables(node);
+
+		StatementPtr clone = Cloner::Clone(node);
+		InvalidateAssignedVariables(node);
+
+		return clone;
+	}
+
+	StatementPtr ConstantPropagationVisitor::Clone(WhileStatement& node)
+	{
+		VariableValues entryValues = m_variableValues;
+		InvalidateAssignedVariables(node);
+
+		auto condition = CloneExpression(node.condition);
+		if (condition->GetType() == NodeType::ConstantValueExpression)
+		{
+			const auto& constant = static_cast<const ConstantValueExpression&>(*condition);
+			if (std::holds_alternative<bool>(constant.value) && !std::get<bool>(constant.value))
+			{
+				// Loop body is never executed
+				m_variableValues = std::move(entryValues);
+
+				m_changed = true;
+				return ShaderBuilder::NoOp();
+			}
+		}
+
+		auto whileStatement = std::make_unique<WhileStatement>();
+		whileStatement->condition = std::move(condition);
+		whileStatement->body = CloneStatement(node.body);
+		whileStatement->unroll = Cloner::Clone(node.unroll);
+		whileStatement->sourceLocation = node.sourceLocation;
+
+		// Only variables assigned in the loop were invalidated, declarations made in its body aren't visible after it
+		InvalidateAssignedVariables(node);
+
+		return whileStatement;
+	}
+
+	void ConstantPropagationVisitor::InvalidateAssignedVariables(Statement& statement)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		AssignedVariableCollector assignedVariableCollector;
+		statement.Visit(assignedVariableCollector);
+
+		for (std::size_t variableIndex : assignedVariableCollector.assignedVariables)
+			m_variableValues.erase(variableIndex);
+	}
+
+	void ConstantPropagationVisitor::MergeVariableValues(VariableValues& values, const VariableValues& otherValues)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		for (auto it = values.begin(); it != values.end();)
+		{
+			auto otherIt = otherValues.find(it->first);
+			if (otherIt == otherValues.end() || !IsSameConstant(it->second, otherIt->second))
+				it = values.erase(it);
+			else
+				++it;
+		}
 	}
 
 	template<BinaryType Type>
@@ -1562,6 +2675,247 @@ namespace nzsl::Ast
 	}
 
 
+	void ConstantPropagationVisitor::SetVariableValue(std::size_t variableIndex, const Expression& value)
+	{
+		if (value.GetType() != NodeType::ConstantValueExpression || m_localVariables.find(variableIndex) == m_localVariables.end())
+		{
+			m_variableValues.erase(variableIndex);
+			return;
+		}
+
+		const ConstantSingleValue& constantValue = static_cast<const ConstantValueExpression&>(value).value;
+		if (std::holds_alternative<NoValue>(constantValue) || std::holds_alternative<std::string>(constantValue))
+		{
+			m_variableValues.erase(variableIndex);
+			return;
+		}
+
+		m_variableValues[variableIndex] = constantValue;
+	}
+
+	ExpressionPtr ConstantPropagationVisitor::SimplifyBinary(BinaryExpression& node, ExpressionPtr& lhs, ExpressionPtr& rhs)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!node.cachedExpressionType)
+			return nullptr;
+
+		const ExpressionType& resultType = ResolveAlias(*node.cachedExpressionType);
+		bool isFloatingPoint = IsFloatingPointType(resultType);
+
+		// An operand can only replace the whole expression if it has the same type (f32 * vec3[f32](1.0) can't be replaced by the f32 operand)
+		auto CanReplaceBy = [&](Expression& operand)
+		{
+			const ExpressionType* operandType = GetExpressionType(operand);
+			return operandType && ResolveAlias(*operandType) == resultType;
+		};
+
+		switch (node.op)
+		{
+			case BinaryType::Add:
+			{
+				if (isFloatingPoint)
+				{
+					// x + (-0.0) => x is bit-exact, unlike x + 0.0 => x (-0.0 + 0.0 = 0.0)
+					if (IsNegativeZero(*rhs) && CanReplaceBy(*lhs))
+						return std::move(lhs);
+
+					if (IsNegativeZero(*lhs) && CanReplaceBy(*rhs))
+						return std::move(rhs);
+
+					if (!m_options.allowUnsafeMathOptimizations)
+						break;
+				}
+
+				// x + 0 => x
+				if (IsConstantValue(*rhs, 0) && CanReplaceBy(*lhs))
+					return std::move(lhs);
+
+				if (IsConstantValue(*lhs, 0) && CanReplaceBy(*rhs))
+					return std::move(rhs);
+
+				break;
+			}
+
+			case BinaryType::Subtract:
+			{
+				// x - 0 => x
+				if (IsConstantValue(*rhs, 0) && CanReplaceBy(*lhs))
+					return std::move(lhs);
+
+				break;
+			}
+
+			case BinaryType::Multiply:
+			{
+				// x * 1 => x
+				if (IsConstantValue(*rhs, 1) && CanReplaceBy(*lhs))
+					return std::move(lhs);
+
+				if (IsConstantValue(*lhs, 1) && CanReplaceBy(*rhs))
+					return std::move(rhs);
+
+				// x * 0 => 0 (integers only, as NaN * 0.0 = NaN)
+				if (!isFloatingPoint)
+				{
+					if (IsConstantValue(*rhs, 0) && CanReplaceBy(*rhs) && IsPureExpression(*lhs))
+						return std::move(rhs);
+
+					if (IsConstantValue(*lhs, 0) && CanReplaceBy(*lhs) && IsPureExpression(*rhs))
+						return std::move(lhs);
+				}
+
+				break;
+			}
+
+			case BinaryType::Divide:
+			{
+				// x / 1 => x
+				if (IsConstantValue(*rhs, 1) && CanReplaceBy(*lhs))
+					return std::move(lhs);
+
+				// x / c => x * (1 / c)
+				if (isFloatingPoint && m_options.allowUnsafeMathOptimizations && !IsMatrixType(resultType) && rhs->GetType() == NodeType::ConstantValueExpression)
+				{
+					auto reciprocal = ComputeReciprocal(static_cast<ConstantValueExpression&>(*rhs));
+					if (!reciprocal)
+						break;
+
+					reciprocal->sourceLocation = rhs->sourceLocation;
+
+					auto binary = ShaderBuilder::Binary(BinaryType::Multiply, std::move(lhs), std::move(reciprocal));
+					binary->cachedExpressionType = node.cachedExpressionType;
+					binary->sourceLocation = node.sourceLocation;
+
+					return binary;
+				}
+
+				break;
+			}
+
+			case BinaryType::Modulo:
+			{
+				// x % 2^n => x & (2^n - 1) (unsigned integers only, as the signed modulo result has the sign of x)
+				if (!IsPrimitiveType(resultType) || std::get<PrimitiveType>(resultType) != PrimitiveType::UInt32 || rhs->GetType() != NodeType::ConstantValueExpression)
+					break;
+
+				const ConstantSingleValue& divisor = static_cast<ConstantValueExpression&>(*rhs).value;
+				if (!std::holds_alternative<std::uint32_t>(divisor))
+					break;
+
+				std::uint32_t divisorValue = std::get<std::uint32_t>(divisor);
+				if (divisorValue == 0 || (divisorValue & (divisorValue - 1)) != 0)
+					break;
+
+				auto mask = ShaderBuilder::ConstantValue(divisorValue - 1);
+				mask->sourceLocation = rhs->sourceLocation;
+
+				auto binary = ShaderBuilder::Binary(BinaryType::BitwiseAnd, std::move(lhs), std::move(mask));
+				binary->cachedExpressionType = node.cachedExpressionType;
+				binary->sourceLocation = node.sourceLocation;
+
+				return binary;
+			}
+
+			case BinaryType::LogicalAnd:
+			{
+				// x && true => x
+				if (IsConstantValue(*rhs, 1))
+					return std::move(lhs);
+
+				if (IsConstantValue(*lhs, 1))
+					return std::move(rhs);
+
+				// false && x => false (x is never evaluated)
+				if (IsConstantValue(*lhs, 0))
+					return std::move(lhs);
+
+				if (IsConstantValue(*rhs, 0) && IsPureExpression(*lhs))
+					return std::move(rhs);
+
+				break;
+			}
+
+			case BinaryType::LogicalOr:
+			{
+				// x || false => x
+				if (IsConstantValue(*rhs, 0))
+					return std::move(lhs);
+
+				if (IsConstantValue(*lhs, 0))
+					return std::move(rhs);
+
+				// true || x => true (x is never evaluated)
+				if (IsConstantValue(*lhs, 1))
+					return std::move(lhs);
+
+				if (IsConstantValue(*rhs, 1) && IsPureExpression(*lhs))
+					return std::move(rhs);
+
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		return nullptr;
+	}
+
+	ExpressionPtr ConstantPropagationVisitor::SimplifyIntrinsic(IntrinsicExpression& node, std::vector<ExpressionPtr>& parameters)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		switch (node.intrinsic)
+		{
+			case IntrinsicType::Normalize:
+			{
+				// normalize(normalize(x)) => normalize(x)
+				if (parameters.size() == 1 && parameters.front()->GetType() == NodeType::IntrinsicExpression)
+				{
+					const IntrinsicExpression& intrinsicExpr = static_cast<const IntrinsicExpression&>(*parameters.front());
+					if (intrinsicExpr.intrinsic == IntrinsicType::Normalize)
+						return std::move(parameters.front());
+				}
+
+				break;
+			}
+
+			case IntrinsicType::Pow:
+			{
+				if (parameters.size() != 2 || !node.cachedExpressionType)
+					break;
+
+				const ExpressionType* valueType = GetExpressionType(*parameters[0]);
+				if (!valueType || ResolveAlias(*valueType) != ResolveAlias(*node.cachedExpressionType))
+					break;
+
+				// pow(x, 1.0) => x
+				if (IsConstantValue(*parameters[1], 1))
+					return std::move(parameters[0]);
+
+				// pow(x, 2.0) => x * x (only if x can be evaluated twice at no cost)
+				if (IsConstantValue(*parameters[1], 2) && IsTrivialExpression(*parameters[0]))
+				{
+					ExpressionPtr valueCopy = Cloner::Clone(*parameters[0]);
+
+					auto binary = ShaderBuilder::Binary(BinaryType::Multiply, std::move(parameters[0]), std::move(valueCopy));
+					binary->cachedExpressionType = node.cachedExpressionType;
+					binary->sourceLocation = node.sourceLocation;
+
+					return binary;
+				}
+
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		return nullptr;
+	}
+
 	StatementPtr ConstantPropagationVisitor::Unscope(StatementPtr node)
 	{
 		assert(node);
@@ -5,14 +5,98 @@
 #include <NZSL/Ast/EliminateUnusedPassVisitor.hpp>
 #include <Nazara/Utils/CallOnExit.hpp>
 #include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
 
 namespace nzsl::Ast
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Looks for declarations EliminateUnusedPassVisitor would remove, without cloning anything
+		class UnusedDeclarationFinder : public RecursiveVisitor
+		{
+			public:
+				UnusedDeclarationFinder(const DependencyCheckerVisitor::UsageSet& usageSet) :
+				m_usageSet(usageSet)
+				{
+				}
+
+				bool Find(Statement& statement)
+				{
+					statement.Visit(*this);
+					return m_found;
+				}
+
+				using RecursiveVisitor::Visit;
+
+				void Visit(DeclareAliasStatement& node) override
+				{
+					assert(node.aliasIndex);
+					if (!m_usageSet.usedAliases.UnboundedTest(*node.aliasIndex))
+						m_found = true;
+				}
+
+				void Visit(DeclareConstStatement& node) override
+				{
+					assert(node.constIndex);
+					if (!m_usageSet.usedConstants.UnboundedTest(*node.constIndex))
+						m_found = true;
+				}
+
+				void Visit(DeclareExternalStatement& node) override
+				{
+					for (const auto& externalVar : node.externalVars)
+					{
+						assert(externalVar.varIndex);
+						if (!m_usageSet.usedVariables.UnboundedTest(*externalVar.varIndex))
+						{
+							m_found = true;
+							break;
+						}
+					}
+				}
+
+				void Visit(DeclareFunctionStatement& node) override
+				{
+					assert(node.funcIndex);
+					if (!m_usageSet.usedFunctions.UnboundedTest(*node.funcIndex))
+						m_found = true;
+					else if (!m_found)
+						RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareStructStatement& node) override
+				{
+					assert(node.structIndex);
+					if (!m_usageSet.usedStructs.UnboundedTest(*node.structIndex))
+						m_found = true;
+				}
+
+				void Visit(DeclareVariableStatement& node) override
+				{
+					assert(node.varIndex);
+					if (!m_usageSet.usedVariables.UnboundedTest(*node.varIndex))
+						m_found = true;
+				}
+
+			private:
+				const DependencyCheckerVisitor::UsageSet& m_usageSet;
+				bool m_found = false;
+		};
+	}
+
 	struct EliminateUnusedPassVisitor::Context
 	{
 		const DependencyCheckerVisitor::UsageSet& usageSet;
 	};
 
+	bool EliminateUnusedPassVisitor::CanTransform(const Module& shaderModule, const DependencyCheckerVisitor::UsageSet& usageSet)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		UnusedDeclarationFinder unusedDeclarationFinder(usageSet);
+		return unusedDeclarationFinder.Find(*shaderModule.rootNode);
+	}
+
 	ModulePtr EliminateUnusedPassVisitor::Process(const Module& shaderModule, const DependencyCheckerVisitor::UsageSet& usageSet)
 	{
 		auto rootNode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode, usageSet));
@@ -27,6 +111,8 @@ namespace nzsl::Ast
 		};
 
 		m_context = &context;
+		m_changed = false;
+
 		Nz::CallOnExit onExit([this]()
 		{
 			m_context = nullptr;
@@ -39,7 +125,10 @@ namespace nzsl::Ast
 	{
 		assert(node.aliasIndex);
 		if (!IsAliasUsed(*node.aliasIndex))
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		return Cloner::Clone(node);
 	}
@@ -48,7 +137,10 @@ namespace nzsl::Ast
 	{
 		assert(node.constIndex);
 		if (!IsConstantUsed(*node.constIndex))
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		return Cloner::Clone(node);
 	}
@@ -69,7 +161,10 @@ namespace nzsl::Ast
 		}
 
 		if (!isUsed)
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		auto clonedNode = Cloner::Clone(node);
 
@@ -81,7 +176,10 @@ namespace nzsl::Ast
 			std::size_t varIndex = *externalVar.varIndex;
 
 			if (!IsVariableUsed(varIndex))
+			{
 				it = externalStatement.externalVars.erase(it);
+				m_changed = true;
+			}
 			else
 				++it;
 		}
@@ -93,7 +191,10 @@ namespace nzsl::Ast
 	{
 		assert(node.funcIndex);
 		if (!IsFunctionUsed(*node.funcIndex))
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		return Cloner::Clone(node);
 	}
@@ -102,7 +203,10 @@ namespace nzsl::Ast
 	{
 		assert(node.structIndex);
 		if (!IsStructUsed(*node.structIndex))
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		return Cloner::Clone(node);
 	}
@@ -111,7 +215,10 @@ namespace nzsl::Ast
 	{
 		assert(node.varIndex);
 		if (!IsVariableUsed(*node.varIndex))
+		{
+			m_changed = true;
 			return ShaderBuilder::NoOp();
+		}
 
 		return Cloner::Clone(node);
 	}
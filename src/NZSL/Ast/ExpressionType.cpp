@@ -154,8 +154,11 @@ namespace nzsl::Ast
 		switch (type)
 		{
 			case Ast::PrimitiveType::Boolean: return "bool";
+			case Ast::PrimitiveType::Float16: return "f16";
 			case Ast::PrimitiveType::Float32: return "f32";
+			case Ast::PrimitiveType::Int16:   return "i16";
 			case Ast::PrimitiveType::Int32:   return "i32";
+			case Ast::PrimitiveType::UInt16:  return "u16";
 			case Ast::PrimitiveType::UInt32:  return "u32";
 			case Ast::PrimitiveType::String:  return "string";
 		}
@@ -163,6 +166,11 @@ namespace nzsl::Ast
 		return "<unhandled primitive type>";
 	}
 
+	std::string ToString(const PushConstantType& type, const Stringifier& stringifier)
+	{
+		return fmt::format("push_constant[{}]", ToString(type.containedType, stringifier));
+	}
+
 	std::string ToString(const SamplerType& type, const Stringifier& /*stringifier*/)
 	{
 		std::string_view dimensionStr;
@@ -179,6 +187,40 @@ namespace nzsl::Ast
 		return fmt::format("sampler{}[{}]", dimensionStr, ToString(type.sampledType));
 	}
 
+	std::string ToString(const StorageImageType& type, const Stringifier& /*stringifier*/)
+	{
+		std::string_view dimensionStr;
+		switch (type.dim)
+		{
+			case ImageType::E1D:       dimensionStr = "1D";      break;
+			case ImageType::E1D_Array: dimensionStr = "1DArray"; break;
+			case ImageType::E2D:       dimensionStr = "2D";      break;
+			case ImageType::E2D_Array: dimensionStr = "2DArray"; break;
+			case ImageType::E3D:       dimensionStr = "3D";      break;
+			case ImageType::Cubemap:   dimensionStr = "Cube";    break;
+		}
+
+		std::string_view formatStr;
+		switch (type.format)
+		{
+			case ImageFormat::R8:       formatStr = "r8";       break;
+			case ImageFormat::R16f:     formatStr = "r16f";     break;
+			case ImageFormat::R32f:     formatStr = "r32f";     break;
+			case ImageFormat::R32i:     formatStr = "r32i";     break;
+			case ImageFormat::R32ui:    formatStr = "r32ui";    break;
+			case ImageFormat::Rg8:      formatStr = "rg8";      break;
+			case ImageFormat::Rg16f:    formatStr = "rg16f";    break;
+			case ImageFormat::Rg32f:    formatStr = "rg32f";    break;
+			case ImageFormat::Rgba8:    formatStr = "rgba8";    break;
+			case ImageFormat::Rgba16f:  formatStr = "rgba16f";  break;
+			case ImageFormat::Rgba32f:  formatStr = "rgba32f";  break;
+			case ImageFormat::Rgba32i:  formatStr = "rgba32i";  break;
+			case ImageFormat::Rgba32ui: formatStr = "rgba32ui"; break;
+		}
+
+		return fmt::format("image{}[{}, {}]", dimensionStr, ToString(type.sampledType), formatStr);
+	}
+
 	std::string ToString(const StorageType& type, const Stringifier& stringifier)
 	{
 		return fmt::format("storage[{}]", ToString(type.containedType, stringifier));
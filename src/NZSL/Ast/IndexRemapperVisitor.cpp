@@ -297,6 +297,12 @@ namespace nzsl::Ast
 
 			return remappedMethodType;
 		}
+		else if (IsPushConstantType(exprType))
+		{
+			PushConstantType pushConstantType;
+			pushConstantType.containedType.structIndex = Nz::Retrieve(m_context->newStructIndices, std::get<PushConstantType>(exprType).containedType.structIndex);
+			return pushConstantType;
+		}
 		else if (IsStorageType(exprType))
 		{
 			StorageType storageType;
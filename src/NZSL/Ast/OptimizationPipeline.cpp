@@ -0,0 +1,177 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/OptimizationPipeline.hpp>
+#include <NZSL/Ast/EliminateUnusedPassVisitor.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
+#include <NZSL/Ast/VectorizationVisitor.hpp>
+
+namespace nzsl::Ast
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		class NodeCounterVisitor : public RecursiveVisitor
+		{
+			public:
+				using RecursiveVisitor::Visit;
+
+#define NZSL_SHADERAST_NODE(Node, Category) void Visit(Node##Category& node) override \
+				{ \
+					nodeCount++; \
+					RecursiveVisitor::Visit(node); \
+				}
+
+#include <NZSL/Ast/NodeList.hpp>
+
+				std::size_t nodeCount = 0;
+		};
+	}
+
+	OptimizationPipeline::OptimizationPipeline(OptimizationLevel optimizationLevel, const Options& options)
+	{
+		switch (optimizationLevel)
+		{
+			case OptimizationLevel::O0:
+				return;
+
+			case OptimizationLevel::O1:
+				m_maxIterationCount = 1;
+				break;
+
+			case OptimizationLevel::O2:
+			case OptimizationLevel::Os:
+				// Folding constants may remove code and eliminating unused code may reveal new constants, iterate until nothing changes
+				m_maxIterationCount = 8;
+				break;
+		}
+
+		// Passes report if they transformed anything, the input module is kept as is when they didn't
+		// They first check for something to transform, so modules which are already optimized aren't cloned for nothing
+		AddPass("constant-propagation", [constantPropagationOptions = options.constantPropagation](const Module& shaderModule) -> ModulePtr
+		{
+			if (!ConstantPropagationVisitor::CanTransform(shaderModule, constantPropagationOptions))
+				return nullptr;
+
+			ConstantPropagationVisitor constantPropagation;
+			ModulePtr optimizedModule = constantPropagation.Process(shaderModule, constantPropagationOptions);
+			if (!constantPropagation.HasChanged())
+				return nullptr;
+
+			return optimizedModule;
+		});
+
+		AddPass("eliminate-unused", [dependencyConfig = options.dependencyConfig](const Module& shaderModule) -> ModulePtr
+		{
+			DependencyCheckerVisitor dependencyVisitor;
+			for (const auto& importedModule : shaderModule.importedModules)
+				dependencyVisitor.Register(*importedModule.module->rootNode, dependencyConfig);
+
+			dependencyVisitor.Register(*shaderModule.rootNode, dependencyConfig);
+			dependencyVisitor.Resolve();
+
+			if (!EliminateUnusedPassVisitor::CanTransform(shaderModule, dependencyVisitor.GetUsage()))
+				return nullptr;
+
+			EliminateUnusedPassVisitor eliminateUnused;
+			ModulePtr optimizedModule = eliminateUnused.Process(shaderModule, dependencyVisitor.GetUsage());
+			if (!eliminateUnused.HasChanged())
+				return nullptr;
+
+			return optimizedModule;
+		});
+
+		// Vectorization may broadcast scalars into new vector constructors, which increases code size
+		if (optimizationLevel == OptimizationLevel::O2)
+		{
+			AddPass("vectorization", [](const Module& shaderModule) -> ModulePtr
+			{
+				if (!VectorizationVisitor::CanTransform(shaderModule))
+					return nullptr;
+
+				VectorizationVisitor vectorizer;
+				ModulePtr optimizedModule = vectorizer.Process(shaderModule);
+				if (!vectorizer.HasChanged())
+					return nullptr;
+
+				return optimizedModule;
+			});
+		}
+	}
+
+	void OptimizationPipeline::AddPass(std::string name, PassCallback callback)
+	{
+		auto& pass = m_passes.emplace_back();
+		pass.name = std::move(name);
+		pass.callback = std::move(callback);
+	}
+
+	ModulePtr OptimizationPipeline::Process(const Module& shaderModule, Statistics* statistics) const
+	{
+		ModulePtr optimizedModule;
+		const Module* currentModule = &shaderModule;
+
+		std::size_t nodeCount = (statistics) ? CountNodes(shaderModule) : 0;
+
+		// Number of passes which ran in a row without changing the module, once every pass saw the current module we reached a fixed point
+		std::size_t unchangedPassCount = 0;
+		std::size_t iteration = 0;
+		for (; iteration < m_maxIterationCount && unchangedPassCount < m_passes.size(); ++iteration)
+		{
+			for (std::size_t passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+			{
+				if (unchangedPassCount >= m_passes.size())
+					break;
+
+				auto startTime = std::chrono::steady_clock::now();
+
+				ModulePtr passResult = m_passes[passIndex].callback(*currentModule);
+				bool changed = (passResult != nullptr);
+				if (changed)
+				{
+					optimizedModule = std::move(passResult);
+					currentModule = optimizedModule.get();
+					unchangedPassCount = 0;
+				}
+				else
+					unchangedPassCount++;
+
+				if (statistics)
+				{
+					auto& passStats = statistics->passes.emplace_back();
+					passStats.changed = changed;
+					passStats.duration = std::chrono::steady_clock::now() - startTime;
+					passStats.iteration = iteration;
+					passStats.nodeCountBefore = nodeCount;
+					passStats.passIndex = passIndex;
+
+					if (changed)
+						nodeCount = CountNodes(*currentModule);
+
+					passStats.nodeCountAfter = nodeCount;
+				}
+			}
+		}
+
+		if (statistics)
+		{
+			statistics->iterationCount = iteration;
+			statistics->reachedFixedPoint = (unchangedPassCount >= m_passes.size());
+		}
+
+		return optimizedModule;
+	}
+
+	std::size_t OptimizationPipeline::CountNodes(const Module& shaderModule)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NodeCounterVisitor nodeCounter;
+		for (const auto& importedModule : shaderModule.importedModules)
+			importedModule.module->rootNode->Visit(nodeCounter);
+
+		shaderModule.rootNode->Visit(nodeCounter);
+
+		return nodeCounter.nodeCount;
+	}
+}
@@ -19,7 +19,10 @@
 #include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/Errors.hpp>
 #include <NZSL/Lang/LangData.hpp>
+#include <NZSL/Math/FieldOffsets.hpp>
+#include <frozen/string.h>
 #include <frozen/unordered_map.h>
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -43,6 +46,476 @@ namespace nzsl::Ast
 
 			using type = T;
 		};
+
+		// Rejects stores to read-only storage buffers and images and loads from write-only ones, once every function body is known
+		class StorageAccessValidator : public RecursiveVisitor
+		{
+			public:
+				StorageAccessValidator(const std::unordered_map<std::size_t, AccessPolicy>& accessPolicies) :
+				m_accessPolicies(accessPolicies)
+				{
+				}
+
+				using RecursiveVisitor::Visit;
+
+				void Visit(AssignExpression& node) override
+				{
+					if (std::optional<AccessPolicy> accessPolicy = VisitAccessChain(*node.left))
+					{
+						if (*accessPolicy == AccessPolicy::Read)
+							throw CompilerStorageReadOnlyStoreError{ node.sourceLocation };
+
+						// Compound assignments read the previous value
+						if (*accessPolicy == AccessPolicy::Write && node.op != AssignType::Simple)
+							throw CompilerStorageWriteOnlyLoadError{ node.sourceLocation };
+
+						// Storing a multi-component swizzle requires loading the whole vector to merge the untouched components
+						if (*accessPolicy == AccessPolicy::Write && node.left->GetType() == NodeType::SwizzleExpression && static_cast<SwizzleExpression&>(*node.left).componentCount > 1)
+							throw CompilerStorageWriteOnlySwizzleStoreError{ node.sourceLocation };
+					}
+
+					node.right->Visit(*this);
+				}
+
+				void Visit(IntrinsicExpression& node) override
+				{
+					switch (node.intrinsic)
+					{
+						// Querying the length of a runtime array doesn't access its memory
+						case IntrinsicType::ArraySize:
+							if (!node.parameters.empty())
+								VisitAccessChain(*node.parameters.front());
+
+							return;
+
+						// Atomic operations both read and write their first parameter
+						case IntrinsicType::AtomicAdd:
+						case IntrinsicType::AtomicAnd:
+						case IntrinsicType::AtomicCompareExchange:
+						case IntrinsicType::AtomicExchange:
+						case IntrinsicType::AtomicMax:
+						case IntrinsicType::AtomicMin:
+						case IntrinsicType::AtomicOr:
+						case IntrinsicType::AtomicXor:
+						{
+							if (node.parameters.empty())
+								break;
+
+							if (std::optional<AccessPolicy> accessPolicy = VisitAccessChain(*node.parameters.front()))
+							{
+								if (*accessPolicy == AccessPolicy::Read)
+									throw CompilerStorageReadOnlyStoreError{ node.sourceLocation };
+
+								if (*accessPolicy == AccessPolicy::Write)
+									throw CompilerStorageWriteOnlyLoadError{ node.sourceLocation };
+							}
+
+							for (std::size_t i = 1; i < node.parameters.size(); ++i)
+								node.parameters[i]->Visit(*this);
+
+							return;
+						}
+
+						// Image intrinsics access the texels of their first parameter, not the image handle itself
+						case IntrinsicType::ImageAtomicAdd:
+						case IntrinsicType::ImageAtomicAnd:
+						case IntrinsicType::ImageAtomicExchange:
+						case IntrinsicType::ImageAtomicMax:
+						case IntrinsicType::ImageAtomicMin:
+						case IntrinsicType::ImageAtomicOr:
+						case IntrinsicType::ImageAtomicXor:
+						case IntrinsicType::ImageLoad:
+						case IntrinsicType::ImageStore:
+						{
+							if (node.parameters.empty())
+								break;
+
+							if (std::optional<AccessPolicy> accessPolicy = VisitAccessChain(*node.parameters.front()))
+							{
+								if (*accessPolicy == AccessPolicy::Read && node.intrinsic != IntrinsicType::ImageLoad)
+									throw CompilerStorageReadOnlyStoreError{ node.sourceLocation };
+
+								if (*accessPolicy == AccessPolicy::Write && node.intrinsic != IntrinsicType::ImageStore)
+									throw CompilerStorageWriteOnlyLoadError{ node.sourceLocation };
+							}
+
+							for (std::size_t i = 1; i < node.parameters.size(); ++i)
+								node.parameters[i]->Visit(*this);
+
+							return;
+						}
+
+						default:
+							break;
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(VariableValueExpression& node) override
+				{
+					if (Retrieve(node.variableId) == AccessPolicy::Write)
+						throw CompilerStorageWriteOnlyLoadError{ node.sourceLocation };
+				}
+
+			private:
+				std::optional<AccessPolicy> Retrieve(std::size_t varIndex) const
+				{
+					auto it = m_accessPolicies.find(varIndex);
+					if (it == m_accessPolicies.end())
+						return std::nullopt;
+
+					return it->second;
+				}
+
+				// Visits indices of an access chain without considering its root variable as loaded
+				std::optional<AccessPolicy> VisitAccessChain(Expression& expression)
+				{
+					Expression* expr = &expression;
+					for (;;)
+					{
+						switch (expr->GetType())
+						{
+							case NodeType::AccessIdentifierExpression:
+								expr = static_cast<AccessIdentifierExpression*>(expr)->expr.get();
+								break;
+
+							case NodeType::AccessIndexExpression:
+							{
+								auto& accessIndex = static_cast<AccessIndexExpression&>(*expr);
+								for (auto& index : accessIndex.indices)
+									index->Visit(*this);
+
+								expr = accessIndex.expr.get();
+								break;
+							}
+
+							case NodeType::SwizzleExpression:
+								expr = static_cast<SwizzleExpression*>(expr)->expression.get();
+								break;
+
+							case NodeType::VariableValueExpression:
+								return Retrieve(static_cast<VariableValueExpression*>(expr)->variableId);
+
+							default:
+								expr->Visit(*this);
+								return std::nullopt;
+						}
+					}
+				}
+
+				const std::unordered_map<std::size_t, AccessPolicy>& m_accessPolicies;
+		};
+
+		// Sampler methods, the method index is the position in this array (only append new methods, indices are serialized)
+		constexpr std::array<std::pair<std::string_view, IntrinsicType>, 6> s_samplerMethods = {
+			{
+				{ "Sample",     IntrinsicType::SampleTexture },
+				{ "Fetch",      IntrinsicType::TextureFetch },
+				{ "Gather",     IntrinsicType::TextureGather },
+				{ "SampleGrad", IntrinsicType::SampleTextureGrad },
+				{ "SampleLod",  IntrinsicType::SampleTextureLod },
+				{ "Size",       IntrinsicType::TextureSize }
+			}
+		};
+
+		// Storage image methods, the method index is the position in this array (only append new methods, indices are serialized)
+		constexpr std::array<std::pair<std::string_view, IntrinsicType>, 9> s_storageImageMethods = {
+			{
+				{ "Load",           IntrinsicType::ImageLoad },
+				{ "Store",          IntrinsicType::ImageStore },
+				{ "AtomicAdd",      IntrinsicType::ImageAtomicAdd },
+				{ "AtomicAnd",      IntrinsicType::ImageAtomicAnd },
+				{ "AtomicExchange", IntrinsicType::ImageAtomicExchange },
+				{ "AtomicMax",      IntrinsicType::ImageAtomicMax },
+				{ "AtomicMin",      IntrinsicType::ImageAtomicMin },
+				{ "AtomicOr",       IntrinsicType::ImageAtomicOr },
+				{ "AtomicXor",      IntrinsicType::ImageAtomicXor }
+			}
+		};
+
+		constexpr auto s_imageFormats = frozen::make_unordered_map<frozen::string, ImageFormat>({
+			{ "r8",       ImageFormat::R8 },
+			{ "r16f",     ImageFormat::R16f },
+			{ "r32f",     ImageFormat::R32f },
+			{ "r32i",     ImageFormat::R32i },
+			{ "r32ui",    ImageFormat::R32ui },
+			{ "rg8",      ImageFormat::Rg8 },
+			{ "rg16f",    ImageFormat::Rg16f },
+			{ "rg32f",    ImageFormat::Rg32f },
+			{ "rgba8",    ImageFormat::Rgba8 },
+			{ "rgba16f",  ImageFormat::Rgba16f },
+			{ "rgba32f",  ImageFormat::Rgba32f },
+			{ "rgba32i",  ImageFormat::Rgba32i },
+			{ "rgba32ui", ImageFormat::Rgba32ui }
+		});
+
+		// Sampled type storage images with this format must use (ex: i32 for r32i)
+		PrimitiveType GetImageFormatSampledType(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::R32i:
+				case ImageFormat::Rgba32i:
+					return PrimitiveType::Int32;
+
+				case ImageFormat::R32ui:
+				case ImageFormat::Rgba32ui:
+					return PrimitiveType::UInt32;
+
+				case ImageFormat::R8:
+				case ImageFormat::R16f:
+				case ImageFormat::R32f:
+				case ImageFormat::Rg8:
+				case ImageFormat::Rg16f:
+				case ImageFormat::Rg32f:
+				case ImageFormat::Rgba8:
+				case ImageFormat::Rgba16f:
+				case ImageFormat::Rgba32f:
+					return PrimitiveType::Float32;
+			}
+
+			return PrimitiveType::Float32;
+		}
+
+		// Number of coordinates required to address a texel (including the array layer)
+		std::size_t GetSamplerCoordinateCount(ImageType imageType)
+		{
+			switch (imageType)
+			{
+				case ImageType::E1D:
+					return 1;
+
+				case ImageType::E1D_Array:
+				case ImageType::E2D:
+					return 2;
+
+				case ImageType::E2D_Array:
+				case ImageType::E3D:
+				case ImageType::Cubemap:
+					return 3;
+			}
+
+			return 0;
+		}
+
+		// Number of components of explicit gradients (excluding the array layer)
+		std::size_t GetSamplerGradientCount(ImageType imageType)
+		{
+			switch (imageType)
+			{
+				case ImageType::E1D:
+				case ImageType::E1D_Array:
+					return 1;
+
+				case ImageType::E2D:
+				case ImageType::E2D_Array:
+					return 2;
+
+				case ImageType::E3D:
+				case ImageType::Cubemap:
+					return 3;
+			}
+
+			return 0;
+		}
+
+		// Number of components returned by a size query (cubemap faces are square)
+		std::size_t GetSamplerSizeCount(ImageType imageType)
+		{
+			switch (imageType)
+			{
+				case ImageType::E1D:
+					return 1;
+
+				case ImageType::E1D_Array:
+				case ImageType::E2D:
+				case ImageType::Cubemap:
+					return 2;
+
+				case ImageType::E2D_Array:
+				case ImageType::E3D:
+					return 3;
+			}
+
+			return 0;
+		}
+
+		ExpressionType BuildScalarOrVectorType(std::size_t componentCount, PrimitiveType primitiveType)
+		{
+			if (componentCount == 1)
+				return primitiveType;
+
+			return VectorType{ componentCount, primitiveType };
+		}
+
+		std::string_view GetLayoutName(StructLayout layout)
+		{
+			switch (layout)
+			{
+				case StructLayout::Packed: return "packed";
+				case StructLayout::Scalar: return "scalar";
+				case StructLayout::Std140: return "std140";
+				case StructLayout::Std430: return "std430";
+			}
+
+			return "<unknown>";
+		}
+
+		// Registers a struct member (or an array of them if arraySize > 0) the way backends lay it out
+		template<typename F>
+		void RegisterStructField(FieldOffsets& fieldOffsets, const ExpressionType& exprType, std::size_t arraySize, F&& retrieveStruct, const SourceLocation& sourceLocation);
+
+		// Structs without a layout attribute are laid out using std140 by the backends
+		template<typename F>
+		FieldOffsets ComputeStructFieldOffsets(const StructDescription& structDesc, F&& retrieveStruct, const SourceLocation& sourceLocation)
+		{
+			StructLayout layout = StructLayout::Std140;
+			if (structDesc.layout.IsResultingValue() && structDesc.layout.GetResultingValue() != StructLayout::Packed)
+				layout = structDesc.layout.GetResultingValue();
+
+			FieldOffsets fieldOffsets(layout);
+			for (const auto& member : structDesc.members)
+			{
+				if (member.cond.IsResultingValue() && !member.cond.GetResultingValue())
+					continue;
+
+				RegisterStructField(fieldOffsets, member.type.GetResultingValue(), 0, retrieveStruct, sourceLocation);
+			}
+
+			return fieldOffsets;
+		}
+
+		template<typename F>
+		void RegisterStructField(FieldOffsets& fieldOffsets, const ExpressionType& exprType, std::size_t arraySize, F&& retrieveStruct, const SourceLocation& sourceLocation)
+		{
+			auto ToFieldType = [&](PrimitiveType primitiveType)
+			{
+				switch (primitiveType)
+				{
+					case PrimitiveType::Boolean: return StructFieldType::Bool1;
+					case PrimitiveType::Float32: return StructFieldType::Float1;
+					case PrimitiveType::Int32:   return StructFieldType::Int1;
+					case PrimitiveType::UInt32:  return StructFieldType::UInt1;
+					case PrimitiveType::Float16: return StructFieldType::Half1;
+					case PrimitiveType::Int16:   return StructFieldType::Short1;
+					case PrimitiveType::UInt16:  return StructFieldType::UShort1;
+					case PrimitiveType::String:  break;
+				}
+
+				throw AstInternalError{ sourceLocation, "unexpected string in struct" };
+			};
+
+			const ExpressionType& resolvedType = ResolveAlias(exprType);
+			if (IsArrayType(resolvedType))
+			{
+				// Arrays of arrays have the same layout as a flattened array
+				const ArrayType& arrayType = std::get<ArrayType>(resolvedType);
+				RegisterStructField(fieldOffsets, arrayType.containedType->type, std::max<std::size_t>(arraySize, 1) * arrayType.length, retrieveStruct, sourceLocation);
+			}
+			else if (IsDynArrayType(resolvedType))
+			{
+				const DynArrayType& arrayType = std::get<DynArrayType>(resolvedType);
+				RegisterStructField(fieldOffsets, arrayType.containedType->type, std::max<std::size_t>(arraySize, 1), retrieveStruct, sourceLocation); //< runtime arrays account for one element
+			}
+			else if (IsPrimitiveType(resolvedType))
+			{
+				StructFieldType fieldType = ToFieldType(std::get<PrimitiveType>(resolvedType));
+				if (arraySize > 0)
+					fieldOffsets.AddFieldArray(fieldType, arraySize);
+				else
+					fieldOffsets.AddField(fieldType);
+			}
+			else if (IsVectorType(resolvedType))
+			{
+				const VectorType& vecType = std::get<VectorType>(resolvedType);
+				StructFieldType fieldType = static_cast<StructFieldType>(Nz::UnderlyingCast(ToFieldType(vecType.type)) + vecType.componentCount - 1);
+				if (arraySize > 0)
+					fieldOffsets.AddFieldArray(fieldType, arraySize);
+				else
+					fieldOffsets.AddField(fieldType);
+			}
+			else if (IsMatrixType(resolvedType))
+			{
+				const MatrixType& matrixType = std::get<MatrixType>(resolvedType);
+				StructFieldType cellType = ToFieldType(matrixType.type);
+				unsigned int columnCount = Nz::SafeCast<unsigned int>(matrixType.columnCount);
+				unsigned int rowCount = Nz::SafeCast<unsigned int>(matrixType.rowCount);
+				if (arraySize > 0)
+					fieldOffsets.AddMatrixArray(cellType, columnCount, rowCount, true, arraySize);
+				else
+					fieldOffsets.AddMatrix(cellType, columnCount, rowCount, true);
+			}
+			else if (IsStructType(resolvedType))
+			{
+				const StructDescription& innerDesc = *retrieveStruct(std::get<StructType>(resolvedType).structIndex);
+				FieldOffsets innerOffsets = ComputeStructFieldOffsets(innerDesc, retrieveStruct, sourceLocation);
+				if (arraySize > 0)
+					fieldOffsets.AddStructArray(innerOffsets, arraySize);
+				else
+					fieldOffsets.AddStruct(innerOffsets);
+			}
+			else
+				throw AstInternalError{ sourceLocation, "unexpected type in struct" };
+		}
+
+		bool IsIntegerType(PrimitiveType primitiveType)
+		{
+			switch (primitiveType)
+			{
+				case PrimitiveType::Int16:
+				case PrimitiveType::Int32:
+				case PrimitiveType::UInt16:
+				case PrimitiveType::UInt32:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		// Precision qualifiers only apply to floating-point values and samplers
+		bool IsPrecisionQualifiable(const ExpressionType& exprType)
+		{
+			const ExpressionType& resolvedType = ResolveAlias(exprType);
+			if (IsPrimitiveType(resolvedType))
+				return std::get<PrimitiveType>(resolvedType) == PrimitiveType::Float32;
+			else if (IsVectorType(resolvedType))
+				return std::get<VectorType>(resolvedType).type == PrimitiveType::Float32;
+			else if (IsMatrixType(resolvedType))
+				return std::get<MatrixType>(resolvedType).type == PrimitiveType::Float32;
+			else if (IsArrayType(resolvedType))
+				return IsPrecisionQualifiable(std::get<ArrayType>(resolvedType).containedType->type);
+			else if (IsDynArrayType(resolvedType))
+				return IsPrecisionQualifiable(std::get<DynArrayType>(resolvedType).containedType->type);
+			else if (IsSamplerType(resolvedType))
+				return true;
+			else
+				return false;
+		}
+
+		// High precision wins over medium precision, operands without precision (constants) don't participate
+		void MergePrecision(std::optional<Precision>& precision, const Expression& operand)
+		{
+			if (operand.cachedPrecision && (!precision || *operand.cachedPrecision == Precision::High))
+				precision = operand.cachedPrecision;
+		}
+
+		std::optional<Precision> FilterPrecision(std::optional<Precision> precision, const std::optional<ExpressionType>& exprType)
+		{
+			if (!exprType || !IsPrecisionQualifiable(*exprType))
+				return std::nullopt;
+
+			return precision;
+		}
+
+		std::optional<Precision> GetMemberPrecision(const StructDescription::StructMember& member)
+		{
+			if (member.precision.IsResultingValue())
+				return member.precision.GetResultingValue();
+
+			return Precision::High;
+		}
 	}
 
 	template<typename T>
@@ -193,6 +666,7 @@ namespace nzsl::Ast
 		std::unordered_map<std::string, std::size_t> moduleByName;
 		std::unordered_map<std::uint64_t, UsedExternalData> usedBindingIndexes;
 		std::unordered_map<std::string, UsedExternalData> declaredExternalVar;
+		std::unordered_map<std::string, UsedExternalData> declaredPushConstants;
 		std::shared_ptr<Environment> globalEnv;
 		std::shared_ptr<Environment> currentEnv;
 		std::shared_ptr<Environment> moduleEnv;
@@ -204,6 +678,8 @@ namespace nzsl::Ast
 		IdentifierList<StructDescription*> structs;
 		IdentifierList<std::variant<ExpressionType, NamedPartialType>> types;
 		IdentifierList<ExpressionType> variableTypes;
+		std::unordered_map<std::size_t, Precision> variablePrecisions;
+		std::unordered_map<std::size_t, AccessPolicy> variableAccessPolicies;
 		ModulePtr currentModule;
 		Options options;
 		FunctionData* currentFunction = nullptr;
@@ -302,6 +778,8 @@ namespace nzsl::Ast
 
 	ExpressionPtr SanitizeVisitor::Clone(AccessIdentifierExpression& node)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		if (node.identifiers.empty())
 			throw AstNoIdentifierError{ node.sourceLocation };
 
@@ -337,7 +815,8 @@ namespace nzsl::Ast
 			// TODO: Add proper support for methods
 			if (IsSamplerType(resolvedType))
 			{
-				if (identifierEntry.identifier == "Sample")
+				auto methodIt = std::find_if(s_samplerMethods.begin(), s_samplerMethods.end(), [&](const auto& method) { return method.first == identifierEntry.identifier; });
+				if (methodIt != s_samplerMethods.end())
 				{
 					// TODO: Add a MethodExpression?
 					auto identifierExpr = std::make_unique<AccessIdentifierExpression>();
@@ -345,7 +824,27 @@ namespace nzsl::Ast
 					identifierExpr->identifiers.emplace_back().identifier = identifierEntry.identifier;
 
 					MethodType methodType;
-					methodType.methodIndex = 0; //< FIXME
+					methodType.methodIndex = std::distance(s_samplerMethods.begin(), methodIt);
+					methodType.objectType = std::make_unique<ContainedType>();
+					methodType.objectType->type = resolvedType;
+
+					identifierExpr->cachedExpressionType = std::move(methodType);
+					indexedExpr = std::move(identifierExpr);
+				}
+				else
+					throw CompilerUnknownMethodError{ identifierEntry.sourceLocation, ToString(resolvedType, indexedExpr->sourceLocation), identifierEntry.identifier };
+			}
+			else if (IsStorageImageType(resolvedType))
+			{
+				auto methodIt = std::find_if(s_storageImageMethods.begin(), s_storageImageMethods.end(), [&](const auto& method) { return method.first == identifierEntry.identifier; });
+				if (methodIt != s_storageImageMethods.end())
+				{
+					auto identifierExpr = std::make_unique<AccessIdentifierExpression>();
+					identifierExpr->expr = std::move(indexedExpr);
+					identifierExpr->identifiers.emplace_back().identifier = identifierEntry.identifier;
+
+					MethodType methodType;
+					methodType.methodIndex = std::distance(s_storageImageMethods.begin(), methodIt);
 					methodType.objectType = std::make_unique<ContainedType>();
 					methodType.objectType->type = resolvedType;
 
@@ -441,6 +940,7 @@ namespace nzsl::Ast
 					}
 
 					accessIdentifierPtr->cachedExpressionType = ResolveTypeExpr(fieldPtr->type, false, identifierEntry.sourceLocation);
+					accessIdentifierPtr->cachedPrecision = FilterPrecision(GetMemberPrecision(*fieldPtr), accessIdentifierPtr->cachedExpressionType);
 
 					auto& newIdentifierEntry = accessIdentifierPtr->identifiers.emplace_back();
 					newIdentifierEntry.identifier = fieldPtr->name;
@@ -454,6 +954,7 @@ namespace nzsl::Ast
 					accessIndex->expr = std::move(indexedExpr);
 					accessIndex->indices.push_back(ShaderBuilder::ConstantValue(fieldIndex));
 					accessIndex->cachedExpressionType = ResolveTypeExpr(fieldPtr->type, false, identifierEntry.sourceLocation);
+					accessIndex->cachedPrecision = FilterPrecision(GetMemberPrecision(*fieldPtr), accessIndex->cachedExpressionType);
 
 					indexedExpr = std::move(accessIndex);
 				}
@@ -523,7 +1024,31 @@ namespace nzsl::Ast
 		for (auto& index : node.indices)
 			MandatoryExpr(index, node.sourceLocation);
 
-		auto clone = Nz::StaticUniquePointerCast<AccessIndexExpression>(Cloner::Clone(node));
+		auto clone = std::make_unique<AccessIndexExpression>();
+		clone->expr = CloneExpression(node.expr);
+		clone->cachedExpressionType = node.cachedExpressionType;
+		clone->cachedPrecision = node.cachedPrecision;
+		clone->sourceLocation = node.sourceLocation;
+
+		// Image formats (ex: image2D[f32, rgba8]) are plain identifiers which must not be resolved
+		const PartialType* partialType = nullptr;
+		if (const ExpressionType* exprType = GetExpressionType(*clone->expr); exprType && IsTypeExpression(ResolveAlias(*exprType)))
+		{
+			const auto& type = m_context->types.Retrieve(std::get<Type>(ResolveAlias(*exprType)).typeIndex, node.sourceLocation);
+			if (std::holds_alternative<NamedPartialType>(type))
+				partialType = &std::get<NamedPartialType>(type).type;
+		}
+
+		clone->indices.reserve(node.indices.size());
+		for (std::size_t i = 0; i < node.indices.size(); ++i)
+		{
+			ExpressionPtr& index = node.indices[i];
+			if (partialType && i < partialType->parameters.size() && partialType->parameters[i] == TypeParameterCategory::ImageFormat && index->GetType() == NodeType::IdentifierExpression)
+				clone->indices.push_back(Cloner::Clone(static_cast<IdentifierExpression&>(*index)));
+			else
+				clone->indices.push_back(CloneExpression(index));
+		}
+
 		Validate(*clone);
 
 		// TODO: Handle AccessIndex on structs with m_context->options.useIdentifierAccessesForStructs
@@ -571,6 +1096,8 @@ namespace nzsl::Ast
 
 	ExpressionPtr SanitizeVisitor::Clone(CallFunctionExpression& node)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		ExpressionPtr targetExpr = CloneExpression(MandatoryExpr(node.targetFunction, node.sourceLocation));
 		const ExpressionType* targetExprType = GetExpressionType(*targetExpr);
 		if (!targetExprType)
@@ -668,10 +1195,21 @@ namespace nzsl::Ast
 			}
 			else if (IsSamplerType(objectType))
 			{
-				if (methodType.methodIndex != 0)
+				if (methodType.methodIndex >= s_samplerMethods.size())
+					throw AstInvalidMethodIndexError{ node.sourceLocation, methodType.methodIndex, ToString(objectType, node.sourceLocation) };
+
+				auto intrinsic = ShaderBuilder::Intrinsic(s_samplerMethods[methodType.methodIndex].second, std::move(parameters));
+				intrinsic->sourceLocation = node.sourceLocation;
+				Validate(*intrinsic);
+
+				return intrinsic;
+			}
+			else if (IsStorageImageType(objectType))
+			{
+				if (methodType.methodIndex >= s_storageImageMethods.size())
 					throw AstInvalidMethodIndexError{ node.sourceLocation, methodType.methodIndex, ToString(objectType, node.sourceLocation) };
 
-				auto intrinsic = ShaderBuilder::Intrinsic(IntrinsicType::SampleTexture, std::move(parameters));
+				auto intrinsic = ShaderBuilder::Intrinsic(s_storageImageMethods[methodType.methodIndex].second, std::move(parameters));
 				intrinsic->sourceLocation = node.sourceLocation;
 				Validate(*intrinsic);
 
@@ -1206,15 +1744,51 @@ namespace nzsl::Ast
 
 		for (auto& extVar : clone->externalVars)
 		{
-			if (!extVar.bindingIndex.HasValue())
-				throw CompilerExtMissingBindingIndexError{ extVar.sourceLocation };
+			bool isWorkgroupShared = false;
+			if (extVar.isWorkgroupShared.HasValue())
+			{
+				ComputeExprValue(extVar.isWorkgroupShared, node.sourceLocation);
+				if (extVar.isWorkgroupShared.IsResultingValue())
+					isWorkgroupShared = extVar.isWorkgroupShared.GetResultingValue();
+			}
 
-			if (extVar.bindingSet.HasValue())
-				ComputeExprValue(extVar.bindingSet, node.sourceLocation);
-			else if (defaultBlockSet)
-				extVar.bindingSet = *defaultBlockSet;
+			std::optional<ExpressionType> resolvedType = ResolveTypeExpr(extVar.type, false, node.sourceLocation);
+			bool isPushConstant = resolvedType.has_value() && IsPushConstantType(ResolveAlias(*resolvedType));
+
+			if (isWorkgroupShared)
+			{
+				// Workgroup-shared variables live in the workgroup memory, not in a descriptor set
+				if (extVar.bindingIndex.HasValue() || extVar.bindingSet.HasValue())
+					throw CompilerExtWorkgroupBindingError{ extVar.sourceLocation, extVar.name };
+			}
+			else if (isPushConstant)
+			{
+				// Push constants are set directly from the command buffer
+				if (extVar.bindingIndex.HasValue() || extVar.bindingSet.HasValue())
+					throw CompilerExtPushConstantBindingError{ extVar.sourceLocation, extVar.name };
+
+				// Only one push constant block is available per entry point
+				bool isConditional = m_context->inConditionalStatement;
+				for (auto&& [pushConstantName, pushConstantData] : m_context->declaredPushConstants)
+				{
+					if (!pushConstantData.isConditional || !isConditional)
+						throw CompilerExtPushConstantAlreadyDeclaredError{ extVar.sourceLocation, extVar.name, pushConstantName };
+				}
 
-			ComputeExprValue(extVar.bindingIndex, node.sourceLocation);
+				m_context->declaredPushConstants.emplace(extVar.name, Context::UsedExternalData{ isConditional });
+			}
+			else
+			{
+				if (!extVar.bindingIndex.HasValue())
+					throw CompilerExtMissingBindingIndexError{ extVar.sourceLocation };
+
+				if (extVar.bindingSet.HasValue())
+					ComputeExprValue(extVar.bindingSet, node.sourceLocation);
+				else if (defaultBlockSet)
+					extVar.bindingSet = *defaultBlockSet;
+
+				ComputeExprValue(extVar.bindingIndex, node.sourceLocation);
+			}
 
 			Context::UsedExternalData usedBindingData;
 			usedBindingData.isConditional = m_context->inConditionalStatement;
@@ -1242,7 +1816,6 @@ namespace nzsl::Ast
 
 			m_context->declaredExternalVar.emplace(extVar.name, usedBindingData);
 
-			std::optional<ExpressionType> resolvedType = ResolveTypeExpr(extVar.type, false, node.sourceLocation);
 			if (!resolvedType.has_value())
 			{
 				RegisterUnresolved(extVar.name);
@@ -1251,29 +1824,113 @@ namespace nzsl::Ast
 
 			const ExpressionType& targetType = ResolveAlias(*resolvedType);
 
-			ExpressionType varType;
-			if (IsStorageType(targetType))
-				varType = std::get<StorageType>(targetType).containedType;
-			else if (IsUniformType(targetType))
-				varType = std::get<UniformType>(targetType).containedType;
-			else if (IsSamplerType(targetType))
-				varType = targetType;
-			else if (IsSamplerType(targetType) || IsPrimitiveType(targetType) || IsVectorType(targetType) || IsMatrixType(targetType))
+			// Arrays of samplers, images and buffers (descriptor arrays) are bound as a single binding
+			const ExpressionType* descriptorType = &targetType;
+			if (!isWorkgroupShared && (IsArrayType(targetType) || IsDynArrayType(targetType)))
 			{
-				if (IsFeatureEnabled(ModuleFeature::PrimitiveExternals))
-					varType = targetType;
+				const ExpressionType& containedType = ResolveAlias((IsArrayType(targetType)) ? std::get<ArrayType>(targetType).containedType->type : std::get<DynArrayType>(targetType).containedType->type);
+				if (IsSamplerType(containedType) || IsStorageImageType(containedType) || IsStorageType(containedType) || IsUniformType(containedType))
+					descriptorType = &containedType;
 			}
-			
-			if (IsNoType(varType))
-				throw CompilerExtTypeNotAllowedError{ extVar.sourceLocation, extVar.name, ToString(*resolvedType, extVar.sourceLocation) };
 
-			ValidateConcreteType(varType, extVar.sourceLocation);
+			ExpressionType varType;
+			if (isWorkgroupShared)
+			{
+				if (IsPushConstantType(targetType) || IsStorageType(targetType) || IsUniformType(targetType) || IsSamplerType(targetType) || IsStorageImageType(targetType))
+					throw CompilerExtWorkgroupTypeNotAllowedError{ extVar.sourceLocation, extVar.name, ToString(*resolvedType, extVar.sourceLocation) };
 
-			extVar.type = std::move(resolvedType).value();
-			extVar.varIndex = RegisterVariable(extVar.name, std::move(varType), extVar.varIndex, extVar.sourceLocation);
-		}
+				varType = targetType;
+			}
+			else if (IsPushConstantType(targetType))
+			{
+				const StructType& structType = std::get<PushConstantType>(targetType).containedType;
 
-		return clone;
+				if (!m_context->options.allowPartialSanitization)
+				{
+					auto RetrieveStruct = [&](std::size_t structIndex) { return m_context->structs.Retrieve(structIndex, extVar.sourceLocation); };
+
+					const StructDescription* desc = RetrieveStruct(structType.structIndex);
+					std::size_t blockSize = ComputeStructFieldOffsets(*desc, RetrieveStruct, extVar.sourceLocation).GetAlignedSize();
+					if (blockSize > m_context->options.maxPushConstantSize)
+						throw CompilerExtPushConstantTooLargeError{ extVar.sourceLocation, extVar.name, Nz::SafeCast<std::uint32_t>(blockSize), m_context->options.maxPushConstantSize };
+				}
+
+				varType = structType;
+			}
+			else if (IsStorageType(*descriptorType))
+				varType = std::get<StorageType>(*descriptorType).containedType;
+			else if (IsUniformType(*descriptorType))
+			{
+				const StructType& structType = std::get<UniformType>(*descriptorType).containedType;
+
+				// std430 is only defined for storage buffers
+				const StructDescription* desc = m_context->structs.Retrieve(structType.structIndex, extVar.sourceLocation);
+				if (desc->layout.IsResultingValue() && desc->layout.GetResultingValue() == StructLayout::Std430)
+					throw CompilerExtUniformLayoutNotAllowedError{ extVar.sourceLocation, extVar.name, std::string(GetLayoutName(StructLayout::Std430)) };
+
+				varType = structType;
+			}
+			else if (IsSamplerType(*descriptorType) || IsStorageImageType(*descriptorType))
+				varType = *descriptorType;
+			else if (IsSamplerType(targetType) || IsPrimitiveType(targetType) || IsVectorType(targetType) || IsMatrixType(targetType))
+			{
+				if (IsFeatureEnabled(ModuleFeature::PrimitiveExternals))
+					varType = targetType;
+			}
+			
+			if (IsNoType(varType))
+				throw CompilerExtTypeNotAllowedError{ extVar.sourceLocation, extVar.name, ToString(*resolvedType, extVar.sourceLocation) };
+
+			if (descriptorType != &targetType)
+			{
+				if (IsArrayType(targetType))
+				{
+					ArrayType arrayType;
+					arrayType.containedType = std::make_unique<ContainedType>();
+					arrayType.containedType->type = std::move(varType);
+					arrayType.length = std::get<ArrayType>(targetType).length;
+
+					varType = std::move(arrayType);
+				}
+				else
+				{
+					DynArrayType arrayType;
+					arrayType.containedType = std::make_unique<ContainedType>();
+					arrayType.containedType->type = std::move(varType);
+
+					varType = std::move(arrayType);
+				}
+			}
+
+			ValidateConcreteType(varType, extVar.sourceLocation);
+
+			if (extVar.accessPolicy.HasValue() || extVar.isRestrict.HasValue())
+			{
+				if (!IsStorageType(*descriptorType) && !IsStorageImageType(*descriptorType))
+					throw CompilerExtAccessNotAllowedError{ extVar.sourceLocation, extVar.name, ToString(*resolvedType, extVar.sourceLocation) };
+
+				if (extVar.accessPolicy.HasValue())
+					ComputeExprValue(extVar.accessPolicy, extVar.sourceLocation);
+
+				if (extVar.isRestrict.HasValue())
+					ComputeExprValue(extVar.isRestrict, extVar.sourceLocation);
+			}
+
+			if (extVar.precision.HasValue())
+			{
+				ComputeExprValue(extVar.precision, extVar.sourceLocation);
+				ValidatePrecision(extVar.precision, varType, extVar.sourceLocation);
+			}
+
+			extVar.type = std::move(resolvedType).value();
+			extVar.varIndex = RegisterVariable(extVar.name, varType, extVar.varIndex, extVar.sourceLocation);
+			RegisterVariablePrecision(*extVar.varIndex, varType, extVar.precision);
+
+			if (extVar.accessPolicy.IsResultingValue() && extVar.accessPolicy.GetResultingValue() != AccessPolicy::ReadWrite)
+				m_context->variableAccessPolicies[*extVar.varIndex] = extVar.accessPolicy.GetResultingValue();
+		}
+
+		return clone;
 	}
 
 	StatementPtr SanitizeVisitor::Clone(DeclareFunctionStatement& node)
@@ -1294,8 +1951,25 @@ namespace nzsl::Ast
 			cloneParam.varIndex = parameter.varIndex;
 			cloneParam.sourceLocation = parameter.sourceLocation;
 
+			if (parameter.precision.HasValue())
+				ComputeExprValue(parameter.precision, cloneParam.precision, cloneParam.sourceLocation);
+
 			if (cloneParam.type.IsResultingValue())
+			{
 				ValidateConcreteType(cloneParam.type.GetResultingValue(), cloneParam.sourceLocation);
+				ValidatePrecision(cloneParam.precision, cloneParam.type.GetResultingValue(), cloneParam.sourceLocation);
+
+				// Access policies are tracked on external variables, storage images can't be passed around
+				const ExpressionType& paramType = ResolveAlias(cloneParam.type.GetResultingValue());
+				const ExpressionType* innerType = &paramType;
+				if (IsArrayType(paramType))
+					innerType = &ResolveAlias(std::get<ArrayType>(paramType).containedType->type);
+				else if (IsDynArrayType(paramType))
+					innerType = &ResolveAlias(std::get<DynArrayType>(paramType).containedType->type);
+
+				if (IsStorageImageType(*innerType))
+					throw CompilerFunctionParameterStorageImageError{ cloneParam.sourceLocation, cloneParam.name, ToString(cloneParam.type.GetResultingValue(), cloneParam.sourceLocation) };
+			}
 		}
 
 		if (node.returnType.HasValue())
@@ -1320,6 +1994,18 @@ namespace nzsl::Ast
 		if (node.isExported.HasValue())
 			ComputeExprValue(node.isExported, clone->isExported, node.sourceLocation);
 
+		for (std::size_t i = 0; i < node.workgroupSize.size(); ++i)
+		{
+			if (!node.workgroupSize[i].HasValue())
+				continue;
+
+			if (ComputeExprValue(node.workgroupSize[i], clone->workgroupSize[i], node.sourceLocation) == ValidationResult::Validated)
+			{
+				if (clone->workgroupSize[i].GetResultingValue() == 0)
+					throw CompilerWorkgroupSizeZeroError{ node.sourceLocation };
+			}
+		}
+
 		if (clone->entryStage.IsResultingValue())
 		{
 			ShaderStageType stageType = clone->entryStage.GetResultingValue();
@@ -1354,7 +2040,17 @@ namespace nzsl::Ast
 				if (node.earlyFragmentTests.HasValue())
 					throw CompilerEarlyFragmentTestsAttributeError{ node.sourceLocation };
 			}
+
+			if (stageType == ShaderStageType::Compute)
+			{
+				if (!node.workgroupSize[0].HasValue())
+					throw CompilerWorkgroupSizeMissingError{ node.sourceLocation };
+			}
+			else if (node.workgroupSize[0].HasValue())
+				throw CompilerWorkgroupAttributeError{ node.sourceLocation };
 		}
+		else if (!node.entryStage.HasValue() && node.workgroupSize[0].HasValue())
+			throw CompilerWorkgroupAttributeError{ node.sourceLocation };
 
 		// Function content is resolved in a second pass
 		auto& pendingFunc = m_context->currentEnv->pendingFunctions.emplace_back();
@@ -1465,6 +2161,9 @@ namespace nzsl::Ast
 			if (member.locationIndex.HasValue())
 				ComputeExprValue(member.locationIndex, member.sourceLocation);
 
+			if (member.precision.HasValue())
+				ComputeExprValue(member.precision, member.sourceLocation);
+
 			if (member.builtin.HasValue() && member.locationIndex.HasValue())
 				throw CompilerStructFieldBuiltinLocationError{ member.sourceLocation };
 
@@ -1483,22 +2182,27 @@ namespace nzsl::Ast
 			}
 
 			const ExpressionType& memberType = member.type.GetResultingValue();
-			if (clone->description.layout.IsResultingValue() && clone->description.layout.GetResultingValue() == StructLayout::Std140)
+			if (clone->description.layout.IsResultingValue() && clone->description.layout.GetResultingValue() != StructLayout::Packed)
 			{
+				StructLayout structLayout = clone->description.layout.GetResultingValue();
 				const ExpressionType& targetType = ResolveAlias(member.type.GetResultingValue());
 
 				if (IsPrimitiveType(targetType) && std::get<PrimitiveType>(targetType) == PrimitiveType::Boolean)
-					throw CompilerStructLayoutTypeNotAllowedError{ member.sourceLocation, "bool", "std140" };
+					throw CompilerStructLayoutTypeNotAllowedError{ member.sourceLocation, "bool", std::string(GetLayoutName(structLayout)) };
 				else if (IsStructType(targetType))
 				{
 					std::size_t structIndex = std::get<StructType>(targetType).structIndex;
 					const StructDescription* desc = m_context->structs.Retrieve(structIndex, member.sourceLocation);
-					if (!desc->layout.HasValue() || desc->layout.GetResultingValue() != clone->description.layout.GetResultingValue())
-						throw CompilerStructLayoutInnerMismatchError{ member.sourceLocation, "std140", "<TODO>" };
+					if (!desc->layout.HasValue())
+						throw CompilerStructLayoutInnerMismatchError{ member.sourceLocation, std::string(GetLayoutName(structLayout)), "<none>" };
+
+					if (desc->layout.GetResultingValue() != structLayout)
+						throw CompilerStructLayoutInnerMismatchError{ member.sourceLocation, std::string(GetLayoutName(structLayout)), std::string(GetLayoutName(desc->layout.GetResultingValue())) };
 				}
 			}
 
 			ValidateConcreteType(memberType, member.sourceLocation);
+			ValidatePrecision(member.precision, memberType, member.sourceLocation);
 
 			if (member.builtin.IsResultingValue())
 			{
@@ -1507,6 +2211,9 @@ namespace nzsl::Ast
 				if (it == Ast::s_builtinData.end())
 					throw AstInternalError{ member.sourceLocation, "missing builtin data" };
 
+				if ((builtin == BuiltinEntry::SubgroupLocalInvocationId || builtin == BuiltinEntry::SubgroupSize) && !IsFeatureEnabled(ModuleFeature::Subgroups))
+					throw CompilerFeatureRequiredError{ member.sourceLocation, ModuleFeature::Subgroups };
+
 				const Ast::BuiltinData& builtinData = it->second;
 				std::visit([&](auto&& arg)
 				{
@@ -1927,6 +2634,7 @@ namespace nzsl::Ast
 			PushScope();
 			{
 				clone->varIndex = RegisterVariable(node.varName, innerType, node.varIndex, node.sourceLocation);
+				RegisterVariablePrecision(*clone->varIndex, innerType, clone->expression->cachedPrecision);
 
 				bool wasInLoop = m_context->inLoop;
 				m_context->inLoop = true;
@@ -2361,6 +3069,15 @@ namespace nzsl::Ast
 		return *expressionType;
 	}
 
+	std::optional<Precision> SanitizeVisitor::GetVariablePrecision(std::size_t varIndex) const
+	{
+		auto it = m_context->variablePrecisions.find(varIndex);
+		if (it == m_context->variablePrecisions.end())
+			return std::nullopt;
+
+		return it->second;
+	}
+
 	ExpressionPtr SanitizeVisitor::HandleIdentifier(const IdentifierData* identifierData, const SourceLocation& sourceLocation)
 	{
 		switch (identifierData->category)
@@ -2443,6 +3160,7 @@ namespace nzsl::Ast
 				// Replace IdentifierExpression by VariableExpression
 				auto varExpr = std::make_unique<VariableValueExpression>();
 				varExpr->cachedExpressionType = m_context->variableTypes.Retrieve(identifierData->index, sourceLocation);
+				varExpr->cachedPrecision = GetVariablePrecision(identifierData->index);
 				varExpr->sourceLocation = sourceLocation;
 				varExpr->variableId = identifierData->index;
 
@@ -2661,8 +3379,11 @@ namespace nzsl::Ast
 	{
 		// Primitive types
 		RegisterType("bool", PrimitiveType::Boolean, std::nullopt, {});
+		RegisterType("f16", PrimitiveType::Float16, std::nullopt, {});
 		RegisterType("f32", PrimitiveType::Float32, std::nullopt, {});
+		RegisterType("i16", PrimitiveType::Int16, std::nullopt, {});
 		RegisterType("i32", PrimitiveType::Int32, std::nullopt, {});
+		RegisterType("u16", PrimitiveType::UInt16, std::nullopt, {});
 		RegisterType("u32", PrimitiveType::UInt32, std::nullopt, {});
 
 		// Partial types
@@ -2824,6 +3545,54 @@ namespace nzsl::Ast
 			}, std::nullopt, {});
 		}
 
+		// storage images
+		struct StorageImageInfo
+		{
+			std::string typeName;
+			ImageType imageType;
+		};
+
+		std::array<StorageImageInfo, 2> storageImageInfos = {
+			{
+				{
+					"image2D",
+					ImageType::E2D
+				},
+				{
+					"image3D",
+					ImageType::E3D
+				}
+			}
+		};
+
+		for (StorageImageInfo& storageImage : storageImageInfos)
+		{
+			RegisterType(std::move(storageImage.typeName), PartialType {
+				{ TypeParameterCategory::PrimitiveType, TypeParameterCategory::ImageFormat }, {},
+				[=](const TypeParameter* parameters, [[maybe_unused]] std::size_t parameterCount, const SourceLocation& sourceLocation) -> ExpressionType
+				{
+					assert(parameterCount == 2);
+					assert(std::holds_alternative<ExpressionType>(parameters[0]));
+					assert(std::holds_alternative<ImageFormat>(parameters[1]));
+
+					const ExpressionType& exprType = std::get<ExpressionType>(parameters[0]);
+					assert(IsPrimitiveType(exprType));
+
+					PrimitiveType primitiveType = std::get<PrimitiveType>(exprType);
+					ImageFormat format = std::get<ImageFormat>(parameters[1]);
+
+					StorageImageType imageType {
+						storageImage.imageType, format, primitiveType
+					};
+
+					if (primitiveType != GetImageFormatSampledType(format))
+						throw CompilerStorageImageFormatTypeError{ sourceLocation, ToString(ExpressionType{ imageType }, sourceLocation), ToString(exprType, sourceLocation) };
+
+					return imageType;
+				}
+			}, std::nullopt, {});
+		}
+
 		// storage
 		RegisterType("storage", PartialType {
 			{ TypeParameterCategory::StructType }, {},
@@ -2842,6 +3611,24 @@ namespace nzsl::Ast
 			}
 		}, std::nullopt, {});
 		
+		// push_constant
+		RegisterType("push_constant", PartialType {
+			{ TypeParameterCategory::StructType }, {},
+			[=](const TypeParameter* parameters, [[maybe_unused]] std::size_t parameterCount, const SourceLocation& /*sourceLocation*/) -> ExpressionType
+			{
+				assert(parameterCount == 1);
+				assert(std::holds_alternative<ExpressionType>(*parameters));
+
+				const ExpressionType& exprType = std::get<ExpressionType>(*parameters);
+				assert(IsStructType(exprType));
+
+				StructType structType = std::get<StructType>(exprType);
+				return PushConstantType {
+					structType
+				};
+			}
+		}, std::nullopt, {});
+
 		// uniform
 		RegisterType("uniform", PartialType {
 			{ TypeParameterCategory::StructType }, {},
@@ -2861,17 +3648,47 @@ namespace nzsl::Ast
 		}, std::nullopt, {});
 
 		// Intrinsics
+		RegisterIntrinsic("atomic_add", IntrinsicType::AtomicAdd);
+		RegisterIntrinsic("atomic_and", IntrinsicType::AtomicAnd);
+		RegisterIntrinsic("atomic_compare_exchange", IntrinsicType::AtomicCompareExchange);
+		RegisterIntrinsic("atomic_exchange", IntrinsicType::AtomicExchange);
+		RegisterIntrinsic("atomic_max", IntrinsicType::AtomicMax);
+		RegisterIntrinsic("atomic_min", IntrinsicType::AtomicMin);
+		RegisterIntrinsic("atomic_or", IntrinsicType::AtomicOr);
+		RegisterIntrinsic("atomic_xor", IntrinsicType::AtomicXor);
+		RegisterIntrinsic("barrier", IntrinsicType::Barrier);
+		RegisterIntrinsic("bitfield_extract", IntrinsicType::BitFieldExtract);
+		RegisterIntrinsic("bitfield_insert", IntrinsicType::BitFieldInsert);
+		RegisterIntrinsic("count_bits", IntrinsicType::BitCount);
 		RegisterIntrinsic("cross", IntrinsicType::CrossProduct);
 		RegisterIntrinsic("dot", IntrinsicType::DotProduct);
 		RegisterIntrinsic("exp", IntrinsicType::Exp);
+		RegisterIntrinsic("first_bit_high", IntrinsicType::FirstBitHigh);
+		RegisterIntrinsic("first_bit_low", IntrinsicType::FirstBitLow);
 		RegisterIntrinsic("inverse", IntrinsicType::Inverse);
 		RegisterIntrinsic("length", IntrinsicType::Length);
 		RegisterIntrinsic("max", IntrinsicType::Max);
+		RegisterIntrinsic("memory_barrier", IntrinsicType::MemoryBarrier);
+		RegisterIntrinsic("memory_barrier_buffer", IntrinsicType::MemoryBarrierBuffer);
+		RegisterIntrinsic("memory_barrier_image", IntrinsicType::MemoryBarrierImage);
+		RegisterIntrinsic("memory_barrier_shared", IntrinsicType::MemoryBarrierShared);
 		RegisterIntrinsic("min", IntrinsicType::Min);
+		RegisterIntrinsic("non_uniform", IntrinsicType::NonUniform);
 		RegisterIntrinsic("normalize", IntrinsicType::Normalize);
+		RegisterIntrinsic("pack_half2x16", IntrinsicType::PackHalf2x16);
+		RegisterIntrinsic("pack_unorm4x8", IntrinsicType::PackUnorm4x8);
 		RegisterIntrinsic("pow", IntrinsicType::Pow);
 		RegisterIntrinsic("reflect", IntrinsicType::Reflect);
+		RegisterIntrinsic("subgroup_add", IntrinsicType::SubgroupAdd);
+		RegisterIntrinsic("subgroup_ballot", IntrinsicType::SubgroupBallot);
+		RegisterIntrinsic("subgroup_broadcast_first", IntrinsicType::SubgroupBroadcastFirst);
+		RegisterIntrinsic("subgroup_elect", IntrinsicType::SubgroupElect);
+		RegisterIntrinsic("subgroup_max", IntrinsicType::SubgroupMax);
+		RegisterIntrinsic("subgroup_min", IntrinsicType::SubgroupMin);
+		RegisterIntrinsic("subgroup_shuffle", IntrinsicType::SubgroupShuffle);
 		RegisterIntrinsic("transpose", IntrinsicType::Transpose);
+		RegisterIntrinsic("unpack_half2x16", IntrinsicType::UnpackHalf2x16);
+		RegisterIntrinsic("unpack_unorm4x8", IntrinsicType::UnpackUnorm4x8);
 	}
 
 	std::size_t SanitizeVisitor::RegisterAlias(std::string name, std::optional<Identifier> aliasData, std::optional<std::size_t> index, const SourceLocation& sourceLocation)
@@ -3185,6 +4002,22 @@ namespace nzsl::Ast
 		return varIndex;
 	}
 
+	void SanitizeVisitor::RegisterVariablePrecision(std::size_t varIndex, const ExpressionType& varType, const ExpressionValue<Precision>& precision)
+	{
+		RegisterVariablePrecision(varIndex, varType, (precision.IsResultingValue()) ? std::optional<Precision>(precision.GetResultingValue()) : std::nullopt);
+	}
+
+	void SanitizeVisitor::RegisterVariablePrecision(std::size_t varIndex, const ExpressionType& varType, std::optional<Precision> precision)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Variables without explicit precision are high precision (if their type can have one)
+		if (IsPrecisionQualifiable(varType))
+			m_context->variablePrecisions[varIndex] = precision.value_or(Precision::High);
+		else
+			m_context->variablePrecisions.erase(varIndex);
+	}
+
 	auto SanitizeVisitor::ResolveAliasIdentifier(const Identifier* identifier, const SourceLocation& sourceLocation) const -> const Identifier*
 	{
 		while (identifier->target.category == IdentifierCategory::Alias)
@@ -3203,7 +4036,10 @@ namespace nzsl::Ast
 			for (auto& parameter : pendingFunc.cloneNode->parameters)
 			{
 				if (!m_context->options.allowPartialSanitization || parameter.type.IsResultingValue())
+				{
 					parameter.varIndex = RegisterVariable(parameter.name, parameter.type.GetResultingValue(), parameter.varIndex, parameter.sourceLocation);
+					RegisterVariablePrecision(*parameter.varIndex, parameter.type.GetResultingValue(), parameter.precision);
+				}
 				else
 					RegisterUnresolved(parameter.name);
 			}
@@ -3284,7 +4120,7 @@ namespace nzsl::Ast
 		{
 			using T = std::decay_t<decltype(arg)>;
 
-			if constexpr (std::is_same_v<T, StorageType> || std::is_same_v<T, StructType> || std::is_same_v<T, UniformType> || std::is_same_v<T, AliasType>)
+			if constexpr (std::is_same_v<T, PushConstantType> || std::is_same_v<T, StorageType> || std::is_same_v<T, StructType> || std::is_same_v<T, UniformType> || std::is_same_v<T, AliasType>)
 				return ResolveStruct(arg, sourceLocation);
 			else if constexpr (std::is_same_v<T, NoType> ||
 			                   std::is_same_v<T, ArrayType> ||
@@ -3295,6 +4131,7 @@ namespace nzsl::Ast
 			                   std::is_same_v<T, MatrixType> ||
 			                   std::is_same_v<T, MethodType> ||
 			                   std::is_same_v<T, SamplerType> ||
+			                   std::is_same_v<T, StorageImageType> ||
 			                   std::is_same_v<T, Type> ||
 			                   std::is_same_v<T, VectorType>)
 			{
@@ -3305,6 +4142,11 @@ namespace nzsl::Ast
 		}, exprType);
 	}
 
+	std::size_t SanitizeVisitor::ResolveStruct(const PushConstantType& pushConstantType, const SourceLocation& /*sourceLocation*/)
+	{
+		return pushConstantType.containedType.structIndex;
+	}
+
 	std::size_t SanitizeVisitor::ResolveStruct(const StorageType& structType, const SourceLocation& /*sourceLocation*/)
 	{
 		return structType.containedType.structIndex;;
@@ -3361,6 +4203,8 @@ namespace nzsl::Ast
 
 	MultiStatementPtr SanitizeVisitor::SanitizeInternal(MultiStatement& rootNode, std::string* error)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		MultiStatementPtr output;
 		{
 			// First pass, evaluate everything except function code
@@ -3368,6 +4212,9 @@ namespace nzsl::Ast
 			{
 				output = Nz::StaticUniquePointerCast<MultiStatement>(Cloner::Clone(rootNode));
 				ResolveFunctions();
+
+				StorageAccessValidator accessValidator(m_context->variableAccessPolicies);
+				output->Visit(accessValidator);
 			}
 			catch (const std::runtime_error& err)
 			{
@@ -3486,6 +4333,8 @@ namespace nzsl::Ast
 
 	auto SanitizeVisitor::Validate(AccessIndexExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const ExpressionType* exprType = GetExpressionType(MandatoryExpr(node.expr, node.sourceLocation));
 		if (!exprType)
 			return ValidationResult::Unresolved;
@@ -3529,6 +4378,21 @@ namespace nzsl::Ast
 						break;
 					}
 
+					case TypeParameterCategory::ImageFormat:
+					{
+						if (indexExpr->GetType() != NodeType::IdentifierExpression)
+							throw CompilerPartialTypeExpectError{ indexExpr->sourceLocation, "image format", Nz::SafeCast<std::uint32_t>(i) };
+
+						const std::string& formatName = static_cast<IdentifierExpression&>(*indexExpr).identifier;
+
+						auto it = s_imageFormats.find(std::string_view(formatName));
+						if (it == s_imageFormats.end())
+							throw CompilerStorageImageUnknownFormatError{ indexExpr->sourceLocation, formatName };
+
+						parameters.push_back(it->second);
+						break;
+					}
+
 					case TypeParameterCategory::FullType:
 					case TypeParameterCategory::PrimitiveType:
 					case TypeParameterCategory::StructType:
@@ -3575,6 +4439,7 @@ namespace nzsl::Ast
 			if (node.indices.size() != 1)
 				throw AstNoIndexError{ node.sourceLocation };
 
+			std::optional<Precision> precision = node.expr->cachedPrecision;
 			for (const auto& indexExpr : node.indices)
 			{
 				const ExpressionType* indexType = GetExpressionType(*indexExpr);
@@ -3617,6 +4482,7 @@ namespace nzsl::Ast
 						return ValidationResult::Unresolved;
 
 					resolvedExprType = std::move(resolvedExprTypeOpt).value();
+					precision = GetMemberPrecision(s->members[index]);
 				}
 				else if (IsMatrixType(resolvedExprType))
 				{
@@ -3638,6 +4504,7 @@ namespace nzsl::Ast
 			}
 
 			node.cachedExpressionType = std::move(resolvedExprType);
+			node.cachedPrecision = FilterPrecision(precision, node.cachedExpressionType);
 		}
 
 		return ValidationResult::Validated;
@@ -3666,11 +4533,16 @@ namespace nzsl::Ast
 				break;
 
 			case AssignType::CompoundAdd:        binaryType = BinaryType::Add; break;
+			case AssignType::CompoundBitwiseAnd: binaryType = BinaryType::BitwiseAnd; break;
+			case AssignType::CompoundBitwiseOr:  binaryType = BinaryType::BitwiseOr; break;
+			case AssignType::CompoundBitwiseXor: binaryType = BinaryType::BitwiseXor; break;
 			case AssignType::CompoundDivide:     binaryType = BinaryType::Divide; break;
 			case AssignType::CompoundModulo:     binaryType = BinaryType::Modulo; break;
 			case AssignType::CompoundMultiply:   binaryType = BinaryType::Multiply; break;
 			case AssignType::CompoundLogicalAnd: binaryType = BinaryType::LogicalAnd; break;
 			case AssignType::CompoundLogicalOr:  binaryType = BinaryType::LogicalOr; break;
+			case AssignType::CompoundShiftLeft:  binaryType = BinaryType::ShiftLeft; break;
+			case AssignType::CompoundShiftRight: binaryType = BinaryType::ShiftRight; break;
 			case AssignType::CompoundSubtract:   binaryType = BinaryType::Subtract; break;
 		}
 
@@ -3688,11 +4560,14 @@ namespace nzsl::Ast
 		}
 
 		node.cachedExpressionType = *leftExprType;
+		node.cachedPrecision = node.left->cachedPrecision;
 		return ValidationResult::Validated;
 	}
 
 	auto SanitizeVisitor::Validate(BinaryExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const ExpressionType* leftExprType = GetExpressionType(MandatoryExpr(node.left, node.sourceLocation));
 		if (!leftExprType)
 			return ValidationResult::Unresolved;
@@ -3702,11 +4577,19 @@ namespace nzsl::Ast
 			return ValidationResult::Unresolved;
 
 		node.cachedExpressionType = ValidateBinaryOp(node.op, ResolveAlias(*leftExprType), ResolveAlias(*rightExprType), node.sourceLocation);
+
+		std::optional<Precision> precision;
+		MergePrecision(precision, *node.left);
+		MergePrecision(precision, *node.right);
+		node.cachedPrecision = FilterPrecision(precision, node.cachedExpressionType);
+
 		return ValidationResult::Validated;
 	}
 
 	auto SanitizeVisitor::Validate(CallFunctionExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		std::size_t targetFuncIndex;
 		if (node.targetFunction->GetType() == NodeType::FunctionExpression)
 			targetFuncIndex = static_cast<FunctionExpression&>(*node.targetFunction).funcId;
@@ -3744,11 +4627,14 @@ namespace nzsl::Ast
 			throw CompilerFunctionCallUnmatchingParameterCountError{ node.sourceLocation, referenceDeclaration->name, Nz::SafeCast<std::uint32_t>(referenceDeclaration->parameters.size()), Nz::SafeCast<std::uint32_t>(node.parameters.size()) };
 
 		node.cachedExpressionType = referenceDeclaration->returnType.GetResultingValue();
+		node.cachedPrecision = FilterPrecision(Precision::High, node.cachedExpressionType);
 		return ValidationResult::Validated;
 	}
 
 	auto SanitizeVisitor::Validate(CastExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		std::optional<ExpressionType> targetTypeOpt = ResolveTypeExpr(node.targetType, false, node.sourceLocation);
 		if (!targetTypeOpt)
 			return ValidationResult::Unresolved;
@@ -3759,6 +4645,81 @@ namespace nzsl::Ast
 
 		std::size_t expressionCount = node.expressions.size();
 
+		auto ArePrimitiveTypesCompatible = [&](PrimitiveType fromPrimitiveType, PrimitiveType targetPrimitiveType)
+		{
+			switch (targetPrimitiveType)
+			{
+				case PrimitiveType::Boolean:
+				case PrimitiveType::String:
+					return false;
+
+				case PrimitiveType::Float16:
+				case PrimitiveType::Float32:
+				{
+					switch (fromPrimitiveType)
+					{
+						case PrimitiveType::Boolean:
+						case PrimitiveType::String:
+							return false;
+
+						case PrimitiveType::Float16:
+						case PrimitiveType::Float32:
+						case PrimitiveType::Int16:
+						case PrimitiveType::Int32:
+						case PrimitiveType::UInt16:
+						case PrimitiveType::UInt32:
+							return true;
+					}
+
+					break;
+				}
+
+				case PrimitiveType::Int16:
+				case PrimitiveType::Int32:
+				{
+					switch (fromPrimitiveType)
+					{
+						case PrimitiveType::Boolean:
+						case PrimitiveType::String:
+						case PrimitiveType::UInt16:
+						case PrimitiveType::UInt32:
+							return false;
+
+						case PrimitiveType::Float16:
+						case PrimitiveType::Float32:
+						case PrimitiveType::Int16:
+						case PrimitiveType::Int32:
+							return true;
+					}
+
+					break;
+				}
+
+				case PrimitiveType::UInt16:
+				case PrimitiveType::UInt32:
+				{
+					switch (fromPrimitiveType)
+					{
+						case PrimitiveType::Boolean:
+						case PrimitiveType::String:
+							return false;
+
+						case PrimitiveType::Float16:
+						case PrimitiveType::Float32:
+						case PrimitiveType::Int16:
+						case PrimitiveType::Int32:
+						case PrimitiveType::UInt16:
+						case PrimitiveType::UInt32:
+							return true;
+					}
+
+					break;
+				}
+			}
+
+			throw AstInternalError{ node.sourceLocation, "unexpected cast from " + Ast::ToString(fromPrimitiveType) + " to " + Ast::ToString(targetPrimitiveType) };
+		};
+
 		if (IsMatrixType(targetType))
 		{
 			const MatrixType& targetMatrixType = std::get<MatrixType>(targetType);
@@ -3773,7 +4734,10 @@ namespace nzsl::Ast
 				if (expressionCount != 1)
 					throw CompilerCastComponentMismatchError{ node.sourceLocation, Nz::SafeCast<std::uint32_t>(expressionCount), 1 };
 
-				// Matrix to matrix cast: always valid
+				// Matrix to matrix cast: always valid as long as base types match
+				PrimitiveType fromBaseType = std::get<MatrixType>(resolvedFirstExprType).type;
+				if (fromBaseType != targetMatrixType.type)
+					throw CompilerCastIncompatibleBaseTypesError{ firstExprPtr.sourceLocation, ToString(targetMatrixType.type, node.sourceLocation), ToString(fromBaseType, firstExprPtr.sourceLocation) };
 			}
 			else if (IsVectorType(resolvedFirstExprType))
 			{
@@ -3847,70 +4811,7 @@ namespace nzsl::Ast
 			PrimitiveType fromPrimitiveType = std::get<PrimitiveType>(resolvedFromType);
 			PrimitiveType targetPrimitiveType = std::get<PrimitiveType>(targetType);
 
-			bool areTypeCompatibles = [&]
-			{
-				switch (targetPrimitiveType)
-				{
-					case PrimitiveType::Boolean:
-					case PrimitiveType::String:
-						return false;
-
-					case PrimitiveType::Float32:
-					{
-						switch (fromPrimitiveType)
-						{
-							case PrimitiveType::Boolean:
-							case PrimitiveType::String:
-								return false;
-
-							case PrimitiveType::Float32:
-							case PrimitiveType::Int32:
-							case PrimitiveType::UInt32:
-								return true;
-						}
-
-						break;
-					}
-
-					case PrimitiveType::Int32:
-					{
-						switch (fromPrimitiveType)
-						{
-							case PrimitiveType::Boolean:
-							case PrimitiveType::String:
-							case PrimitiveType::UInt32:
-								return false;
-
-							case PrimitiveType::Float32:
-							case PrimitiveType::Int32:
-								return true;
-						}
-
-						break;
-					}
-
-					case PrimitiveType::UInt32:
-					{
-						switch (fromPrimitiveType)
-						{
-							case PrimitiveType::Boolean:
-							case PrimitiveType::String:
-								return false;
-
-							case PrimitiveType::Float32:
-							case PrimitiveType::Int32:
-							case PrimitiveType::UInt32:
-								return true;
-						}
-
-						break;
-					}
-				}
-
-				throw AstInternalError{ node.sourceLocation, "unexpected cast from " + Ast::ToString(fromPrimitiveType) + " to " + Ast::ToString(targetPrimitiveType) };
-			}();
-
-			if (!areTypeCompatibles)
+			if (!ArePrimitiveTypesCompatible(fromPrimitiveType, targetPrimitiveType))
 				throw CompilerCastIncompatibleTypesError{ node.expressions[0]->sourceLocation, ToString(targetType, node.sourceLocation), ToString(resolvedFromType, node.sourceLocation) };
 		}
 		else if (IsVectorType(targetType))
@@ -3946,8 +4847,9 @@ namespace nzsl::Ast
 				}
 				else if (IsVectorType(resolvedExprType))
 				{
+					// A single vector can be converted component-wise to another base type (vec4[f32](vec4[f16]))
 					PrimitiveType primitiveType = std::get<VectorType>(resolvedExprType).type;
-					if (primitiveType != targetBaseType)
+					if (primitiveType != targetBaseType && (expressionCount != 1 || !ArePrimitiveTypesCompatible(primitiveType, targetBaseType)))
 						throw CompilerCastIncompatibleBaseTypesError{ exprPtr->sourceLocation, ToString(targetBaseType, node.sourceLocation), ToString(primitiveType, exprPtr->sourceLocation) };
 				}
 				else
@@ -3987,7 +4889,15 @@ namespace nzsl::Ast
 		else
 			throw CompilerInvalidCastError{ node.sourceLocation, ToString(targetType, node.sourceLocation) };
 
+		std::optional<Precision> precision;
+		for (const auto& exprPtr : node.expressions)
+		{
+			if (exprPtr)
+				MergePrecision(precision, *exprPtr);
+		}
+
 		node.cachedExpressionType = targetType;
+		node.cachedPrecision = FilterPrecision(precision, node.cachedExpressionType);
 		node.targetType = std::move(targetType);
 
 		return ValidationResult::Validated;
@@ -4081,7 +4991,14 @@ namespace nzsl::Ast
 
 		ValidateConcreteType(resolvedType, node.sourceLocation);
 
+		if (node.precision.HasValue())
+		{
+			ComputeExprValue(node.precision, node.sourceLocation);
+			ValidatePrecision(node.precision, resolvedType, node.sourceLocation);
+		}
+
 		node.varIndex = RegisterVariable(node.varName, resolvedType, node.varIndex, node.sourceLocation);
+		RegisterVariablePrecision(*node.varIndex, resolvedType, node.precision);
 		node.varType = std::move(resolvedType);
 
 		if (m_context->options.makeVariableNameUnique)
@@ -4116,6 +5033,58 @@ namespace nzsl::Ast
 
 	auto SanitizeVisitor::Validate(IntrinsicExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		switch (node.intrinsic)
+		{
+			case IntrinsicType::SubgroupAdd:
+			case IntrinsicType::SubgroupBallot:
+			case IntrinsicType::SubgroupBroadcastFirst:
+			case IntrinsicType::SubgroupElect:
+			case IntrinsicType::SubgroupMax:
+			case IntrinsicType::SubgroupMin:
+			case IntrinsicType::SubgroupShuffle:
+				if (!IsFeatureEnabled(ModuleFeature::Subgroups))
+					throw CompilerFeatureRequiredError{ node.sourceLocation, ModuleFeature::Subgroups };
+
+				break;
+
+			default:
+				break;
+		}
+
+		ValidationResult result = ValidateIntrinsicSignature(node);
+		if (result == ValidationResult::Unresolved)
+			return result;
+
+		// Workgroup synchronization only makes sense in compute shaders
+		if (node.intrinsic == IntrinsicType::Barrier || node.intrinsic == IntrinsicType::MemoryBarrierShared)
+		{
+			if (m_context->currentFunction)
+				m_context->currentFunction->requiredShaderStage.emplace(ShaderStageType::Compute, node.sourceLocation);
+		}
+
+		std::optional<Precision> precision;
+		if (node.intrinsic == IntrinsicType::SampleTexture || node.intrinsic == IntrinsicType::SampleTextureGrad || node.intrinsic == IntrinsicType::SampleTextureLod || node.intrinsic == IntrinsicType::TextureFetch || node.intrinsic == IntrinsicType::TextureGather)
+		{
+			// Sampling precision comes from the sampler
+			precision = node.parameters.front()->cachedPrecision;
+		}
+		else
+		{
+			for (const auto& param : node.parameters)
+				MergePrecision(precision, *param);
+		}
+
+		node.cachedPrecision = FilterPrecision(precision, node.cachedExpressionType);
+
+		return result;
+	}
+
+	auto SanitizeVisitor::ValidateIntrinsicSignature(IntrinsicExpression& node) -> ValidationResult
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		auto IsArrayOrDynArray = [](const ExpressionType& type)
 		{
 			return IsArrayType(type) || IsDynArrayType(type);
@@ -4123,13 +5092,43 @@ namespace nzsl::Ast
 
 		auto IsFloatingPointVector = [](const ExpressionType& type)
 		{
-			return type == ExpressionType{ VectorType{ 3, PrimitiveType::Float32 } };
+			return type == ExpressionType{ VectorType{ 3, PrimitiveType::Float32 } } || type == ExpressionType{ VectorType{ 3, PrimitiveType::Float16 } };
 		};
 
-		auto IsSquareMatrix = [](const ExpressionType& type)
+		auto IsAtomicType = [](const ExpressionType& type)
 		{
-			if (!IsMatrixType(type))
-				return false;
+			return type == ExpressionType{ PrimitiveType::Int32 } || type == ExpressionType{ PrimitiveType::UInt32 };
+		};
+
+		// Bit manipulation instructions only operate on 32-bit integers
+		auto IsInteger32 = [](const ExpressionType& type)
+		{
+			auto IsInteger32Primitive = [](PrimitiveType primitiveType) { return primitiveType == PrimitiveType::Int32 || primitiveType == PrimitiveType::UInt32; };
+
+			return (IsPrimitiveType(type) && IsInteger32Primitive(std::get<PrimitiveType>(type))) ||
+			       (IsVectorType(type) && IsInteger32Primitive(std::get<VectorType>(type).type));
+		};
+
+		auto IsSignedInteger32Scalar = [](const ExpressionType& type)
+		{
+			return type == ExpressionType{ PrimitiveType::Int32 };
+		};
+
+		auto IsScalarOrVector = [](const ExpressionType& type)
+		{
+			return (IsPrimitiveType(type) && std::get<PrimitiveType>(type) != PrimitiveType::String) || IsVectorType(type);
+		};
+
+		auto CheckLValue = [](Expression& expression, const ExpressionType& /*type*/)
+		{
+			if (GetExpressionCategory(expression) != ExpressionCategory::LValue)
+				throw CompilerIntrinsicExpectedLValueError{ expression.sourceLocation, 0 };
+		};
+
+		auto IsSquareMatrix = [](const ExpressionType& type)
+		{
+			if (!IsMatrixType(type))
+				return false;
 
 			const MatrixType& matrixType = std::get<MatrixType>(type);
 			return matrixType.columnCount == matrixType.rowCount;
@@ -4144,8 +5143,10 @@ namespace nzsl::Ast
 
 		auto CheckFloatingPoint = [](Expression& expression, const ExpressionType& type)
 		{
-			if ((IsPrimitiveType(type) && std::get<PrimitiveType>(type) != PrimitiveType::Float32) ||
-				(IsVectorType(type) && std::get<VectorType>(type).type != PrimitiveType::Float32))
+			auto IsFloatingPoint = [](PrimitiveType primitiveType) { return primitiveType == PrimitiveType::Float16 || primitiveType == PrimitiveType::Float32; };
+
+			if ((IsPrimitiveType(type) && !IsFloatingPoint(std::get<PrimitiveType>(type))) ||
+				(IsVectorType(type) && !IsFloatingPoint(std::get<VectorType>(type).type)))
 				throw CompilerIntrinsicExpectedFloatError{ expression.sourceLocation };
 		};
 
@@ -4174,6 +5175,86 @@ namespace nzsl::Ast
 				node.cachedExpressionType = ExpressionType{ PrimitiveType::UInt32 };
 				return ValidationResult::Validated;
 
+			case IntrinsicType::AtomicAdd:
+			case IntrinsicType::AtomicAnd:
+			case IntrinsicType::AtomicExchange:
+			case IntrinsicType::AtomicMax:
+			case IntrinsicType::AtomicMin:
+			case IntrinsicType::AtomicOr:
+			case IntrinsicType::AtomicXor:
+				if (IsUnresolved(ValidateIntrinsicParamCount<2>(node))
+				 || IsUnresolved(ValidateIntrinsicParamMatchingType(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsAtomicType, "i32/u32"))
+				 || IsUnresolved(ValidateIntrinsicParameter<0>(node, CheckLValue)))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
+			case IntrinsicType::AtomicCompareExchange:
+				if (IsUnresolved(ValidateIntrinsicParamCount<3>(node))
+				 || IsUnresolved(ValidateIntrinsicParamMatchingType(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsAtomicType, "i32/u32"))
+				 || IsUnresolved(ValidateIntrinsicParameter<0>(node, CheckLValue)))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
+			case IntrinsicType::Barrier:
+			case IntrinsicType::MemoryBarrier:
+			case IntrinsicType::MemoryBarrierBuffer:
+			case IntrinsicType::MemoryBarrierImage:
+			case IntrinsicType::MemoryBarrierShared:
+				if (IsUnresolved(ValidateIntrinsicParamCount<0>(node)))
+					return ValidationResult::Unresolved;
+
+				node.cachedExpressionType = ExpressionType{ NoType{} };
+				return ValidationResult::Validated;
+
+			case IntrinsicType::BitCount:
+			case IntrinsicType::FirstBitHigh:
+			case IntrinsicType::FirstBitLow:
+			{
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsInteger32, "i32/u32 scalar or vector")))
+					return ValidationResult::Unresolved;
+
+				// Results are always signed (-1 for first_bit_* when no bit is set)
+				const ExpressionType& paramType = ResolveAlias(GetExpressionTypeSecure(*node.parameters.front()));
+				if (IsVectorType(paramType))
+					node.cachedExpressionType = VectorType{ std::get<VectorType>(paramType).componentCount, PrimitiveType::Int32 };
+				else
+					node.cachedExpressionType = PrimitiveType::Int32;
+
+				return ValidationResult::Validated;
+			}
+
+			case IntrinsicType::BitFieldExtract:
+				if (IsUnresolved(ValidateIntrinsicParamCount<3>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsInteger32, "i32/u32 scalar or vector"))
+				 || IsUnresolved(ValidateIntrinsicParameterType<1>(node, IsSignedInteger32Scalar, "i32"))
+				 || IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsSignedInteger32Scalar, "i32")))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
+			case IntrinsicType::BitFieldInsert:
+			{
+				auto CheckMatchingBase = [&](Expression& expression, const ExpressionType& type)
+				{
+					if (ResolveAlias(GetExpressionTypeSecure(*node.parameters.front())) != type)
+						throw CompilerIntrinsicUnmatchingParameterTypeError{ expression.sourceLocation };
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParamCount<4>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsInteger32, "i32/u32 scalar or vector"))
+				 || IsUnresolved(ValidateIntrinsicParameter<1>(node, CheckMatchingBase))
+				 || IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsSignedInteger32Scalar, "i32"))
+				 || IsUnresolved(ValidateIntrinsicParameterType<3>(node, IsSignedInteger32Scalar, "i32")))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+			}
+
 			case IntrinsicType::CrossProduct:
 				if (IsUnresolved(ValidateIntrinsicParamCount<2>(node))
 				 || IsUnresolved(ValidateIntrinsicParamMatchingType(node))
@@ -4197,6 +5278,75 @@ namespace nzsl::Ast
 
 				return SetReturnTypeToFirstParameterType();
 
+			case IntrinsicType::ImageAtomicAdd:
+			case IntrinsicType::ImageAtomicAnd:
+			case IntrinsicType::ImageAtomicExchange:
+			case IntrinsicType::ImageAtomicMax:
+			case IntrinsicType::ImageAtomicMin:
+			case IntrinsicType::ImageAtomicOr:
+			case IntrinsicType::ImageAtomicXor:
+			case IntrinsicType::ImageLoad:
+			case IntrinsicType::ImageStore:
+			{
+				ValidationResult result = (node.intrinsic == IntrinsicType::ImageLoad) ? ValidateIntrinsicParamCount<2>(node) : ValidateIntrinsicParamCount<3>(node);
+				if (IsUnresolved(result)
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsStorageImageType, "storage image type")))
+					return ValidationResult::Unresolved;
+
+				const StorageImageType& imageType = std::get<StorageImageType>(ResolveAlias(GetExpressionTypeSecure(*node.parameters[0])));
+
+				// Texels are addressed with integer coordinates
+				std::size_t coordinateCount = GetSamplerCoordinateCount(imageType.dim);
+				auto IsCoordinatesType = [=](const ExpressionType& type)
+				{
+					return type == BuildScalarOrVectorType(coordinateCount, PrimitiveType::Int32);
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParameterType<1>(node, IsCoordinatesType, "integer coordinates of image dimensions")))
+					return ValidationResult::Unresolved;
+
+				switch (node.intrinsic)
+				{
+					case IntrinsicType::ImageLoad:
+						node.cachedExpressionType = VectorType{ 4, imageType.sampledType };
+						break;
+
+					case IntrinsicType::ImageStore:
+					{
+						auto IsTexelType = [&](const ExpressionType& type)
+						{
+							return type == ExpressionType{ VectorType{ 4, imageType.sampledType } };
+						};
+
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsTexelType, "vec4 of image sampled type")))
+							return ValidationResult::Unresolved;
+
+						node.cachedExpressionType = ExpressionType{ NoType{} };
+						break;
+					}
+
+					default:
+					{
+						// Atomic operations are only defined on single-component 32-bit integer formats
+						if (imageType.format != ImageFormat::R32i && imageType.format != ImageFormat::R32ui)
+							throw CompilerStorageImageAtomicFormatError{ node.parameters[0]->sourceLocation, ToString(GetExpressionTypeSecure(*node.parameters[0]), node.parameters[0]->sourceLocation) };
+
+						auto IsValueType = [&](const ExpressionType& type)
+						{
+							return type == ExpressionType{ imageType.sampledType };
+						};
+
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsValueType, "image sampled type")))
+							return ValidationResult::Unresolved;
+
+						node.cachedExpressionType = ExpressionType{ imageType.sampledType };
+						break;
+					}
+				}
+
+				return ValidationResult::Validated;
+			}
+
 			case IntrinsicType::Length:
 				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
 				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsFloatingPointVector, "floating-point vector")))
@@ -4220,6 +5370,13 @@ namespace nzsl::Ast
 
 				return SetReturnTypeToFirstParameterType();
 
+			case IntrinsicType::NonUniform:
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsScalarOrVector, "scalar or vector")))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
 			case IntrinsicType::Normalize:
 				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
 				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsFloatingPointVector, "floating-point vector")))
@@ -4227,6 +5384,23 @@ namespace nzsl::Ast
 
 				return SetReturnTypeToFirstParameterType();
 
+			case IntrinsicType::PackHalf2x16:
+			case IntrinsicType::PackUnorm4x8:
+			{
+				std::size_t componentCount = (node.intrinsic == IntrinsicType::PackHalf2x16) ? 2 : 4;
+				auto IsRightType = [=](const ExpressionType& type)
+				{
+					return type == ExpressionType{ VectorType{ componentCount, PrimitiveType::Float32 } };
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsRightType, (componentCount == 2) ? "vec2[f32]" : "vec4[f32]")))
+					return ValidationResult::Unresolved;
+
+				node.cachedExpressionType = ExpressionType{ PrimitiveType::UInt32 };
+				return ValidationResult::Validated;
+			}
+
 			case IntrinsicType::Pow:
 				if (IsUnresolved(ValidateIntrinsicParamCount<2>(node))
 				 || IsUnresolved(ValidateIntrinsicParamMatchingType(node))
@@ -4244,47 +5418,192 @@ namespace nzsl::Ast
 				return SetReturnTypeToFirstParameterType();
 
 			case IntrinsicType::SampleTexture:
+			case IntrinsicType::SampleTextureGrad:
+			case IntrinsicType::SampleTextureLod:
+			case IntrinsicType::TextureFetch:
+			case IntrinsicType::TextureGather:
+			case IntrinsicType::TextureSize:
 			{
-				if (IsUnresolved(ValidateIntrinsicParamCount<2>(node))
+				ValidationResult result;
+				switch (node.intrinsic)
+				{
+					case IntrinsicType::SampleTextureGrad: result = ValidateIntrinsicParamCount<4>(node); break;
+					case IntrinsicType::SampleTextureLod:  result = ValidateIntrinsicParamCount<3>(node); break;
+					case IntrinsicType::TextureFetch:      result = ValidateIntrinsicParamCount<3>(node); break;
+					case IntrinsicType::TextureSize:       result = ValidateIntrinsicParamCount<2>(node); break;
+
+					// Gather component is optional (defaults to red)
+					case IntrinsicType::TextureGather:
+						result = (node.parameters.size() == 3) ? ValidateIntrinsicParamCount<3>(node) : ValidateIntrinsicParamCount<2>(node);
+						break;
+
+					default:
+						result = ValidateIntrinsicParamCount<2>(node);
+						break;
+				}
+
+				if (IsUnresolved(result)
 				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsSamplerType, "sampler type")))
 					return ValidationResult::Unresolved;
 
-				// Special check: vector dimensions must match sample type
 				const SamplerType& samplerType = std::get<SamplerType>(ResolveAlias(GetExpressionTypeSecure(*node.parameters[0])));
-				std::size_t requiredComponentCount = 0;
-				switch (samplerType.dim)
-				{
-					case ImageType::E1D:
-						requiredComponentCount = 1;
-						break;
 
-					case ImageType::E1D_Array:
-					case ImageType::E2D:
-						requiredComponentCount = 2;
-						break;
+				// Texel fetches can't address cubemaps and gathers only work on 2D textures
+				bool isDimSupported = true;
+				if (node.intrinsic == IntrinsicType::TextureFetch)
+					isDimSupported = (samplerType.dim != ImageType::Cubemap);
+				else if (node.intrinsic == IntrinsicType::TextureGather)
+					isDimSupported = (samplerType.dim == ImageType::E2D || samplerType.dim == ImageType::E2D_Array || samplerType.dim == ImageType::Cubemap);
 
-					case ImageType::E2D_Array:
-					case ImageType::E3D:
-					case ImageType::Cubemap:
-						requiredComponentCount = 3;
-						break;
+				if (!isDimSupported)
+					throw CompilerSamplerUnexpectedDimError{ node.parameters[0]->sourceLocation, ToString(GetExpressionTypeSecure(*node.parameters[0]), node.parameters[0]->sourceLocation) };
+
+				if (node.intrinsic == IntrinsicType::TextureSize)
+				{
+					if (IsUnresolved(ValidateIntrinsicParameterType<1>(node, IsSignedInteger32Scalar, "i32")))
+						return ValidationResult::Unresolved;
+
+					node.cachedExpressionType = BuildScalarOrVectorType(GetSamplerSizeCount(samplerType.dim), PrimitiveType::Int32);
+					return ValidationResult::Validated;
 				}
 
+				// Special check: vector dimensions must match sample type
+				std::size_t requiredComponentCount = GetSamplerCoordinateCount(samplerType.dim);
 				if (requiredComponentCount == 0)
 					throw AstInternalError{ node.parameters[0]->sourceLocation, "unhandled sampler dimensions" };
 
+				// Texel fetches use integer coordinates
+				PrimitiveType coordinatesType = (node.intrinsic == IntrinsicType::TextureFetch) ? PrimitiveType::Int32 : PrimitiveType::Float32;
 				auto IsRightType = [=](const ExpressionType& type)
 				{
-					return type == ExpressionType{ VectorType{ requiredComponentCount, PrimitiveType::Float32 } };
+					return type == BuildScalarOrVectorType(requiredComponentCount, coordinatesType);
 				};
 
 				if (IsUnresolved(ValidateIntrinsicParameterType<1>(node, IsRightType, "sampler of requirement components")))
 					return ValidationResult::Unresolved;
 
+				switch (node.intrinsic)
+				{
+					case IntrinsicType::SampleTextureGrad:
+					{
+						std::size_t gradientComponentCount = GetSamplerGradientCount(samplerType.dim);
+						auto IsGradientType = [=](const ExpressionType& type)
+						{
+							return type == BuildScalarOrVectorType(gradientComponentCount, PrimitiveType::Float32);
+						};
+
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsGradientType, "gradient of sampler dimensions"))
+						 || IsUnresolved(ValidateIntrinsicParameterType<3>(node, IsGradientType, "gradient of sampler dimensions")))
+							return ValidationResult::Unresolved;
+
+						break;
+					}
+
+					case IntrinsicType::SampleTextureLod:
+					{
+						auto IsFloat32Scalar = [](const ExpressionType& type)
+						{
+							return type == ExpressionType{ PrimitiveType::Float32 };
+						};
+
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsFloat32Scalar, "f32")))
+							return ValidationResult::Unresolved;
+
+						break;
+					}
+
+					case IntrinsicType::TextureFetch:
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsSignedInteger32Scalar, "i32")))
+							return ValidationResult::Unresolved;
+
+						break;
+
+					case IntrinsicType::TextureGather:
+					{
+						if (node.parameters.size() < 3)
+							break;
+
+						if (IsUnresolved(ValidateIntrinsicParameterType<2>(node, IsSignedInteger32Scalar, "i32")))
+							return ValidationResult::Unresolved;
+
+						// Both SPIR-V and GLSL require the gathered component to be a constant
+						std::optional<ConstantValue> componentValue = ComputeConstantValue(*node.parameters[2]);
+						if (!componentValue.has_value())
+							return ValidationResult::Unresolved;
+
+						std::int32_t component = std::get<std::int32_t>(*componentValue);
+						if (component < 0 || component > 3)
+							throw CompilerSamplerGatherComponentOutOfRangeError{ node.parameters[2]->sourceLocation, component };
+
+						SourceLocation componentLocation = node.parameters[2]->sourceLocation;
+						node.parameters[2] = ShaderBuilder::ConstantValue(component);
+						node.parameters[2]->sourceLocation = componentLocation;
+						break;
+					}
+
+					default:
+						break;
+				}
+
 				node.cachedExpressionType = VectorType{ 4, samplerType.sampledType };
 				return ValidationResult::Validated;
 			}
 
+			case IntrinsicType::SubgroupAdd:
+			case IntrinsicType::SubgroupMax:
+			case IntrinsicType::SubgroupMin:
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsScalarOrVector, "scalar or vector"))
+				 || IsUnresolved(ValidateIntrinsicParameter<0>(node, CheckNotBoolean)))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
+			case IntrinsicType::SubgroupBallot:
+			{
+				auto IsBoolean = [](const ExpressionType& type)
+				{
+					return type == ExpressionType{ PrimitiveType::Boolean };
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsBoolean, "bool")))
+					return ValidationResult::Unresolved;
+
+				// One bit per invocation, for up to 128 invocations
+				node.cachedExpressionType = VectorType{ 4, PrimitiveType::UInt32 };
+				return ValidationResult::Validated;
+			}
+
+			case IntrinsicType::SubgroupBroadcastFirst:
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsScalarOrVector, "scalar or vector")))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+
+			case IntrinsicType::SubgroupElect:
+				if (IsUnresolved(ValidateIntrinsicParamCount<0>(node)))
+					return ValidationResult::Unresolved;
+
+				node.cachedExpressionType = ExpressionType{ PrimitiveType::Boolean };
+				return ValidationResult::Validated;
+
+			case IntrinsicType::SubgroupShuffle:
+			{
+				auto IsUInt32 = [](const ExpressionType& type)
+				{
+					return type == ExpressionType{ PrimitiveType::UInt32 };
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParamCount<2>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsScalarOrVector, "scalar or vector"))
+				 || IsUnresolved(ValidateIntrinsicParameterType<1>(node, IsUInt32, "u32")))
+					return ValidationResult::Unresolved;
+
+				return SetReturnTypeToFirstParameterType();
+			}
+
 			case IntrinsicType::Transpose:
 			{
 				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
@@ -4297,6 +5616,23 @@ namespace nzsl::Ast
 				node.cachedExpressionType = matrixType;
 				return ValidationResult::Validated;
 			}
+
+			case IntrinsicType::UnpackHalf2x16:
+			case IntrinsicType::UnpackUnorm4x8:
+			{
+				auto IsUInt32 = [](const ExpressionType& type)
+				{
+					return type == ExpressionType{ PrimitiveType::UInt32 };
+				};
+
+				if (IsUnresolved(ValidateIntrinsicParamCount<1>(node))
+				 || IsUnresolved(ValidateIntrinsicParameterType<0>(node, IsUInt32, "u32")))
+					return ValidationResult::Unresolved;
+
+				std::size_t componentCount = (node.intrinsic == IntrinsicType::UnpackHalf2x16) ? 2 : 4;
+				node.cachedExpressionType = VectorType{ componentCount, PrimitiveType::Float32 };
+				return ValidationResult::Validated;
+			}
 		}
 
 		throw AstInternalError{ node.sourceLocation, "unhandled intrinsic" };
@@ -4304,6 +5640,8 @@ namespace nzsl::Ast
 
 	auto SanitizeVisitor::Validate(SwizzleExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const ExpressionType* exprType = GetExpressionType(MandatoryExpr(node.expression, node.sourceLocation));
 		if (!exprType)
 			return ValidationResult::Unresolved;
@@ -4349,11 +5687,15 @@ namespace nzsl::Ast
 		else
 			node.cachedExpressionType = baseType;
 
+		node.cachedPrecision = FilterPrecision(node.expression->cachedPrecision, node.cachedExpressionType);
+
 		return ValidationResult::Validated;
 	}
 	
 	auto SanitizeVisitor::Validate(UnaryExpression& node) -> ValidationResult
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const ExpressionType* exprType = GetExpressionType(MandatoryExpr(node.expression, node.sourceLocation));
 		if (!exprType)
 			return ValidationResult::Unresolved;
@@ -4362,6 +5704,22 @@ namespace nzsl::Ast
 
 		switch (node.op)
 		{
+			case UnaryType::BitwiseNot:
+			{
+				PrimitiveType basicType;
+				if (IsPrimitiveType(resolvedExprType))
+					basicType = std::get<PrimitiveType>(resolvedExprType);
+				else if (IsVectorType(resolvedExprType))
+					basicType = std::get<VectorType>(resolvedExprType).type;
+				else
+					throw CompilerUnaryUnsupportedError{ node.sourceLocation, ToString(*exprType, node.sourceLocation) };
+
+				if (!IsIntegerType(basicType))
+					throw CompilerUnaryUnsupportedError{ node.sourceLocation, ToString(*exprType, node.sourceLocation) };
+
+				break;
+			}
+
 			case UnaryType::LogicalNot:
 			{
 				if (resolvedExprType != ExpressionType(PrimitiveType::Boolean))
@@ -4381,7 +5739,7 @@ namespace nzsl::Ast
 				else
 					throw CompilerUnaryUnsupportedError{ node.sourceLocation, ToString(*exprType, node.sourceLocation) };
 
-				if (basicType != PrimitiveType::Float32 && basicType != PrimitiveType::Int32 && basicType != PrimitiveType::UInt32)
+				if (basicType == PrimitiveType::Boolean || basicType == PrimitiveType::String)
 					throw CompilerUnaryUnsupportedError{ node.sourceLocation, ToString(*exprType, node.sourceLocation) };
 
 				break;
@@ -4389,17 +5747,21 @@ namespace nzsl::Ast
 		}
 
 		node.cachedExpressionType = *exprType;
+		node.cachedPrecision = node.expression->cachedPrecision;
 		return ValidationResult::Validated;
 	}
 
 	auto SanitizeVisitor::Validate(VariableValueExpression& node) -> ValidationResult
 	{
 		node.cachedExpressionType = m_context->variableTypes.Retrieve(node.variableId, node.sourceLocation);
+		node.cachedPrecision = GetVariablePrecision(node.variableId);
 		return ValidationResult::Validated;
 	}
 
 	ExpressionType SanitizeVisitor::ValidateBinaryOp(BinaryType op, const ExpressionType& leftExprType, const ExpressionType& rightExprType, const SourceLocation& sourceLocation)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		if (!IsPrimitiveType(leftExprType) && !IsMatrixType(leftExprType) && !IsVectorType(leftExprType))
 			throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
 
@@ -4437,8 +5799,11 @@ namespace nzsl::Ast
 				{
 					switch (leftType)
 					{
+						case PrimitiveType::Float16:
 						case PrimitiveType::Float32:
+						case PrimitiveType::Int16:
 						case PrimitiveType::Int32:
+						case PrimitiveType::UInt16:
 						case PrimitiveType::UInt32:
 						{
 							if (IsMatrixType(rightExprType))
@@ -4479,6 +5844,30 @@ namespace nzsl::Ast
 					TypeMustMatch(leftExprType, rightExprType, sourceLocation);
 					return PrimitiveType::Boolean;
 				}
+
+				case BinaryType::BitwiseAnd:
+				case BinaryType::BitwiseOr:
+				case BinaryType::BitwiseXor:
+				{
+					if (!IsIntegerType(leftType))
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
+
+					TypeMustMatch(leftExprType, rightExprType, sourceLocation);
+					return leftExprType;
+				}
+
+				case BinaryType::ShiftLeft:
+				case BinaryType::ShiftRight:
+				{
+					if (!IsIntegerType(leftType))
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
+
+					// Shift amount signedness doesn't have to match
+					if (!IsPrimitiveType(rightExprType) || !IsIntegerType(std::get<PrimitiveType>(rightExprType)))
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "right", ToString(rightExprType, sourceLocation) };
+
+					return leftExprType;
+				}
 			}
 		}
 		else if (IsMatrixType(leftExprType))
@@ -4528,8 +5917,13 @@ namespace nzsl::Ast
 						throw CompilerBinaryIncompatibleTypesError{ sourceLocation, ToString(leftExprType, sourceLocation), ToString(rightExprType, sourceLocation) };
 				}
 
+				case BinaryType::BitwiseAnd:
+				case BinaryType::BitwiseOr:
+				case BinaryType::BitwiseXor:
 				case BinaryType::LogicalAnd:
 				case BinaryType::LogicalOr:
+				case BinaryType::ShiftLeft:
+				case BinaryType::ShiftRight:
 					throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
 			}
 		}
@@ -4575,6 +5969,41 @@ namespace nzsl::Ast
 				case BinaryType::LogicalAnd:
 				case BinaryType::LogicalOr:
 					throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
+
+				case BinaryType::BitwiseAnd:
+				case BinaryType::BitwiseOr:
+				case BinaryType::BitwiseXor:
+				{
+					if (!IsIntegerType(leftType.type))
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
+
+					TypeMustMatch(leftExprType, rightExprType, sourceLocation);
+					return leftExprType;
+				}
+
+				case BinaryType::ShiftLeft:
+				case BinaryType::ShiftRight:
+				{
+					if (!IsIntegerType(leftType.type))
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "left", ToString(leftExprType, sourceLocation) };
+
+					// Shift amount can either be a scalar or a vector with the same component count
+					if (IsPrimitiveType(rightExprType))
+					{
+						if (!IsIntegerType(std::get<PrimitiveType>(rightExprType)))
+							throw CompilerBinaryUnsupportedError{ sourceLocation, "right", ToString(rightExprType, sourceLocation) };
+					}
+					else if (IsVectorType(rightExprType))
+					{
+						const VectorType& rightType = std::get<VectorType>(rightExprType);
+						if (!IsIntegerType(rightType.type) || rightType.componentCount != leftType.componentCount)
+							throw CompilerBinaryUnsupportedError{ sourceLocation, "right", ToString(rightExprType, sourceLocation) };
+					}
+					else
+						throw CompilerBinaryUnsupportedError{ sourceLocation, "right", ToString(rightExprType, sourceLocation) };
+
+					return leftExprType;
+				}
 			}
 		}
 
@@ -4591,6 +6020,17 @@ namespace nzsl::Ast
 		}
 	}
 
+	void SanitizeVisitor::ValidatePrecision(const ExpressionValue<Precision>& precision, const ExpressionType& exprType, const SourceLocation& sourceLocation)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (!precision.IsResultingValue())
+			return;
+
+		if (!IsPrecisionQualifiable(exprType))
+			throw CompilerPrecisionUnexpectedTypeError{ sourceLocation, ToString(exprType, sourceLocation) };
+	}
+
 	template<std::size_t N>
 	auto SanitizeVisitor::ValidateIntrinsicParamCount(IntrinsicExpression& node) -> ValidationResult
 	{
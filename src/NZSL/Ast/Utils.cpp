@@ -155,4 +155,103 @@ namespace nzsl::Ast
 	{
 		m_expressionCategory = ExpressionCategory::RValue;
 	}
+
+	bool IsPureExpression(const Expression& expression)
+	{
+		switch (expression.GetType())
+		{
+			case NodeType::ConstantExpression:
+			case NodeType::ConstantValueExpression:
+			case NodeType::IdentifierExpression:
+			case NodeType::VariableValueExpression:
+				return true;
+
+			case NodeType::AccessIdentifierExpression:
+				return IsPureExpression(*static_cast<const AccessIdentifierExpression&>(expression).expr);
+
+			case NodeType::AccessIndexExpression:
+			{
+				const auto& accessIndex = static_cast<const AccessIndexExpression&>(expression);
+				for (const auto& indexExpr : accessIndex.indices)
+				{
+					if (!IsPureExpression(*indexExpr))
+						return false;
+				}
+
+				return IsPureExpression(*accessIndex.expr);
+			}
+
+			case NodeType::BinaryExpression:
+			{
+				const auto& binary = static_cast<const BinaryExpression&>(expression);
+				return IsPureExpression(*binary.left) && IsPureExpression(*binary.right);
+			}
+
+			case NodeType::CastExpression:
+			{
+				const auto& cast = static_cast<const CastExpression&>(expression);
+				for (const auto& expr : cast.expressions)
+				{
+					if (!IsPureExpression(*expr))
+						return false;
+				}
+
+				return true;
+			}
+
+			case NodeType::IntrinsicExpression:
+			{
+				const auto& intrinsic = static_cast<const IntrinsicExpression&>(expression);
+				for (const auto& parameter : intrinsic.parameters)
+				{
+					if (!IsPureExpression(*parameter))
+						return false;
+				}
+
+				return true;
+			}
+
+			case NodeType::SwizzleExpression:
+				return IsPureExpression(*static_cast<const SwizzleExpression&>(expression).expression);
+
+			case NodeType::UnaryExpression:
+				return IsPureExpression(*static_cast<const UnaryExpression&>(expression).expression);
+
+			default:
+				return false;
+		}
+	}
+
+	bool IsTrivialExpression(const Expression& expression)
+	{
+		switch (expression.GetType())
+		{
+			case NodeType::ConstantExpression:
+			case NodeType::ConstantValueExpression:
+			case NodeType::IdentifierExpression:
+			case NodeType::VariableValueExpression:
+				return true;
+
+			case NodeType::AccessIdentifierExpression:
+				return IsTrivialExpression(*static_cast<const AccessIdentifierExpression&>(expression).expr);
+
+			case NodeType::AccessIndexExpression:
+			{
+				const auto& accessIndex = static_cast<const AccessIndexExpression&>(expression);
+				for (const auto& indexExpr : accessIndex.indices)
+				{
+					if (indexExpr->GetType() != NodeType::ConstantValueExpression)
+						return false;
+				}
+
+				return IsTrivialExpression(*accessIndex.expr);
+			}
+
+			case NodeType::SwizzleExpression:
+				return IsTrivialExpression(*static_cast<const SwizzleExpression&>(expression).expression);
+
+			default:
+				return false;
+		}
+	}
 }
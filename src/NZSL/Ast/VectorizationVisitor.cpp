@@ -0,0 +1,737 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/VectorizationVisitor.hpp>
+#include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
+#include <NZSL/Ast/Utils.hpp>
+#include <array>
+#include <cassert>
+#include <optional>
+
+namespace nzsl::Ast
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		struct LaneStore
+		{
+			Expression* base;
+			Expression* value;
+			std::uint32_t component;
+		};
+
+		std::optional<PrimitiveType> GetLaneType(Expression& expression)
+		{
+			const ExpressionType* expressionType = GetExpressionType(expression);
+			if (!expressionType)
+				return std::nullopt;
+
+			const ExpressionType& resolvedType = ResolveAlias(*expressionType);
+			if (!IsPrimitiveType(resolvedType))
+				return std::nullopt;
+
+			PrimitiveType primitiveType = std::get<PrimitiveType>(resolvedType);
+			switch (primitiveType)
+			{
+				case PrimitiveType::Float32:
+				case PrimitiveType::Int32:
+				case PrimitiveType::UInt32:
+					return primitiveType;
+
+				default:
+					return std::nullopt;
+			}
+		}
+
+		const VectorType* GetVectorType(Expression& expression)
+		{
+			const ExpressionType* expressionType = GetExpressionType(expression);
+			if (!expressionType)
+				return nullptr;
+
+			const ExpressionType& resolvedType = ResolveAlias(*expressionType);
+			if (!IsVectorType(resolvedType))
+				return nullptr;
+
+			return &std::get<VectorType>(resolvedType);
+		}
+
+		// Checks if two trivial expressions refer to the same value (unlike Compare, source locations are ignored)
+		bool IsSameValue(const Expression& lhs, const Expression& rhs)
+		{
+			if (lhs.GetType() != rhs.GetType())
+				return false;
+
+			switch (lhs.GetType())
+			{
+				case NodeType::AccessIdentifierExpression:
+				{
+					const auto& lhsAccess = static_cast<const AccessIdentifierExpression&>(lhs);
+					const auto& rhsAccess = static_cast<const AccessIdentifierExpression&>(rhs);
+					if (lhsAccess.identifiers.size() != rhsAccess.identifiers.size())
+						return false;
+
+					for (std::size_t i = 0; i < lhsAccess.identifiers.size(); ++i)
+					{
+						if (lhsAccess.identifiers[i].identifier != rhsAccess.identifiers[i].identifier)
+							return false;
+					}
+
+					return IsSameValue(*lhsAccess.expr, *rhsAccess.expr);
+				}
+
+				case NodeType::AccessIndexExpression:
+				{
+					const auto& lhsAccess = static_cast<const AccessIndexExpression&>(lhs);
+					const auto& rhsAccess = static_cast<const AccessIndexExpression&>(rhs);
+					if (lhsAccess.indices.size() != rhsAccess.indices.size())
+						return false;
+
+					for (std::size_t i = 0; i < lhsAccess.indices.size(); ++i)
+					{
+						if (!IsSameValue(*lhsAccess.indices[i], *rhsAccess.indices[i]))
+							return false;
+					}
+
+					return IsSameValue(*lhsAccess.expr, *rhsAccess.expr);
+				}
+
+				case NodeType::ConstantExpression:
+					return static_cast<const ConstantExpression&>(lhs).constantId == static_cast<const ConstantExpression&>(rhs).constantId;
+
+				case NodeType::ConstantValueExpression:
+					return static_cast<const ConstantValueExpression&>(lhs).value == static_cast<const ConstantValueExpression&>(rhs).value;
+
+				case NodeType::IdentifierExpression:
+					return static_cast<const IdentifierExpression&>(lhs).identifier == static_cast<const IdentifierExpression&>(rhs).identifier;
+
+				case NodeType::SwizzleExpression:
+				{
+					const auto& lhsSwizzle = static_cast<const SwizzleExpression&>(lhs);
+					const auto& rhsSwizzle = static_cast<const SwizzleExpression&>(rhs);
+					if (lhsSwizzle.componentCount != rhsSwizzle.componentCount)
+						return false;
+
+					for (std::size_t i = 0; i < lhsSwizzle.componentCount; ++i)
+					{
+						if (lhsSwizzle.components[i] != rhsSwizzle.components[i])
+							return false;
+					}
+
+					return IsSameValue(*lhsSwizzle.expression, *rhsSwizzle.expression);
+				}
+
+				case NodeType::VariableValueExpression:
+					return static_cast<const VariableValueExpression&>(lhs).variableId == static_cast<const VariableValueExpression&>(rhs).variableId;
+
+				default:
+					return false;
+			}
+		}
+
+		// Checks if an expression reads one of the written components of a vector (conservative, unknown expressions are assumed to read them)
+		bool ReadsWrittenComponents(const Expression& expression, const Expression& base, std::uint32_t writtenComponents)
+		{
+			if (IsSameValue(expression, base))
+				return true;
+
+			switch (expression.GetType())
+			{
+				case NodeType::ConstantExpression:
+				case NodeType::ConstantValueExpression:
+				case NodeType::IdentifierExpression:
+				case NodeType::VariableValueExpression:
+					return false;
+
+				case NodeType::AccessIdentifierExpression:
+					return ReadsWrittenComponents(*static_cast<const AccessIdentifierExpression&>(expression).expr, base, writtenComponents);
+
+				case NodeType::AccessIndexExpression:
+				{
+					const auto& accessIndex = static_cast<const AccessIndexExpression&>(expression);
+					for (const auto& indexExpr : accessIndex.indices)
+					{
+						if (ReadsWrittenComponents(*indexExpr, base, writtenComponents))
+							return true;
+					}
+
+					return ReadsWrittenComponents(*accessIndex.expr, base, writtenComponents);
+				}
+
+				case NodeType::BinaryExpression:
+				{
+					const auto& binary = static_cast<const BinaryExpression&>(expression);
+					return ReadsWrittenComponents(*binary.left, base, writtenComponents) || ReadsWrittenComponents(*binary.right, base, writtenComponents);
+				}
+
+				case NodeType::SwizzleExpression:
+				{
+					const auto& swizzle = static_cast<const SwizzleExpression&>(expression);
+					if (!IsSameValue(*swizzle.expression, base))
+						return ReadsWrittenComponents(*swizzle.expression, base, writtenComponents);
+
+					for (std::size_t i = 0; i < swizzle.componentCount; ++i)
+					{
+						if (writtenComponents & (1u << swizzle.components[i]))
+							return true;
+					}
+
+					return false;
+				}
+
+				case NodeType::UnaryExpression:
+					return ReadsWrittenComponents(*static_cast<const UnaryExpression&>(expression).expression, base, writtenComponents);
+
+				default:
+					return true;
+			}
+		}
+
+		// Matches base.c = value;
+		std::optional<LaneStore> GetLaneStore(Statement& statement)
+		{
+			if (statement.GetType() != NodeType::ExpressionStatement)
+				return std::nullopt;
+
+			auto& expressionStatement = static_cast<ExpressionStatement&>(statement);
+			if (expressionStatement.expression->GetType() != NodeType::AssignExpression)
+				return std::nullopt;
+
+			auto& assign = static_cast<AssignExpression&>(*expressionStatement.expression);
+			if (assign.op != AssignType::Simple || assign.left->GetType() != NodeType::SwizzleExpression)
+				return std::nullopt;
+
+			auto& swizzle = static_cast<SwizzleExpression&>(*assign.left);
+			if (swizzle.componentCount != 1 || !IsTrivialExpression(*swizzle.expression) || !GetVectorType(*swizzle.expression))
+				return std::nullopt;
+
+			return LaneStore{ swizzle.expression.get(), assign.right.get(), swizzle.components[0] };
+		}
+
+		// Looks for casts and lane stores VectorizationVisitor may vectorize, without cloning anything (conservative)
+		class VectorizationCandidateFinder : public RecursiveVisitor
+		{
+			public:
+				bool Find(Statement& statement)
+				{
+					statement.Visit(*this);
+					return m_found;
+				}
+
+				using RecursiveVisitor::Visit;
+
+				void Visit(CastExpression& node) override
+				{
+					if (!m_found && node.targetType.IsResultingValue())
+					{
+						const ExpressionType& targetType = ResolveAlias(node.targetType.GetResultingValue());
+						if (IsVectorType(targetType))
+						{
+							const VectorType& vectorType = std::get<VectorType>(targetType);
+							if (node.expressions.size() == vectorType.componentCount && GetLaneType(*node.expressions.front()) == vectorType.type)
+							{
+								for (const auto& expr : node.expressions)
+								{
+									if (expr->GetType() != NodeType::ConstantValueExpression)
+									{
+										m_found = true;
+										break;
+									}
+								}
+							}
+						}
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareFunctionStatement& node) override
+				{
+					FindLaneStores(node.statements);
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(MultiStatement& node) override
+				{
+					FindLaneStores(node.statements);
+					RecursiveVisitor::Visit(node);
+				}
+
+			private:
+				void FindLaneStores(const std::vector<StatementPtr>& statements)
+				{
+					// Only consecutive stores to different components of the same vector can be merged
+					for (std::size_t i = 1; i < statements.size() && !m_found; ++i)
+					{
+						std::optional<LaneStore> previousStore = GetLaneStore(*statements[i - 1]);
+						if (!previousStore)
+							continue;
+
+						std::optional<LaneStore> store = GetLaneStore(*statements[i]);
+						if (store && store->component != previousStore->component && IsSameValue(*store->base, *previousStore->base))
+							m_found = true;
+					}
+				}
+
+				bool m_found = false;
+		};
+	}
+
+	struct VectorizationVisitor::VectorizedExpression
+	{
+		ExpressionPtr expression;
+		bool isScalar = false; //< all lanes compute the same value, expression is a scalar which has to be broadcasted
+	};
+
+	bool VectorizationVisitor::CanTransform(const Module& shaderModule)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		VectorizationCandidateFinder candidateFinder;
+		return candidateFinder.Find(*shaderModule.rootNode);
+	}
+
+	ModulePtr VectorizationVisitor::Process(const Module& shaderModule)
+	{
+		auto rootNode = Nz::StaticUniquePointerCast<MultiStatement>(Process(*shaderModule.rootNode));
+
+		return std::make_shared<Module>(shaderModule.metadata, std::move(rootNode), shaderModule.importedModules);
+	}
+
+	StatementPtr VectorizationVisitor::Process(Statement& statement)
+	{
+		m_changed = false;
+
+		return Clone(statement);
+	}
+
+	ExpressionPtr VectorizationVisitor::Clone(CastExpression& node)
+	{
+		ExpressionPtr clone = Cloner::Clone(node);
+		auto& cast = static_cast<CastExpression&>(*clone);
+
+		// vec3[f32](a.x * b.x, a.y * b.y, a.z * b.z) => a.xyz * b.xyz
+		if (!cast.targetType.IsResultingValue())
+			return clone;
+
+		const ExpressionType& targetType = ResolveAlias(cast.targetType.GetResultingValue());
+		if (!IsVectorType(targetType))
+			return clone;
+
+		const VectorType& vectorType = std::get<VectorType>(targetType);
+		if (cast.expressions.size() != vectorType.componentCount)
+			return clone;
+
+		std::vector<Expression*> lanes;
+		lanes.reserve(cast.expressions.size());
+
+		bool isConstant = true;
+		for (auto& expr : cast.expressions)
+		{
+			if (expr->GetType() != NodeType::ConstantValueExpression)
+				isConstant = false;
+
+			lanes.push_back(expr.get());
+		}
+
+		// A cast of constants is already the vector form
+		if (isConstant || GetLaneType(*lanes.front()) != vectorType.type)
+			return clone;
+
+		VectorizedExpression vectorized = VectorizeLanes(lanes);
+		if (!vectorized.expression || vectorized.isScalar)
+			return clone;
+
+		vectorized.expression->sourceLocation = node.sourceLocation;
+
+		m_changed = true;
+		return std::move(vectorized.expression);
+	}
+
+	StatementPtr VectorizationVisitor::Clone(DeclareFunctionStatement& node)
+	{
+		m_localVariables.clear();
+		for (const auto& parameter : node.parameters)
+		{
+			if (parameter.varIndex)
+				m_localVariables.insert(*parameter.varIndex);
+		}
+
+		StatementPtr clone = Cloner::Clone(node);
+		VectorizeStatements(static_cast<DeclareFunctionStatement&>(*clone).statements);
+
+		m_localVariables.clear();
+
+		return clone;
+	}
+
+	StatementPtr VectorizationVisitor::Clone(DeclareVariableStatement& node)
+	{
+		if (node.varIndex)
+			m_localVariables.insert(*node.varIndex);
+
+		return Cloner::Clone(node);
+	}
+
+	StatementPtr VectorizationVisitor::Clone(MultiStatement& node)
+	{
+		StatementPtr clone = Cloner::Clone(node);
+		VectorizeStatements(static_cast<MultiStatement&>(*clone).statements);
+
+		return clone;
+	}
+
+	bool VectorizationVisitor::IsLocalVariable(const Expression& expression) const
+	{
+		const Expression* expr = &expression;
+		for (;;)
+		{
+			switch (expr->GetType())
+			{
+				case NodeType::AccessIdentifierExpression:
+					expr = static_cast<const AccessIdentifierExpression*>(expr)->expr.get();
+					break;
+
+				case NodeType::AccessIndexExpression:
+					expr = static_cast<const AccessIndexExpression*>(expr)->expr.get();
+					break;
+
+				case NodeType::SwizzleExpression:
+					expr = static_cast<const SwizzleExpression*>(expr)->expression.get();
+					break;
+
+				case NodeType::VariableValueExpression:
+					return m_localVariables.find(static_cast<const VariableValueExpression*>(expr)->variableId) != m_localVariables.end();
+
+				default:
+					return false;
+			}
+		}
+	}
+
+	auto VectorizationVisitor::VectorizeLanes(const std::vector<Expression*>& lanes) -> VectorizedExpression
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		assert(lanes.size() >= 2 && lanes.size() <= 4);
+
+		Expression& firstLane = *lanes.front();
+
+		std::optional<PrimitiveType> laneType = GetLaneType(firstLane);
+		if (!laneType)
+			return {};
+
+		for (Expression* lane : lanes)
+		{
+			if (lane->GetType() != firstLane.GetType() || GetLaneType(*lane) != laneType)
+				return {};
+		}
+
+		VectorType vectorType{ lanes.size(), *laneType };
+
+		// Every lane uses the same value (a.x * s, a.y * s)
+		if (IsTrivialExpression(firstLane))
+		{
+			bool isSameValue = true;
+			for (std::size_t i = 1; i < lanes.size(); ++i)
+			{
+				if (!IsSameValue(*lanes[i], firstLane))
+				{
+					isSameValue = false;
+					break;
+				}
+			}
+
+			if (isSameValue)
+			{
+				VectorizedExpression result;
+				result.expression = Cloner::Clone(firstLane);
+				result.isScalar = true;
+
+				return result;
+			}
+		}
+
+		switch (firstLane.GetType())
+		{
+			case NodeType::BinaryExpression:
+			{
+				BinaryType op = static_cast<BinaryExpression&>(firstLane).op;
+				switch (op)
+				{
+					case BinaryType::Add:
+					case BinaryType::Divide:
+					case BinaryType::Modulo:
+					case BinaryType::Multiply:
+					case BinaryType::Subtract:
+						break;
+
+					default:
+						return {};
+				}
+
+				std::vector<Expression*> leftLanes;
+				leftLanes.reserve(lanes.size());
+
+				std::vector<Expression*> rightLanes;
+				rightLanes.reserve(lanes.size());
+
+				for (Expression* lane : lanes)
+				{
+					auto& binary = static_cast<BinaryExpression&>(*lane);
+					if (binary.op != op)
+						return {};
+
+					leftLanes.push_back(binary.left.get());
+					rightLanes.push_back(binary.right.get());
+				}
+
+				VectorizedExpression left = VectorizeLanes(leftLanes);
+				if (!left.expression)
+					return {};
+
+				VectorizedExpression right = VectorizeLanes(rightLanes);
+				if (!right.expression)
+					return {};
+
+				// Only floating-point multiplications accept a scalar and a vector operand in every backend, broadcast the scalar for other operations
+				bool acceptsScalarOperand = (op == BinaryType::Multiply && *laneType == PrimitiveType::Float32);
+				if (left.isScalar != right.isScalar && !acceptsScalarOperand)
+				{
+					VectorizedExpression& scalar = (left.isScalar) ? left : right;
+					if (!IsTrivialExpression(*scalar.expression))
+						return {};
+
+					std::vector<ExpressionPtr> values;
+					for (std::size_t i = 0; i < lanes.size(); ++i)
+						values.push_back(Cloner::Clone(*scalar.expression));
+
+					auto cast = ShaderBuilder::Cast(ExpressionType{ vectorType }, std::move(values));
+					cast->cachedExpressionType = vectorType;
+					cast->sourceLocation = scalar.expression->sourceLocation;
+
+					scalar.expression = std::move(cast);
+					scalar.isScalar = false;
+				}
+
+				VectorizedExpression result;
+				result.isScalar = left.isScalar && right.isScalar;
+
+				auto binary = ShaderBuilder::Binary(op, std::move(left.expression), std::move(right.expression));
+				if (result.isScalar)
+					binary->cachedExpressionType = *laneType;
+				else
+					binary->cachedExpressionType = vectorType;
+
+				binary->sourceLocation = firstLane.sourceLocation;
+
+				result.expression = std::move(binary);
+				return result;
+			}
+
+			case NodeType::ConstantValueExpression:
+			{
+				// a.x * 2.0, a.y * 3.0 => a.xy * vec2[f32](2.0, 3.0)
+				std::vector<ExpressionPtr> values;
+				values.reserve(lanes.size());
+
+				for (Expression* lane : lanes)
+					values.push_back(Cloner::Clone(*lane));
+
+				auto cast = ShaderBuilder::Cast(ExpressionType{ vectorType }, std::move(values));
+				cast->cachedExpressionType = vectorType;
+				cast->sourceLocation = firstLane.sourceLocation;
+
+				VectorizedExpression result;
+				result.expression = std::move(cast);
+
+				return result;
+			}
+
+			case NodeType::SwizzleExpression:
+			{
+				// a.x, a.y => a.xy
+				auto& firstSwizzle = static_cast<SwizzleExpression&>(firstLane);
+				if (!IsTrivialExpression(*firstSwizzle.expression))
+					return {};
+
+				const VectorType* baseType = GetVectorType(*firstSwizzle.expression);
+				if (!baseType)
+					return {};
+
+				std::array<std::uint32_t, 4> components;
+				bool isIdentity = (baseType->componentCount == lanes.size());
+				for (std::size_t i = 0; i < lanes.size(); ++i)
+				{
+					auto& swizzle = static_cast<SwizzleExpression&>(*lanes[i]);
+					if (swizzle.componentCount != 1 || !IsSameValue(*swizzle.expression, *firstSwizzle.expression))
+						return {};
+
+					components[i] = swizzle.components[0];
+					if (components[i] != i)
+						isIdentity = false;
+				}
+
+				VectorizedExpression result;
+				if (isIdentity)
+					result.expression = Cloner::Clone(*firstSwizzle.expression);
+				else
+				{
+					auto swizzle = ShaderBuilder::Swizzle(Cloner::Clone(*firstSwizzle.expression), components, lanes.size());
+					swizzle->cachedExpressionType = vectorType;
+					swizzle->sourceLocation = firstLane.sourceLocation;
+
+					result.expression = std::move(swizzle);
+				}
+
+				return result;
+			}
+
+			case NodeType::UnaryExpression:
+			{
+				std::vector<Expression*> operandLanes;
+				operandLanes.reserve(lanes.size());
+
+				for (Expression* lane : lanes)
+				{
+					auto& unary = static_cast<UnaryExpression&>(*lane);
+					if (unary.op != UnaryType::Minus)
+						return {};
+
+					operandLanes.push_back(unary.expression.get());
+				}
+
+				VectorizedExpression operand = VectorizeLanes(operandLanes);
+				if (!operand.expression)
+					return {};
+
+				VectorizedExpression result;
+				result.isScalar = operand.isScalar;
+
+				auto unary = ShaderBuilder::Unary(UnaryType::Minus, std::move(operand.expression));
+				if (result.isScalar)
+					unary->cachedExpressionType = *laneType;
+				else
+					unary->cachedExpressionType = vectorType;
+
+				unary->sourceLocation = firstLane.sourceLocation;
+
+				result.expression = std::move(unary);
+				return result;
+			}
+
+			default:
+				return {};
+		}
+	}
+
+	void VectorizationVisitor::VectorizeStatements(std::vector<StatementPtr>& statements)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// r.x = a.x * b.x; r.y = a.y * b.y; => r.xy = a.xy * b.xy;
+		std::vector<StatementPtr> vectorizedStatements;
+		vectorizedStatements.reserve(statements.size());
+
+		for (std::size_t i = 0; i < statements.size();)
+		{
+			std::optional<LaneStore> firstStore = GetLaneStore(*statements[i]);
+			if (!firstStore)
+			{
+				vectorizedStatements.push_back(std::move(statements[i]));
+				++i;
+				continue;
+			}
+
+			const VectorType& baseType = *GetVectorType(*firstStore->base);
+
+			// Storing only some lanes of a vector loads it first, which races with other invocations and reads write-only storage,
+			// only merge partial stores to function variables
+			bool allowPartialStore = IsLocalVariable(*firstStore->base);
+
+			std::vector<LaneStore> stores = { *firstStore };
+			std::uint32_t writtenComponents = 1u << firstStore->component;
+			for (std::size_t j = i + 1; j < statements.size() && stores.size() < baseType.componentCount; ++j)
+			{
+				std::optional<LaneStore> store = GetLaneStore(*statements[j]);
+				if (!store || !IsSameValue(*store->base, *firstStore->base))
+					break;
+
+				if (writtenComponents & (1u << store->component))
+					break;
+
+				// A lane reading a component written by a previous lane cannot be computed at the same time
+				if (ReadsWrittenComponents(*store->value, *firstStore->base, writtenComponents))
+					break;
+
+				writtenComponents |= 1u << store->component;
+				stores.push_back(*store);
+			}
+
+			// Try the largest group first, trailing lanes which don't match are left as is
+			VectorizedExpression vectorized;
+			for (; stores.size() >= 2; stores.pop_back())
+			{
+				std::vector<Expression*> lanes;
+				lanes.reserve(stores.size());
+
+				for (const LaneStore& store : stores)
+					lanes.push_back(store.value);
+
+				// Lanes are stored in order, a whole vector store can only happen with all of them
+				if (!allowPartialStore && stores.size() != baseType.componentCount)
+					continue;
+
+				vectorized = VectorizeLanes(lanes);
+				if (vectorized.expression && !vectorized.isScalar)
+					break;
+			}
+
+			if (stores.size() >= 2)
+			{
+				VectorType storeType{ stores.size(), baseType.type };
+
+				std::array<std::uint32_t, 4> components;
+				bool isIdentity = (baseType.componentCount == stores.size());
+				for (std::size_t k = 0; k < stores.size(); ++k)
+				{
+					components[k] = stores[k].component;
+					if (components[k] != k)
+						isIdentity = false;
+				}
+
+				ExpressionPtr target = Cloner::Clone(*firstStore->base);
+				if (!isIdentity)
+				{
+					auto swizzle = ShaderBuilder::Swizzle(std::move(target), components, stores.size());
+					swizzle->cachedExpressionType = storeType;
+					swizzle->sourceLocation = swizzle->expression->sourceLocation;
+
+					target = std::move(swizzle);
+				}
+
+				auto assign = ShaderBuilder::Assign(AssignType::Simple, std::move(target), std::move(vectorized.expression));
+				assign->cachedExpressionType = storeType;
+
+				const SourceLocation& firstLocation = statements[i]->sourceLocation;
+				const SourceLocation& lastLocation = statements[i + stores.size() - 1]->sourceLocation;
+				if (firstLocation.IsValid() && lastLocation.IsValid() && firstLocation.file == lastLocation.file)
+					assign->sourceLocation = SourceLocation::BuildFromTo(firstLocation, lastLocation);
+				else
+					assign->sourceLocation = firstLocation;
+
+				vectorizedStatements.push_back(ShaderBuilder::ExpressionStatement(std::move(assign)));
+				m_changed = true;
+
+				i += stores.size();
+				continue;
+			}
+
+			vectorizedStatements.push_back(std::move(statements[i]));
+			++i;
+		}
+
+		statements = std::move(vectorizedStatements);
+	}
+}
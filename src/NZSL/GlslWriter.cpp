@@ -9,9 +9,8 @@
 #include <NZSL/Enums.hpp>
 #include <NZSL/ShaderBuilder.hpp>
 #include <NZSL/Ast/Cloner.hpp>
-#include <NZSL/Ast/ConstantPropagationVisitor.hpp>
 #include <NZSL/Ast/ConstantValue.hpp>
-#include <NZSL/Ast/EliminateUnusedPassVisitor.hpp>
+#include <NZSL/Ast/OptimizationPipeline.hpp>
 #include <NZSL/Ast/RecursiveVisitor.hpp>
 #include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/LangData.hpp>
@@ -38,10 +37,25 @@ namespace nzsl
 		{
 			None = -1,
 
+			BitManipulation, // GLSL 4.0 or GLSL ES 3.1 or GL_ARB_gpu_shader5 (also covers packUnorm4x8)
+			ComputeShader, // GLSL 4.3 or GLSL ES 3.1 or GL_ARB_compute_shader
+			Float16, // GL_EXT_shader_explicit_arithmetic_types_float16
+			ImageAtomic, // GLSL 4.2 or GLSL ES 3.2 or GL_OES_shader_image_atomic
+			ImageExtendedFormats, // GLSL 4.2 or GL_NV_image_formats
+			ImageLoadStore, // GLSL 4.2 or GLSL ES 3.1 or GL_ARB_shader_image_load_store
+			Int16, // GL_EXT_shader_explicit_arithmetic_types_int16
+			NonUniformQualifier, // GL_EXT_nonuniform_qualifier
+			PackHalf, // GLSL 4.2 or GLSL ES 3.0 or GL_ARB_shading_language_packing
 			ShaderDrawParameters_BaseInstance, // GLSL 4.6 or GL_ARB_shader_draw_parameters
 			ShaderDrawParameters_BaseVertex, // GLSL 4.6 or GL_ARB_shader_draw_parameters
 			ShaderDrawParameters_DrawIndex, // GLSL 4.6 or GL_ARB_shader_draw_parameters
 			SSBO, // GLSL 4.3 or GLSL ES 3.1 or GL_ARB_shader_storage_buffer_object
+			SubgroupArithmetic, // GL_KHR_shader_subgroup_arithmetic
+			SubgroupBallot, // GL_KHR_shader_subgroup_ballot
+			SubgroupBasic, // GL_KHR_shader_subgroup_basic
+			SubgroupShuffle, // GL_KHR_shader_subgroup_shuffle
+			TextureGather, // GLSL 4.0 or GLSL ES 3.1 or GL_ARB_texture_gather
+			TextureGatherComponent, // GLSL 4.0 or GLSL ES 3.1 or GL_ARB_gpu_shader5
 		};
 		
 		struct GlslBuiltin
@@ -51,14 +65,42 @@ namespace nzsl
 		};
 
 		constexpr auto s_glslBuiltinMapping = frozen::make_unordered_map<Ast::BuiltinEntry, GlslBuiltin>({
-			{ Ast::BuiltinEntry::BaseInstance,   { "gl_BaseInstance", GlslCapability::ShaderDrawParameters_BaseInstance } },
-			{ Ast::BuiltinEntry::BaseVertex,     { "gl_BaseVertex",   GlslCapability::ShaderDrawParameters_BaseVertex } },
-			{ Ast::BuiltinEntry::DrawIndex,      { "gl_DrawID",       GlslCapability::ShaderDrawParameters_DrawIndex } },
-			{ Ast::BuiltinEntry::FragCoord,      { "gl_FragCoord",    GlslCapability::None } },
-			{ Ast::BuiltinEntry::FragDepth,      { "gl_FragDepth",    GlslCapability::None } },
-			{ Ast::BuiltinEntry::InstanceIndex,  { "gl_InstanceID",   GlslCapability::ShaderDrawParameters_BaseInstance } },
-			{ Ast::BuiltinEntry::VertexIndex,    { "gl_VertexID",     GlslCapability::None } },
-			{ Ast::BuiltinEntry::VertexPosition, { "gl_Position",     GlslCapability::None } }
+			{ Ast::BuiltinEntry::BaseInstance,              { "gl_BaseInstance",         GlslCapability::ShaderDrawParameters_BaseInstance } },
+			{ Ast::BuiltinEntry::BaseVertex,                { "gl_BaseVertex",           GlslCapability::ShaderDrawParameters_BaseVertex } },
+			{ Ast::BuiltinEntry::DrawIndex,                 { "gl_DrawID",               GlslCapability::ShaderDrawParameters_DrawIndex } },
+			{ Ast::BuiltinEntry::FragCoord,                 { "gl_FragCoord",            GlslCapability::None } },
+			{ Ast::BuiltinEntry::FragDepth,                 { "gl_FragDepth",            GlslCapability::None } },
+			{ Ast::BuiltinEntry::GlobalInvocationId,        { "gl_GlobalInvocationID",   GlslCapability::ComputeShader } },
+			{ Ast::BuiltinEntry::InstanceIndex,             { "gl_InstanceID",           GlslCapability::ShaderDrawParameters_BaseInstance } },
+			{ Ast::BuiltinEntry::LocalInvocationId,         { "gl_LocalInvocationID",    GlslCapability::ComputeShader } },
+			{ Ast::BuiltinEntry::LocalInvocationIndex,      { "gl_LocalInvocationIndex", GlslCapability::ComputeShader } },
+			{ Ast::BuiltinEntry::SubgroupLocalInvocationId, { "gl_SubgroupInvocationID", GlslCapability::SubgroupBasic } },
+			{ Ast::BuiltinEntry::SubgroupSize,              { "gl_SubgroupSize",         GlslCapability::SubgroupBasic } },
+			{ Ast::BuiltinEntry::VertexIndex,               { "gl_VertexID",             GlslCapability::None } },
+			{ Ast::BuiltinEntry::VertexPosition,            { "gl_Position",             GlslCapability::None } },
+			{ Ast::BuiltinEntry::WorkgroupId,               { "gl_WorkGroupID",          GlslCapability::ComputeShader } }
+		});
+
+		struct GlslImageFormat
+		{
+			std::string_view identifier;
+			GlslCapability requiredCapability;
+		};
+
+		constexpr auto s_glslImageFormatMapping = frozen::make_unordered_map<ImageFormat, GlslImageFormat>({
+			{ ImageFormat::R8,       { "r8",       GlslCapability::ImageExtendedFormats } },
+			{ ImageFormat::R16f,     { "r16f",     GlslCapability::ImageExtendedFormats } },
+			{ ImageFormat::R32f,     { "r32f",     GlslCapability::None } },
+			{ ImageFormat::R32i,     { "r32i",     GlslCapability::None } },
+			{ ImageFormat::R32ui,    { "r32ui",    GlslCapability::None } },
+			{ ImageFormat::Rg8,      { "rg8",      GlslCapability::ImageExtendedFormats } },
+			{ ImageFormat::Rg16f,    { "rg16f",    GlslCapability::ImageExtendedFormats } },
+			{ ImageFormat::Rg32f,    { "rg32f",    GlslCapability::ImageExtendedFormats } },
+			{ ImageFormat::Rgba8,    { "rgba8",    GlslCapability::None } },
+			{ ImageFormat::Rgba16f,  { "rgba16f",  GlslCapability::None } },
+			{ ImageFormat::Rgba32f,  { "rgba32f",  GlslCapability::None } },
+			{ ImageFormat::Rgba32i,  { "rgba32i",  GlslCapability::None } },
+			{ ImageFormat::Rgba32ui, { "rgba32ui", GlslCapability::None } }
 		});
 
 		struct GlslWriterPreVisitor : Ast::RecursiveVisitor
@@ -78,6 +120,28 @@ namespace nzsl
 				reservedIdentifiers.insert(name);
 			}
 
+			void RegisterTypeCapabilities(const Ast::ExpressionType& type)
+			{
+				auto RegisterPrimitiveType = [&](Ast::PrimitiveType primitiveType)
+				{
+					if (primitiveType == Ast::PrimitiveType::Float16)
+						capabilities.insert(GlslCapability::Float16);
+					else if (primitiveType == Ast::PrimitiveType::Int16 || primitiveType == Ast::PrimitiveType::UInt16)
+						capabilities.insert(GlslCapability::Int16);
+				};
+
+				if (IsPrimitiveType(type))
+					RegisterPrimitiveType(std::get<Ast::PrimitiveType>(type));
+				else if (IsVectorType(type))
+					RegisterPrimitiveType(std::get<Ast::VectorType>(type).type);
+				else if (IsMatrixType(type))
+					RegisterPrimitiveType(std::get<Ast::MatrixType>(type).type);
+				else if (IsArrayType(type))
+					RegisterTypeCapabilities(std::get<Ast::ArrayType>(type).containedType->type);
+				else if (IsDynArrayType(type))
+					RegisterTypeCapabilities(std::get<Ast::DynArrayType>(type).containedType->type);
+			}
+
 			using RecursiveVisitor::Visit;
 
 			void Visit(Ast::CallFunctionExpression& node) override
@@ -88,6 +152,13 @@ namespace nzsl
 				currentFunction->calledFunctions.UnboundedSet(std::get<Ast::FunctionType>(*GetExpressionType(*node.targetFunction)).funcIndex);
 			}
 
+			void Visit(Ast::CastExpression& node) override
+			{
+				RegisterTypeCapabilities(node.targetType.GetResultingValue());
+
+				RecursiveVisitor::Visit(node);
+			}
+
 			void Visit(Ast::ConditionalExpression& /*node*/) override
 			{
 				throw std::runtime_error("unexpected conditional expression, is shader sanitized?");
@@ -102,14 +173,41 @@ namespace nzsl
 			{
 				for (const auto& extVar : node.externalVars)
 				{
-					const Ast::ExpressionType& type = extVar.type.GetResultingValue();
-					if (IsStorageType(type))
+					const Ast::ExpressionType& extVarType = extVar.type.GetResultingValue();
+
+					// Arrays of samplers and buffers (descriptor arrays) use the same declaration as their element
+					const Ast::ExpressionType* typePtr = &extVarType;
+					if (IsArrayType(extVarType))
+						typePtr = &std::get<Ast::ArrayType>(extVarType).containedType->type;
+					else if (IsDynArrayType(extVarType))
+					{
+						typePtr = &std::get<Ast::DynArrayType>(extVarType).containedType->type;
+
+						// Runtime-sized descriptor arrays are only available through GL_EXT_nonuniform_qualifier
+						if (IsSamplerType(*typePtr) || IsStorageImageType(*typePtr) || IsStorageType(*typePtr) || IsUniformType(*typePtr))
+							capabilities.insert(GlslCapability::NonUniformQualifier);
+					}
+
+					const Ast::ExpressionType& type = *typePtr;
+					if (IsStorageImageType(type))
+					{
+						capabilities.insert(GlslCapability::ImageLoadStore);
+
+						auto it = s_glslImageFormatMapping.find(std::get<Ast::StorageImageType>(type).format);
+						assert(it != s_glslImageFormatMapping.end());
+						capabilities.insert(it->second.requiredCapability);
+					}
+					else if (IsStorageType(type))
 					{
 						capabilities.insert(GlslCapability::SSBO);
 						bufferStructs.UnboundedSet(std::get<Ast::StorageType>(type).containedType.structIndex);
 					}
 					else if (IsUniformType(type))
 						bufferStructs.UnboundedSet(std::get<Ast::UniformType>(type).containedType.structIndex);
+					else if (IsPushConstantType(type))
+						bufferStructs.UnboundedSet(std::get<Ast::PushConstantType>(type).containedType.structIndex);
+					else
+						RegisterTypeCapabilities(type);
 				}
 
 				RecursiveVisitor::Visit(node);
@@ -140,6 +238,9 @@ namespace nzsl
 						entryPoint = &node;
 					}
 
+					if (node.entryStage.GetResultingValue() == ShaderStageType::Compute)
+						capabilities.insert(GlslCapability::ComputeShader);
+
 					if (!node.parameters.empty())
 					{
 						assert(node.parameters.size() == 1);
@@ -168,6 +269,12 @@ namespace nzsl
 					}
 				}
 
+				for (const auto& parameter : node.parameters)
+					RegisterTypeCapabilities(parameter.type.GetResultingValue());
+
+				if (node.returnType.HasValue())
+					RegisterTypeCapabilities(node.returnType.GetResultingValue());
+
 				assert(node.funcIndex);
 				assert(functions.find(node.funcIndex.value()) == functions.end());
 				FunctionData& funcData = functions[node.funcIndex.value()];
@@ -188,6 +295,8 @@ namespace nzsl
 				for (const auto& member : node.description.members)
 				{
 					const Ast::ExpressionType& type = member.type.GetResultingValue();
+					RegisterTypeCapabilities(type);
+
 					if (IsStorageType(type))
 						usedStructs.UnboundedSet(std::get<Ast::StorageType>(type).containedType.structIndex);
 					else if (IsUniformType(type))
@@ -204,6 +313,75 @@ namespace nzsl
 					usedStructs.UnboundedSet(std::get<Ast::StorageType>(type).containedType.structIndex);
 				else if (IsUniformType(type))
 					usedStructs.UnboundedSet(std::get<Ast::UniformType>(type).containedType.structIndex);
+				else
+					RegisterTypeCapabilities(type);
+
+				RecursiveVisitor::Visit(node);
+			}
+
+			void Visit(Ast::IntrinsicExpression& node) override
+			{
+				switch (node.intrinsic)
+				{
+					case Ast::IntrinsicType::BitCount:
+					case Ast::IntrinsicType::BitFieldExtract:
+					case Ast::IntrinsicType::BitFieldInsert:
+					case Ast::IntrinsicType::FirstBitHigh:
+					case Ast::IntrinsicType::FirstBitLow:
+					case Ast::IntrinsicType::PackUnorm4x8:
+					case Ast::IntrinsicType::UnpackUnorm4x8:
+						capabilities.insert(GlslCapability::BitManipulation);
+						break;
+
+					case Ast::IntrinsicType::ImageAtomicAdd:
+					case Ast::IntrinsicType::ImageAtomicAnd:
+					case Ast::IntrinsicType::ImageAtomicExchange:
+					case Ast::IntrinsicType::ImageAtomicMax:
+					case Ast::IntrinsicType::ImageAtomicMin:
+					case Ast::IntrinsicType::ImageAtomicOr:
+					case Ast::IntrinsicType::ImageAtomicXor:
+						capabilities.insert(GlslCapability::ImageAtomic);
+						break;
+
+					case Ast::IntrinsicType::NonUniform:
+						capabilities.insert(GlslCapability::NonUniformQualifier);
+						break;
+
+					case Ast::IntrinsicType::PackHalf2x16:
+					case Ast::IntrinsicType::UnpackHalf2x16:
+						capabilities.insert(GlslCapability::PackHalf);
+						break;
+
+					case Ast::IntrinsicType::SubgroupAdd:
+					case Ast::IntrinsicType::SubgroupMax:
+					case Ast::IntrinsicType::SubgroupMin:
+						capabilities.insert(GlslCapability::SubgroupBasic);
+						capabilities.insert(GlslCapability::SubgroupArithmetic);
+						break;
+
+					case Ast::IntrinsicType::SubgroupBallot:
+					case Ast::IntrinsicType::SubgroupBroadcastFirst:
+						capabilities.insert(GlslCapability::SubgroupBasic);
+						capabilities.insert(GlslCapability::SubgroupBallot);
+						break;
+
+					case Ast::IntrinsicType::SubgroupElect:
+						capabilities.insert(GlslCapability::SubgroupBasic);
+						break;
+
+					case Ast::IntrinsicType::SubgroupShuffle:
+						capabilities.insert(GlslCapability::SubgroupBasic);
+						capabilities.insert(GlslCapability::SubgroupShuffle);
+						break;
+
+					case Ast::IntrinsicType::TextureGather:
+						// Selecting the gathered component came with GL_ARB_gpu_shader5
+						capabilities.insert((node.parameters.size() > 2) ? GlslCapability::TextureGatherComponent : GlslCapability::TextureGather);
+						break;
+
+					default:
+						break;
+				}
 
 				RecursiveVisitor::Visit(node);
 			}
@@ -239,7 +417,7 @@ namespace nzsl
 				// All reserved GLSL keywords as of GLSL ES 3.2
 				"active", "asm", "atomic_uint", "attribute", "bool", "break", "buffer", "bvec2", "bvec3", "bvec4", "case", "cast", "centroid", "class", "coherent", "common", "const", "continue", "default", "discard", "dmat2", "dmat2x2", "dmat2x3", "dmat2x4", "dmat3", "dmat3x2", "dmat3x3", "dmat3x4", "dmat4", "dmat4x2", "dmat4x3", "dmat4x4", "do", "double", "dvec2", "dvec3", "dvec4", "else", "enum", "extern", "external", "false", "filter", "fixed", "flat", "float", "for", "fvec2", "fvec3", "fvec4", "goto", "half", "highp", "hvec2", "hvec3", "hvec4", "if", "iimage1D", "iimage1DArray", "iimage2D", "iimage2DArray", "iimage2DMS", "iimage2DMSArray", "iimage2DRect", "iimage3D", "iimageBuffer", "iimageCube", "iimageCubeArray", "image1D", "image1DArray", "image2D", "image2DArray", "image2DMS", "image2DMSArray", "image2DRect", "image3D", "imageBuffer", "imageCube", "imageCubeArray", "in", "inline", "inout", "input", "int", "interface", "invariant", "isampler1D", "isampler1DArray", "isampler2D", "isampler2DArray", "isampler2DMS", "isampler2DMSArray", "isampler2DRect", "isampler3D", "isamplerBuffer", "isamplerCube", "isamplerCubeArray", "isubpassInput", "isubpassInputMS", "itexture2D", "itexture2DArray", "itexture2DMS", "itexture2DMSArray", "itexture3D", "itextureBuffer", "itextureCube", "itextureCubeArray", "ivec2", "ivec3", "ivec4", "layout", "long", "lowp", "mat2", "mat2x2", "mat2x3", "mat2x4", "mat3", "mat3x2", "mat3x3", "mat3x4", "mat4", "mat4x2", "mat4x3", "mat4x4", "mediump", "namespace", "noinline", "noperspective", "out", "output", "partition", "patch", "precise", "precision", "public", "readonly", "resource", "restrict", "return", "sample", "sampler", "sampler1D", "sampler1DArray", "sampler1DArrayShadow", "sampler1DShadow", "sampler2D", "sampler2DArray", "sampler2DArrayShadow", "sampler2DMS", "sampler2DMSArray", "sampler2DRect", "sampler2DRectShadow", "sampler2DShadow", "sampler3D", "sampler3DRect", "samplerBuffer", "samplerCube", "samplerCubeArray", "samplerCubeArrayShadow", "samplerCubeShadow", "samplerShadow", "shared", "short", "sizeof", "smooth", "static", "struct", "subpassInput", "subpassInputMS", "subroutine", "superp", "switch", "template", "texture2D", "texture2DArray", "texture2DMS", "texture2DMSArray", "texture3D", "textureBuffer", "textureCube", "textureCubeArray", "this", "true", "typedef", "uimage1D", "uimage1DArray", "uimage2D", "uimage2DArray", "uimage2DMS", "uimage2DMSArray", "uimage2DRect", "uimage3D", "uimageBuffer", "uimageCube", "uimageCubeArray", "uint", "uniform", "union", "unsigned", "usampler1D", "usampler1DArray", "usampler2D", "usampler2DArray", "usampler2DMS", "usampler2DMSArray", "usampler2DRect", "usampler3D", "usamplerBuffer", "usamplerCube", "usamplerCubeArray", "using", "usubpassInput", "usubpassInputMS", "utexture2D", "utexture2DArray", "utexture2DMS", "utexture2DMSArray", "utexture3D", "utextureBuffer", "utextureCube", "utextureCubeArray", "uvec2", "uvec3", "uvec4", "varying", "vec2", "vec3", "vec4", "void", "volatile", "while", "writeonly",
 				// GLSL intrinsic functions (WIP)
-				"cross", "dot", "exp", "inverse", "length", "max", "min", "mod", "normalize", "pow", "texture", "transpose"
+				"atomicAdd", "atomicAnd", "atomicCompSwap", "atomicExchange", "atomicMax", "atomicMin", "atomicOr", "atomicXor", "barrier", "bitCount", "bitfieldExtract", "bitfieldInsert", "cross", "dot", "exp", "findLSB", "findMSB", "inverse", "length", "max", "memoryBarrier", "memoryBarrierBuffer", "memoryBarrierImage", "memoryBarrierShared", "min", "mod", "normalize", "packHalf2x16", "packUnorm4x8", "pow", "texture", "transpose", "unpackHalf2x16", "unpackUnorm4x8"
 			};
 		}
 
@@ -264,6 +442,7 @@ namespace nzsl
 		std::unordered_map<std::size_t, std::string> variableNames;
 		std::unordered_map<std::string, unsigned int> explicitUniformBlockBinding;
 		std::unordered_set<std::string> reservedKeywords;
+		std::string pushConstantBlockName;
 		Nz::Bitset<> declaredFunctions;
 		const GlslWriter::BindingMapping& bindingMapping;
 		GlslWriterPreVisitor previsitor;
@@ -303,16 +482,21 @@ namespace nzsl
 		else
 			targetModule = &module;
 
-		if (states.optimize)
-		{
-			sanitizedModule = Ast::PropagateConstants(*targetModule);
-
-			Ast::DependencyCheckerVisitor::Config dependencyConfig;
-			dependencyConfig.usedShaderStages = (shaderStage) ? *shaderStage : ShaderStageType_All; //< only one should exist anyway
+		OptimizationLevel optimizationLevel = states.optimizationLevel;
+		if (optimizationLevel == OptimizationLevel::O0 && states.optimize)
+			optimizationLevel = OptimizationLevel::O1;
 
-			sanitizedModule = Ast::EliminateUnusedPass(*sanitizedModule, dependencyConfig);
+		if (optimizationLevel != OptimizationLevel::O0)
+		{
+			Ast::OptimizationPipeline::Options optimizationOptions;
+			optimizationOptions.dependencyConfig.usedShaderStages = (shaderStage) ? *shaderStage : ShaderStageType_All; //< only one should exist anyway
 
-			targetModule = sanitizedModule.get();
+			Ast::OptimizationPipeline optimizationPipeline(optimizationLevel, optimizationOptions);
+			if (Ast::ModulePtr optimizedModule = optimizationPipeline.Process(*targetModule))
+			{
+				sanitizedModule = std::move(optimizedModule);
+				targetModule = sanitizedModule.get();
+			}
 		}
 
 		// Previsitor
@@ -365,6 +549,7 @@ namespace nzsl
 		Output output;
 		output.code = std::move(state.stream).str();
 		output.explicitUniformBlockBinding = std::move(state.explicitUniformBlockBinding);
+		output.pushConstantBlockName = std::move(state.pushConstantBlockName);
 		output.usesDrawParameterBaseInstanceUniform = m_currentState->hasDrawParametersBaseInstanceUniform;
 		output.usesDrawParameterBaseVertexUniform = m_currentState->hasDrawParametersBaseVertexUniform;
 		output.usesDrawParameterDrawIndexUniform = m_currentState->hasDrawParametersDrawIndexUniform;
@@ -506,6 +691,9 @@ namespace nzsl
 
 	void GlslWriter::Append(const Ast::MatrixType& matrixType)
 	{
+		if (matrixType.type == Ast::PrimitiveType::Float16)
+			Append("f16");
+
 		if (matrixType.columnCount == matrixType.rowCount)
 		{
 			Append("mat");
@@ -530,13 +718,21 @@ namespace nzsl
 		switch (type)
 		{
 			case Ast::PrimitiveType::Boolean: return Append("bool");
+			case Ast::PrimitiveType::Float16: return Append("float16_t");
 			case Ast::PrimitiveType::Float32: return Append("float");
+			case Ast::PrimitiveType::Int16:   return Append("int16_t");
 			case Ast::PrimitiveType::Int32:   return Append("int");
+			case Ast::PrimitiveType::UInt16:  return Append("uint16_t");
 			case Ast::PrimitiveType::UInt32:  return Append("uint");
 			case Ast::PrimitiveType::String:  throw std::runtime_error("unexpected string constant");
 		}
 	}
 
+	void GlslWriter::Append(const Ast::PushConstantType& /*pushConstantType*/)
+	{
+		throw std::runtime_error("unexpected PushConstantType");
+	}
+
 	void GlslWriter::Append(const Ast::SamplerType& samplerType)
 	{
 		switch (samplerType.sampledType)
@@ -548,6 +744,11 @@ namespace nzsl
 			case Ast::PrimitiveType::Int32:   Append("i"); break;
 			case Ast::PrimitiveType::UInt32:  Append("u"); break;
 
+			case Ast::PrimitiveType::Float16:
+			case Ast::PrimitiveType::Int16:
+			case Ast::PrimitiveType::UInt16:
+				throw std::runtime_error("unexpected 16-bit sampled type");
+
 			case Ast::PrimitiveType::String:  throw std::runtime_error("unexpected string type");
 		}
 
@@ -564,6 +765,38 @@ namespace nzsl
 		}
 	}
 
+	void GlslWriter::Append(const Ast::StorageImageType& storageImageType)
+	{
+		switch (storageImageType.sampledType)
+		{
+			case Ast::PrimitiveType::Boolean:
+			case Ast::PrimitiveType::Float32:
+				break;
+
+			case Ast::PrimitiveType::Int32:   Append("i"); break;
+			case Ast::PrimitiveType::UInt32:  Append("u"); break;
+
+			case Ast::PrimitiveType::Float16:
+			case Ast::PrimitiveType::Int16:
+			case Ast::PrimitiveType::UInt16:
+				throw std::runtime_error("unexpected 16-bit sampled type");
+
+			case Ast::PrimitiveType::String:  throw std::runtime_error("unexpected string type");
+		}
+
+		Append("image");
+
+		switch (storageImageType.dim)
+		{
+			case ImageType::E1D:       Append("1D");      break;
+			case ImageType::E1D_Array: Append("1DArray"); break;
+			case ImageType::E2D:       Append("2D");      break;
+			case ImageType::E2D_Array: Append("2DArray"); break;
+			case ImageType::E3D:       Append("3D");      break;
+			case ImageType::Cubemap:   Append("Cube");    break;
+		}
+	}
+
 	void GlslWriter::Append(const Ast::StorageType& /*storageType*/)
 	{
 		throw std::runtime_error("unexpected StorageType");
@@ -590,8 +823,11 @@ namespace nzsl
 		switch (vecType.type)
 		{
 			case Ast::PrimitiveType::Boolean: Append("b"); break;
+			case Ast::PrimitiveType::Float16: Append("f16"); break;
 			case Ast::PrimitiveType::Float32: break;
+			case Ast::PrimitiveType::Int16:   Append("i16"); break;
 			case Ast::PrimitiveType::Int32:   Append("i"); break;
+			case Ast::PrimitiveType::UInt16:  Append("u16"); break;
 			case Ast::PrimitiveType::UInt32:  Append("u"); break;
 			case Ast::PrimitiveType::String:  throw std::runtime_error("unexpected string type");
 		}
@@ -607,6 +843,14 @@ namespace nzsl
 			case Ast::MemoryLayout::Std140:
 				Append("std140");
 				break;
+
+			case Ast::MemoryLayout::Std430:
+				Append("std430");
+				break;
+
+			case Ast::MemoryLayout::Scalar:
+				Append("scalar");
+				break;
 		}
 	}
 
@@ -728,6 +972,7 @@ namespace nzsl
 
 			first = false;
 
+			AppendPrecisionQualifier(parameter.precision);
 			AppendVariableDeclaration(parameter.type.GetResultingValue(), SanitizeIdentifier(parameter.name));
 		}
 		AppendLine((forward) ? ");" : ")");
@@ -778,6 +1023,7 @@ namespace nzsl
 
 		switch (m_currentState->stage)
 		{
+			case ShaderStageType::Compute: fileTitle += "compute shader - "; break;
 			case ShaderStageType::Fragment: fileTitle += "fragment shader - "; break;
 			case ShaderStageType::Vertex: fileTitle += "vertex shader - "; break;
 		}
@@ -798,6 +1044,134 @@ namespace nzsl
 				case GlslCapability::None:
 					break;
 
+				case GlslCapability::BitManipulation:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 310)
+							throw std::runtime_error("this version of OpenGL ES does not support bit manipulation functions");
+					}
+					else if (glslVersion < 400)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_gpu_shader5"))
+							requiredExtensions.emplace("GL_ARB_gpu_shader5");
+						else
+							throw std::runtime_error("this version of OpenGL does not support bit manipulation functions");
+					}
+
+					break;
+				}
+
+				case GlslCapability::ComputeShader:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 310)
+							throw std::runtime_error("this version of OpenGL ES does not support compute shaders");
+					}
+					else if (glslVersion < 430)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_compute_shader"))
+							requiredExtensions.emplace("GL_ARB_compute_shader");
+						else
+							throw std::runtime_error("this version of OpenGL does not support compute shaders");
+					}
+
+					break;
+				}
+
+				case GlslCapability::Float16:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_EXT_shader_explicit_arithmetic_types_float16"))
+						requiredExtensions.emplace("GL_EXT_shader_explicit_arithmetic_types_float16");
+					else
+						throw std::runtime_error("this version of OpenGL does not support 16-bit floating-point types");
+
+					break;
+				}
+
+				case GlslCapability::ImageAtomic:
+				{
+					if (m_environment.glES && glslVersion < 320)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_OES_shader_image_atomic"))
+							requiredExtensions.emplace("GL_OES_shader_image_atomic");
+						else
+							throw std::runtime_error("this version of OpenGL ES does not support image atomic operations");
+					}
+
+					break;
+				}
+
+				case GlslCapability::ImageExtendedFormats:
+				{
+					if (m_environment.glES)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_NV_image_formats"))
+							requiredExtensions.emplace("GL_NV_image_formats");
+						else
+							throw std::runtime_error("this version of OpenGL ES does not support this image format");
+					}
+
+					break;
+				}
+
+				case GlslCapability::ImageLoadStore:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 310)
+							throw std::runtime_error("this version of OpenGL ES does not support image load/store");
+					}
+					else if (glslVersion < 420)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_shader_image_load_store"))
+							requiredExtensions.emplace("GL_ARB_shader_image_load_store");
+						else
+							throw std::runtime_error("this version of OpenGL does not support image load/store");
+					}
+
+					break;
+				}
+
+				case GlslCapability::Int16:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_EXT_shader_explicit_arithmetic_types_int16"))
+						requiredExtensions.emplace("GL_EXT_shader_explicit_arithmetic_types_int16");
+					else
+						throw std::runtime_error("this version of OpenGL does not support 16-bit integer types");
+
+					break;
+				}
+
+				case GlslCapability::NonUniformQualifier:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_EXT_nonuniform_qualifier"))
+						requiredExtensions.emplace("GL_EXT_nonuniform_qualifier");
+					else
+						throw std::runtime_error("this version of OpenGL does not support non-uniform descriptor indexing");
+
+					break;
+				}
+
+				case GlslCapability::PackHalf:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 300)
+							throw std::runtime_error("this version of OpenGL ES does not support half-float packing");
+					}
+					else if (glslVersion < 420)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_shading_language_packing"))
+							requiredExtensions.emplace("GL_ARB_shading_language_packing");
+						else
+							throw std::runtime_error("this version of OpenGL does not support half-float packing");
+					}
+
+					break;
+				}
+
 				case GlslCapability::ShaderDrawParameters_BaseInstance:
 				{
 					if (m_environment.glES)
@@ -860,6 +1234,82 @@ namespace nzsl
 					
 					break;
 				}
+
+				case GlslCapability::SubgroupArithmetic:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_KHR_shader_subgroup_arithmetic"))
+						requiredExtensions.emplace("GL_KHR_shader_subgroup_arithmetic");
+					else
+						throw std::runtime_error("this version of OpenGL does not support subgroup arithmetic operations");
+
+					break;
+				}
+
+				case GlslCapability::SubgroupBallot:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_KHR_shader_subgroup_ballot"))
+						requiredExtensions.emplace("GL_KHR_shader_subgroup_ballot");
+					else
+						throw std::runtime_error("this version of OpenGL does not support subgroup ballot operations");
+
+					break;
+				}
+
+				case GlslCapability::SubgroupBasic:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_KHR_shader_subgroup_basic"))
+						requiredExtensions.emplace("GL_KHR_shader_subgroup_basic");
+					else
+						throw std::runtime_error("this version of OpenGL does not support subgroup operations");
+
+					break;
+				}
+
+				case GlslCapability::SubgroupShuffle:
+				{
+					if (m_environment.extCallback && m_environment.extCallback("GL_KHR_shader_subgroup_shuffle"))
+						requiredExtensions.emplace("GL_KHR_shader_subgroup_shuffle");
+					else
+						throw std::runtime_error("this version of OpenGL does not support subgroup shuffle operations");
+
+					break;
+				}
+
+				case GlslCapability::TextureGather:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 310)
+							throw std::runtime_error("this version of OpenGL ES does not support texture gathering");
+					}
+					else if (glslVersion < 400)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_texture_gather"))
+							requiredExtensions.emplace("GL_ARB_texture_gather");
+						else
+							throw std::runtime_error("this version of OpenGL does not support texture gathering");
+					}
+
+					break;
+				}
+
+				case GlslCapability::TextureGatherComponent:
+				{
+					if (m_environment.glES)
+					{
+						if (glslVersion < 310)
+							throw std::runtime_error("this version of OpenGL ES does not support texture gathering");
+					}
+					else if (glslVersion < 400)
+					{
+						if (m_environment.extCallback && m_environment.extCallback("GL_ARB_gpu_shader5"))
+							requiredExtensions.emplace("GL_ARB_gpu_shader5");
+						else
+							throw std::runtime_error("this version of OpenGL does not support texture gathering with component selection");
+					}
+
+					break;
+				}
 			}
 		}
 
@@ -986,6 +1436,16 @@ namespace nzsl
 			AppendComment("License: " + metadata.license);
 	}
 
+	void GlslWriter::AppendPrecisionQualifier(const Ast::ExpressionValue<Ast::Precision>& precision)
+	{
+		// Desktop GLSL ignores precision qualifiers and high precision is the default in GLSL ES (see AppendHeader)
+		if (!m_environment.glES || !precision.IsResultingValue())
+			return;
+
+		if (precision.GetResultingValue() == Ast::Precision::Medium)
+			Append("mediump ");
+	}
+
 	void GlslWriter::AppendStatementList(std::vector<Ast::StatementPtr>& statements)
 	{
 		bool first = true;
@@ -1044,6 +1504,13 @@ namespace nzsl
 			}
 		}
 
+		if (node.entryStage.GetResultingValue() == ShaderStageType::Compute)
+		{
+			assert(node.workgroupSize[0].HasValue());
+			AppendLine("layout(local_size_x = ", node.workgroupSize[0].GetResultingValue(), ", local_size_y = ", node.workgroupSize[1].GetResultingValue(), ", local_size_z = ", node.workgroupSize[2].GetResultingValue(), ") in;");
+			AppendLine();
+		}
+
 		HandleInOut();
 		AppendLine("void main()");
 		EnterScope();
@@ -1112,6 +1579,7 @@ namespace nzsl
 					auto OutputVariable = [&](auto&&... arg)
 					{
 						Append((in) ? "in" : "out", " ");
+						AppendPrecisionQualifier(member.precision);
 						AppendVariableDeclaration(member.type.GetResultingValue(), varName);
 						AppendLine(";", arg...);
 					};
@@ -1281,13 +1749,13 @@ namespace nzsl
 			if (IsPrimitiveType(*node.cachedExpressionType))
 			{
 				Ast::PrimitiveType primitiveType = std::get<Ast::PrimitiveType>(*node.cachedExpressionType);
-				if (primitiveType == Ast::PrimitiveType::Float32)
+				if (primitiveType == Ast::PrimitiveType::Float16 || primitiveType == Ast::PrimitiveType::Float32)
 					isFmod = true;
 			}
 			else if (IsVectorType(*node.cachedExpressionType))
 			{
 				Ast::PrimitiveType primitiveType = std::get<Ast::VectorType>(*node.cachedExpressionType).type;
-				if (primitiveType == Ast::PrimitiveType::Float32)
+				if (primitiveType == Ast::PrimitiveType::Float16 || primitiveType == Ast::PrimitiveType::Float32)
 					isFmod = true;
 			}
 			else
@@ -1312,11 +1780,16 @@ namespace nzsl
 		{
 			case Ast::AssignType::Simple:             Append(" = "); break;
 			case Ast::AssignType::CompoundAdd:        Append(" += "); break;
+			case Ast::AssignType::CompoundBitwiseAnd: Append(" &= "); break;
+			case Ast::AssignType::CompoundBitwiseOr:  Append(" |= "); break;
+			case Ast::AssignType::CompoundBitwiseXor: Append(" ^= "); break;
 			case Ast::AssignType::CompoundDivide:     Append(" /= "); break;
 			case Ast::AssignType::CompoundModulo:     Append(" %= "); break;
 			case Ast::AssignType::CompoundMultiply:   Append(" *= "); break;
 			case Ast::AssignType::CompoundLogicalAnd: Append(" &&= "); break;
 			case Ast::AssignType::CompoundLogicalOr:  Append(" ||= "); break;
+			case Ast::AssignType::CompoundShiftLeft:  Append(" <<= "); break;
+			case Ast::AssignType::CompoundShiftRight: Append(" >>= "); break;
 			case Ast::AssignType::CompoundSubtract:   Append(" -= "); break;
 		}
 
@@ -1332,13 +1805,13 @@ namespace nzsl
 			if (IsPrimitiveType(*node.cachedExpressionType))
 			{
 				Ast::PrimitiveType primitiveType = std::get<Ast::PrimitiveType>(*node.cachedExpressionType);
-				if (primitiveType == Ast::PrimitiveType::Float32)
+				if (primitiveType == Ast::PrimitiveType::Float16 || primitiveType == Ast::PrimitiveType::Float32)
 					isFmod = true;
 			}
 			else if (IsVectorType(*node.cachedExpressionType))
 			{
 				Ast::PrimitiveType primitiveType = std::get<Ast::VectorType>(*node.cachedExpressionType).type;
-				if (primitiveType == Ast::PrimitiveType::Float32)
+				if (primitiveType == Ast::PrimitiveType::Float16 || primitiveType == Ast::PrimitiveType::Float32)
 					isFmod = true;
 			}
 			else
@@ -1375,6 +1848,12 @@ namespace nzsl
 
 			case Ast::BinaryType::LogicalAnd: Append(" && "); break;
 			case Ast::BinaryType::LogicalOr:  Append(" || "); break;
+
+			case Ast::BinaryType::BitwiseAnd: Append(" & ");  break;
+			case Ast::BinaryType::BitwiseOr:  Append(" | ");  break;
+			case Ast::BinaryType::BitwiseXor: Append(" ^ ");  break;
+			case Ast::BinaryType::ShiftLeft:  Append(" << "); break;
+			case Ast::BinaryType::ShiftRight: Append(" >> "); break;
 		}
 
 		Visit(node.right, true);
@@ -1477,6 +1956,54 @@ namespace nzsl
 				method = true;
 				break;
 
+			case Ast::IntrinsicType::AtomicAdd:
+				Append("atomicAdd");
+				break;
+
+			case Ast::IntrinsicType::AtomicAnd:
+				Append("atomicAnd");
+				break;
+
+			case Ast::IntrinsicType::AtomicCompareExchange:
+				Append("atomicCompSwap");
+				break;
+
+			case Ast::IntrinsicType::AtomicExchange:
+				Append("atomicExchange");
+				break;
+
+			case Ast::IntrinsicType::AtomicMax:
+				Append("atomicMax");
+				break;
+
+			case Ast::IntrinsicType::AtomicMin:
+				Append("atomicMin");
+				break;
+
+			case Ast::IntrinsicType::AtomicOr:
+				Append("atomicOr");
+				break;
+
+			case Ast::IntrinsicType::AtomicXor:
+				Append("atomicXor");
+				break;
+
+			case Ast::IntrinsicType::Barrier:
+				Append("barrier");
+				break;
+
+			case Ast::IntrinsicType::BitCount:
+				Append("bitCount");
+				break;
+
+			case Ast::IntrinsicType::BitFieldExtract:
+				Append("bitfieldExtract");
+				break;
+
+			case Ast::IntrinsicType::BitFieldInsert:
+				Append("bitfieldInsert");
+				break;
+
 			case Ast::IntrinsicType::CrossProduct:
 				Append("cross");
 				break;
@@ -1489,6 +2016,50 @@ namespace nzsl
 				Append("exp");
 				break;
 
+			case Ast::IntrinsicType::FirstBitHigh:
+				Append("findMSB");
+				break;
+
+			case Ast::IntrinsicType::FirstBitLow:
+				Append("findLSB");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicAdd:
+				Append("imageAtomicAdd");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicAnd:
+				Append("imageAtomicAnd");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicExchange:
+				Append("imageAtomicExchange");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicMax:
+				Append("imageAtomicMax");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicMin:
+				Append("imageAtomicMin");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicOr:
+				Append("imageAtomicOr");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicXor:
+				Append("imageAtomicXor");
+				break;
+
+			case Ast::IntrinsicType::ImageLoad:
+				Append("imageLoad");
+				break;
+
+			case Ast::IntrinsicType::ImageStore:
+				Append("imageStore");
+				break;
+
 			case Ast::IntrinsicType::Inverse:
 				Append("inverse");
 				break;
@@ -1501,14 +2072,42 @@ namespace nzsl
 				Append("max");
 				break;
 
+			case Ast::IntrinsicType::MemoryBarrier:
+				Append("memoryBarrier");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierBuffer:
+				Append("memoryBarrierBuffer");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierImage:
+				Append("memoryBarrierImage");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierShared:
+				Append("memoryBarrierShared");
+				break;
+
 			case Ast::IntrinsicType::Min:
 				Append("min");
 				break;
 
+			case Ast::IntrinsicType::NonUniform:
+				Append("nonuniformEXT");
+				break;
+
 			case Ast::IntrinsicType::Normalize:
 				Append("normalize");
 				break;
 
+			case Ast::IntrinsicType::PackHalf2x16:
+				Append("packHalf2x16");
+				break;
+
+			case Ast::IntrinsicType::PackUnorm4x8:
+				Append("packUnorm4x8");
+				break;
+
 			case Ast::IntrinsicType::Pow:
 				Append("pow");
 				break;
@@ -1521,10 +2120,65 @@ namespace nzsl
 				Append("texture");
 				break;
 
+			case Ast::IntrinsicType::SampleTextureGrad:
+				Append("textureGrad");
+				break;
+
+			case Ast::IntrinsicType::SampleTextureLod:
+				Append("textureLod");
+				break;
+
+			case Ast::IntrinsicType::SubgroupAdd:
+				Append("subgroupAdd");
+				break;
+
+			case Ast::IntrinsicType::SubgroupBallot:
+				Append("subgroupBallot");
+				break;
+
+			case Ast::IntrinsicType::SubgroupBroadcastFirst:
+				Append("subgroupBroadcastFirst");
+				break;
+
+			case Ast::IntrinsicType::SubgroupElect:
+				Append("subgroupElect");
+				break;
+
+			case Ast::IntrinsicType::SubgroupMax:
+				Append("subgroupMax");
+				break;
+
+			case Ast::IntrinsicType::SubgroupMin:
+				Append("subgroupMin");
+				break;
+
+			case Ast::IntrinsicType::SubgroupShuffle:
+				Append("subgroupShuffle");
+				break;
+
+			case Ast::IntrinsicType::TextureFetch:
+				Append("texelFetch");
+				break;
+
+			case Ast::IntrinsicType::TextureGather:
+				Append("textureGather");
+				break;
+
+			case Ast::IntrinsicType::TextureSize:
+				Append("textureSize");
+				break;
+
 			case Ast::IntrinsicType::Transpose:
 				Append("transpose");
 				break;
 
+			case Ast::IntrinsicType::UnpackHalf2x16:
+				Append("unpackHalf2x16");
+				break;
+
+			case Ast::IntrinsicType::UnpackUnorm4x8:
+				Append("unpackUnorm4x8");
+				break;
 		}
 
 		Append("(");
@@ -1557,6 +2211,11 @@ namespace nzsl
 	{
 		switch (node.op)
 		{
+			case Ast::UnaryType::BitwiseNot:
+				Append("~");
+				Visit(node.expression, true);
+				return;
+
 			case Ast::UnaryType::LogicalNot:
 				Append("!");
 				break;
@@ -1640,31 +2299,100 @@ namespace nzsl
 		for (const auto& externalVar : node.externalVars)
 		{
 			const Ast::ExpressionType& exprType = externalVar.type.GetResultingValue();
+
+			if (externalVar.isWorkgroupShared.HasValue() && externalVar.isWorkgroupShared.GetResultingValue())
+			{
+				std::string varName = SanitizeIdentifier(externalVar.name + m_currentState->moduleSuffix);
+
+				Append("shared ");
+				AppendPrecisionQualifier(externalVar.precision);
+				AppendVariableDeclaration(exprType, varName);
+				AppendLine(";");
+
+				assert(externalVar.varIndex);
+				RegisterVariable(*externalVar.varIndex, varName);
+				continue;
+			}
 			
-			bool isUniformOrStorage = IsStorageType(exprType) || IsUniformType(exprType);
+			// Arrays of buffers are declared as a single block with an array instance name
+			const Ast::ExpressionType* blockType = &exprType;
+			std::optional<std::uint32_t> blockArrayLength; //< 0 for unsized arrays
+			if (IsArrayType(exprType))
+			{
+				const auto& arrayType = std::get<Ast::ArrayType>(exprType);
+				if (IsStorageType(arrayType.containedType->type) || IsUniformType(arrayType.containedType->type))
+				{
+					blockType = &arrayType.containedType->type;
+					blockArrayLength = arrayType.length;
+				}
+			}
+			else if (IsDynArrayType(exprType))
+			{
+				const auto& arrayType = std::get<Ast::DynArrayType>(exprType);
+				if (IsStorageType(arrayType.containedType->type) || IsUniformType(arrayType.containedType->type))
+				{
+					blockType = &arrayType.containedType->type;
+					blockArrayLength = 0;
+				}
+			}
+
+			bool isPushConstant = IsPushConstantType(*blockType);
+			bool isUniformOrStorage = isPushConstant || IsStorageType(*blockType) || IsUniformType(*blockType);
 
-			bool isStd140 = false;
+			// Storage images carry their format in the layout qualifier
+			const Ast::StorageImageType* storageImageType = nullptr;
+			if (IsStorageImageType(exprType))
+				storageImageType = &std::get<Ast::StorageImageType>(exprType);
+			else if (IsArrayType(exprType) && IsStorageImageType(std::get<Ast::ArrayType>(exprType).containedType->type))
+				storageImageType = &std::get<Ast::StorageImageType>(std::get<Ast::ArrayType>(exprType).containedType->type);
+			else if (IsDynArrayType(exprType) && IsStorageImageType(std::get<Ast::DynArrayType>(exprType).containedType->type))
+				storageImageType = &std::get<Ast::StorageImageType>(std::get<Ast::DynArrayType>(exprType).containedType->type);
+
+			std::size_t structIndex = 0;
+			std::optional<Ast::MemoryLayout> memoryLayout;
 			if (isUniformOrStorage)
 			{
-				std::size_t structIndex;
-				if (IsStorageType(exprType))
-					structIndex = std::get<Ast::StorageType>(exprType).containedType.structIndex;
-				else if (IsUniformType(exprType))
-					structIndex = std::get<Ast::UniformType>(exprType).containedType.structIndex;
+				if (IsPushConstantType(*blockType))
+					structIndex = std::get<Ast::PushConstantType>(*blockType).containedType.structIndex;
+				else if (IsStorageType(*blockType))
+					structIndex = std::get<Ast::StorageType>(*blockType).containedType.structIndex;
+				else if (IsUniformType(*blockType))
+					structIndex = std::get<Ast::UniformType>(*blockType).containedType.structIndex;
 				else
 					throw std::runtime_error("unexpected type");
 				
 				const auto& structInfo = Nz::Retrieve(m_currentState->structs, structIndex);
 				if (structInfo.desc->layout.HasValue())
-					isStd140 = structInfo.desc->layout.GetResultingValue() == StructLayout::Std140;
+				{
+					switch (structInfo.desc->layout.GetResultingValue())
+					{
+						case StructLayout::Packed:
+							break;
+
+						case StructLayout::Scalar:
+							throw std::runtime_error("scalar layout is not supported by GLSL");
+
+						case StructLayout::Std140:
+							memoryLayout = Ast::MemoryLayout::Std140;
+							break;
+
+						case StructLayout::Std430:
+							// push constants are emulated with uniform blocks, which don't support std430
+							memoryLayout = (isPushConstant) ? Ast::MemoryLayout::Std140 : Ast::MemoryLayout::Std430;
+							break;
+					}
+				}
 			}
 
 			std::string varName = SanitizeIdentifier(externalVar.name + m_currentState->moduleSuffix);
 
-			if (!m_currentState->bindingMapping.empty() || isStd140)
+			// Push constants have no binding, the engine has to look up the block by its name
+			bool hasBinding = !isPushConstant && !m_currentState->bindingMapping.empty();
+
+			if (hasBinding || memoryLayout || storageImageType)
 				Append("layout(");
 
-			if (!m_currentState->bindingMapping.empty())
+			if (hasBinding)
 			{
 				assert(externalVar.bindingIndex.HasValue());
 
@@ -1682,32 +2410,72 @@ namespace nzsl
 				if (!m_currentState->requiresExplicitUniformBinding)
 				{
 					Append("binding = ", bindingIt->second);
-					if (isStd140)
+					if (memoryLayout || storageImageType)
 						Append(", ");
 				}
 				else
 					m_currentState->explicitUniformBlockBinding.emplace(varName, bindingIt->second);
 			}
 
-			if (isStd140)
-				Append("std140");
+			if (memoryLayout)
+				Append(*memoryLayout);
+
+			if (storageImageType)
+			{
+				auto it = s_glslImageFormatMapping.find(storageImageType->format);
+				assert(it != s_glslImageFormatMapping.end());
 
-			if (!m_currentState->bindingMapping.empty() || isStd140)
+				Append(it->second.identifier);
+			}
+
+			if (hasBinding || memoryLayout || storageImageType)
 				Append(") ");
 
-			if (IsStorageType(exprType))
+			if (IsStorageType(*blockType) || storageImageType)
+			{
+				if (externalVar.accessPolicy.HasValue())
+				{
+					switch (externalVar.accessPolicy.GetResultingValue())
+					{
+						case Ast::AccessPolicy::Read:
+							Append("readonly ");
+							break;
+
+						case Ast::AccessPolicy::ReadWrite:
+							break;
+
+						case Ast::AccessPolicy::Write:
+							Append("writeonly ");
+							break;
+					}
+				}
+
+				if (externalVar.isRestrict.HasValue() && externalVar.isRestrict.GetResultingValue())
+					Append("restrict ");
+			}
+
+			if (IsStorageType(*blockType))
 				Append("buffer ");
 			else
 				Append("uniform ");
 
 			if (isUniformOrStorage)
 			{
-				Append("_nzslBinding_");
-				AppendLine(varName);
+				if (isPushConstant)
+				{
+					std::string blockName = "_nzslPushConstant_" + varName;
+					AppendLine(blockName);
+
+					m_currentState->pushConstantBlockName = std::move(blockName);
+				}
+				else
+				{
+					Append("_nzslBinding_");
+					AppendLine(varName);
+				}
 
 				EnterScope();
 				{
-					std::size_t structIndex = (IsStorageType(exprType)) ? std::get<Ast::StorageType>(exprType).containedType.structIndex : std::get<Ast::UniformType>(exprType).containedType.structIndex;
 					const auto& structData = Nz::Retrieve(m_currentState->structs, structIndex);
 
 					bool first = true;
@@ -1721,6 +2489,7 @@ namespace nzsl
 
 						first = false;
 
+						AppendPrecisionQualifier(member.precision);
 						AppendVariableDeclaration(member.type.GetResultingValue(), member.name);
 						Append(";");
 					}
@@ -1729,9 +2498,25 @@ namespace nzsl
 
 				Append(" ");
 				Append(varName);
+
+				if (blockArrayLength)
+				{
+					if (*blockArrayLength > 0)
+						Append("[", *blockArrayLength, "]");
+					else
+						Append("[]");
+				}
 			}
 			else
+			{
+				// GLSL ES has no default precision for image types
+				if (storageImageType && m_environment.glES)
+					Append("highp ");
+				else
+					AppendPrecisionQualifier(externalVar.precision);
+
 				AppendVariableDeclaration(externalVar.type.GetResultingValue(), varName);
+			}
 
 			AppendLine(";");
 
@@ -1825,6 +2610,7 @@ namespace nzsl
 
 				first = false;
 
+				AppendPrecisionQualifier(member.precision);
 				AppendVariableDeclaration(member.type.GetResultingValue(), member.name);
 				Append(";");
 			}
@@ -1844,6 +2630,7 @@ namespace nzsl
 		assert(node.varIndex);
 		RegisterVariable(*node.varIndex, varName);
 
+		AppendPrecisionQualifier(node.precision);
 		AppendVariableDeclaration(node.varType.GetResultingValue(), varName);
 		if (node.initialExpression)
 		{
@@ -18,6 +18,7 @@ struct fmt::formatter<nzsl::Ast::AttributeType> : formatter<string_view>
 		std::string_view name = "<unhandled attribute type>";
 		switch (p)
 		{
+			case nzsl::Ast::AttributeType::Access:             name = "access"; break;
 			case nzsl::Ast::AttributeType::Author:             name = "author"; break;
 			case nzsl::Ast::AttributeType::Binding:            name = "binding"; break;
 			case nzsl::Ast::AttributeType::Builtin:            name = "builtin"; break;
@@ -32,8 +33,11 @@ struct fmt::formatter<nzsl::Ast::AttributeType> : formatter<string_view>
 			case nzsl::Ast::AttributeType::Layout:             name = "layout"; break;
 			case nzsl::Ast::AttributeType::License:            name = "license"; break;
 			case nzsl::Ast::AttributeType::Location:           name = "location"; break;
+			case nzsl::Ast::AttributeType::Precision:          name = "precision"; break;
+			case nzsl::Ast::AttributeType::Restrict:           name = "restrict"; break;
 			case nzsl::Ast::AttributeType::Set:                name = "set"; break;
 			case nzsl::Ast::AttributeType::Unroll:             name = "unroll"; break;
+			case nzsl::Ast::AttributeType::Workgroup:          name = "workgroup"; break;
 		}
 
 		return formatter<string_view>::format(name, ctx);
@@ -50,14 +54,20 @@ struct fmt::formatter<nzsl::Ast::BuiltinEntry> : formatter<string_view>
 		std::string_view name = "<unhandled builtin>";
 		switch (p)
 		{
-			case nzsl::Ast::BuiltinEntry::BaseInstance:   name = "baseinstance"; break;
-			case nzsl::Ast::BuiltinEntry::BaseVertex:     name = "basevertex"; break;
-			case nzsl::Ast::BuiltinEntry::DrawIndex:      name = "drawindex"; break;
-			case nzsl::Ast::BuiltinEntry::FragCoord:      name = "fragcoord"; break;
-			case nzsl::Ast::BuiltinEntry::FragDepth:      name = "fragdepth"; break;
-			case nzsl::Ast::BuiltinEntry::InstanceIndex:  name = "instanceindex"; break;
-			case nzsl::Ast::BuiltinEntry::VertexIndex :   name = "vertexindex"; break;
-			case nzsl::Ast::BuiltinEntry::VertexPosition: name = "position"; break;
+			case nzsl::Ast::BuiltinEntry::BaseInstance:              name = "baseinstance"; break;
+			case nzsl::Ast::BuiltinEntry::BaseVertex:                name = "basevertex"; break;
+			case nzsl::Ast::BuiltinEntry::DrawIndex:                 name = "drawindex"; break;
+			case nzsl::Ast::BuiltinEntry::FragCoord:                 name = "fragcoord"; break;
+			case nzsl::Ast::BuiltinEntry::FragDepth:                 name = "fragdepth"; break;
+			case nzsl::Ast::BuiltinEntry::GlobalInvocationId:        name = "globalinvocationid"; break;
+			case nzsl::Ast::BuiltinEntry::InstanceIndex:             name = "instanceindex"; break;
+			case nzsl::Ast::BuiltinEntry::LocalInvocationId:         name = "localinvocationid"; break;
+			case nzsl::Ast::BuiltinEntry::LocalInvocationIndex:      name = "localinvocationindex"; break;
+			case nzsl::Ast::BuiltinEntry::SubgroupLocalInvocationId: name = "subgrouplocalinvocationid"; break;
+			case nzsl::Ast::BuiltinEntry::SubgroupSize:              name = "subgroupsize"; break;
+			case nzsl::Ast::BuiltinEntry::VertexIndex :              name = "vertexindex"; break;
+			case nzsl::Ast::BuiltinEntry::VertexPosition:            name = "position"; break;
+			case nzsl::Ast::BuiltinEntry::WorkgroupId:               name = "workgroupid"; break;
 		}
 
 		return formatter<string_view>::format(name, ctx);
@@ -75,6 +85,7 @@ struct fmt::formatter<nzsl::Ast::ModuleFeature> : formatter<string_view>
 		switch (p)
 		{
 			case nzsl::Ast::ModuleFeature::PrimitiveExternals: name = "primitive_externals"; break;
+			case nzsl::Ast::ModuleFeature::Subgroups:          name = "subgroups"; break;
 		}
 
 		return formatter<string_view>::format(name, ctx);
@@ -111,6 +122,7 @@ struct fmt::formatter<nzsl::ShaderStageType> : formatter<string_view>
 		std::string_view name = "<unhandled shader stage>";
 		switch (p)
 		{
+			case nzsl::ShaderStageType::Compute:  name = "compute"; break;
 			case nzsl::ShaderStageType::Fragment: name = "fragment"; break;
 			case nzsl::ShaderStageType::Vertex:   name = "vertex"; break;
 		}
@@ -25,14 +25,20 @@ namespace nzsl::Ast
 	};
 
 	constexpr auto s_builtinData = frozen::make_unordered_map<BuiltinEntry, BuiltinData>({
-		{ Ast::BuiltinEntry::BaseInstance,   { "base_instance",  ShaderStageType::Vertex,   PrimitiveType::Int32 } },
-		{ Ast::BuiltinEntry::BaseVertex,     { "base_vertex",    ShaderStageType::Vertex,   PrimitiveType::Int32 } },
-		{ Ast::BuiltinEntry::DrawIndex,      { "draw_index",     ShaderStageType::Vertex,   PrimitiveType::Int32 } },
-		{ Ast::BuiltinEntry::FragCoord,      { "frag_coord",     ShaderStageType::Fragment, VectorType { 4, PrimitiveType::Float32 } } },
-		{ Ast::BuiltinEntry::FragDepth,      { "frag_depth",     ShaderStageType::Fragment, PrimitiveType::Float32 } },
-		{ Ast::BuiltinEntry::InstanceIndex,  { "instance_index", ShaderStageType::Vertex,   PrimitiveType::Int32 } },
-		{ Ast::BuiltinEntry::VertexIndex,    { "vertex_index",   ShaderStageType::Vertex,   PrimitiveType::Int32 } },
-		{ Ast::BuiltinEntry::VertexPosition, { "position",       ShaderStageType::Vertex,   VectorType { 4, PrimitiveType::Float32 } } }
+		{ Ast::BuiltinEntry::BaseInstance,              { "base_instance",                ShaderStageType::Vertex,   PrimitiveType::Int32 } },
+		{ Ast::BuiltinEntry::BaseVertex,                { "base_vertex",                  ShaderStageType::Vertex,   PrimitiveType::Int32 } },
+		{ Ast::BuiltinEntry::DrawIndex,                 { "draw_index",                   ShaderStageType::Vertex,   PrimitiveType::Int32 } },
+		{ Ast::BuiltinEntry::FragCoord,                 { "frag_coord",                   ShaderStageType::Fragment, VectorType { 4, PrimitiveType::Float32 } } },
+		{ Ast::BuiltinEntry::FragDepth,                 { "frag_depth",                   ShaderStageType::Fragment, PrimitiveType::Float32 } },
+		{ Ast::BuiltinEntry::GlobalInvocationId,        { "global_invocation_id",         ShaderStageType::Compute,  VectorType { 3, PrimitiveType::UInt32 } } },
+		{ Ast::BuiltinEntry::InstanceIndex,             { "instance_index",               ShaderStageType::Vertex,   PrimitiveType::Int32 } },
+		{ Ast::BuiltinEntry::LocalInvocationId,         { "local_invocation_id",          ShaderStageType::Compute,  VectorType { 3, PrimitiveType::UInt32 } } },
+		{ Ast::BuiltinEntry::LocalInvocationIndex,      { "local_invocation_index",       ShaderStageType::Compute,  PrimitiveType::UInt32 } },
+		{ Ast::BuiltinEntry::SubgroupLocalInvocationId, { "subgroup_local_invocation_id", ShaderStageType_All,       PrimitiveType::UInt32 } },
+		{ Ast::BuiltinEntry::SubgroupSize,              { "subgroup_size",                ShaderStageType_All,       PrimitiveType::UInt32 } },
+		{ Ast::BuiltinEntry::VertexIndex,               { "vertex_index",                 ShaderStageType::Vertex,   PrimitiveType::Int32 } },
+		{ Ast::BuiltinEntry::VertexPosition,            { "position",                     ShaderStageType::Vertex,   VectorType { 4, PrimitiveType::Float32 } } },
+		{ Ast::BuiltinEntry::WorkgroupId,               { "workgroup_id",                 ShaderStageType::Compute,  VectorType { 3, PrimitiveType::UInt32 } } }
 	});
 }
 
@@ -19,6 +19,13 @@
 
 namespace nzsl
 {
+	struct LangWriter::AccessAttribute
+	{
+		const Ast::ExpressionValue<Ast::AccessPolicy>& accessPolicy;
+
+		bool HasValue() const { return accessPolicy.HasValue(); }
+	};
+
 	struct LangWriter::AuthorAttribute
 	{
 		const std::string& author;
@@ -103,6 +110,20 @@ namespace nzsl
 		bool HasValue() const { return locationIndex.HasValue(); }
 	};
 	
+	struct LangWriter::PrecisionAttribute
+	{
+		const Ast::ExpressionValue<Ast::Precision>& precision;
+
+		bool HasValue() const { return precision.HasValue(); }
+	};
+
+	struct LangWriter::RestrictAttribute
+	{
+		const Ast::ExpressionValue<bool>& isRestrict;
+
+		bool HasValue() const { return isRestrict.HasValue() && (!isRestrict.IsResultingValue() || isRestrict.GetResultingValue()); }
+	};
+
 	struct LangWriter::SetAttribute
 	{
 		const Ast::ExpressionValue<std::uint32_t>& setIndex;
@@ -117,6 +138,20 @@ namespace nzsl
 		bool HasValue() const { return unroll.HasValue(); }
 	};
 
+	struct LangWriter::WorkgroupAttribute
+	{
+		const std::array<Ast::ExpressionValue<std::uint32_t>, 3>& workgroupSize;
+
+		bool HasValue() const { return workgroupSize[0].HasValue(); }
+	};
+
+	struct LangWriter::WorkgroupSharedAttribute
+	{
+		const Ast::ExpressionValue<bool>& isWorkgroupShared;
+
+		bool HasValue() const { return isWorkgroupShared.HasValue() && (!isWorkgroupShared.IsResultingValue() || isWorkgroupShared.GetResultingValue()); }
+	};
+
 	struct LangWriter::State
 	{
 		struct Identifier
@@ -251,13 +286,21 @@ namespace nzsl
 		switch (type)
 		{
 			case Ast::PrimitiveType::Boolean: return Append("bool");
+			case Ast::PrimitiveType::Float16: return Append("f16");
 			case Ast::PrimitiveType::Float32: return Append("f32");
+			case Ast::PrimitiveType::Int16:   return Append("i16");
 			case Ast::PrimitiveType::Int32:   return Append("i32");
+			case Ast::PrimitiveType::UInt16:  return Append("u16");
 			case Ast::PrimitiveType::UInt32:  return Append("u32");
 			case Ast::PrimitiveType::String:  return Append("string");
 		}
 	}
 
+	void LangWriter::Append(const Ast::PushConstantType& pushConstantType)
+	{
+		Append("push_constant[", pushConstantType.containedType, "]");
+	}
+
 	void LangWriter::Append(const Ast::SamplerType& samplerType)
 	{
 		Append("sampler");
@@ -275,6 +318,42 @@ namespace nzsl
 		Append("[", samplerType.sampledType, "]");
 	}
 
+	void LangWriter::Append(const Ast::StorageImageType& storageImageType)
+	{
+		Append("image");
+
+		switch (storageImageType.dim)
+		{
+			case ImageType::E1D:       Append("1D");      break;
+			case ImageType::E1D_Array: Append("1DArray"); break;
+			case ImageType::E2D:       Append("2D");      break;
+			case ImageType::E2D_Array: Append("2DArray"); break;
+			case ImageType::E3D:       Append("3D");      break;
+			case ImageType::Cubemap:   Append("Cube");    break;
+		}
+
+		Append("[", storageImageType.sampledType, ", ");
+
+		switch (storageImageType.format)
+		{
+			case ImageFormat::R8:       Append("r8");       break;
+			case ImageFormat::R16f:     Append("r16f");     break;
+			case ImageFormat::R32f:     Append("r32f");     break;
+			case ImageFormat::R32i:     Append("r32i");     break;
+			case ImageFormat::R32ui:    Append("r32ui");    break;
+			case ImageFormat::Rg8:      Append("rg8");      break;
+			case ImageFormat::Rg16f:    Append("rg16f");    break;
+			case ImageFormat::Rg32f:    Append("rg32f");    break;
+			case ImageFormat::Rgba8:    Append("rgba8");    break;
+			case ImageFormat::Rgba16f:  Append("rgba16f");  break;
+			case ImageFormat::Rgba32f:  Append("rgba32f");  break;
+			case ImageFormat::Rgba32i:  Append("rgba32i");  break;
+			case ImageFormat::Rgba32ui: Append("rgba32ui"); break;
+		}
+
+		Append("]");
+	}
+
 	void LangWriter::Append(const Ast::StorageType& storageType)
 	{
 		Append("storage[", storageType.containedType, "]");
@@ -368,6 +447,36 @@ namespace nzsl
 		AppendAttributesInternal(first, secondParam, std::forward<Rest>(params)...);
 	}
 
+	void LangWriter::AppendAttribute(AccessAttribute attribute)
+	{
+		if (!attribute.HasValue())
+			return;
+
+		Append("access(");
+
+		if (attribute.accessPolicy.IsResultingValue())
+		{
+			switch (attribute.accessPolicy.GetResultingValue())
+			{
+				case Ast::AccessPolicy::Read:
+					Append("readonly");
+					break;
+
+				case Ast::AccessPolicy::ReadWrite:
+					Append("readwrite");
+					break;
+
+				case Ast::AccessPolicy::Write:
+					Append("writeonly");
+					break;
+			}
+		}
+		else
+			attribute.accessPolicy.GetExpression()->Visit(*this);
+
+		Append(")");
+	}
+
 	void LangWriter::AppendAttribute(AuthorAttribute attribute)
 	{
 		if (!attribute.HasValue())
@@ -484,6 +593,10 @@ namespace nzsl
 		{
 			switch (attribute.stageType.GetResultingValue())
 			{
+				case ShaderStageType::Compute:
+					Append("compute");
+					break;
+
 				case ShaderStageType::Fragment:
 					Append("frag");
 					break;
@@ -508,6 +621,10 @@ namespace nzsl
 			case Ast::ModuleFeature::PrimitiveExternals:
 				Append("primitive_externals");
 				break;
+
+			case Ast::ModuleFeature::Subgroups:
+				Append("subgroups");
+				break;
 		}
 
 		Append(")");
@@ -546,9 +663,17 @@ namespace nzsl
 					Append("packed");
 					break;
 
+				case StructLayout::Scalar:
+					Append("scalar");
+					break;
+
 				case StructLayout::Std140:
 					Append("std140");
 					break;
+
+				case StructLayout::Std430:
+					Append("std430");
+					break;
 			}
 		}
 		else
@@ -579,6 +704,47 @@ namespace nzsl
 		Append(")");
 	}
 	
+	void LangWriter::AppendAttribute(PrecisionAttribute attribute)
+	{
+		if (!attribute.HasValue())
+			return;
+
+		Append("precision(");
+
+		if (attribute.precision.IsResultingValue())
+		{
+			switch (attribute.precision.GetResultingValue())
+			{
+				case Ast::Precision::High:
+					Append("high");
+					break;
+
+				case Ast::Precision::Medium:
+					Append("medium");
+					break;
+			}
+		}
+		else
+			attribute.precision.GetExpression()->Visit(*this);
+
+		Append(")");
+	}
+
+	void LangWriter::AppendAttribute(RestrictAttribute attribute)
+	{
+		if (!attribute.HasValue())
+			return;
+
+		if (attribute.isRestrict.IsResultingValue())
+			Append("restrict");
+		else
+		{
+			Append("restrict(");
+			attribute.isRestrict.GetExpression()->Visit(*this);
+			Append(")");
+		}
+	}
+
 	void LangWriter::AppendAttribute(SetAttribute attribute)
 	{
 		if (!attribute.HasValue())
@@ -627,6 +793,43 @@ namespace nzsl
 		Append(")");
 	}
 
+	void LangWriter::AppendAttribute(WorkgroupAttribute attribute)
+	{
+		if (!attribute.HasValue())
+			return;
+
+		Append("workgroup(");
+
+		for (std::size_t i = 0; i < attribute.workgroupSize.size(); ++i)
+		{
+			if (i != 0)
+				Append(", ");
+
+			const auto& size = attribute.workgroupSize[i];
+			if (size.IsResultingValue())
+				Append(size.GetResultingValue());
+			else
+				size.GetExpression()->Visit(*this);
+		}
+
+		Append(")");
+	}
+
+	void LangWriter::AppendAttribute(WorkgroupSharedAttribute attribute)
+	{
+		if (!attribute.HasValue())
+			return;
+
+		if (attribute.isWorkgroupShared.IsResultingValue())
+			Append("workgroup");
+		else
+		{
+			Append("workgroup(");
+			attribute.isWorkgroupShared.GetExpression()->Visit(*this);
+			Append(")");
+		}
+	}
+
 	void LangWriter::AppendComment(std::string_view section)
 	{
 		std::size_t lineFeed = section.find('\n');
@@ -862,11 +1065,16 @@ namespace nzsl
 		{
 			case Ast::AssignType::Simple: Append(" = "); break;
 			case Ast::AssignType::CompoundAdd: Append(" += "); break;
+			case Ast::AssignType::CompoundBitwiseAnd: Append(" &= "); break;
+			case Ast::AssignType::CompoundBitwiseOr: Append(" |= "); break;
+			case Ast::AssignType::CompoundBitwiseXor: Append(" ^= "); break;
 			case Ast::AssignType::CompoundDivide: Append(" /= "); break;
 			case Ast::AssignType::CompoundModulo: Append(" %= "); break;
 			case Ast::AssignType::CompoundMultiply: Append(" *= "); break;
 			case Ast::AssignType::CompoundLogicalAnd: Append(" &&= "); break;
 			case Ast::AssignType::CompoundLogicalOr: Append(" ||= "); break;
+			case Ast::AssignType::CompoundShiftLeft: Append(" <<= "); break;
+			case Ast::AssignType::CompoundShiftRight: Append(" >>= "); break;
 			case Ast::AssignType::CompoundSubtract: Append(" -= "); break;
 		}
 
@@ -894,6 +1102,12 @@ namespace nzsl
 
 			case Ast::BinaryType::LogicalAnd: Append(" && "); break;
 			case Ast::BinaryType::LogicalOr:  Append(" || "); break;
+
+			case Ast::BinaryType::BitwiseAnd: Append(" & ");  break;
+			case Ast::BinaryType::BitwiseOr:  Append(" | ");  break;
+			case Ast::BinaryType::BitwiseXor: Append(" ^ ");  break;
+			case Ast::BinaryType::ShiftLeft:  Append(" << "); break;
+			case Ast::BinaryType::ShiftRight: Append(" >> "); break;
 		}
 
 		Visit(node.right, true);
@@ -1007,6 +1221,54 @@ namespace nzsl
 				method = true;
 				break;
 
+			case Ast::IntrinsicType::AtomicAdd:
+				Append("atomic_add");
+				break;
+
+			case Ast::IntrinsicType::AtomicAnd:
+				Append("atomic_and");
+				break;
+
+			case Ast::IntrinsicType::AtomicCompareExchange:
+				Append("atomic_compare_exchange");
+				break;
+
+			case Ast::IntrinsicType::AtomicExchange:
+				Append("atomic_exchange");
+				break;
+
+			case Ast::IntrinsicType::AtomicMax:
+				Append("atomic_max");
+				break;
+
+			case Ast::IntrinsicType::AtomicMin:
+				Append("atomic_min");
+				break;
+
+			case Ast::IntrinsicType::AtomicOr:
+				Append("atomic_or");
+				break;
+
+			case Ast::IntrinsicType::AtomicXor:
+				Append("atomic_xor");
+				break;
+
+			case Ast::IntrinsicType::Barrier:
+				Append("barrier");
+				break;
+
+			case Ast::IntrinsicType::BitCount:
+				Append("count_bits");
+				break;
+
+			case Ast::IntrinsicType::BitFieldExtract:
+				Append("bitfield_extract");
+				break;
+
+			case Ast::IntrinsicType::BitFieldInsert:
+				Append("bitfield_insert");
+				break;
+
 			case Ast::IntrinsicType::CrossProduct:
 				Append("cross");
 				break;
@@ -1019,6 +1281,77 @@ namespace nzsl
 				Append("exp");
 				break;
 
+			case Ast::IntrinsicType::FirstBitHigh:
+				Append("first_bit_high");
+				break;
+
+			case Ast::IntrinsicType::FirstBitLow:
+				Append("first_bit_low");
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicAdd:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicAdd");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicAnd:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicAnd");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicExchange:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicExchange");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicMax:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicMax");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicMin:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicMin");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicOr:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicOr");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageAtomicXor:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".AtomicXor");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageLoad:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".Load");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::ImageStore:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".Store");
+				method = true;
+				break;
+
 			case Ast::IntrinsicType::Inverse:
 				Append("inverse");
 				break;
@@ -1031,14 +1364,42 @@ namespace nzsl
 				Append("max");
 				break;
 
+			case Ast::IntrinsicType::MemoryBarrier:
+				Append("memory_barrier");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierBuffer:
+				Append("memory_barrier_buffer");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierImage:
+				Append("memory_barrier_image");
+				break;
+
+			case Ast::IntrinsicType::MemoryBarrierShared:
+				Append("memory_barrier_shared");
+				break;
+
 			case Ast::IntrinsicType::Min:
 				Append("min");
 				break;
 
+			case Ast::IntrinsicType::NonUniform:
+				Append("non_uniform");
+				break;
+
 			case Ast::IntrinsicType::Normalize:
 				Append("normalize");
 				break;
 
+			case Ast::IntrinsicType::PackHalf2x16:
+				Append("pack_half2x16");
+				break;
+
+			case Ast::IntrinsicType::PackUnorm4x8:
+				Append("pack_unorm4x8");
+				break;
+
 			case Ast::IntrinsicType::Pow:
 				Append("pow");
 				break;
@@ -1054,9 +1415,80 @@ namespace nzsl
 				method = true;
 				break;
 
+			case Ast::IntrinsicType::SampleTextureGrad:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".SampleGrad");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::SampleTextureLod:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".SampleLod");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::SubgroupAdd:
+				Append("subgroup_add");
+				break;
+
+			case Ast::IntrinsicType::SubgroupBallot:
+				Append("subgroup_ballot");
+				break;
+
+			case Ast::IntrinsicType::SubgroupBroadcastFirst:
+				Append("subgroup_broadcast_first");
+				break;
+
+			case Ast::IntrinsicType::SubgroupElect:
+				Append("subgroup_elect");
+				break;
+
+			case Ast::IntrinsicType::SubgroupMax:
+				Append("subgroup_max");
+				break;
+
+			case Ast::IntrinsicType::SubgroupMin:
+				Append("subgroup_min");
+				break;
+
+			case Ast::IntrinsicType::SubgroupShuffle:
+				Append("subgroup_shuffle");
+				break;
+
+			case Ast::IntrinsicType::TextureFetch:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".Fetch");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::TextureGather:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".Gather");
+				method = true;
+				break;
+
+			case Ast::IntrinsicType::TextureSize:
+				assert(!node.parameters.empty());
+				Visit(node.parameters.front(), true);
+				Append(".Size");
+				method = true;
+				break;
+
 			case Ast::IntrinsicType::Transpose:
 				Append("transpose");
 				break;
+
+			case Ast::IntrinsicType::UnpackHalf2x16:
+				Append("unpack_half2x16");
+				break;
+
+			case Ast::IntrinsicType::UnpackUnorm4x8:
+				Append("unpack_unorm4x8");
+				break;
 		}
 
 		Append("(");
@@ -1097,6 +1529,11 @@ namespace nzsl
 	{
 		switch (node.op)
 		{
+		case Ast::UnaryType::BitwiseNot:
+			Append("~");
+			Visit(node.expression, true);
+			return;
+
 		case Ast::UnaryType::LogicalNot:
 			Append("!");
 			break;
@@ -1204,7 +1641,7 @@ namespace nzsl
 
 			first = false;
 
-			AppendAttributes(false, SetAttribute{ externalVar.bindingSet }, BindingAttribute{ externalVar.bindingIndex });
+			AppendAttributes(false, SetAttribute{ externalVar.bindingSet }, BindingAttribute{ externalVar.bindingIndex }, WorkgroupSharedAttribute{ externalVar.isWorkgroupShared }, AccessAttribute{ externalVar.accessPolicy }, RestrictAttribute{ externalVar.isRestrict }, PrecisionAttribute{ externalVar.precision });
 			Append(externalVar.name, ": ", externalVar.type);
 
 			if (externalVar.varIndex)
@@ -1221,7 +1658,7 @@ namespace nzsl
 		if (node.funcIndex)
 			RegisterFunction(*node.funcIndex, node.name);
 
-		AppendAttributes(true, EntryAttribute{ node.entryStage }, EarlyFragmentTestsAttribute{ node.earlyFragmentTests }, DepthWriteAttribute{ node.depthWrite });
+		AppendAttributes(true, EntryAttribute{ node.entryStage }, WorkgroupAttribute{ node.workgroupSize }, EarlyFragmentTestsAttribute{ node.earlyFragmentTests }, DepthWriteAttribute{ node.depthWrite });
 		Append("fn ", node.name, "(");
 		for (std::size_t i = 0; i < node.parameters.size(); ++i)
 		{
@@ -1230,6 +1667,7 @@ namespace nzsl
 			if (i != 0)
 				Append(", ");
 
+			AppendAttributes(false, PrecisionAttribute{ parameter.precision });
 			Append(parameter.name);
 			Append(": ");
 			Append(parameter.type);
@@ -1288,7 +1726,7 @@ namespace nzsl
 
 				first = false;
 
-				AppendAttributes(false, LocationAttribute{ member.locationIndex }, BuiltinAttribute{ member.builtin });
+				AppendAttributes(false, LocationAttribute{ member.locationIndex }, BuiltinAttribute{ member.builtin }, PrecisionAttribute{ member.precision });
 				Append(member.name, ": ", member.type);
 			}
 		}
@@ -1300,6 +1738,7 @@ namespace nzsl
 		if (node.varIndex)
 			RegisterVariable(*node.varIndex, node.varName);
 
+		AppendAttributes(false, PrecisionAttribute{ node.precision });
 		Append("let ", node.varName);
 		if (node.varType.HasValue())
 			Append(": ", node.varType);
@@ -326,8 +326,13 @@ namespace nzsl
 						else
 							tokenType = TokenType::LogicalOr;
 					}
+					else if (next == '=')
+					{
+						currentPos++;
+						tokenType = TokenType::BitwiseOrAssign;
+					}
 					else
-						throw LexerUnrecognizedTokenError{ token.location }; //< TODO: Add BOR (a | b)
+						tokenType = TokenType::BitwiseOr;
 
 					break;
 				}
@@ -347,8 +352,13 @@ namespace nzsl
 						else
 							tokenType = TokenType::LogicalAnd;
 					}
+					else if (next == '=')
+					{
+						currentPos++;
+						tokenType = TokenType::BitwiseAndAssign;
+					}
 					else
-						throw LexerUnrecognizedTokenError{ token.location }; //< TODO: Add BAND (a & b)
+						tokenType = TokenType::BitwiseAnd;
 
 					break;
 				}
@@ -361,6 +371,18 @@ namespace nzsl
 						currentPos++;
 						tokenType = TokenType::LessThanEqual;
 					}
+					else if (next == '<')
+					{
+						currentPos++;
+						next = Peek();
+						if (next == '=')
+						{
+							currentPos++;
+							tokenType = TokenType::ShiftLeftAssign;
+						}
+						else
+							tokenType = TokenType::ShiftLeft;
+					}
 					else
 						tokenType = TokenType::LessThan;
 
@@ -375,12 +397,38 @@ namespace nzsl
 						currentPos++;
 						tokenType = TokenType::GreaterThanEqual;
 					}
+					else if (next == '>')
+					{
+						currentPos++;
+						next = Peek();
+						if (next == '=')
+						{
+							currentPos++;
+							tokenType = TokenType::ShiftRightAssign;
+						}
+						else
+							tokenType = TokenType::ShiftRight;
+					}
 					else
 						tokenType = TokenType::GreaterThan;
 
 					break;
 				}
 
+				case '^':
+				{
+					char next = Peek();
+					if (next == '=')
+					{
+						currentPos++;
+						tokenType = TokenType::BitwiseXorAssign;
+					}
+					else
+						tokenType = TokenType::BitwiseXor;
+
+					break;
+				}
+
 				case '!':
 				{
 					char next = Peek();
@@ -437,6 +485,7 @@ namespace nzsl
 					break;
 				}
 
+				case '~': tokenType = TokenType::BitwiseNot; break;
 				case ':': tokenType = TokenType::Colon; break;
 				case ';': tokenType = TokenType::Semicolon; break;
 				case '.': tokenType = TokenType::Dot; break;
@@ -31,8 +31,13 @@ namespace nzsl
 
 		m_largestFieldAlignment = std::max(fieldAlignement, m_largestFieldAlignment);
 
+		// Array elements are padded to the array alignment, except in packed layout
+		std::size_t elementSize = GetSize(type);
+		if (m_layout != StructLayout::Packed)
+			elementSize = Nz::Align(elementSize, fieldAlignement);
+
 		std::size_t offset = Nz::Align(m_size, Nz::Align(fieldAlignement, m_offsetRounding));
-		m_size = offset + GetSize(type) * arraySize;
+		m_size = offset + elementSize * arraySize;
 
 		m_offsetRounding = 1;
 
@@ -36,6 +36,12 @@ namespace nzsl
 {
 	namespace NAZARA_ANONYMOUS_NAMESPACE
 	{
+		constexpr auto s_accessPolicies = frozen::make_unordered_map<frozen::string, Ast::AccessPolicy>({
+			{ "readonly",  Ast::AccessPolicy::Read },
+			{ "readwrite", Ast::AccessPolicy::ReadWrite },
+			{ "writeonly", Ast::AccessPolicy::Write }
+		});
+
 		constexpr auto s_depthWriteModes = frozen::make_unordered_map<frozen::string, Ast::DepthWriteMode>({
 			{ "greater",   Ast::DepthWriteMode::Greater },
 			{ "less",      Ast::DepthWriteMode::Less },
@@ -44,11 +50,13 @@ namespace nzsl
 		});
 
 		constexpr auto s_entryPoints = frozen::make_unordered_map<frozen::string, ShaderStageType>({
+			{ "compute", ShaderStageType::Compute },
 			{ "frag", ShaderStageType::Fragment },
 			{ "vert", ShaderStageType::Vertex },
 		});
 
 		constexpr auto s_identifierToAttributeType = frozen::make_unordered_map<frozen::string, Ast::AttributeType>({
+			{ "access",               Ast::AttributeType::Access },
 			{ "author",               Ast::AttributeType::Author },
 			{ "binding",              Ast::AttributeType::Binding },
 			{ "builtin",              Ast::AttributeType::Builtin },
@@ -63,12 +71,16 @@ namespace nzsl
 			{ "license",              Ast::AttributeType::License },
 			{ "location",             Ast::AttributeType::Location },
 			{ "nzsl_version",         Ast::AttributeType::LangVersion },
+			{ "precision",            Ast::AttributeType::Precision },
+			{ "restrict",             Ast::AttributeType::Restrict },
 			{ "set",                  Ast::AttributeType::Set },
-			{ "unroll",               Ast::AttributeType::Unroll }
+			{ "unroll",               Ast::AttributeType::Unroll },
+			{ "workgroup",            Ast::AttributeType::Workgroup }
 		});
 		
 		constexpr auto s_moduleFeatures = frozen::make_unordered_map<frozen::string, Ast::ModuleFeature>({
 			{ "primitive_externals", Ast::ModuleFeature::PrimitiveExternals },
+			{ "subgroups",           Ast::ModuleFeature::Subgroups },
 		});
 
 		constexpr auto BuildIdentifierMapping()
@@ -90,7 +102,14 @@ namespace nzsl
 		constexpr auto s_builtinMapping = BuildIdentifierMapping();
 
 		constexpr auto s_layoutMapping = frozen::make_unordered_map<frozen::string, StructLayout>({
-			{ "std140", StructLayout::Std140 }
+			{ "scalar", StructLayout::Scalar },
+			{ "std140", StructLayout::Std140 },
+			{ "std430", StructLayout::Std430 }
+		});
+
+		constexpr auto s_precisions = frozen::make_unordered_map<frozen::string, Ast::Precision>({
+			{ "high",   Ast::Precision::High },
+			{ "medium", Ast::Precision::Medium }
 		});
 
 		constexpr auto s_unrollModes = frozen::make_unordered_map<frozen::string, Ast::LoopUnroll>({
@@ -213,12 +232,19 @@ namespace nzsl
 
 			Ast::AttributeType attributeType = it->second;
 
-			Ast::ExpressionPtr arg;
+			std::vector<Ast::ExpressionPtr> args;
 			if (Peek().type == TokenType::OpenParenthesis)
 			{
 				Consume();
 
-				arg = ParseExpression();
+				do
+				{
+					if (!args.empty())
+						Consume(); //< Comma
+
+					args.push_back(ParseExpression());
+				}
+				while (Peek().type == TokenType::Comma);
 
 				const Token& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
 				attributeLocation.ExtendToRight(closeToken.location);
@@ -228,7 +254,7 @@ namespace nzsl
 
 			attributes.push_back({
 				attributeType,
-				std::move(arg),
+				std::move(args),
 				attributeLocation
 			});
 		}
@@ -678,14 +704,30 @@ namespace nzsl
 				{
 					switch (attribute.type)
 					{
+						case Ast::AttributeType::Access:
+							HandleUniqueStringAttributeKey(extVar.accessPolicy, std::move(attribute), s_accessPolicies);
+							break;
+
 						case Ast::AttributeType::Binding:
 							HandleUniqueAttribute(extVar.bindingIndex, std::move(attribute));
 							break;
 
+						case Ast::AttributeType::Precision:
+							HandleUniqueStringAttributeKey(extVar.precision, std::move(attribute), s_precisions);
+							break;
+
+						case Ast::AttributeType::Restrict:
+							HandleUniqueAttribute(extVar.isRestrict, std::move(attribute), true);
+							break;
+
 						case Ast::AttributeType::Set:
 							HandleUniqueAttribute(extVar.bindingSet, std::move(attribute));
 							break;
 
+						case Ast::AttributeType::Workgroup:
+							HandleUniqueAttribute(extVar.isWorkgroupShared, std::move(attribute), true);
+							break;
+
 						default:
 							throw ParserUnexpectedAttributeError{ attribute.sourceLocation, attribute.type };
 					}
@@ -853,6 +895,20 @@ namespace nzsl
 					HandleUniqueAttribute(func->earlyFragmentTests, std::move(attribute));
 					break;
 
+				case Ast::AttributeType::Workgroup:
+				{
+					if (func->workgroupSize[0].HasValue())
+						throw ParserAttributeMultipleUniqueError{ attribute.sourceLocation, attribute.type };
+
+					if (attribute.args.size() != 3)
+						throw ParserAttributeUnexpectedParameterCountError{ attribute.sourceLocation, attribute.type, 3, Nz::SafeCast<std::uint32_t>(attribute.args.size()) };
+
+					for (std::size_t i = 0; i < 3; ++i)
+						func->workgroupSize[i] = std::move(attribute.args[i]);
+
+					break;
+				}
+
 				default:
 					throw ParserUnexpectedAttributeError{ attribute.sourceLocation, attribute.type };
 			}
@@ -866,8 +922,26 @@ namespace nzsl
 
 	Ast::DeclareFunctionStatement::Parameter Parser::ParseFunctionParameter()
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		Ast::DeclareFunctionStatement::Parameter parameter;
 
+		if (Peek().type == TokenType::OpenSquareBracket)
+		{
+			for (auto&& attribute : ParseAttributes())
+			{
+				switch (attribute.type)
+				{
+					case Ast::AttributeType::Precision:
+						HandleUniqueStringAttributeKey(parameter.precision, std::move(attribute), s_precisions);
+						break;
+
+					default:
+						throw ParserUnexpectedAttributeError{ attribute.sourceLocation, attribute.type };
+				}
+			}
+		}
+
 		parameter.name = ParseIdentifierAsName(&parameter.sourceLocation);
 
 		Expect(Advance(), TokenType::Colon);
@@ -1064,10 +1138,8 @@ namespace nzsl
 					break;
 
 				case TokenType::Let:
-					if (!attributes.empty())
-						throw ParserUnexpectedTokenError{ token.location, token.type };
-
-					statement = ParseVariableDeclaration();
+					statement = ParseVariableDeclaration(std::move(attributes));
+					attributes.clear();
 					break;
 
 				case TokenType::Identifier:
@@ -1221,6 +1293,10 @@ namespace nzsl
 							HandleUniqueAttribute(structField.locationIndex, std::move(attribute));
 							break;
 
+						case Ast::AttributeType::Precision:
+							HandleUniqueStringAttributeKey(structField.precision, std::move(attribute), s_precisions);
+							break;
+
 						default:
 							throw ParserUnexpectedAttributeError{ attribute.sourceLocation, attribute.type };
 					}
@@ -1250,8 +1326,10 @@ namespace nzsl
 			return structDeclStatement;
 	}
 
-	Ast::StatementPtr Parser::ParseVariableDeclaration()
+	Ast::StatementPtr Parser::ParseVariableDeclaration(std::vector<Attribute> attributes)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		const auto& letToken = Expect(Advance(), TokenType::Let);
 
 		SourceLocation letLocation = letToken.location;
@@ -1265,6 +1343,19 @@ namespace nzsl
 		auto variableDeclStatement = ShaderBuilder::DeclareVariable(std::move(variableName), std::move(variableType), std::move(expression));
 		variableDeclStatement->sourceLocation = std::move(letLocation);
 
+		for (auto&& attribute : attributes)
+		{
+			switch (attribute.type)
+			{
+				case Ast::AttributeType::Precision:
+					HandleUniqueStringAttributeKey(variableDeclStatement->precision, std::move(attribute), s_precisions);
+					break;
+
+				default:
+					throw ParserUnexpectedAttributeError{ attribute.sourceLocation, attribute.type };
+			}
+		}
+
 		return variableDeclStatement;
 	}
 
@@ -1358,6 +1449,9 @@ namespace nzsl
 					case TokenType::Dot:
 						return BuildIdentifierAccess(std::move(lhs), std::move(rhs));
 
+					case TokenType::BitwiseAnd:        return BuildBinary(Ast::BinaryType::BitwiseAnd, std::move(lhs), std::move(rhs));
+					case TokenType::BitwiseOr:         return BuildBinary(Ast::BinaryType::BitwiseOr,  std::move(lhs), std::move(rhs));
+					case TokenType::BitwiseXor:        return BuildBinary(Ast::BinaryType::BitwiseXor, std::move(lhs), std::move(rhs));
 					case TokenType::Divide:            return BuildBinary(Ast::BinaryType::Divide,     std::move(lhs), std::move(rhs));
 					case TokenType::Equal:             return BuildBinary(Ast::BinaryType::CompEq,     std::move(lhs), std::move(rhs));
 					case TokenType::LessThan:          return BuildBinary(Ast::BinaryType::CompLt,     std::move(lhs), std::move(rhs));
@@ -1371,6 +1465,8 @@ namespace nzsl
 					case TokenType::Multiply:          return BuildBinary(Ast::BinaryType::Multiply,   std::move(lhs), std::move(rhs));
 					case TokenType::NotEqual:          return BuildBinary(Ast::BinaryType::CompNe,     std::move(lhs), std::move(rhs));
 					case TokenType::Plus:              return BuildBinary(Ast::BinaryType::Add,        std::move(lhs), std::move(rhs));
+					case TokenType::ShiftLeft:         return BuildBinary(Ast::BinaryType::ShiftLeft,  std::move(lhs), std::move(rhs));
+					case TokenType::ShiftRight:        return BuildBinary(Ast::BinaryType::ShiftRight, std::move(lhs), std::move(rhs));
 					default:
 						throw ParserUnexpectedTokenError{ token.location, token.type };
 				}
@@ -1438,6 +1534,9 @@ namespace nzsl
 		switch (token.type)
 		{
 			case TokenType::Assign:           assignType = Ast::AssignType::Simple; break;
+			case TokenType::BitwiseAndAssign: assignType = Ast::AssignType::CompoundBitwiseAnd; break;
+			case TokenType::BitwiseOrAssign:  assignType = Ast::AssignType::CompoundBitwiseOr; break;
+			case TokenType::BitwiseXorAssign: assignType = Ast::AssignType::CompoundBitwiseXor; break;
 			case TokenType::DivideAssign:     assignType = Ast::AssignType::CompoundDivide; break;
 			case TokenType::LogicalAndAssign: assignType = Ast::AssignType::CompoundLogicalAnd; break;
 			case TokenType::LogicalOrAssign:  assignType = Ast::AssignType::CompoundLogicalOr; break;
@@ -1445,6 +1544,8 @@ namespace nzsl
 			case TokenType::MultiplyAssign:   assignType = Ast::AssignType::CompoundMultiply; break;
 			case TokenType::MinusAssign:      assignType = Ast::AssignType::CompoundSubtract; break;
 			case TokenType::PlusAssign:       assignType = Ast::AssignType::CompoundAdd; break;
+			case TokenType::ShiftLeftAssign:  assignType = Ast::AssignType::CompoundShiftLeft; break;
+			case TokenType::ShiftRightAssign: assignType = Ast::AssignType::CompoundShiftRight; break;
 
 			case TokenType::Semicolon:
 				return left; // discarded expression (ex: function call with no return)
@@ -1523,6 +1624,20 @@ namespace nzsl
 				primaryExpr->sourceLocation = token.location;
 				break;
 
+			case TokenType::BitwiseNot:
+			{
+				Consume();
+
+				// ~ only applies to its operand (with member accesses, indexing and calls), not to the whole expression
+				Ast::ExpressionPtr expr = ParseBinOpRhs(100, ParsePrimaryExpression());
+
+				auto notExpr = ShaderBuilder::Unary(Ast::UnaryType::BitwiseNot, std::move(expr));
+				notExpr->sourceLocation = SourceLocation::BuildFromTo(token.location, notExpr->expression->sourceLocation);
+
+				primaryExpr = std::move(notExpr);
+				break;
+			}
+
 			case TokenType::ConstSelect:
 				primaryExpr = ParseConstSelectExpression();
 				break;
@@ -1643,29 +1758,45 @@ namespace nzsl
 
 	const std::string& Parser::ExtractStringAttribute(Attribute&& attribute)
 	{
-		if (!attribute.args)
+		if (attribute.args.empty())
 			throw ParserAttributeMissingParameterError{ attribute.sourceLocation, attribute.type };
 
-		if (attribute.args->GetType() != Ast::NodeType::ConstantValueExpression)
+		if (attribute.args.size() > 1)
+			throw ParserAttributeUnexpectedParameterCountError{ attribute.sourceLocation, attribute.type, 1, Nz::SafeCast<std::uint32_t>(attribute.args.size()) };
+
+		const Ast::ExpressionPtr& arg = attribute.args.front();
+		if (arg->GetType() != Ast::NodeType::ConstantValueExpression)
 			throw ParserAttributeExpectStringError{ attribute.sourceLocation, attribute.type };
 
-		auto& constantValue = Nz::SafeCast<Ast::ConstantValueExpression&>(*attribute.args);
+		auto& constantValue = Nz::SafeCast<Ast::ConstantValueExpression&>(*arg);
 		if (Ast::GetConstantType(constantValue.value) != Ast::ExpressionType{ Ast::PrimitiveType::String })
 			throw ParserAttributeExpectStringError{ attribute.sourceLocation, attribute.type };
 
 		return std::get<std::string>(constantValue.value);
 	}
 
+	Ast::ExpressionPtr Parser::ExtractSingleAttributeParameter(Attribute&& attribute)
+	{
+		if (attribute.args.empty())
+			return nullptr;
+
+		if (attribute.args.size() > 1)
+			throw ParserAttributeUnexpectedParameterCountError{ attribute.sourceLocation, attribute.type, 1, Nz::SafeCast<std::uint32_t>(attribute.args.size()) };
+
+		return std::move(attribute.args.front());
+	}
+
 	template<typename T>
 	void Parser::HandleUniqueAttribute(Ast::ExpressionValue<T>& targetAttribute, Parser::Attribute&& attribute)
 	{
 		if (targetAttribute.HasValue())
 			throw ParserAttributeMultipleUniqueError{ attribute.sourceLocation, attribute.type };
 
-		if (!attribute.args)
+		Ast::ExpressionPtr arg = ExtractSingleAttributeParameter(std::move(attribute));
+		if (!arg)
 			throw ParserAttributeMissingParameterError{ attribute.sourceLocation, attribute.type };
 
-		targetAttribute = std::move(attribute.args);
+		targetAttribute = std::move(arg);
 	}
 
 	template<typename T>
@@ -1674,8 +1805,8 @@ namespace nzsl
 		if (targetAttribute.HasValue())
 			throw ParserAttributeMultipleUniqueError{ attribute.sourceLocation, attribute.type };
 
-		if (attribute.args)
-			targetAttribute = std::move(attribute.args);
+		if (Ast::ExpressionPtr arg = ExtractSingleAttributeParameter(std::move(attribute)))
+			targetAttribute = std::move(arg);
 		else
 			targetAttribute = std::move(defaultValue);
 	}
@@ -1687,16 +1818,16 @@ namespace nzsl
 			throw ParserAttributeMultipleUniqueError{ attribute.sourceLocation, attribute.type };
 
 		//FIXME: This should be handled with global values at sanitization stage
-		if (attribute.args)
+		if (Ast::ExpressionPtr arg = ExtractSingleAttributeParameter(std::move(attribute)))
 		{
-			if (attribute.args->GetType() != Ast::NodeType::IdentifierExpression)
-				throw ParserAttributeParameterIdentifierError{ attribute.args->sourceLocation, attribute.type };
+			if (arg->GetType() != Ast::NodeType::IdentifierExpression)
+				throw ParserAttributeParameterIdentifierError{ arg->sourceLocation, attribute.type };
 
-			std::string_view exprStr = static_cast<Ast::IdentifierExpression&>(*attribute.args).identifier;
+			std::string_view exprStr = static_cast<Ast::IdentifierExpression&>(*arg).identifier;
 
 			auto it = map.find(exprStr);
 			if (it == map.end())
-				throw ParserAttributeInvalidParameterError{ attribute.args->sourceLocation, exprStr, attribute.type };
+				throw ParserAttributeInvalidParameterError{ arg->sourceLocation, exprStr, attribute.type };
 
 			targetAttribute = it->second;
 		}
@@ -1711,8 +1842,12 @@ namespace nzsl
 
 	int Parser::GetTokenPrecedence(TokenType token)
 	{
+		// Bitwise operators bind tighter than comparisons (a & mask == 0 is (a & mask) == 0)
 		switch (token)
 		{
+			case TokenType::BitwiseAnd:        return 56;
+			case TokenType::BitwiseOr:         return 52;
+			case TokenType::BitwiseXor:        return 54;
 			case TokenType::Divide:            return 80;
 			case TokenType::Dot:               return 150;
 			case TokenType::Equal:             return 50;
@@ -1727,6 +1862,8 @@ namespace nzsl
 			case TokenType::Minus:             return 60;
 			case TokenType::NotEqual:          return 50;
 			case TokenType::Plus:              return 60;
+			case TokenType::ShiftLeft:         return 58;
+			case TokenType::ShiftRight:        return 58;
 			case TokenType::OpenSquareBracket: return 100;
 			case TokenType::OpenParenthesis:   return 100;
 			default: return -1;
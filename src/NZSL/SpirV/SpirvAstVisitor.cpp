@@ -21,10 +21,21 @@ namespace nzsl
 
 	std::uint32_t SpirvAstVisitor::EvaluateExpression(Ast::Expression& expr)
 	{
+		// Restore the parent line afterwards, so the instructions using this expression are attributed to their own node
+		SpirvBlock::DebugLine parentLine = m_debugLine;
+		SetSourceLocation(expr.sourceLocation);
+
 		expr.Visit(*this);
 
+		m_debugLine = parentLine;
+
 		assert(m_resultIds.size() == 1);
-		return PopResultId();
+		std::uint32_t resultId = PopResultId();
+
+		if (expr.cachedPrecision == Ast::Precision::Medium)
+			DecorateRelaxedPrecision(resultId);
+
+		return resultId;
 	}
 
 	auto SpirvAstVisitor::GetVariable(std::size_t varIndex) const -> const SpirvVariable&
@@ -32,6 +43,51 @@ namespace nzsl
 		return Nz::Retrieve(m_variables, varIndex);
 	}
 
+	SpirvScope SpirvAstVisitor::GetIntrinsicMemoryScope(Ast::IntrinsicType intrinsic)
+	{
+		switch (intrinsic)
+		{
+			case Ast::IntrinsicType::Barrier:
+			case Ast::IntrinsicType::MemoryBarrierShared:
+				return SpirvScope::Workgroup;
+
+			default:
+				return SpirvScope::Device;
+		}
+	}
+
+	std::uint32_t SpirvAstVisitor::GetIntrinsicMemorySemantics(Ast::IntrinsicType intrinsic)
+	{
+		auto Semantics = [](std::initializer_list<SpirvMemorySemantics> semantics)
+		{
+			std::uint32_t value = 0;
+			for (SpirvMemorySemantics semantic : semantics)
+				value |= static_cast<std::uint32_t>(semantic);
+
+			return value;
+		};
+
+		switch (intrinsic)
+		{
+			case Ast::IntrinsicType::Barrier:
+			case Ast::IntrinsicType::MemoryBarrierShared:
+				return Semantics({ SpirvMemorySemantics::AcquireRelease, SpirvMemorySemantics::WorkgroupMemory });
+
+			case Ast::IntrinsicType::MemoryBarrier:
+				return Semantics({ SpirvMemorySemantics::AcquireRelease, SpirvMemorySemantics::UniformMemory, SpirvMemorySemantics::WorkgroupMemory, SpirvMemorySemantics::ImageMemory });
+
+			case Ast::IntrinsicType::MemoryBarrierBuffer:
+				return Semantics({ SpirvMemorySemantics::AcquireRelease, SpirvMemorySemantics::UniformMemory });
+
+			case Ast::IntrinsicType::MemoryBarrierImage:
+				return Semantics({ SpirvMemorySemantics::AcquireRelease, SpirvMemorySemantics::ImageMemory });
+
+			// Atomics are relaxed, like their GLSL counterparts
+			default:
+				return Semantics({ SpirvMemorySemantics::Relaxed });
+		}
+	}
+
 	void SpirvAstVisitor::Visit(Ast::AccessIndexExpression& node)
 	{
 		SpirvExpressionLoad accessMemberVisitor(m_writer, *this, *m_currentBlock);
@@ -87,10 +143,13 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFAdd;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpIAdd;
 
@@ -106,10 +165,13 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFSub;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpISub;
 
@@ -125,12 +187,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFDiv;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSDiv;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpUDiv;
 
@@ -146,12 +211,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFMod;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSMod;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpUMod;
 
@@ -167,6 +235,7 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 						{
 							if (IsPrimitiveType(leftType))
@@ -206,7 +275,9 @@ namespace nzsl
 							return SpirvOp::OpFMul;
 						}
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpIMul;
 
@@ -225,10 +296,13 @@ namespace nzsl
 						case Ast::PrimitiveType::Boolean:
 							return SpirvOp::OpLogicalEqual;
 
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdEqual;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpIEqual;
 
@@ -243,12 +317,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdGreaterThan;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSGreaterThan;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpUGreaterThan;
 
@@ -264,12 +341,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdGreaterThanEqual;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSGreaterThanEqual;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpUGreaterThanEqual;
 
@@ -285,12 +365,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdLessThanEqual;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSLessThanEqual;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpULessThanEqual;
 
@@ -306,12 +389,15 @@ namespace nzsl
 				{
 					switch (leftTypeBase)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdLessThan;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
 							return SpirvOp::OpSLessThan;
 
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpULessThan;
 
@@ -330,10 +416,13 @@ namespace nzsl
 						case Ast::PrimitiveType::Boolean:
 							return SpirvOp::OpLogicalNotEqual;
 
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							return SpirvOp::OpFOrdNotEqual;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							return SpirvOp::OpINotEqual;
 
@@ -349,6 +438,40 @@ namespace nzsl
 
 				case Ast::BinaryType::LogicalOr:
 					return SpirvOp::OpLogicalOr;
+
+				case Ast::BinaryType::BitwiseAnd:
+					return SpirvOp::OpBitwiseAnd;
+
+				case Ast::BinaryType::BitwiseOr:
+					return SpirvOp::OpBitwiseOr;
+
+				case Ast::BinaryType::BitwiseXor:
+					return SpirvOp::OpBitwiseXor;
+
+				case Ast::BinaryType::ShiftLeft:
+					return SpirvOp::OpShiftLeftLogical;
+
+				case Ast::BinaryType::ShiftRight:
+				{
+					switch (leftTypeBase)
+					{
+						case Ast::PrimitiveType::Int16:
+						case Ast::PrimitiveType::Int32:
+							return SpirvOp::OpShiftRightArithmetic;
+
+						case Ast::PrimitiveType::UInt16:
+						case Ast::PrimitiveType::UInt32:
+							return SpirvOp::OpShiftRightLogical;
+
+						case Ast::PrimitiveType::Boolean:
+						case Ast::PrimitiveType::Float16:
+						case Ast::PrimitiveType::Float32:
+						case Ast::PrimitiveType::String:
+							break;
+					}
+
+					break;
+				}
 			}
 
 			assert(false);
@@ -382,6 +505,28 @@ namespace nzsl
 			else if (leftType != rightType)
 				throw std::runtime_error("unexpected division/modulo operands");
 		}
+		else if (node.op == Ast::BinaryType::ShiftLeft || node.op == Ast::BinaryType::ShiftRight)
+		{
+			// Shift amount must have as many components as the shifted value (but its signedness may differ)
+			if (IsVectorType(leftType) && IsPrimitiveType(rightType))
+			{
+				const Ast::VectorType& leftVec = std::get<Ast::VectorType>(leftType);
+
+				std::uint32_t vecType = m_writer.GetTypeId(Ast::VectorType{ leftVec.componentCount, std::get<Ast::PrimitiveType>(rightType) });
+
+				std::uint32_t rightAsVec = m_writer.AllocateResultId();
+				m_currentBlock->AppendVariadic(SpirvOp::OpCompositeConstruct, [&](auto&& append)
+				{
+					append(vecType);
+					append(rightAsVec);
+
+					for (std::size_t i = 0; i < leftVec.componentCount; ++i)
+						append(rightOperand);
+				});
+
+				rightOperand = rightAsVec;
+			}
+		}
 
 		m_currentBlock->Append(op, m_writer.GetTypeId(resultType), resultId, leftOperand, rightOperand);
 		PushResultId(resultId);
@@ -392,9 +537,9 @@ namespace nzsl
 		assert(node.condStatements.size() == 1); //< sanitization splits multiple branches
 		auto& condStatement = node.condStatements.front();
 
-		auto mergeBlock = std::make_unique<SpirvBlock>(m_writer);
-		auto contentBlock = std::make_unique<SpirvBlock>(m_writer);
-		auto elseBlock = std::make_unique<SpirvBlock>(m_writer);
+		auto mergeBlock = CreateBlock();
+		auto contentBlock = CreateBlock();
+		auto elseBlock = CreateBlock();
 
 		std::uint32_t conditionId = EvaluateExpression(*condStatement.condition);
 		m_currentBlock->Append(SpirvOp::OpSelectionMerge, mergeBlock->GetLabelId(), SpirvSelectionControl::None);
@@ -474,6 +619,51 @@ namespace nzsl
 
 	void SpirvAstVisitor::Visit(Ast::CastExpression& node)
 	{
+		auto IsFloatingPoint = [](Ast::PrimitiveType type) { return type == Ast::PrimitiveType::Float16 || type == Ast::PrimitiveType::Float32; };
+		auto IsSignedInteger = [](Ast::PrimitiveType type) { return type == Ast::PrimitiveType::Int16 || type == Ast::PrimitiveType::Int32; };
+		auto IsUnsignedInteger = [](Ast::PrimitiveType type) { return type == Ast::PrimitiveType::UInt16 || type == Ast::PrimitiveType::UInt32; };
+		auto Is16Bits = [](Ast::PrimitiveType type) { return type == Ast::PrimitiveType::Float16 || type == Ast::PrimitiveType::Int16 || type == Ast::PrimitiveType::UInt16; };
+
+		// Conversion opcodes work on scalars as well as on vectors (component-wise)
+		auto GetConversionOp = [&](Ast::PrimitiveType fromType, Ast::PrimitiveType targetType) -> SpirvOp
+		{
+			if (fromType == Ast::PrimitiveType::Boolean)
+				throw std::runtime_error("unsupported cast from boolean");
+
+			if (fromType == Ast::PrimitiveType::String || targetType == Ast::PrimitiveType::String)
+				throw std::runtime_error("unexpected string type");
+
+			if (IsFloatingPoint(targetType))
+			{
+				if (IsFloatingPoint(fromType))
+					return SpirvOp::OpFConvert;
+				else if (IsSignedInteger(fromType))
+					return SpirvOp::OpConvertSToF;
+				else
+					return SpirvOp::OpConvertUToF;
+			}
+			else if (IsSignedInteger(targetType))
+			{
+				if (IsFloatingPoint(fromType))
+					return SpirvOp::OpConvertFToS;
+				else if (IsSignedInteger(fromType))
+					return SpirvOp::OpSConvert;
+				else
+					throw std::runtime_error("unsupported cast from unsigned to signed integer");
+			}
+			else if (IsUnsignedInteger(targetType))
+			{
+				if (IsFloatingPoint(fromType))
+					return SpirvOp::OpConvertFToU;
+				else if (IsSignedInteger(fromType))
+					return (Is16Bits(fromType) == Is16Bits(targetType)) ? SpirvOp::OpBitcast : SpirvOp::OpSConvert;
+				else
+					return SpirvOp::OpUConvert;
+			}
+			else
+				throw std::runtime_error("unsupported cast to boolean");
+		};
+
 		const Ast::ExpressionType& targetExprType = node.targetType.GetResultingValue();
 		if (IsPrimitiveType(targetExprType))
 		{
@@ -491,91 +681,28 @@ namespace nzsl
 			if (targetType == fromType)
 				return PushResultId(fromId);
 
-			std::optional<SpirvOp> castOp;
-			switch (targetType)
-			{
-				case Ast::PrimitiveType::Boolean:
-					throw std::runtime_error("unsupported cast to boolean");
+			SpirvOp castOp = GetConversionOp(fromType, targetType);
 
-				case Ast::PrimitiveType::Float32:
-				{
-					switch (fromType)
-					{
-						case Ast::PrimitiveType::Boolean:
-							throw std::runtime_error("unsupported cast from boolean");
-
-						case Ast::PrimitiveType::Float32:
-							break; //< Already handled
-
-						case Ast::PrimitiveType::Int32:
-							castOp = SpirvOp::OpConvertSToF;
-							break;
-
-						case Ast::PrimitiveType::UInt32:
-							castOp = SpirvOp::OpConvertUToF;
-							break;
-
-						case Ast::PrimitiveType::String:
-							throw std::runtime_error("unexpected string type");
-					}
-					break;
-				}
-
-				case Ast::PrimitiveType::Int32:
-				{
-					switch (fromType)
-					{
-						case Ast::PrimitiveType::Boolean:
-							throw std::runtime_error("unsupported cast from boolean");
-
-						case Ast::PrimitiveType::Float32:
-							castOp = SpirvOp::OpConvertFToS;
-							break;
-
-						case Ast::PrimitiveType::Int32:
-							break; //< Already handled
-
-						case Ast::PrimitiveType::UInt32:
-							throw std::runtime_error("unsupported cast from int32");
-
-						case Ast::PrimitiveType::String:
-							throw std::runtime_error("unexpected string type");
-					}
-					break;
-				}
-
-				case Ast::PrimitiveType::UInt32:
-				{
-					switch (fromType)
-					{
-						case Ast::PrimitiveType::Boolean:
-							throw std::runtime_error("unsupported cast from boolean");
-
-						case Ast::PrimitiveType::Float32:
-							castOp = SpirvOp::OpConvertFToU;
-							break;
-
-						case Ast::PrimitiveType::Int32:
-							castOp = SpirvOp::OpBitcast;
-							break;
-
-						case Ast::PrimitiveType::UInt32:
-							break; //< Already handled
+			std::uint32_t resultId = m_writer.AllocateResultId();
+			m_currentBlock->Append(castOp, m_writer.GetTypeId(targetType), resultId, fromId);
 
-						case Ast::PrimitiveType::String:
-							throw std::runtime_error("unexpected string type");
-					}
-					break;
-				}
+			PushResultId(resultId);
+		}
+		else if (IsVectorType(targetExprType) && node.expressions.size() == 1 && IsVectorType(*GetExpressionType(*node.expressions.front())))
+		{
+			// Component-wise conversion (vec4[f16] => vec4[f32])
+			const Ast::VectorType& targetType = std::get<Ast::VectorType>(targetExprType);
+			const Ast::VectorType& fromType = std::get<Ast::VectorType>(*GetExpressionType(*node.expressions.front()));
+			assert(targetType.componentCount == fromType.componentCount);
 
-				case Ast::PrimitiveType::String:
-					throw std::runtime_error("unexpected string type");
-			}
+			std::uint32_t fromId = EvaluateExpression(*node.expressions.front());
+			if (targetType.type == fromType.type)
+				return PushResultId(fromId);
 
-			assert(castOp);
+			SpirvOp castOp = GetConversionOp(fromType.type, targetType.type);
 
 			std::uint32_t resultId = m_writer.AllocateResultId();
-			m_currentBlock->Append(*castOp, m_writer.GetTypeId(targetType), resultId, fromId);
+			m_currentBlock->Append(castOp, m_writer.GetTypeId(targetExprType), resultId, fromId);
 
 			PushResultId(resultId);
 		}
@@ -631,19 +758,33 @@ namespace nzsl
 		for (auto&& extVar : node.externalVars)
 		{
 			assert(extVar.varIndex);
-			RegisterExternalVariable(*extVar.varIndex, extVar.type.GetResultingValue());
+			bool isWorkgroupShared = extVar.isWorkgroupShared.HasValue() && extVar.isWorkgroupShared.GetResultingValue();
+			RegisterExternalVariable(*extVar.varIndex, extVar.type.GetResultingValue(), isWorkgroupShared);
 		}
 	}
 
 	void SpirvAstVisitor::Visit(Ast::DeclareFunctionStatement& node)
 	{
+		assert(node.funcIndex);
+		if (m_funcData.find(*node.funcIndex) == m_funcData.end())
+			return; //< function isn't generated (only used by imported functions)
+
+		if (m_deferredFunctions)
+		{
+			m_deferredFunctions->push_back(&node);
+			return;
+		}
+
 		assert(node.funcIndex);
 		m_funcIndex = *node.funcIndex;
 		m_funcCallIndex = 0;
 
-		auto& func = m_funcData[m_funcIndex];
+		auto& func = Nz::Retrieve(m_funcData, m_funcIndex);
+
+		FunctionCode& functionCode = m_functions.emplace_back();
+		functionCode.declaration.Append(SpirvOp::OpFunction, func.returnTypeId, func.funcId, 0, func.funcTypeId);
 
-		m_instructions.Append(SpirvOp::OpFunction, func.returnTypeId, func.funcId, 0, func.funcTypeId);
+		m_relaxedPrecisionIds.clear();
 
 		if (!func.parameters.empty())
 		{
@@ -651,13 +792,20 @@ namespace nzsl
 			for (std::size_t i = 0; i < func.parameters.size(); ++i)
 			{
 				std::uint32_t paramResultId = m_writer.AllocateResultId();
-				m_instructions.Append(SpirvOp::OpFunctionParameter, func.parameters[i].pointerTypeId, paramResultId);
+				functionCode.declaration.Append(SpirvOp::OpFunctionParameter, func.parameters[i].pointerTypeId, paramResultId);
 
 				RegisterVariable(*node.parameters[i].varIndex, func.parameters[i].typeId, paramResultId, SpirvStorageClass::Function);
+
+				const auto& precision = node.parameters[i].precision;
+				if (precision.IsResultingValue() && precision.GetResultingValue() == Ast::Precision::Medium)
+					DecorateRelaxedPrecision(paramResultId);
 			}
 		}
 
-		auto contentBlock = std::make_unique<SpirvBlock>(m_writer);
+		if (func.linkageType == SpirvLinkageType::Import)
+			return;
+
+		auto contentBlock = CreateBlock();
 		m_currentBlock = contentBlock.get();
 
 		m_functionBlocks.clear();
@@ -692,16 +840,19 @@ namespace nzsl
 			}
 		}
 
+		m_debugLine.fileId = m_writer.GetSourceFileId(node.sourceLocation.file);
+		SetSourceLocation(node.sourceLocation);
+
+		Nz::CallOnExit resetDebugLine([&] { m_debugLine = {}; });
+
 		HandleStatementList(node.statements);
 
 		// Add implicit return
 		if (!m_functionBlocks.back()->IsTerminated())
 			m_functionBlocks.back()->Append(SpirvOp::OpReturn);
 
-		for (std::unique_ptr<SpirvBlock>& block : m_functionBlocks)
-			m_instructions.AppendSection(*block);
-
-		m_instructions.Append(SpirvOp::OpFunctionEnd);
+		functionCode.blocks = std::move(m_functionBlocks);
+		m_functionBlocks.clear();
 	}
 
 	void SpirvAstVisitor::Visit(Ast::DeclareOptionStatement& /*node*/)
@@ -717,7 +868,7 @@ namespace nzsl
 
 	void SpirvAstVisitor::Visit(Ast::DeclareVariableStatement& node)
 	{
-		const auto& func = m_funcData[m_funcIndex];
+		const auto& func = Nz::Retrieve(m_funcData, m_funcIndex);
 
 		std::uint32_t typeId = m_writer.GetTypeId(node.varType.GetResultingValue());
 
@@ -727,6 +878,9 @@ namespace nzsl
 
 		RegisterVariable(*node.varIndex, typeId, varId, SpirvStorageClass::Function);
 
+		if (node.precision.IsResultingValue() && node.precision.GetResultingValue() == Ast::Precision::Medium)
+			DecorateRelaxedPrecision(varId);
+
 		if (node.initialExpression)
 		{
 			std::uint32_t value = EvaluateExpression(*node.initialExpression);
@@ -778,6 +932,134 @@ namespace nzsl
 				return;
 			}
 
+			case Ast::IntrinsicType::AtomicAdd:
+			case Ast::IntrinsicType::AtomicAnd:
+			case Ast::IntrinsicType::AtomicCompareExchange:
+			case Ast::IntrinsicType::AtomicExchange:
+			case Ast::IntrinsicType::AtomicMax:
+			case Ast::IntrinsicType::AtomicMin:
+			case Ast::IntrinsicType::AtomicOr:
+			case Ast::IntrinsicType::AtomicXor:
+			{
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+				assert(IsPrimitiveType(*parameterType));
+				bool isSigned = std::get<Ast::PrimitiveType>(*parameterType) == Ast::PrimitiveType::Int32;
+
+				SpirvOp op;
+				switch (node.intrinsic)
+				{
+					case Ast::IntrinsicType::AtomicAdd:             op = SpirvOp::OpAtomicIAdd; break;
+					case Ast::IntrinsicType::AtomicAnd:             op = SpirvOp::OpAtomicAnd; break;
+					case Ast::IntrinsicType::AtomicCompareExchange: op = SpirvOp::OpAtomicCompareExchange; break;
+					case Ast::IntrinsicType::AtomicExchange:        op = SpirvOp::OpAtomicExchange; break;
+					case Ast::IntrinsicType::AtomicMax:             op = (isSigned) ? SpirvOp::OpAtomicSMax : SpirvOp::OpAtomicUMax; break;
+					case Ast::IntrinsicType::AtomicMin:             op = (isSigned) ? SpirvOp::OpAtomicSMin : SpirvOp::OpAtomicUMin; break;
+					case Ast::IntrinsicType::AtomicOr:              op = SpirvOp::OpAtomicOr; break;
+					case Ast::IntrinsicType::AtomicXor:             op = SpirvOp::OpAtomicXor; break;
+					default:
+						throw std::runtime_error("unexpected atomic intrinsic");
+				}
+
+				std::uint32_t typeId = m_writer.GetTypeId(*parameterType);
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(GetIntrinsicMemoryScope(node.intrinsic)));
+				std::uint32_t semanticsId = m_writer.GetSingleConstantId(GetIntrinsicMemorySemantics(node.intrinsic));
+
+				SpirvExpressionLoad pointerVisitor(m_writer, *this, *m_currentBlock);
+				std::uint32_t pointerId = pointerVisitor.EvaluatePointer(*node.parameters[0]);
+
+				std::uint32_t resultId = m_writer.AllocateResultId();
+				if (node.intrinsic == Ast::IntrinsicType::AtomicCompareExchange)
+				{
+					std::uint32_t comparatorId = EvaluateExpression(*node.parameters[1]);
+					std::uint32_t valueId = EvaluateExpression(*node.parameters[2]);
+
+					m_currentBlock->Append(op, typeId, resultId, pointerId, scopeId, semanticsId, semanticsId, valueId, comparatorId);
+				}
+				else
+				{
+					std::uint32_t valueId = EvaluateExpression(*node.parameters[1]);
+
+					m_currentBlock->Append(op, typeId, resultId, pointerId, scopeId, semanticsId, valueId);
+				}
+
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::Barrier:
+			{
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(GetIntrinsicMemoryScope(node.intrinsic)));
+				std::uint32_t semanticsId = m_writer.GetSingleConstantId(GetIntrinsicMemorySemantics(node.intrinsic));
+
+				m_currentBlock->Append(SpirvOp::OpControlBarrier, scopeId, scopeId, semanticsId);
+				PushResultId(0);
+				return;
+			}
+
+			case Ast::IntrinsicType::MemoryBarrier:
+			case Ast::IntrinsicType::MemoryBarrierBuffer:
+			case Ast::IntrinsicType::MemoryBarrierImage:
+			case Ast::IntrinsicType::MemoryBarrierShared:
+			{
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(GetIntrinsicMemoryScope(node.intrinsic)));
+				std::uint32_t semanticsId = m_writer.GetSingleConstantId(GetIntrinsicMemorySemantics(node.intrinsic));
+
+				m_currentBlock->Append(SpirvOp::OpMemoryBarrier, scopeId, semanticsId);
+				PushResultId(0);
+				return;
+			}
+
+			case Ast::IntrinsicType::BitCount:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t param = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpBitCount, typeId, resultId, param);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::BitFieldExtract:
+			{
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+
+				Ast::PrimitiveType baseType = (IsVectorType(*parameterType)) ? std::get<Ast::VectorType>(*parameterType).type : std::get<Ast::PrimitiveType>(*parameterType);
+				SpirvOp op = (baseType == Ast::PrimitiveType::Int32) ? SpirvOp::OpBitFieldSExtract : SpirvOp::OpBitFieldUExtract;
+
+				std::uint32_t typeId = m_writer.GetTypeId(*parameterType);
+
+				std::uint32_t base = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t offset = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t count = EvaluateExpression(*node.parameters[2]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(op, typeId, resultId, base, offset, count);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::BitFieldInsert:
+			{
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+
+				std::uint32_t typeId = m_writer.GetTypeId(*parameterType);
+
+				std::uint32_t base = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t insert = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t offset = EvaluateExpression(*node.parameters[2]);
+				std::uint32_t count = EvaluateExpression(*node.parameters[3]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpBitFieldInsert, typeId, resultId, base, insert, offset, count);
+				PushResultId(resultId);
+				return;
+			}
+
 			case Ast::IntrinsicType::CrossProduct:
 			{
 				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
@@ -834,6 +1116,116 @@ namespace nzsl
 				return;
 			}
 
+			case Ast::IntrinsicType::FirstBitHigh:
+			case Ast::IntrinsicType::FirstBitLow:
+			{
+				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
+
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+
+				Ast::PrimitiveType baseType = (IsVectorType(*parameterType)) ? std::get<Ast::VectorType>(*parameterType).type : std::get<Ast::PrimitiveType>(*parameterType);
+
+				SpirvGlslStd450Op op;
+				if (node.intrinsic == Ast::IntrinsicType::FirstBitLow)
+					op = SpirvGlslStd450Op::FindILsb;
+				else
+					op = (baseType == Ast::PrimitiveType::Int32) ? SpirvGlslStd450Op::FindSMsb : SpirvGlslStd450Op::FindUMsb;
+
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t param = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpExtInst, typeId, resultId, glslInstructionSet, op, param);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::ImageAtomicAdd:
+			case Ast::IntrinsicType::ImageAtomicAnd:
+			case Ast::IntrinsicType::ImageAtomicExchange:
+			case Ast::IntrinsicType::ImageAtomicMax:
+			case Ast::IntrinsicType::ImageAtomicMin:
+			case Ast::IntrinsicType::ImageAtomicOr:
+			case Ast::IntrinsicType::ImageAtomicXor:
+			{
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+				assert(IsStorageImageType(*parameterType));
+				const Ast::StorageImageType& imageType = std::get<Ast::StorageImageType>(*parameterType);
+				bool isSigned = imageType.sampledType == Ast::PrimitiveType::Int32;
+
+				SpirvOp op;
+				switch (node.intrinsic)
+				{
+					case Ast::IntrinsicType::ImageAtomicAdd:      op = SpirvOp::OpAtomicIAdd; break;
+					case Ast::IntrinsicType::ImageAtomicAnd:      op = SpirvOp::OpAtomicAnd; break;
+					case Ast::IntrinsicType::ImageAtomicExchange: op = SpirvOp::OpAtomicExchange; break;
+					case Ast::IntrinsicType::ImageAtomicMax:      op = (isSigned) ? SpirvOp::OpAtomicSMax : SpirvOp::OpAtomicUMax; break;
+					case Ast::IntrinsicType::ImageAtomicMin:      op = (isSigned) ? SpirvOp::OpAtomicSMin : SpirvOp::OpAtomicUMin; break;
+					case Ast::IntrinsicType::ImageAtomicOr:       op = SpirvOp::OpAtomicOr; break;
+					case Ast::IntrinsicType::ImageAtomicXor:      op = SpirvOp::OpAtomicXor; break;
+					default:
+						throw std::runtime_error("unexpected image atomic intrinsic");
+				}
+
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+				std::uint32_t texelPointerTypeId = m_writer.GetPointerTypeId(imageType.sampledType, SpirvStorageClass::Image);
+				std::uint32_t sampleId = m_writer.GetSingleConstantId(std::uint32_t(0));
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(GetIntrinsicMemoryScope(node.intrinsic)));
+				std::uint32_t semanticsId = m_writer.GetSingleConstantId(GetIntrinsicMemorySemantics(node.intrinsic));
+
+				// Atomics operate on a pointer to the texel, built from the image variable (not a loaded image)
+				SpirvExpressionLoad pointerVisitor(m_writer, *this, *m_currentBlock);
+				std::uint32_t imagePointerId = pointerVisitor.EvaluatePointer(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t valueId = EvaluateExpression(*node.parameters[2]);
+
+				std::uint32_t texelPointerId = m_writer.AllocateResultId();
+				m_currentBlock->Append(SpirvOp::OpImageTexelPointer, texelPointerTypeId, texelPointerId, imagePointerId, coordinatesId, sampleId);
+
+				// Texel pointers of a non-uniformly indexed descriptor array must be decorated as well
+				if (node.parameters[0]->GetType() == Ast::NodeType::AccessIndexExpression)
+				{
+					const auto& accessIndex = static_cast<const Ast::AccessIndexExpression&>(*node.parameters[0]);
+					if (accessIndex.indices.size() == 1 && accessIndex.indices.front()->GetType() == Ast::NodeType::IntrinsicExpression && static_cast<const Ast::IntrinsicExpression&>(*accessIndex.indices.front()).intrinsic == Ast::IntrinsicType::NonUniform)
+						DecorateNonUniform(texelPointerId);
+				}
+
+				std::uint32_t resultId = m_writer.AllocateResultId();
+				m_currentBlock->Append(op, typeId, resultId, texelPointerId, scopeId, semanticsId, valueId);
+
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::ImageLoad:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t imageId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+
+				std::uint32_t resultId = m_writer.AllocateResultId();
+				m_currentBlock->Append(SpirvOp::OpImageRead, typeId, resultId, imageId, coordinatesId);
+
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::ImageStore:
+			{
+				std::uint32_t imageId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t texelId = EvaluateExpression(*node.parameters[2]);
+
+				m_currentBlock->Append(SpirvOp::OpImageWrite, imageId, coordinatesId, texelId);
+
+				PushResultId(0);
+				return;
+			}
+
 			case Ast::IntrinsicType::Inverse:
 			{
 				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
@@ -892,14 +1284,17 @@ namespace nzsl
 					case Ast::PrimitiveType::Boolean:
 						throw std::runtime_error("unexpected boolean for max/min intrinsic");
 
+					case Ast::PrimitiveType::Float16:
 					case Ast::PrimitiveType::Float32:
 						op = (node.intrinsic == Ast::IntrinsicType::Max) ? SpirvGlslStd450Op::FMax : SpirvGlslStd450Op::FMin;
 						break;
 
+					case Ast::PrimitiveType::Int16:
 					case Ast::PrimitiveType::Int32:
 						op = (node.intrinsic == Ast::IntrinsicType::Max) ? SpirvGlslStd450Op::SMax : SpirvGlslStd450Op::SMin;
 						break;
 
+					case Ast::PrimitiveType::UInt16:
 					case Ast::PrimitiveType::UInt32:
 						op = (node.intrinsic == Ast::IntrinsicType::Max) ? SpirvGlslStd450Op::UMax : SpirvGlslStd450Op::UMin;
 						break;
@@ -917,6 +1312,21 @@ namespace nzsl
 				return;
 			}
 
+			case Ast::IntrinsicType::NonUniform:
+			{
+				// Decorations apply to results, copy the value so the decoration doesn't leak to other uses (constants, variables)
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t valueId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpCopyObject, typeId, resultId, valueId);
+				DecorateNonUniform(resultId);
+
+				PushResultId(resultId);
+				return;
+			}
+
 			case Ast::IntrinsicType::Normalize:
 			{
 				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
@@ -937,6 +1347,34 @@ namespace nzsl
 				return;
 			}
 
+			case Ast::IntrinsicType::PackHalf2x16:
+			case Ast::IntrinsicType::PackUnorm4x8:
+			case Ast::IntrinsicType::UnpackHalf2x16:
+			case Ast::IntrinsicType::UnpackUnorm4x8:
+			{
+				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
+
+				SpirvGlslStd450Op op;
+				switch (node.intrinsic)
+				{
+					case Ast::IntrinsicType::PackHalf2x16:   op = SpirvGlslStd450Op::PackHalf2x16; break;
+					case Ast::IntrinsicType::PackUnorm4x8:   op = SpirvGlslStd450Op::PackUnorm4x8; break;
+					case Ast::IntrinsicType::UnpackHalf2x16: op = SpirvGlslStd450Op::UnpackHalf2x16; break;
+					case Ast::IntrinsicType::UnpackUnorm4x8: op = SpirvGlslStd450Op::UnpackUnorm4x8; break;
+					default:
+						throw std::runtime_error("unexpected pack intrinsic");
+				}
+
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t param = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpExtInst, typeId, resultId, glslInstructionSet, op, param);
+				PushResultId(resultId);
+				return;
+			}
+
 			case Ast::IntrinsicType::Pow:
 			{
 				std::uint32_t glslInstructionSet = m_writer.GetExtendedInstructionSet("GLSL.std.450");
@@ -986,6 +1424,184 @@ namespace nzsl
 				return;
 			}
 
+			case Ast::IntrinsicType::SampleTextureGrad:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t samplerId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t ddxId = EvaluateExpression(*node.parameters[2]);
+				std::uint32_t ddyId = EvaluateExpression(*node.parameters[3]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpImageSampleExplicitLod, typeId, resultId, samplerId, coordinatesId, SpirvImageOperands::Grad, ddxId, ddyId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::SampleTextureLod:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t samplerId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t lodId = EvaluateExpression(*node.parameters[2]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpImageSampleExplicitLod, typeId, resultId, samplerId, coordinatesId, SpirvImageOperands::Lod, lodId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::SubgroupAdd:
+			case Ast::IntrinsicType::SubgroupMax:
+			case Ast::IntrinsicType::SubgroupMin:
+			{
+				const Ast::ExpressionType* parameterType = GetExpressionType(*node.parameters[0]);
+				assert(parameterType);
+				assert(IsPrimitiveType(*parameterType) || IsVectorType(*parameterType));
+				std::uint32_t typeId = m_writer.GetTypeId(*parameterType);
+
+				Ast::PrimitiveType basicType;
+				if (IsPrimitiveType(*parameterType))
+					basicType = std::get<Ast::PrimitiveType>(*parameterType);
+				else if (IsVectorType(*parameterType))
+					basicType = std::get<Ast::VectorType>(*parameterType).type;
+				else
+					throw std::runtime_error("unexpected expression type");
+
+				SpirvOp op;
+				switch (basicType)
+				{
+					case Ast::PrimitiveType::Boolean:
+						throw std::runtime_error("unexpected boolean for subgroup arithmetic intrinsic");
+
+					case Ast::PrimitiveType::Float16:
+					case Ast::PrimitiveType::Float32:
+						if (node.intrinsic == Ast::IntrinsicType::SubgroupAdd)
+							op = SpirvOp::OpGroupNonUniformFAdd;
+						else
+							op = (node.intrinsic == Ast::IntrinsicType::SubgroupMax) ? SpirvOp::OpGroupNonUniformFMax : SpirvOp::OpGroupNonUniformFMin;
+						break;
+
+					case Ast::PrimitiveType::Int16:
+					case Ast::PrimitiveType::Int32:
+						if (node.intrinsic == Ast::IntrinsicType::SubgroupAdd)
+							op = SpirvOp::OpGroupNonUniformIAdd;
+						else
+							op = (node.intrinsic == Ast::IntrinsicType::SubgroupMax) ? SpirvOp::OpGroupNonUniformSMax : SpirvOp::OpGroupNonUniformSMin;
+						break;
+
+					case Ast::PrimitiveType::UInt16:
+					case Ast::PrimitiveType::UInt32:
+						if (node.intrinsic == Ast::IntrinsicType::SubgroupAdd)
+							op = SpirvOp::OpGroupNonUniformIAdd;
+						else
+							op = (node.intrinsic == Ast::IntrinsicType::SubgroupMax) ? SpirvOp::OpGroupNonUniformUMax : SpirvOp::OpGroupNonUniformUMin;
+						break;
+
+					case Ast::PrimitiveType::String:
+						throw std::runtime_error("unexpected string type");
+				}
+
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(SpirvScope::Subgroup));
+				std::uint32_t valueId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(op, typeId, resultId, scopeId, SpirvGroupOperation::Reduce, valueId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::SubgroupBallot:
+			case Ast::IntrinsicType::SubgroupBroadcastFirst:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(SpirvScope::Subgroup));
+
+				std::uint32_t valueId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				SpirvOp op = (node.intrinsic == Ast::IntrinsicType::SubgroupBallot) ? SpirvOp::OpGroupNonUniformBallot : SpirvOp::OpGroupNonUniformBroadcastFirst;
+				m_currentBlock->Append(op, typeId, resultId, scopeId, valueId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::SubgroupElect:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(SpirvScope::Subgroup));
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpGroupNonUniformElect, typeId, resultId, scopeId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::SubgroupShuffle:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+				std::uint32_t scopeId = m_writer.GetSingleConstantId(static_cast<std::uint32_t>(SpirvScope::Subgroup));
+
+				std::uint32_t valueId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t invocationId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpGroupNonUniformShuffle, typeId, resultId, scopeId, valueId, invocationId);
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::TextureFetch:
+			case Ast::IntrinsicType::TextureSize:
+			{
+				const Ast::ExpressionType* samplerType = GetExpressionType(*node.parameters[0]);
+				assert(samplerType);
+				assert(IsSamplerType(*samplerType));
+
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				// Fetches and queries operate on the image, not on the sampled image
+				std::uint32_t samplerId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t imageId = m_writer.AllocateResultId();
+				m_currentBlock->Append(SpirvOp::OpImage, m_writer.GetImageTypeId(std::get<Ast::SamplerType>(*samplerType)), imageId, samplerId);
+
+				std::uint32_t resultId;
+				if (node.intrinsic == Ast::IntrinsicType::TextureFetch)
+				{
+					std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+					std::uint32_t lodId = EvaluateExpression(*node.parameters[2]);
+					resultId = m_writer.AllocateResultId();
+
+					m_currentBlock->Append(SpirvOp::OpImageFetch, typeId, resultId, imageId, coordinatesId, SpirvImageOperands::Lod, lodId);
+				}
+				else
+				{
+					std::uint32_t lodId = EvaluateExpression(*node.parameters[1]);
+					resultId = m_writer.AllocateResultId();
+
+					m_currentBlock->Append(SpirvOp::OpImageQuerySizeLod, typeId, resultId, imageId, lodId);
+				}
+
+				PushResultId(resultId);
+				return;
+			}
+
+			case Ast::IntrinsicType::TextureGather:
+			{
+				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
+
+				std::uint32_t samplerId = EvaluateExpression(*node.parameters[0]);
+				std::uint32_t coordinatesId = EvaluateExpression(*node.parameters[1]);
+				std::uint32_t componentId = (node.parameters.size() > 2) ? EvaluateExpression(*node.parameters[2]) : m_writer.GetSingleConstantId(std::int32_t(0));
+				std::uint32_t resultId = m_writer.AllocateResultId();
+
+				m_currentBlock->Append(SpirvOp::OpImageGather, typeId, resultId, samplerId, coordinatesId, componentId);
+				PushResultId(resultId);
+				return;
+			}
+
 			case Ast::IntrinsicType::Transpose:
 			{
 				std::uint32_t typeId = m_writer.GetTypeId(*node.cachedExpressionType);
@@ -1017,7 +1633,7 @@ namespace nzsl
 		if (node.returnExpr)
 		{
 			// Handle entry point return
-			const auto& func = m_funcData[m_funcIndex];
+			const auto& func = Nz::Retrieve(m_funcData, m_funcIndex);
 			if (func.entryPointData)
 			{
 				auto& entryPointData = *func.entryPointData;
@@ -1133,6 +1749,14 @@ namespace nzsl
 		{
 			switch (node.op)
 			{
+				case Ast::UnaryType::BitwiseNot:
+				{
+					std::uint32_t resultId = m_writer.AllocateResultId();
+					m_currentBlock->Append(SpirvOp::OpNot, m_writer.GetTypeId(*resultType), resultId, operand);
+
+					return resultId;
+				}
+
 				case Ast::UnaryType::LogicalNot:
 				{
 					assert(IsPrimitiveType(*exprType));
@@ -1158,11 +1782,14 @@ namespace nzsl
 
 					switch (basicType)
 					{
+						case Ast::PrimitiveType::Float16:
 						case Ast::PrimitiveType::Float32:
 							m_currentBlock->Append(SpirvOp::OpFNegate, m_writer.GetTypeId(*resultType), resultId, operand);
 							return resultId;
 
+						case Ast::PrimitiveType::Int16:
 						case Ast::PrimitiveType::Int32:
+						case Ast::PrimitiveType::UInt16:
 						case Ast::PrimitiveType::UInt32:
 							m_currentBlock->Append(SpirvOp::OpSNegate, m_writer.GetTypeId(*resultType), resultId, operand);
 							return resultId;
@@ -1195,10 +1822,10 @@ namespace nzsl
 		assert(node.condition);
 		assert(node.body);
 
-		auto headerBlock = std::make_unique<SpirvBlock>(m_writer);
-		auto bodyBlock = std::make_unique<SpirvBlock>(m_writer);
-		auto mergeBlock = std::make_unique<SpirvBlock>(m_writer);
-		auto continueBlock = std::make_unique<SpirvBlock>(m_writer);
+		auto headerBlock = CreateBlock();
+		auto bodyBlock = CreateBlock();
+		auto mergeBlock = CreateBlock();
+		auto continueBlock = CreateBlock();
 
 		m_currentBlock->Append(SpirvOp::OpBranch, headerBlock->GetLabelId());
 		m_currentBlock = headerBlock.get();
@@ -1257,10 +1884,26 @@ namespace nzsl
 		m_currentBlock = m_functionBlocks.back().get();
 	}
 
+	void SpirvAstVisitor::DecorateNonUniform(std::uint32_t resultId)
+	{
+		m_functions.back().decorations.Append(SpirvOp::OpDecorate, resultId, SpirvDecoration::NonUniform);
+	}
+
+	void SpirvAstVisitor::DecorateRelaxedPrecision(std::uint32_t resultId)
+	{
+		// Some results (such as variable pointers) can be evaluated multiple times
+		if (!m_relaxedPrecisionIds.insert(resultId).second)
+			return;
+
+		m_functions.back().decorations.Append(SpirvOp::OpDecorate, resultId, SpirvDecoration::RelaxedPrecision);
+	}
+
 	void SpirvAstVisitor::HandleStatementList(const std::vector<Ast::StatementPtr>& statements)
 	{
 		for (auto& statement : statements)
 		{
+			SetSourceLocation(statement->sourceLocation);
+
 			// Handle termination statements
 			switch (statement->GetType())
 			{
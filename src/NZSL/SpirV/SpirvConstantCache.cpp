@@ -6,7 +6,10 @@
 #include <NZSL/Ast/Nodes.hpp>
 #include <NZSL/Math/FieldOffsets.hpp>
 #include <NZSL/SpirV/SpirvSection.hpp>
+#include <NZSL/SpirV/SpirvTypeCache.hpp>
+#include <Nazara/Utils/Algorithm.hpp>
 #include <tsl/ordered_map.h>
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -14,6 +17,10 @@ namespace nzsl
 {
 	namespace
 	{
+		// Type building is const and may run concurrently from multiple threads (see SpirvWriter::Environment::functionThreadCount)
+		thread_local bool s_isInBlockStruct = false;
+		thread_local StructLayout s_blockLayout = StructLayout::Std140; //< layout of the struct being built, used for array strides
+
 		StructFieldType SpirvTypeToStructFieldType(const SpirvConstantCache::AnyType& type)
 		{
 			if (std::holds_alternative<SpirvConstantCache::Bool>(type))
@@ -21,18 +28,147 @@ namespace nzsl
 			else if (std::holds_alternative<SpirvConstantCache::Float>(type))
 			{
 				const auto& floatType = std::get<SpirvConstantCache::Float>(type);
-				assert(floatType.width == 32 || floatType.width == 64);
-				return (floatType.width == 32) ? StructFieldType::Float1 : StructFieldType::Double1;
+				switch (floatType.width)
+				{
+					case 16: return StructFieldType::Half1;
+					case 32: return StructFieldType::Float1;
+					case 64: return StructFieldType::Double1;
+					default: throw std::runtime_error("unexpected float width " + std::to_string(floatType.width));
+				}
 			}
 			else if (std::holds_alternative<SpirvConstantCache::Integer>(type))
 			{
 				const auto& intType = std::get<SpirvConstantCache::Integer>(type);
-				assert(intType.width == 32);
-				return (intType.signedness) ? StructFieldType::Int1 : StructFieldType::UInt1;
+				switch (intType.width)
+				{
+					case 16: return (intType.signedness) ? StructFieldType::Short1 : StructFieldType::UShort1;
+					case 32: return (intType.signedness) ? StructFieldType::Int1 : StructFieldType::UInt1;
+					default: throw std::runtime_error("unexpected integer width " + std::to_string(intType.width));
+				}
 			}
 
 			throw std::runtime_error("unexpected type");
 		}
+
+		bool Uses16BitType(const SpirvConstantCache::AnyType& type)
+		{
+			return std::visit([](auto&& arg) -> bool
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, SpirvConstantCache::Float> || std::is_same_v<T, SpirvConstantCache::Integer>)
+					return arg.width == 16;
+				else if constexpr (std::is_same_v<T, SpirvConstantCache::Array>)
+					return Uses16BitType(arg.elementType->type);
+				else if constexpr (std::is_same_v<T, SpirvConstantCache::Matrix>)
+					return Uses16BitType(arg.columnType->type);
+				else if constexpr (std::is_same_v<T, SpirvConstantCache::Structure>)
+				{
+					for (const auto& member : arg.members)
+					{
+						if (Uses16BitType(member.type->type))
+							return true;
+					}
+
+					return false;
+				}
+				else if constexpr (std::is_same_v<T, SpirvConstantCache::Vector>)
+					return Uses16BitType(arg.componentType->type);
+				else
+					return false;
+			}, type);
+		}
+
+		// Structs without a layout attribute keep the historical std140 offsets
+		StructLayout GetStructLayout(const Ast::StructDescription& structDesc)
+		{
+			if (!structDesc.layout.IsResultingValue() || structDesc.layout.GetResultingValue() == StructLayout::Packed)
+				return StructLayout::Std140;
+
+			return structDesc.layout.GetResultingValue();
+		}
+
+		template<typename T>
+		void AppendKeyValue(std::string& key, T value)
+		{
+			key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		bool AppendStructKey(std::string& key, const SpirvConstantCache::StructCallback& structCallback, const Ast::StructDescription& structDesc, const std::vector<SpirvDecoration>& decorations, bool isInBlockStruct);
+
+		// Returns false for types which can't be part of a struct key (they're not cached)
+		bool AppendTypeKey(std::string& key, const SpirvConstantCache::StructCallback& structCallback, const Ast::ExpressionType& type, bool isInBlockStruct)
+		{
+			AppendKeyValue(key, std::uint8_t(type.index()));
+
+			return std::visit([&](auto&& arg) -> bool
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, Ast::ArrayType> || std::is_same_v<T, Ast::DynArrayType>)
+				{
+					if constexpr (std::is_same_v<T, Ast::ArrayType>)
+						AppendKeyValue(key, arg.length);
+
+					return AppendTypeKey(key, structCallback, arg.containedType->type, isInBlockStruct);
+				}
+				else if constexpr (std::is_same_v<T, Ast::MatrixType>)
+				{
+					AppendKeyValue(key, arg.columnCount);
+					AppendKeyValue(key, arg.rowCount);
+					AppendKeyValue(key, arg.type);
+					return true;
+				}
+				else if constexpr (std::is_same_v<T, Ast::PrimitiveType>)
+				{
+					AppendKeyValue(key, arg);
+					return true;
+				}
+				else if constexpr (std::is_same_v<T, Ast::StructType>)
+					return AppendStructKey(key, structCallback, structCallback(arg.structIndex), {}, isInBlockStruct);
+				else if constexpr (std::is_same_v<T, Ast::VectorType>)
+				{
+					AppendKeyValue(key, arg.componentCount);
+					AppendKeyValue(key, arg.type);
+					return true;
+				}
+				else
+					return false;
+			}, type);
+		}
+
+		// Struct types only depend on their name, members and decorations (and whether they're part of a block, which changes array strides)
+		bool AppendStructKey(std::string& key, const SpirvConstantCache::StructCallback& structCallback, const Ast::StructDescription& structDesc, const std::vector<SpirvDecoration>& decorations, bool isInBlockStruct)
+		{
+			key.append(structDesc.name);
+			key.push_back('\0');
+
+			AppendKeyValue(key, GetStructLayout(structDesc));
+			AppendKeyValue(key, isInBlockStruct);
+			AppendKeyValue(key, decorations.size());
+			for (SpirvDecoration decoration : decorations)
+			{
+				AppendKeyValue(key, decoration);
+				isInBlockStruct = isInBlockStruct || decoration == SpirvDecoration::Block || decoration == SpirvDecoration::BufferBlock;
+			}
+
+			for (const auto& member : structDesc.members)
+			{
+				if (member.cond.HasValue() && !member.cond.GetResultingValue())
+					continue;
+
+				key.append(member.name);
+				key.push_back('\0');
+
+				AppendKeyValue(key, member.precision.IsResultingValue() && member.precision.GetResultingValue() == Ast::Precision::Medium);
+
+				if (!AppendTypeKey(key, structCallback, member.type.GetResultingValue(), isInBlockStruct))
+					return false;
+			}
+
+			key.push_back('\0'); //< end of members
+			return true;
+		}
 	}
 
 	struct SpirvConstantCache::Eq
@@ -112,6 +248,9 @@ namespace nzsl
 			if (lhs.decorations != rhs.decorations)
 				return false;
 
+			if (lhs.layout != rhs.layout)
+				return false;
+
 			if (!Compare(lhs.members, rhs.members))
 				return false;
 
@@ -126,6 +265,9 @@ namespace nzsl
 			if (lhs.name != rhs.name)
 				return false;
 
+			if (lhs.relaxedPrecision != rhs.relaxedPrecision)
+				return false;
+
 			return true;
 		}
 
@@ -162,11 +304,24 @@ namespace nzsl
 
 		bool Compare(const Constant& lhs, const Constant& rhs) const
 		{
+			if (&lhs == &rhs)
+				return true;
+
+			// Structurally equal constants have the same hash
+			if (lhs.hash && rhs.hash && *lhs.hash != *rhs.hash)
+				return false;
+
 			return Compare(lhs.constant, rhs.constant);
 		}
 
 		bool Compare(const Type& lhs, const Type& rhs) const
 		{
+			if (&lhs == &rhs)
+				return true;
+
+			if (lhs.hash && rhs.hash && *lhs.hash != *rhs.hash)
+				return false;
+
 			return Compare(lhs.type, rhs.type);
 		}
 
@@ -259,9 +414,12 @@ namespace nzsl
 		}
 
 		void Register(const Bool&) {}
+		void Register(const Void&) {}
+
+		// 16-bit types which are only loaded, stored and converted only require the storage capabilities (see Register(const Pointer&)),
+		// Float16 and Int16 are required when 16-bit values are kept in function variables or passed to functions (and by the writer for operations on them)
 		void Register(const Float&) {}
 		void Register(const Integer&) {}
-		void Register(const Void&) {}
 
 		void Register(const Image& image)
 		{
@@ -272,6 +430,10 @@ namespace nzsl
 		{
 			cache.Register(*func.returnType);
 			Register(func.parameters);
+
+			Require16BitArithmetic(func.returnType->type);
+			for (const TypePtr& parameter : func.parameters)
+				Require16BitArithmetic(parameter->type);
 		}
 
 		void Register(const Matrix& vec)
@@ -284,6 +446,35 @@ namespace nzsl
 		{
 			assert(ptr.type);
 			cache.Register(*ptr.type);
+
+			// Storing 16-bit types in interface storage classes requires its own capability
+			if (Uses16BitType(ptr.type->type))
+			{
+				switch (ptr.storageClass)
+				{
+					case SpirvStorageClass::Input:
+					case SpirvStorageClass::Output:
+						RequireCapability(SpirvCapability::StorageInputOutput16);
+						break;
+
+					case SpirvStorageClass::PushConstant:
+						RequireCapability(SpirvCapability::StoragePushConstant16);
+						break;
+
+					case SpirvStorageClass::StorageBuffer:
+						RequireCapability(SpirvCapability::StorageBuffer16BitAccess);
+						break;
+
+					// Uniform pointers may point to uniform or storage buffers members, this is handled when registering the variable
+					case SpirvStorageClass::Uniform:
+						break;
+
+					// Function, private and workgroup variables hold values the shader computes with
+					default:
+						Require16BitArithmetic(ptr.type->type);
+						break;
+				}
+			}
 		}
 
 		void Register(const SampledImage& sampledImage)
@@ -295,7 +486,10 @@ namespace nzsl
 		void Register(const Structure& s)
 		{
 			Register(s.members);
-			cache.BuildFieldOffsets(s);
+
+			// Offsets only have to be computed once (and structs coming from a SpirvTypeCache already have them)
+			if (!s.members.empty() && !s.members.front().offset)
+				cache.BuildFieldOffsets(s);
 		}
 
 		void Register(const SpirvConstantCache::Structure::Member& m)
@@ -309,6 +503,26 @@ namespace nzsl
 			cache.Register(*variable.type);
 			if (variable.initializer)
 				cache.Register(*variable.initializer.value());
+
+			// Before SPIR-V 1.3, storage buffers are BufferBlock structs (or arrays of them) in the Uniform storage class
+			if (variable.storageClass == SpirvStorageClass::Uniform && std::holds_alternative<Pointer>(variable.type->type))
+			{
+				const TypePtr* blockType = &std::get<Pointer>(variable.type->type).type;
+				while (std::holds_alternative<Array>((*blockType)->type))
+					blockType = &std::get<Array>((*blockType)->type).elementType;
+
+				if (Uses16BitType((*blockType)->type))
+				{
+					bool isBufferBlock = false;
+					if (std::holds_alternative<Structure>((*blockType)->type))
+					{
+						const auto& decorations = std::get<Structure>((*blockType)->type).decorations;
+						isBufferBlock = std::find(decorations.begin(), decorations.end(), SpirvDecoration::BufferBlock) != decorations.end();
+					}
+
+					RequireCapability((isBufferBlock) ? SpirvCapability::StorageBuffer16BitAccess : SpirvCapability::UniformAndStorageBuffer16BitAccess);
+				}
+			}
 		}
 
 		void Register(const Vector& vec)
@@ -399,16 +613,253 @@ namespace nzsl
 			return Register(*lhs);
 		}
 
+		void Require16BitArithmetic(const AnyType& type)
+		{
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+
+				if constexpr (std::is_same_v<T, Float>)
+				{
+					if (arg.width == 16)
+						RequireCapability(SpirvCapability::Float16);
+				}
+				else if constexpr (std::is_same_v<T, Integer>)
+				{
+					if (arg.width == 16)
+						RequireCapability(SpirvCapability::Int16);
+				}
+				else if constexpr (std::is_same_v<T, Array>)
+					Require16BitArithmetic(arg.elementType->type);
+				else if constexpr (std::is_same_v<T, Matrix>)
+					Require16BitArithmetic(arg.columnType->type);
+				else if constexpr (std::is_same_v<T, Structure>)
+				{
+					for (const auto& member : arg.members)
+						Require16BitArithmetic(member.type->type);
+				}
+				else if constexpr (std::is_same_v<T, Vector>)
+					Require16BitArithmetic(arg.componentType->type);
+			}, type);
+		}
+
+		void RequireCapability(SpirvCapability capability)
+		{
+			if (cache.m_internal->capabilityCallback)
+				cache.m_internal->capabilityCallback(capability);
+		}
+
 		SpirvConstantCache& cache;
 	};
 
-	//< FIXME PLZ
-	struct AnyHasher
+	struct SpirvConstantCache::Hasher
 	{
-		template<typename U>
-		std::size_t operator()(const U&) const
+		std::size_t Hash(const ConstantBool& constant) const
+		{
+			return std::hash<bool>{}(constant.value);
+		}
+
+		std::size_t Hash(const ConstantComposite& constant) const
+		{
+			std::size_t seed = Hash(constant.type);
+			Combine(seed, constant.values);
+
+			return seed;
+		}
+
+		std::size_t Hash(const ConstantScalar& constant) const
+		{
+			return std::hash<decltype(constant.value)>{}(constant.value);
+		}
+
+		std::size_t Hash(const Array& array) const
+		{
+			std::size_t seed = Hash(array.elementType);
+			Combine(seed, array.length);
+			Nz::HashCombine(seed, array.stride);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Bool& /*type*/) const
+		{
+			return 0;
+		}
+
+		std::size_t Hash(const Float& type) const
+		{
+			return std::hash<std::uint32_t>{}(type.width);
+		}
+
+		std::size_t Hash(const Function& function) const
+		{
+			std::size_t seed = Hash(function.returnType);
+			Combine(seed, function.parameters);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Image& image) const
+		{
+			std::size_t seed = Hash(image.sampledType);
+			Nz::HashCombine(seed, image.qualifier);
+			Nz::HashCombine(seed, image.depth);
+			Nz::HashCombine(seed, image.sampled);
+			Nz::HashCombine(seed, image.dim);
+			Nz::HashCombine(seed, image.format);
+			Nz::HashCombine(seed, image.arrayed);
+			Nz::HashCombine(seed, image.multisampled);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Integer& type) const
+		{
+			std::size_t seed = std::hash<std::uint32_t>{}(type.width);
+			Nz::HashCombine(seed, type.signedness);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Matrix& matrix) const
+		{
+			std::size_t seed = Hash(matrix.columnType);
+			Nz::HashCombine(seed, matrix.columnCount);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Pointer& pointer) const
+		{
+			std::size_t seed = Hash(pointer.type);
+			Nz::HashCombine(seed, pointer.storageClass);
+
+			return seed;
+		}
+
+		std::size_t Hash(const SampledImage& sampledImage) const
 		{
-			return 42;
+			return Hash(sampledImage.image);
+		}
+
+		std::size_t Hash(const Structure& structure) const
+		{
+			std::size_t seed = std::hash<std::string>{}(structure.name);
+			for (SpirvDecoration decoration : structure.decorations)
+				Nz::HashCombine(seed, decoration);
+
+			Nz::HashCombine(seed, structure.layout);
+			Combine(seed, structure.members);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Structure::Member& member) const
+		{
+			std::size_t seed = Hash(member.type);
+			Nz::HashCombine(seed, member.name);
+			Nz::HashCombine(seed, member.relaxedPrecision);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Variable& variable) const
+		{
+			std::size_t seed = Hash(variable.type);
+			Nz::HashCombine(seed, variable.debugName);
+			Nz::HashCombine(seed, variable.funcId);
+			Nz::HashCombine(seed, variable.storageClass);
+			Combine(seed, variable.initializer);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Vector& vector) const
+		{
+			std::size_t seed = Hash(vector.componentType);
+			Nz::HashCombine(seed, vector.componentCount);
+
+			return seed;
+		}
+
+		std::size_t Hash(const Void& /*type*/) const
+		{
+			return 0;
+		}
+
+
+		std::size_t Hash(const Constant& constant) const
+		{
+			// Nested constants and types are shared between many others, only hash them once
+			if (!constant.hash)
+				constant.hash = Hash(constant.constant);
+
+			return *constant.hash;
+		}
+
+		std::size_t Hash(const Type& type) const
+		{
+			if (!type.hash)
+				type.hash = Hash(type.type);
+
+			return *type.hash;
+		}
+
+
+		std::size_t Hash(const std::variant<AnyConstant, AnyType>& v) const
+		{
+			// Registered constants and types are looked up with their own hash (without wrapping them into this variant first)
+			return std::visit([&](auto&& arg)
+			{
+				return Hash(arg);
+			}, v);
+		}
+
+		template<typename T>
+		std::size_t Hash(const std::shared_ptr<T>& ptr) const
+		{
+			if (!ptr)
+				return 0;
+
+			return Hash(*ptr);
+		}
+
+		template<typename... T>
+		std::size_t Hash(const std::variant<T...>& v) const
+		{
+			std::size_t seed = v.index();
+			std::visit([&](auto&& arg)
+			{
+				Nz::HashCombine(seed, Hash(arg));
+			}, v);
+
+			return seed;
+		}
+
+		template<typename T>
+		void Combine(std::size_t& seed, const std::optional<T>& opt) const
+		{
+			Nz::HashCombine(seed, (opt) ? Hash(*opt) : 0);
+		}
+
+		template<typename T>
+		void Combine(std::size_t& seed, const std::shared_ptr<T>& ptr) const
+		{
+			Nz::HashCombine(seed, Hash(ptr));
+		}
+
+		template<typename T>
+		void Combine(std::size_t& seed, const std::vector<T>& values) const
+		{
+			Nz::HashCombine(seed, values.size());
+			for (const T& value : values)
+				Nz::HashCombine(seed, Hash(value));
+		}
+
+		template<typename T>
+		std::size_t operator()(const T& value) const
+		{
+			return Hash(value);
 		}
 	};
 
@@ -425,11 +876,12 @@ namespace nzsl
 		{
 		}
 
-		tsl::ordered_map<std::variant<AnyConstant, AnyType>, std::uint32_t /*id*/, AnyHasher, Eq> ids;
-		tsl::ordered_map<Variable, std::uint32_t /*id*/, AnyHasher, Eq> variableIds;
+		tsl::ordered_map<std::variant<AnyConstant, AnyType>, std::uint32_t /*id*/, Hasher, Eq> ids;
+		tsl::ordered_map<Variable, std::uint32_t /*id*/, Hasher, Eq> variableIds;
+		CapabilityCallback capabilityCallback;
 		StructCallback structCallback;
+		std::shared_ptr<SpirvTypeCache> typeCache;
 		std::uint32_t& nextResultId;
-		bool isInBlockStruct = false;
 	};
 
 	SpirvConstantCache::SpirvConstantCache(std::uint32_t& resultId)
@@ -527,11 +979,11 @@ namespace nzsl
 
 	FieldOffsets SpirvConstantCache::BuildFieldOffsets(const Structure& structData) const
 	{
-		FieldOffsets structOffsets(StructLayout::Std140);
+		FieldOffsets structOffsets(structData.layout);
 
 		for (const Structure::Member& member : structData.members)
 		{
-			member.offset = Nz::SafeCast<std::uint32_t>(std::visit([&](auto&& arg) -> std::size_t
+			std::uint32_t offset = Nz::SafeCast<std::uint32_t>(std::visit([&](auto&& arg) -> std::size_t
 			{
 				using T = std::decay_t<decltype(arg)>;
 
@@ -552,17 +1004,8 @@ namespace nzsl
 				}
 				else if constexpr (std::is_same_v<T, Bool>)
 					return structOffsets.AddField(StructFieldType::Bool1);
-				else if constexpr (std::is_same_v<T, Float>)
-				{
-					switch (arg.width)
-					{
-						case 32: return structOffsets.AddField(StructFieldType::Float1);
-						case 64: return structOffsets.AddField(StructFieldType::Double1);
-						default: throw std::runtime_error("unexpected float width " + std::to_string(arg.width));
-					}
-				}
-				else if constexpr (std::is_same_v<T, Integer>)
-					return structOffsets.AddField((arg.signedness) ? StructFieldType::Int1 : StructFieldType::UInt1);
+				else if constexpr (std::is_same_v<T, Float> || std::is_same_v<T, Integer>)
+					return structOffsets.AddField(SpirvTypeToStructFieldType(arg));
 				else if constexpr (std::is_same_v<T, Matrix>)
 				{
 					assert(std::holds_alternative<Vector>(arg.columnType->type));
@@ -573,15 +1016,7 @@ namespace nzsl
 
 					Float& vecType = std::get<Float>(columnVec.componentType->type);
 
-					StructFieldType columnType;
-					switch (vecType.width)
-					{
-						case 32: columnType = StructFieldType::Float1;  break;
-						case 64: columnType = StructFieldType::Double1; break;
-						default: throw std::runtime_error("unexpected float width " + std::to_string(vecType.width));
-					}
-
-					return structOffsets.AddMatrix(columnType, arg.columnCount, columnVec.componentCount, true);
+					return structOffsets.AddMatrix(SpirvTypeToStructFieldType(vecType), arg.columnCount, columnVec.componentCount, true);
 				}
 				else if constexpr (std::is_same_v<T, Pointer>)
 					throw std::runtime_error("unhandled pointer in struct");
@@ -589,31 +1024,9 @@ namespace nzsl
 					return structOffsets.AddStruct(BuildFieldOffsets(arg));
 				else if constexpr (std::is_same_v<T, Vector>)
 				{
-					if (std::holds_alternative<Bool>(arg.componentType->type))
-						return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(StructFieldType::Bool1) + arg.componentCount - 1));
-					else if (std::holds_alternative<Float>(arg.componentType->type))
-					{
-						Float& floatData = std::get<Float>(arg.componentType->type);
-						switch (floatData.width)
-						{
-							case 32: return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(StructFieldType::Float1) + arg.componentCount - 1));
-							case 64: return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(StructFieldType::Double1) + arg.componentCount - 1));
-							default: throw std::runtime_error("unexpected float width " + std::to_string(floatData.width));
-						}
-					}
-					else if (std::holds_alternative<Integer>(arg.componentType->type))
-					{
-						Integer& intData = std::get<Integer>(arg.componentType->type);
-						if (intData.width != 32)
-							throw std::runtime_error("unexpected integer width " + std::to_string(intData.width));
-
-						if (intData.signedness)
-							return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(StructFieldType::Int1) + arg.componentCount - 1));
-						else
-							return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(StructFieldType::UInt1) + arg.componentCount - 1));
-					}
-					else
-						throw std::runtime_error("unexpected type for vector");
+					// Vector field types follow their component type (Float1, Float2, ...)
+					StructFieldType componentType = SpirvTypeToStructFieldType(arg.componentType->type);
+					return structOffsets.AddField(static_cast<StructFieldType>(Nz::UnderlyingCast(componentType) + arg.componentCount - 1));
 				}
 				else if constexpr (std::is_same_v<T, Function>)
 					throw std::runtime_error("unexpected function as struct member");
@@ -626,6 +1039,12 @@ namespace nzsl
 				else
 					static_assert(Nz::AlwaysFalse<T>::value, "non-exhaustive visitor");
 			}, member.type->type));
+
+			// Structs may be shared between threads (see SpirvTypeCache), don't write offsets which are already known
+			if (!member.offset)
+				member.offset = offset;
+			else
+				assert(*member.offset == offset);
 		}
 
 		return structOffsets;
@@ -647,48 +1066,48 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildPointerType(const Ast::ExpressionType& type, SpirvStorageClass storageClass) const -> TypePtr
 	{
-		bool wasInblockStruct = m_internal->isInBlockStruct;
-		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer)
-			m_internal->isInBlockStruct = true;
+		bool wasInblockStruct = s_isInBlockStruct;
+		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer || storageClass == SpirvStorageClass::PushConstant)
+			s_isInBlockStruct = true;
 
 		auto typePtr = std::make_shared<Type>(Pointer{
 			BuildType(type),
 			storageClass
 		});
 
-		m_internal->isInBlockStruct = wasInblockStruct;
+		s_isInBlockStruct = wasInblockStruct;
 
 		return typePtr;
 	}
 
 	auto SpirvConstantCache::BuildPointerType(const TypePtr& type, SpirvStorageClass storageClass) const -> TypePtr
 	{
-		bool wasInblockStruct = m_internal->isInBlockStruct;
-		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer)
-			m_internal->isInBlockStruct = true;
+		bool wasInblockStruct = s_isInBlockStruct;
+		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer || storageClass == SpirvStorageClass::PushConstant)
+			s_isInBlockStruct = true;
 
 		auto typePtr = std::make_shared<Type>(Pointer{
 			type,
 			storageClass
 		});
 
-		m_internal->isInBlockStruct = wasInblockStruct;
+		s_isInBlockStruct = wasInblockStruct;
 
 		return typePtr;
 	}
 
 	auto SpirvConstantCache::BuildPointerType(const Ast::PrimitiveType& type, SpirvStorageClass storageClass) const -> TypePtr
 	{
-		bool wasInblockStruct = m_internal->isInBlockStruct;
-		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer)
-			m_internal->isInBlockStruct = true;
+		bool wasInblockStruct = s_isInBlockStruct;
+		if (storageClass == SpirvStorageClass::Uniform || storageClass == SpirvStorageClass::StorageBuffer || storageClass == SpirvStorageClass::PushConstant)
+			s_isInBlockStruct = true;
 
 		auto typePtr = std::make_shared<Type>(Pointer{
 			BuildType(type),
 			storageClass
 			});
 
-		m_internal->isInBlockStruct = wasInblockStruct;
+		s_isInBlockStruct = wasInblockStruct;
 
 		return typePtr;
 	}
@@ -707,9 +1126,9 @@ namespace nzsl
 
 		// ArrayStride
 		std::optional<std::uint32_t> arrayStride;
-		if (m_internal->isInBlockStruct)
+		if (s_isInBlockStruct)
 		{
-			FieldOffsets fieldOffset(StructLayout::Std140);
+			FieldOffsets fieldOffset(s_blockLayout);
 			RegisterArrayField(fieldOffset, builtContainedType->type, 1);
 
 			arrayStride = Nz::SafeCast<std::uint32_t>(fieldOffset.GetAlignedSize());
@@ -732,9 +1151,9 @@ namespace nzsl
 
 		// ArrayStride
 		std::optional<std::uint32_t> arrayStride;
-		if (m_internal->isInBlockStruct)
+		if (s_isInBlockStruct)
 		{
-			FieldOffsets fieldOffset(StructLayout::Std140);
+			FieldOffsets fieldOffset(s_blockLayout);
 			RegisterArrayField(fieldOffset, builtContainedType->type, 1);
 
 			arrayStride = Nz::SafeCast<std::uint32_t>(fieldOffset.GetAlignedSize());
@@ -764,12 +1183,21 @@ namespace nzsl
 				case Ast::PrimitiveType::Boolean:
 					return Bool{};
 
+				case Ast::PrimitiveType::Float16:
+					return Float{ 16 };
+
 				case Ast::PrimitiveType::Float32:
 					return Float{ 32 };
 
+				case Ast::PrimitiveType::Int16:
+					return Integer{ 16, true };
+
 				case Ast::PrimitiveType::Int32:
 					return Integer{ 32, true };
 
+				case Ast::PrimitiveType::UInt16:
+					return Integer{ 16, false };
+
 				case Ast::PrimitiveType::UInt32:
 					return Integer{ 32, false };
 
@@ -797,6 +1225,11 @@ namespace nzsl
 		return std::make_shared<Type>(Void{});
 	}
 
+	auto SpirvConstantCache::BuildType(const Ast::PushConstantType& type) const -> TypePtr
+	{
+		return BuildType(type.containedType);
+	}
+
 	auto SpirvConstantCache::BuildType(const Ast::SamplerType& type) const -> TypePtr
 	{
 		Image imageType;
@@ -825,6 +1258,56 @@ namespace nzsl
 		return std::make_shared<Type>(SampledImage{ std::make_shared<Type>(imageType) });
 	}
 
+	auto SpirvConstantCache::BuildType(const Ast::StorageImageType& type) const -> TypePtr
+	{
+		Image imageType;
+		imageType.sampled = false;
+		imageType.sampledType = BuildType(type.sampledType);
+
+		imageType.dim = [&]
+		{
+			switch (type.dim)
+			{
+				case ImageType::Cubemap: return SpirvDim::Cube;
+				case ImageType::E1D_Array:
+					imageType.arrayed = true;
+					[[fallthrough]];
+				case ImageType::E1D: return SpirvDim::Dim1D;
+				case ImageType::E2D_Array:
+					imageType.arrayed = true;
+					[[fallthrough]];
+				case ImageType::E2D: return SpirvDim::Dim2D;
+				case ImageType::E3D: return SpirvDim::Dim3D;
+			}
+
+			throw std::runtime_error("unhandled image dimension");
+		}();
+
+		imageType.format = [&]
+		{
+			switch (type.format)
+			{
+				case ImageFormat::R8:       return SpirvImageFormat::R8;
+				case ImageFormat::R16f:     return SpirvImageFormat::R16f;
+				case ImageFormat::R32f:     return SpirvImageFormat::R32f;
+				case ImageFormat::R32i:     return SpirvImageFormat::R32i;
+				case ImageFormat::R32ui:    return SpirvImageFormat::R32ui;
+				case ImageFormat::Rg8:      return SpirvImageFormat::Rg8;
+				case ImageFormat::Rg16f:    return SpirvImageFormat::Rg16f;
+				case ImageFormat::Rg32f:    return SpirvImageFormat::Rg32f;
+				case ImageFormat::Rgba8:    return SpirvImageFormat::Rgba8;
+				case ImageFormat::Rgba16f:  return SpirvImageFormat::Rgba16f;
+				case ImageFormat::Rgba32f:  return SpirvImageFormat::Rgba32f;
+				case ImageFormat::Rgba32i:  return SpirvImageFormat::Rgba32i;
+				case ImageFormat::Rgba32ui: return SpirvImageFormat::Rgba32ui;
+			}
+
+			throw std::runtime_error("unhandled image format");
+		}();
+
+		return std::make_shared<Type>(imageType);
+	}
+
 	auto SpirvConstantCache::BuildType(const Ast::StorageType& type) const -> TypePtr
 	{
 		return BuildType(type.containedType);
@@ -838,14 +1321,30 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildType(const Ast::StructDescription& structDesc, std::vector<SpirvDecoration> decorations) const -> TypePtr
 	{
+		std::string typeKey;
+		if (m_internal->typeCache)
+		{
+			if (AppendStructKey(typeKey, m_internal->structCallback, structDesc, decorations, s_isInBlockStruct))
+			{
+				if (TypePtr cachedType = m_internal->typeCache->FindStruct(typeKey))
+					return cachedType;
+			}
+			else
+				typeKey.clear();
+		}
+
 		Structure sType;
 		sType.name = structDesc.name;
 		sType.decorations = std::move(decorations);
+		sType.layout = GetStructLayout(structDesc);
 
-		bool wasInBlock = m_internal->isInBlockStruct;
+		StructLayout previousLayout = s_blockLayout;
+		s_blockLayout = sType.layout;
+
+		bool wasInBlock = s_isInBlockStruct;
 		if (!wasInBlock)
 		{
-			m_internal->isInBlockStruct = std::find(sType.decorations.begin(), sType.decorations.end(), SpirvDecoration::Block) != sType.decorations.end()
+			s_isInBlockStruct = std::find(sType.decorations.begin(), sType.decorations.end(), SpirvDecoration::Block) != sType.decorations.end()
 			                           || std::find(sType.decorations.begin(), sType.decorations.end(), SpirvDecoration::BufferBlock) != sType.decorations.end();
 		}
 
@@ -857,11 +1356,23 @@ namespace nzsl
 			auto& sMembers = sType.members.emplace_back();
 			sMembers.name = member.name;
 			sMembers.type = BuildType(member.type.GetResultingValue());
+			sMembers.relaxedPrecision = member.precision.IsResultingValue() && member.precision.GetResultingValue() == Ast::Precision::Medium;
 		}
 
-		m_internal->isInBlockStruct = wasInBlock;
+		s_isInBlockStruct = wasInBlock;
+		s_blockLayout = previousLayout;
+
+		TypePtr typePtr = std::make_shared<Type>(std::move(sType));
+		if (!typeKey.empty())
+		{
+			// Compute the layout and the hash before sharing the type, they won't be modified afterwards
+			BuildFieldOffsets(std::get<Structure>(typePtr->type));
+			Hasher{}(*typePtr);
+
+			return m_internal->typeCache->RegisterStruct(std::move(typeKey), std::move(typePtr));
+		}
 
-		return std::make_shared<Type>(std::move(sType));
+		return typePtr;
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::VectorType& type) const -> TypePtr
@@ -874,6 +1385,24 @@ namespace nzsl
 		return BuildType(type.containedType);
 	}
 
+	std::optional<std::uint32_t> SpirvConstantCache::FindId(const Constant& c) const
+	{
+		auto it = m_internal->ids.find(c.constant);
+		if (it == m_internal->ids.end())
+			return std::nullopt;
+
+		return it->second;
+	}
+
+	std::optional<std::uint32_t> SpirvConstantCache::FindId(const Type& t) const
+	{
+		auto it = m_internal->ids.find(t.type);
+		if (it == m_internal->ids.end())
+			return std::nullopt;
+
+		return it->second;
+	}
+
 	std::uint32_t SpirvConstantCache::GetId(const Constant& c)
 	{
 		auto it = m_internal->ids.find(c.constant);
@@ -1022,7 +1551,7 @@ namespace nzsl
 	std::size_t SpirvConstantCache::RegisterArrayField(FieldOffsets& fieldOffsets, const Vector& type, std::size_t arrayLength) const
 	{
 		assert(type.componentCount > 0 && type.componentCount <= 4);
-		return fieldOffsets.AddFieldArray(static_cast<StructFieldType>(Nz::UnderlyingCast(SpirvTypeToStructFieldType(type.componentType->type)) + type.componentCount), arrayLength);
+		return fieldOffsets.AddFieldArray(static_cast<StructFieldType>(Nz::UnderlyingCast(SpirvTypeToStructFieldType(type.componentType->type)) + type.componentCount - 1), arrayLength);
 	}
 
 	std::size_t SpirvConstantCache::RegisterArrayField(FieldOffsets& /*fieldOffsets*/, const Void& /*type*/, std::size_t /*arrayLength*/) const
@@ -1030,12 +1559,22 @@ namespace nzsl
 		throw std::runtime_error("unexpected Void");
 	}
 
+	void SpirvConstantCache::SetCapabilityCallback(CapabilityCallback callback)
+	{
+		m_internal->capabilityCallback = std::move(callback);
+	}
+
 	void SpirvConstantCache::SetStructCallback(StructCallback callback)
 	{
 		m_internal->structCallback = std::move(callback);
 	}
 
-	void SpirvConstantCache::Write(SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos)
+	void SpirvConstantCache::SetTypeCache(std::shared_ptr<SpirvTypeCache> typeCache)
+	{
+		m_internal->typeCache = std::move(typeCache);
+	}
+
+	void SpirvConstantCache::Write(SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos)
 	{
 		for (auto&& [object, id] : m_internal->ids)
 		{
@@ -1053,8 +1592,8 @@ namespace nzsl
 			const auto& var = variable;
 			std::uint32_t resultId = id;
 
-			if (!variable.debugName.empty())
-				debugInfos.Append(SpirvOp::OpName, resultId, variable.debugName);
+			if (debugInfos && !variable.debugName.empty())
+				debugInfos->Append(SpirvOp::OpName, resultId, variable.debugName);
 
 			constants.AppendVariadic(SpirvOp::OpVariable, [&](const auto& appender)
 			{
@@ -1120,7 +1659,7 @@ namespace nzsl
 		}, constant);
 	}
 
-	void SpirvConstantCache::Write(const AnyType& type, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos)
+	void SpirvConstantCache::Write(const AnyType& type, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos)
 	{
 		std::visit([&](auto&& arg)
 		{
@@ -1201,7 +1740,7 @@ namespace nzsl
 		}, type);
 	}
 
-	void SpirvConstantCache::WriteStruct(const Structure& structData, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos)
+	void SpirvConstantCache::WriteStruct(const Structure& structData, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection* debugInfos)
 	{
 		constants.AppendVariadic(SpirvOp::OpTypeStruct, [&](const auto& appender)
 		{
@@ -1211,7 +1750,8 @@ namespace nzsl
 				appender(GetId(*member.type));
 		});
 
-		debugInfos.Append(SpirvOp::OpName, resultId, structData.name);
+		if (debugInfos)
+			debugInfos->Append(SpirvOp::OpName, resultId, structData.name);
 
 		for (SpirvDecoration decoration : structData.decorations)
 			annotations.Append(SpirvOp::OpDecorate, resultId, decoration);
@@ -1219,7 +1759,8 @@ namespace nzsl
 		for (std::size_t memberIndex = 0; memberIndex < structData.members.size(); ++memberIndex)
 		{
 			const auto& member = structData.members[memberIndex];
-			debugInfos.Append(SpirvOp::OpMemberName, resultId, memberIndex, member.name);
+			if (debugInfos)
+				debugInfos->Append(SpirvOp::OpMemberName, resultId, memberIndex, member.name);
 
 			std::uint32_t offset = member.offset.value();
 
@@ -1229,12 +1770,19 @@ namespace nzsl
 
 				if constexpr (std::is_same_v<T, Matrix>)
 				{
+					// Matrix columns are laid out like an array of column vectors
+					FieldOffsets columnOffsets(structData.layout);
+					RegisterArrayField(columnOffsets, *arg.columnType, 1);
+
 					annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::ColMajor);
-					annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::MatrixStride, 16);
+					annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::MatrixStride, Nz::SafeCast<std::uint32_t>(columnOffsets.GetAlignedSize()));
 				}
 			}, member.type->type);
 
 			annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::Offset, offset);
+
+			if (member.relaxedPrecision)
+				annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::RelaxedPrecision);
 		}
 	}
 }
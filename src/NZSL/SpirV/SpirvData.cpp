@@ -9885,6 +9885,21 @@ namespace nzsl
 
 	const SpirvInstruction* GetSpirvInstruction(std::uint16_t op)
 	{
+		static const std::array<const SpirvInstruction*, 404> s_instructionLookup = []
+		{
+			std::array<const SpirvInstruction*, 404> lookup = {};
+			for (const SpirvInstruction& inst : s_instructions)
+			{
+				if (std::uint16_t(inst.op) < lookup.size())
+					lookup[std::uint16_t(inst.op)] = &inst;
+			}
+
+			return lookup;
+		}();
+
+		if (op < s_instructionLookup.size())
+			return s_instructionLookup[op];
+
 		auto it = std::lower_bound(std::begin(s_instructions), std::end(s_instructions), op, [](const SpirvInstruction& inst, std::uint16_t op) { return std::uint16_t(inst.op) < op; });
 		if (it != std::end(s_instructions) && std::uint16_t(it->op) == op)
 			return &*it;
@@ -9894,6 +9909,21 @@ namespace nzsl
 
 	const SpirvGlslStd450Instruction* GetSpirvGlslStd450Instruction(std::uint16_t op)
 	{
+		static const std::array<const SpirvGlslStd450Instruction*, 82> s_instructionLookup = []
+		{
+			std::array<const SpirvGlslStd450Instruction*, 82> lookup = {};
+			for (const SpirvGlslStd450Instruction& inst : s_instructionsGlslStd450)
+			{
+				if (std::uint16_t(inst.op) < lookup.size())
+					lookup[std::uint16_t(inst.op)] = &inst;
+			}
+
+			return lookup;
+		}();
+
+		if (op < s_instructionLookup.size())
+			return s_instructionLookup[op];
+
 		auto it = std::lower_bound(std::begin(s_instructionsGlslStd450), std::end(s_instructionsGlslStd450), op, [](const SpirvGlslStd450Instruction& inst, std::uint16_t op) { return std::uint16_t(inst.op) < op; });
 		if (it != std::end(s_instructionsGlslStd450) && std::uint16_t(it->op) == op)
 			return &*it;
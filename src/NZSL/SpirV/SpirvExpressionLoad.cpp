@@ -58,6 +58,12 @@ namespace nzsl
 				std::uint32_t resultId = m_visitor.AllocateResultId();
 				m_block.Append(SpirvOp::OpLoad, m_writer.GetTypeId(*pointerChainAccess.exprType), resultId, pointerId);
 
+				if (pointerChainAccess.isNonUniform)
+				{
+					m_visitor.DecorateNonUniform(pointerId);
+					m_visitor.DecorateNonUniform(resultId);
+				}
+
 				return resultId;
 			},
 			[](const Value& value) -> std::uint32_t
@@ -71,6 +77,52 @@ namespace nzsl
 		}, m_value);
 	}
 
+	std::uint32_t SpirvExpressionLoad::EvaluatePointer(Ast::Expression& node)
+	{
+		node.Visit(*this);
+
+		return std::visit(Nz::Overloaded
+		{
+			[](const CompositeExtraction& /*extractedValue*/) -> std::uint32_t
+			{
+				throw std::runtime_error("expected a pointer, got a composite extraction");
+			},
+			[](const Pointer& pointer) -> std::uint32_t
+			{
+				return pointer.pointerId;
+			},
+			[this](const PointerChainAccess& pointerChainAccess) -> std::uint32_t
+			{
+				std::uint32_t pointerType = m_writer.RegisterPointerType(*pointerChainAccess.exprType, pointerChainAccess.storage); //< FIXME: We shouldn't register this so late
+
+				std::uint32_t pointerId = m_visitor.AllocateResultId();
+
+				m_block.AppendVariadic(SpirvOp::OpAccessChain, [&](const auto& appender)
+				{
+					appender(pointerType);
+					appender(pointerId);
+					appender(pointerChainAccess.pointerId);
+
+					for (std::uint32_t id : pointerChainAccess.indicesId)
+						appender(id);
+				});
+
+				if (pointerChainAccess.isNonUniform)
+					m_visitor.DecorateNonUniform(pointerId);
+
+				return pointerId;
+			},
+			[](const Value& /*value*/) -> std::uint32_t
+			{
+				throw std::runtime_error("expected a pointer, got a value");
+			},
+			[](std::monostate) -> std::uint32_t
+			{
+				throw std::runtime_error("an internal error occurred");
+			}
+		}, m_value);
+	}
+
 	void SpirvExpressionLoad::Visit(Ast::AccessIndexExpression& node)
 	{
 		node.expr->Visit(*this);
@@ -150,6 +202,9 @@ namespace nzsl
 		{
 			std::uint32_t indexId = m_visitor.EvaluateExpression(*indexExpr);
 
+			// The access chain (and the loaded value) of a non-uniform index must be decorated as well
+			bool isNonUniform = indexExpr->GetType() == Ast::NodeType::IntrinsicExpression && static_cast<Ast::IntrinsicExpression&>(*indexExpr).intrinsic == Ast::IntrinsicType::NonUniform;
+
 			std::visit(Nz::Overloaded
 			{
 				[&](CompositeExtraction& /*extractedValue*/)
@@ -164,6 +219,7 @@ namespace nzsl
 					pointerChainAccess.pointedTypeId = pointer.pointedTypeId;
 					pointerChainAccess.pointerId = pointer.pointerId;
 					pointerChainAccess.storage = pointer.storage;
+					pointerChainAccess.isNonUniform = isNonUniform;
 
 					m_value = std::move(pointerChainAccess);
 				},
@@ -171,6 +227,7 @@ namespace nzsl
 				{
 					pointerChainAccess.exprType = exprType;
 					pointerChainAccess.indicesId.push_back(indexId);
+					pointerChainAccess.isNonUniform |= isNonUniform;
 				},
 				[&](const Value& /*value*/)
 				{
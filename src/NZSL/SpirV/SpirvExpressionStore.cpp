@@ -98,11 +98,16 @@ namespace nzsl
 				std::uint32_t pointerType = m_writer.RegisterPointerType(*exprType, pointer.storage); //< FIXME
 
 				assert(node.indices.size() == 1);
-				std::uint32_t indexId = m_visitor.EvaluateExpression(*node.indices.front());
+				auto& indexExpr = node.indices.front();
+				std::uint32_t indexId = m_visitor.EvaluateExpression(*indexExpr);
 
 				m_block.Append(SpirvOp::OpAccessChain, pointerType, resultId, pointer.pointerId, indexId); 
 
-				m_value = Pointer { pointer.storage, resultId };
+				bool isNonUniform = pointer.isNonUniform || (indexExpr->GetType() == Ast::NodeType::IntrinsicExpression && static_cast<Ast::IntrinsicExpression&>(*indexExpr).intrinsic == Ast::IntrinsicType::NonUniform);
+				if (isNonUniform)
+					m_visitor.DecorateNonUniform(resultId);
+
+				m_value = Pointer { pointer.storage, resultId, isNonUniform };
 			},
 			[](std::monostate)
 			{
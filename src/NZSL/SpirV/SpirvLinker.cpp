@@ -0,0 +1,546 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvLinker.hpp>
+#include <Nazara/Utils/Algorithm.hpp>
+#include <Nazara/Utils/CallOnExit.hpp>
+#include <NZSL/SpirV/SpirvData.hpp>
+#include <NZSL/SpirV/SpirvUtils.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nzsl
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Types and constants which are structurally identical (including their decorations and names) are merged
+		bool IsDeduplicable(const SpirvInstruction& instruction)
+		{
+			if (instruction.op == SpirvOp::OpUndef)
+				return true;
+
+			if (instruction.op == SpirvOp::OpTypeForwardPointer)
+				return false;
+
+			std::string_view name = instruction.name;
+			return name.substr(0, 6) == "OpType" || name.substr(0, 10) == "OpConstant";
+		}
+
+		struct WordsHasher
+		{
+			std::size_t operator()(const std::vector<std::uint32_t>& words) const
+			{
+				std::size_t seed = words.size();
+				for (std::uint32_t word : words)
+					Nz::HashCombine(seed, word);
+
+				return seed;
+			}
+		};
+	}
+
+	struct SpirvLinker::Instruction
+	{
+		const SpirvInstruction* data;
+		const std::uint32_t* words; //< including the opcode
+		std::uint32_t wordCount;
+		SpirvLogicalSection section;
+	};
+
+	struct SpirvLinker::Module
+	{
+		struct Function
+		{
+			std::size_t firstInstruction;
+			std::size_t lastInstruction;
+			std::uint32_t id;
+			std::vector<std::uint32_t> callees;
+			bool hasBody = false;
+			bool isUsed = false;
+		};
+
+		std::unordered_map<std::uint32_t, std::string> imports; //< function id => linkage name
+		std::unordered_map<std::uint32_t, std::size_t> functionIndices;
+		std::unordered_map<std::uint32_t, std::vector<std::size_t>> decorations; //< target id => instruction indices
+		std::unordered_map<std::uint32_t, std::vector<std::size_t>> names; //< target id => instruction indices
+		std::unordered_set<std::uint32_t> removedIds; //< their debug names and decorations are removed as well
+		std::vector<Function> functions;
+		std::vector<Instruction> instructions;
+		std::vector<std::uint32_t> entryPoints;
+		std::vector<std::uint32_t> idRemapping; //< module id => output id (0 if not assigned yet)
+		SpirvHeader header;
+	};
+
+	struct SpirvLinker::State
+	{
+		struct Export
+		{
+			std::size_t moduleIndex;
+			std::uint32_t functionId;
+		};
+
+		std::unordered_map<std::string, Export> exports;
+		std::unordered_map<std::vector<std::uint32_t>, std::uint32_t, WordsHasher> globalIds;
+		std::unordered_map<std::string, std::uint32_t> extInstImports;
+		std::vector<Module> modules;
+		std::vector<std::vector<std::uint32_t>> preambleInstructions; //< capabilities, extensions and memory model, deduplicated
+		std::vector<std::uint32_t> capabilities;
+		std::vector<std::uint32_t> extensions;
+		std::vector<std::uint32_t> extInstructions;
+		std::vector<std::uint32_t> memoryModel;
+		std::vector<std::uint32_t> entryPoints;
+		std::vector<std::uint32_t> executionModes;
+		std::vector<std::uint32_t> debugSources;
+		std::vector<std::uint32_t> debugNames;
+		std::vector<std::uint32_t> debugModuleProcessed;
+		std::vector<std::uint32_t> annotations;
+		std::vector<std::uint32_t> globals;
+		std::vector<std::uint32_t> functions;
+		std::uint32_t nextResultId = 1;
+		bool isInsideFunction = false;
+	};
+
+	std::vector<std::uint32_t> SpirvLinker::Link(const std::vector<std::uint32_t>* const* modules, std::size_t moduleCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State state;
+
+		m_currentState = &state;
+		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
+
+		state.modules.reserve(moduleCount);
+		for (std::size_t i = 0; i < moduleCount; ++i)
+		{
+			state.modules.emplace_back();
+			Decode(modules[i]->data(), modules[i]->size());
+
+			Module& module = state.modules.back();
+			for (auto&& [functionId, linkageName] : module.imports)
+			{
+				auto it = module.functionIndices.find(functionId);
+				if (it == module.functionIndices.end())
+					throw std::runtime_error(fmt::format("module #{} imports \"{}\" using an unknown function", i, linkageName));
+			}
+		}
+
+		auto ResolveFunction = [&](std::size_t moduleIndex, std::uint32_t functionId) -> State::Export
+		{
+			const Module& module = state.modules[moduleIndex];
+			if (auto it = module.imports.find(functionId); it != module.imports.end())
+			{
+				auto exportIt = state.exports.find(it->second);
+				if (exportIt == state.exports.end())
+					throw std::runtime_error(fmt::format("unresolved import \"{}\"", it->second));
+
+				return exportIt->second;
+			}
+
+			return State::Export{ moduleIndex, functionId };
+		};
+
+		// Only keep functions used by entry points (or every function when linking modules without entry points)
+		bool hasEntryPoints = std::any_of(state.modules.begin(), state.modules.end(), [](const Module& module) { return !module.entryPoints.empty(); });
+
+		std::vector<State::Export> functionsToVisit;
+		for (std::size_t moduleIndex = 0; moduleIndex < state.modules.size(); ++moduleIndex)
+		{
+			Module& module = state.modules[moduleIndex];
+			if (hasEntryPoints)
+			{
+				for (std::uint32_t functionId : module.entryPoints)
+					functionsToVisit.push_back({ moduleIndex, functionId });
+			}
+			else
+			{
+				for (const Module::Function& function : module.functions)
+					functionsToVisit.push_back({ moduleIndex, function.id });
+			}
+		}
+
+		while (!functionsToVisit.empty())
+		{
+			State::Export functionRef = functionsToVisit.back();
+			functionsToVisit.pop_back();
+
+			functionRef = ResolveFunction(functionRef.moduleIndex, functionRef.functionId);
+
+			Module& module = state.modules[functionRef.moduleIndex];
+			Module::Function& function = module.functions[Nz::Retrieve(module.functionIndices, functionRef.functionId)];
+			if (function.isUsed)
+				continue;
+
+			if (!function.hasBody)
+				throw std::runtime_error("function has no body and isn't imported");
+
+			function.isUsed = true;
+			for (std::uint32_t calleeId : function.callees)
+				functionsToVisit.push_back({ functionRef.moduleIndex, calleeId });
+		}
+
+		// Assign function ids first, as imported functions may be defined by a later module
+		for (Module& module : state.modules)
+		{
+			for (const Module::Function& function : module.functions)
+			{
+				if (function.isUsed)
+				{
+					module.idRemapping[function.id] = state.nextResultId++;
+					continue;
+				}
+
+				for (std::size_t i = function.firstInstruction; i <= function.lastInstruction; ++i)
+				{
+					const Instruction& instruction = module.instructions[i];
+					if (std::uint32_t resultId = GetResultId(*instruction.data, instruction.words + 1, instruction.wordCount - 1))
+						module.removedIds.insert(resultId);
+				}
+			}
+		}
+
+		for (std::size_t moduleIndex = 0; moduleIndex < state.modules.size(); ++moduleIndex)
+		{
+			Module& module = state.modules[moduleIndex];
+			for (auto&& [functionId, linkageName] : module.imports)
+			{
+				auto exportIt = state.exports.find(linkageName);
+				if (exportIt == state.exports.end())
+					continue; //< unused (or an error would have been triggered)
+
+				const Module& exportModule = state.modules[exportIt->second.moduleIndex];
+				module.idRemapping[functionId] = exportModule.idRemapping[exportIt->second.functionId];
+			}
+		}
+
+		auto Remap = [&](Module& module, std::uint32_t id) -> std::uint32_t
+		{
+			if (id >= module.idRemapping.size())
+				throw std::runtime_error(fmt::format("id {} is out of bounds", id));
+
+			std::uint32_t& newId = module.idRemapping[id];
+			if (newId == 0)
+				newId = state.nextResultId++;
+
+			return newId;
+		};
+
+		auto AppendRemapped = [&](Module& module, const Instruction& instruction, std::vector<std::uint32_t>& output)
+		{
+			std::size_t offset = output.size();
+			output.insert(output.end(), instruction.words, instruction.words + instruction.wordCount);
+
+			ForEachIdOperand(*instruction.data, &output[offset + 1], instruction.wordCount - 1, [&](std::uint32_t& id)
+			{
+				id = Remap(module, id);
+			});
+		};
+
+		auto AppendUnique = [&](const Instruction& instruction, std::vector<std::uint32_t>& output)
+		{
+			std::vector<std::uint32_t> words(instruction.words, instruction.words + instruction.wordCount);
+			if (std::find(state.preambleInstructions.begin(), state.preambleInstructions.end(), words) != state.preambleInstructions.end())
+				return;
+
+			output.insert(output.end(), words.begin(), words.end());
+			state.preambleInstructions.push_back(std::move(words));
+		};
+
+		std::uint32_t versionNumber = 0;
+		for (Module& module : state.modules)
+		{
+			versionNumber = std::max(versionNumber, module.header.versionNumber);
+
+			for (const Instruction& instruction : module.instructions)
+			{
+				switch (instruction.section)
+				{
+					case SpirvLogicalSection::Capability:
+					{
+						if (static_cast<SpirvCapability>(instruction.words[1]) != SpirvCapability::Linkage)
+							AppendUnique(instruction, state.capabilities);
+
+						break;
+					}
+
+					case SpirvLogicalSection::Extension:
+						AppendUnique(instruction, state.extensions);
+						break;
+
+					case SpirvLogicalSection::ExtInstImport:
+					{
+						std::string name;
+						for (std::uint32_t i = 2; i < instruction.wordCount; ++i)
+						{
+							std::uint32_t word = instruction.words[i];
+							for (std::size_t j = 0; j < 4; ++j)
+							{
+								char c = static_cast<char>((word >> (j * 8)) & 0xFF);
+								if (c == '\0')
+									break;
+
+								name.push_back(c);
+							}
+						}
+
+						auto it = state.extInstImports.find(name);
+						if (it == state.extInstImports.end())
+						{
+							AppendRemapped(module, instruction, state.extInstructions);
+							state.extInstImports.emplace(std::move(name), Remap(module, instruction.words[1]));
+						}
+						else
+							module.idRemapping[instruction.words[1]] = it->second;
+
+						break;
+					}
+
+					case SpirvLogicalSection::MemoryModel:
+					{
+						if (state.memoryModel.empty())
+							state.memoryModel.assign(instruction.words, instruction.words + instruction.wordCount);
+
+						break;
+					}
+
+					default:
+						break;
+				}
+			}
+
+			// Types, constants and global variables
+			for (const Instruction& instruction : module.instructions)
+			{
+				if (instruction.section != SpirvLogicalSection::Global)
+					continue;
+
+				std::uint32_t resultId = GetResultId(*instruction.data, instruction.words + 1, instruction.wordCount - 1);
+				if (resultId != 0 && resultId < module.idRemapping.size() && module.idRemapping[resultId] == 0 && IsDeduplicable(*instruction.data))
+				{
+					std::vector<std::uint32_t> key(instruction.words, instruction.words + instruction.wordCount);
+					ForEachIdOperand(*instruction.data, &key[1], key.size() - 1, [&](std::uint32_t& id)
+					{
+						id = (id != resultId) ? Remap(module, id) : 0;
+					});
+
+					// Decorations and names are part of the type identity (target id is skipped)
+					for (const auto* targetInstructions : { &module.decorations, &module.names })
+					{
+						if (auto it = targetInstructions->find(resultId); it != targetInstructions->end())
+						{
+							for (std::size_t instructionIndex : it->second)
+							{
+								const Instruction& targetInstruction = module.instructions[instructionIndex];
+								key.push_back(targetInstruction.words[0]);
+								key.insert(key.end(), targetInstruction.words + 2, targetInstruction.words + targetInstruction.wordCount);
+							}
+						}
+					}
+
+					auto it = state.globalIds.find(key);
+					if (it != state.globalIds.end())
+					{
+						module.idRemapping[resultId] = it->second;
+						module.removedIds.insert(resultId);
+						continue;
+					}
+
+					state.globalIds.emplace(std::move(key), Remap(module, resultId));
+				}
+
+				AppendRemapped(module, instruction, state.globals);
+			}
+
+			for (const Instruction& instruction : module.instructions)
+			{
+				switch (instruction.section)
+				{
+					case SpirvLogicalSection::Annotation:
+					{
+						if (module.removedIds.count(instruction.words[1]))
+							break;
+
+						if (instruction.data->op == SpirvOp::OpDecorate && static_cast<SpirvDecoration>(instruction.words[2]) == SpirvDecoration::LinkageAttributes)
+							break;
+
+						AppendRemapped(module, instruction, state.annotations);
+						break;
+					}
+
+					case SpirvLogicalSection::DebugName:
+					{
+						if (module.removedIds.count(instruction.words[1]))
+							break;
+
+						AppendRemapped(module, instruction, state.debugNames);
+						break;
+					}
+
+					case SpirvLogicalSection::DebugSource:
+						AppendRemapped(module, instruction, state.debugSources);
+						break;
+
+					case SpirvLogicalSection::DebugModuleProcessed:
+						AppendRemapped(module, instruction, state.debugModuleProcessed);
+						break;
+
+					case SpirvLogicalSection::EntryPoint:
+						AppendRemapped(module, instruction, state.entryPoints);
+						break;
+
+					case SpirvLogicalSection::ExecutionMode:
+						AppendRemapped(module, instruction, state.executionModes);
+						break;
+
+					default:
+						break;
+				}
+			}
+
+			for (const Module::Function& function : module.functions)
+			{
+				if (!function.isUsed)
+					continue;
+
+				for (std::size_t i = function.firstInstruction; i <= function.lastInstruction; ++i)
+					AppendRemapped(module, module.instructions[i], state.functions);
+			}
+		}
+
+		std::vector<std::uint32_t> output;
+		output.push_back(SpirvMagicNumber);
+		output.push_back(versionNumber);
+		output.push_back((!state.modules.empty()) ? state.modules.front().header.generatorId : 0);
+		output.push_back(state.nextResultId); //< bound
+		output.push_back(0); //< schema
+
+		for (const auto* section : { &state.capabilities, &state.extensions, &state.extInstructions, &state.memoryModel, &state.entryPoints, &state.executionModes, &state.debugSources, &state.debugNames, &state.debugModuleProcessed, &state.annotations, &state.globals, &state.functions })
+			output.insert(output.end(), section->begin(), section->end());
+
+		return output;
+	}
+
+	bool SpirvLinker::HandleHeader(const SpirvHeader& header)
+	{
+		Module& module = m_currentState->modules.back();
+		module.header = header;
+		module.idRemapping.resize(header.bound, 0);
+
+		m_currentState->isInsideFunction = false;
+
+		return true;
+	}
+
+	bool SpirvLinker::HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount)
+	{
+		if (wordCount == 0)
+			throw std::runtime_error("invalid instruction word count");
+
+		State& state = *m_currentState;
+		Module& module = state.modules.back();
+
+		std::size_t instructionIndex = module.instructions.size();
+
+		Instruction& inst = module.instructions.emplace_back();
+		inst.data = &instruction;
+		inst.words = GetCurrentPtr() - 1;
+		inst.wordCount = wordCount;
+		inst.section = (state.isInsideFunction || instruction.op == SpirvOp::OpFunction) ? SpirvLogicalSection::Function : GetLogicalSection(instruction.op);
+
+		auto GetWord = [&](std::size_t index)
+		{
+			if (index >= wordCount)
+				throw std::runtime_error(fmt::format("{} has too few operands", instruction.name));
+
+			return inst.words[index];
+		};
+
+		auto GetCurrentFunction = [&]() -> Module::Function&
+		{
+			if (!state.isInsideFunction || module.functions.empty())
+				throw std::runtime_error(fmt::format("unexpected {} outside of a function", instruction.name));
+
+			return module.functions.back();
+		};
+
+		switch (instruction.op)
+		{
+			case SpirvOp::OpFunction:
+			{
+				if (state.isInsideFunction)
+					throw std::runtime_error("unexpected OpFunction inside of a function");
+
+				Module::Function& function = module.functions.emplace_back();
+				function.firstInstruction = instructionIndex;
+				function.id = GetWord(2);
+
+				module.functionIndices[function.id] = module.functions.size() - 1;
+				state.isInsideFunction = true;
+				break;
+			}
+
+			case SpirvOp::OpFunctionEnd:
+			{
+				GetCurrentFunction().lastInstruction = instructionIndex;
+				state.isInsideFunction = false;
+				break;
+			}
+
+			case SpirvOp::OpLabel:
+				GetCurrentFunction().hasBody = true;
+				break;
+
+			case SpirvOp::OpFunctionCall:
+				GetCurrentFunction().callees.push_back(GetWord(3));
+				break;
+
+			case SpirvOp::OpEntryPoint:
+				module.entryPoints.push_back(GetWord(2));
+				break;
+
+			case SpirvOp::OpName:
+			case SpirvOp::OpMemberName:
+				module.names[GetWord(1)].push_back(instructionIndex);
+				break;
+
+			case SpirvOp::OpDecorate:
+			{
+				std::uint32_t targetId = GetWord(1);
+				module.decorations[targetId].push_back(instructionIndex);
+
+				if (static_cast<SpirvDecoration>(GetWord(2)) == SpirvDecoration::LinkageAttributes)
+				{
+					ReadWord(); //< target
+					ReadWord(); //< decoration
+					std::string linkageName = ReadString();
+					SpirvLinkageType linkageType = static_cast<SpirvLinkageType>(ReadWord());
+
+					if (linkageType == SpirvLinkageType::Import)
+						module.imports.emplace(targetId, std::move(linkageName));
+					else if (linkageType == SpirvLinkageType::Export)
+					{
+						State::Export exportData{ state.modules.size() - 1, targetId };
+						if (!state.exports.emplace(linkageName, exportData).second)
+							throw std::runtime_error(fmt::format("\"{}\" is exported by multiple modules", linkageName));
+					}
+				}
+				break;
+			}
+
+			case SpirvOp::OpMemberDecorate:
+				module.decorations[GetWord(1)].push_back(instructionIndex);
+				break;
+
+			default:
+				break;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,1479 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvOptimizer.hpp>
+#include <Nazara/Utils/CallOnExit.hpp>
+#include <NZSL/SpirV/SpirvData.hpp>
+#include <NZSL/SpirV/SpirvSectionBase.hpp>
+#include <NZSL/SpirV/SpirvUtils.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nzsl
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+		// Decorations of a value which can't be dropped when replacing it by another value
+		constexpr std::uint32_t ValueDecoration_NonUniform = 1 << 0;
+		constexpr std::uint32_t ValueDecoration_RelaxedPrecision = 1 << 1;
+
+		class VectorOutputSink : public SpirvOptimizer::OutputSink
+		{
+			public:
+				std::uint32_t* Allocate(std::size_t wordCount) override
+				{
+					words.resize(wordCount);
+					return words.data();
+				}
+
+				std::vector<std::uint32_t> words;
+		};
+
+		using IdReplacements = std::unordered_map<std::uint32_t, std::uint32_t>;
+
+		// Calls callback with every id used by an instruction (including its result type but not its result id)
+		template<typename T, typename F>
+		void ForEachUsedId(T& instruction, F&& callback)
+		{
+			const SpirvInstruction* instructionData = GetSpirvInstruction(static_cast<std::uint16_t>(instruction.op));
+			assert(instructionData);
+
+			// The result id is the first operand, or the second one when the instruction has a result type
+			const std::uint32_t* resultOperand = nullptr;
+			if (instruction.resultId != 0)
+				resultOperand = &instruction.operands[(instruction.resultTypeId != 0) ? 1 : 0];
+
+			ForEachIdOperand(*instructionData, instruction.operands.data(), instruction.operands.size(), [&](auto& id)
+			{
+				if (&id != resultOperand)
+					callback(id);
+			});
+		}
+
+		std::uint32_t ResolveId(const IdReplacements& replacements, std::uint32_t id)
+		{
+			for (;;)
+			{
+				auto it = replacements.find(id);
+				if (it == replacements.end())
+					return id;
+
+				id = it->second;
+			}
+		}
+
+		template<typename T>
+		void ApplyReplacements(T& function, const IdReplacements& replacements)
+		{
+			if (replacements.empty())
+				return;
+
+			for (auto& block : function.blocks)
+			{
+				for (auto& instruction : block.instructions)
+				{
+					ForEachUsedId(instruction, [&](std::uint32_t& id)
+					{
+						id = ResolveId(replacements, id);
+					});
+				}
+			}
+		}
+
+		template<typename T>
+		void EraseRemovedInstructions(T& function)
+		{
+			for (auto& block : function.blocks)
+			{
+				auto it = std::remove_if(block.instructions.begin(), block.instructions.end(), [](const auto& instruction) { return instruction.removed; });
+				block.instructions.erase(it, block.instructions.end());
+			}
+		}
+
+		std::string ReadLiteralString(const std::vector<std::uint32_t>& operands, std::size_t wordIndex)
+		{
+			std::string str;
+			for (; wordIndex < operands.size(); ++wordIndex)
+			{
+				std::uint32_t value = operands[wordIndex];
+				for (std::size_t j = 0; j < 4; ++j)
+				{
+					char c = static_cast<char>((value >> (j * 8)) & 0xFF);
+					if (c == '\0')
+						return str;
+
+					str.push_back(c);
+				}
+			}
+
+			return str;
+		}
+
+		bool IsAnnotationOrDebugInstruction(SpirvOp op)
+		{
+			switch (op)
+			{
+				case SpirvOp::OpDecorate:
+				case SpirvOp::OpMemberDecorate:
+				case SpirvOp::OpMemberName:
+				case SpirvOp::OpName:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		bool IsTypeOrConstantDeclaration(SpirvOp op)
+		{
+			switch (op)
+			{
+				case SpirvOp::OpConstant:
+				case SpirvOp::OpConstantComposite:
+				case SpirvOp::OpConstantFalse:
+				case SpirvOp::OpConstantNull:
+				case SpirvOp::OpConstantSampler:
+				case SpirvOp::OpConstantTrue:
+				case SpirvOp::OpTypeArray:
+				case SpirvOp::OpTypeBool:
+				case SpirvOp::OpTypeFloat:
+				case SpirvOp::OpTypeFunction:
+				case SpirvOp::OpTypeImage:
+				case SpirvOp::OpTypeInt:
+				case SpirvOp::OpTypeMatrix:
+				case SpirvOp::OpTypePointer:
+				case SpirvOp::OpTypeRuntimeArray:
+				case SpirvOp::OpTypeSampledImage:
+				case SpirvOp::OpTypeSampler:
+				case SpirvOp::OpTypeStruct:
+				case SpirvOp::OpTypeVector:
+				case SpirvOp::OpTypeVoid:
+				case SpirvOp::OpUndef:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+	}
+
+	struct SpirvOptimizer::Instruction
+	{
+		SpirvOp op = SpirvOp::OpNop;
+		std::uint32_t resultId = 0;
+		std::uint32_t resultTypeId = 0;
+		std::vector<std::uint32_t> operands;
+		bool removed = false;
+	};
+
+	struct SpirvOptimizer::Function
+	{
+		struct Block
+		{
+			std::size_t immediateDominator;
+			std::uint32_t labelId;
+			std::vector<Instruction> instructions;
+			std::vector<std::size_t> dominatedBlocks;
+			std::vector<std::size_t> predecessors;
+			std::vector<std::size_t> successors;
+			bool isReachable;
+		};
+
+		std::vector<Block> blocks;
+		std::vector<Instruction> declaration; //< OpFunction and OpFunctionParameter
+		Instruction end;
+	};
+
+	struct SpirvOptimizer::State
+	{
+		State(const Settings& s) :
+		settings(s)
+		{
+		}
+
+		struct PointerType
+		{
+			SpirvStorageClass storageClass;
+			std::uint32_t pointeeTypeId;
+		};
+
+		std::unordered_map<std::uint32_t, PointerType> pointerTypes;
+		std::unordered_map<std::uint32_t, std::uint32_t> arrayElementTypes;
+		std::unordered_map<std::uint32_t, std::uint32_t> undefIds;
+		std::unordered_set<std::uint32_t> bufferBlockTypes;
+		std::unordered_map<std::uint32_t, std::uint32_t> valueDecorations; //< id => mask of decorations changing how the value is computed (see GetValueDecorations)
+		std::uint32_t glslStd450Id = 0;
+		std::uint32_t nextResultId;
+		std::vector<Function> functions;
+		std::vector<Instruction> globals;
+		std::vector<Instruction> undefs;
+		SpirvHeader header;
+		const Settings& settings;
+		bool isInsideFunction = false;
+	};
+
+	std::vector<std::uint32_t> SpirvOptimizer::Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		VectorOutputSink output;
+		Optimize(codepoints, count, settings, output);
+
+		return std::move(output.words);
+	}
+
+	void SpirvOptimizer::Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings, OutputSink& output)
+	{
+		State state(settings);
+
+		m_currentState = &state;
+		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
+
+		Decode(codepoints, count);
+
+		for (Function& function : state.functions)
+		{
+			if (function.blocks.empty())
+				continue;
+
+			BuildControlFlow(function);
+
+			if (settings.promoteVariables)
+				PromoteVariables(function);
+
+			if (settings.forwardLoadStores || settings.removeRedundantAccessChains)
+				ForwardLoadStores(function);
+
+			if (settings.eliminateDeadCode)
+				EliminateDeadInstructions(function);
+		}
+
+		if (settings.eliminateDeadCode)
+			EliminateDeadGlobals();
+
+		// Compute the optimized module size first so it can be written directly in the output storage
+		std::size_t wordCount = 5; //< header
+		auto CountInstruction = [&](const Instruction& instruction)
+		{
+			if (!instruction.removed)
+				wordCount += 1 + instruction.operands.size();
+		};
+
+		for (const Instruction& instruction : state.globals)
+			CountInstruction(instruction);
+
+		for (const Instruction& instruction : state.undefs)
+			CountInstruction(instruction);
+
+		for (const Function& function : state.functions)
+		{
+			for (const Instruction& instruction : function.declaration)
+				CountInstruction(instruction);
+
+			for (const Function::Block& block : function.blocks)
+			{
+				wordCount += 2; //< OpLabel
+				for (const Instruction& instruction : block.instructions)
+					CountInstruction(instruction);
+			}
+
+			CountInstruction(function.end);
+		}
+
+		std::uint32_t* outputWords = output.Allocate(wordCount);
+		std::uint32_t* outputEnd = outputWords;
+
+		*outputEnd++ = SpirvMagicNumber;
+		*outputEnd++ = state.header.versionNumber;
+		*outputEnd++ = state.header.generatorId;
+		*outputEnd++ = state.nextResultId; //< bound
+		*outputEnd++ = state.header.schema;
+
+		auto AppendInstruction = [&](const Instruction& instruction)
+		{
+			if (instruction.removed)
+				return;
+
+			*outputEnd++ = SpirvSectionBase::BuildOpcode(instruction.op, static_cast<unsigned int>(1 + instruction.operands.size()));
+			outputEnd = std::copy(instruction.operands.begin(), instruction.operands.end(), outputEnd);
+		};
+
+		for (const Instruction& instruction : state.globals)
+			AppendInstruction(instruction);
+
+		for (const Instruction& instruction : state.undefs)
+			AppendInstruction(instruction);
+
+		for (const Function& function : state.functions)
+		{
+			for (const Instruction& instruction : function.declaration)
+				AppendInstruction(instruction);
+
+			for (const Function::Block& block : function.blocks)
+			{
+				*outputEnd++ = SpirvSectionBase::BuildOpcode(SpirvOp::OpLabel, 2);
+				*outputEnd++ = block.labelId;
+
+				for (const Instruction& instruction : block.instructions)
+					AppendInstruction(instruction);
+			}
+
+			AppendInstruction(function.end);
+		}
+
+		assert(outputEnd == outputWords + wordCount);
+	}
+
+	bool SpirvOptimizer::HandleHeader(const SpirvHeader& header)
+	{
+		m_currentState->header = header;
+		m_currentState->nextResultId = header.bound;
+
+		return true;
+	}
+
+	bool SpirvOptimizer::HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State& state = *m_currentState;
+
+		Instruction inst;
+		inst.op = instruction.op;
+		inst.operands.resize(wordCount - 1);
+		for (std::uint32_t& word : inst.operands)
+			word = ReadWord();
+
+		if (instruction.minOperandCount > 0 && !inst.operands.empty() && instruction.operands[0].kind == SpirvOperandKind::IdResultType)
+			inst.resultTypeId = inst.operands[0];
+
+		inst.resultId = GetResultId(instruction, inst.operands.data(), inst.operands.size());
+
+		switch (inst.op)
+		{
+			case SpirvOp::OpFunction:
+				state.functions.emplace_back().declaration.push_back(std::move(inst));
+				state.isInsideFunction = true;
+				break;
+
+			case SpirvOp::OpFunctionEnd:
+				state.functions.back().end = std::move(inst);
+				state.isInsideFunction = false;
+				break;
+
+			case SpirvOp::OpFunctionParameter:
+				state.functions.back().declaration.push_back(std::move(inst));
+				break;
+
+			case SpirvOp::OpLabel:
+				state.functions.back().blocks.emplace_back().labelId = inst.resultId;
+				break;
+
+			default:
+			{
+				if (state.isInsideFunction)
+				{
+					if (state.functions.back().blocks.empty())
+						throw std::runtime_error("invalid SPIR-V: instruction outside of a block");
+
+					state.functions.back().blocks.back().instructions.push_back(std::move(inst));
+					break;
+				}
+
+				switch (inst.op)
+				{
+					case SpirvOp::OpDecorate:
+					{
+						if (inst.operands.size() >= 2)
+						{
+							switch (static_cast<SpirvDecoration>(inst.operands[1]))
+							{
+								case SpirvDecoration::BufferBlock:
+									state.bufferBlockTypes.insert(inst.operands[0]);
+									break;
+
+								case SpirvDecoration::NonUniform:
+									state.valueDecorations[inst.operands[0]] |= ValueDecoration_NonUniform;
+									break;
+
+								case SpirvDecoration::RelaxedPrecision:
+									state.valueDecorations[inst.operands[0]] |= ValueDecoration_RelaxedPrecision;
+									break;
+
+								default:
+									break;
+							}
+						}
+
+						break;
+					}
+
+					case SpirvOp::OpExtInstImport:
+					{
+						if (ReadLiteralString(inst.operands, 1) == "GLSL.std.450")
+							state.glslStd450Id = inst.resultId;
+
+						break;
+					}
+
+					case SpirvOp::OpTypeArray:
+					case SpirvOp::OpTypeRuntimeArray:
+						state.arrayElementTypes[inst.operands[0]] = inst.operands[1];
+						break;
+
+					case SpirvOp::OpTypePointer:
+					{
+						auto& pointerType = state.pointerTypes[inst.resultId];
+						pointerType.storageClass = static_cast<SpirvStorageClass>(inst.operands[1]);
+						pointerType.pointeeTypeId = inst.operands[2];
+						break;
+					}
+
+					default:
+						break;
+				}
+
+				state.globals.push_back(std::move(inst));
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	std::uint32_t SpirvOptimizer::AllocateResultId()
+	{
+		return m_currentState->nextResultId++;
+	}
+
+	void SpirvOptimizer::BuildControlFlow(Function& function)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::unordered_map<std::uint32_t, std::size_t> blockIndices;
+		for (std::size_t i = 0; i < function.blocks.size(); ++i)
+			blockIndices[function.blocks[i].labelId] = i;
+
+		auto AddEdge = [&](std::size_t from, std::uint32_t targetLabel)
+		{
+			auto it = blockIndices.find(targetLabel);
+			if (it == blockIndices.end())
+				throw std::runtime_error("invalid SPIR-V: branch to unknown label %" + std::to_string(targetLabel));
+
+			auto& successors = function.blocks[from].successors;
+			if (std::find(successors.begin(), successors.end(), it->second) != successors.end())
+				return;
+
+			successors.push_back(it->second);
+			function.blocks[it->second].predecessors.push_back(from);
+		};
+
+		for (std::size_t i = 0; i < function.blocks.size(); ++i)
+		{
+			auto& block = function.blocks[i];
+			if (block.instructions.empty())
+				throw std::runtime_error("invalid SPIR-V: block %" + std::to_string(block.labelId) + " has no terminator");
+
+			const Instruction& terminator = block.instructions.back();
+			switch (terminator.op)
+			{
+				case SpirvOp::OpBranch:
+					AddEdge(i, terminator.operands[0]);
+					break;
+
+				case SpirvOp::OpBranchConditional:
+					AddEdge(i, terminator.operands[1]);
+					AddEdge(i, terminator.operands[2]);
+					break;
+
+				case SpirvOp::OpSwitch:
+				{
+					AddEdge(i, terminator.operands[1]);
+					for (std::size_t j = 2; j + 1 < terminator.operands.size(); j += 2)
+						AddEdge(i, terminator.operands[j + 1]);
+
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		// Dominator tree ("A Simple, Fast Dominance Algorithm", Cooper, Harvey and Kennedy)
+		std::vector<std::size_t> postOrder;
+		std::vector<std::size_t> postOrderIndices(function.blocks.size(), InvalidIndex);
+		{
+			std::vector<bool> visited(function.blocks.size(), false);
+			std::vector<std::pair<std::size_t, std::size_t>> stack;
+
+			visited[0] = true;
+			stack.emplace_back(0, 0);
+			while (!stack.empty())
+			{
+				std::size_t blockIndex = stack.back().first;
+				std::size_t successorIndex = stack.back().second;
+
+				const auto& successors = function.blocks[blockIndex].successors;
+				if (successorIndex < successors.size())
+				{
+					stack.back().second++;
+
+					std::size_t successor = successors[successorIndex];
+					if (!visited[successor])
+					{
+						visited[successor] = true;
+						stack.emplace_back(successor, 0);
+					}
+				}
+				else
+				{
+					postOrderIndices[blockIndex] = postOrder.size();
+					postOrder.push_back(blockIndex);
+					stack.pop_back();
+				}
+			}
+
+			for (std::size_t i = 0; i < function.blocks.size(); ++i)
+			{
+				function.blocks[i].immediateDominator = InvalidIndex;
+				function.blocks[i].isReachable = visited[i];
+			}
+		}
+
+		auto Intersect = [&](std::size_t lhs, std::size_t rhs)
+		{
+			while (lhs != rhs)
+			{
+				while (postOrderIndices[lhs] < postOrderIndices[rhs])
+					lhs = function.blocks[lhs].immediateDominator;
+
+				while (postOrderIndices[rhs] < postOrderIndices[lhs])
+					rhs = function.blocks[rhs].immediateDominator;
+			}
+
+			return lhs;
+		};
+
+		function.blocks[0].immediateDominator = 0;
+
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it)
+			{
+				std::size_t blockIndex = *it;
+				if (blockIndex == 0)
+					continue;
+
+				std::size_t newDominator = InvalidIndex;
+				for (std::size_t predecessor : function.blocks[blockIndex].predecessors)
+				{
+					if (function.blocks[predecessor].immediateDominator == InvalidIndex)
+						continue;
+
+					newDominator = (newDominator == InvalidIndex) ? predecessor : Intersect(predecessor, newDominator);
+				}
+
+				if (function.blocks[blockIndex].immediateDominator != newDominator)
+				{
+					function.blocks[blockIndex].immediateDominator = newDominator;
+					changed = true;
+				}
+			}
+		}
+
+		for (std::size_t i = 1; i < function.blocks.size(); ++i)
+		{
+			if (function.blocks[i].isReachable)
+				function.blocks[function.blocks[i].immediateDominator].dominatedBlocks.push_back(i);
+		}
+	}
+
+	void SpirvOptimizer::EliminateDeadGlobals()
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State& state = *m_currentState;
+
+		std::unordered_map<std::uint32_t, const Instruction*> declarations;
+		for (const Instruction& instruction : state.globals)
+		{
+			if (IsTypeOrConstantDeclaration(instruction.op) && instruction.resultId != 0)
+				declarations[instruction.resultId] = &instruction;
+		}
+
+		for (const Instruction& instruction : state.undefs)
+			declarations[instruction.resultId] = &instruction;
+
+		// Types and constants are alive as long as something else uses them
+		std::unordered_set<std::uint32_t> usedIds;
+		std::vector<const Instruction*> worklist;
+		auto MarkOperands = [&](const Instruction& instruction)
+		{
+			ForEachUsedId(instruction, [&](std::uint32_t id)
+			{
+				if (!usedIds.insert(id).second)
+					return;
+
+				if (auto it = declarations.find(id); it != declarations.end())
+					worklist.push_back(it->second);
+			});
+		};
+
+		for (const Instruction& instruction : state.globals)
+		{
+			if (!IsTypeOrConstantDeclaration(instruction.op) && !IsAnnotationOrDebugInstruction(instruction.op))
+				MarkOperands(instruction);
+		}
+
+		for (const Function& function : state.functions)
+		{
+			for (const Instruction& instruction : function.declaration)
+				MarkOperands(instruction);
+
+			for (const Function::Block& block : function.blocks)
+			{
+				for (const Instruction& instruction : block.instructions)
+					MarkOperands(instruction);
+			}
+		}
+
+		while (!worklist.empty())
+		{
+			const Instruction* instruction = worklist.back();
+			worklist.pop_back();
+
+			MarkOperands(*instruction);
+		}
+
+		for (Instruction& instruction : state.globals)
+		{
+			if (IsTypeOrConstantDeclaration(instruction.op) && instruction.resultId != 0 && usedIds.find(instruction.resultId) == usedIds.end())
+				instruction.removed = true;
+		}
+
+		for (Instruction& instruction : state.undefs)
+		{
+			if (usedIds.find(instruction.resultId) == usedIds.end())
+				instruction.removed = true;
+		}
+
+		// Remove names and decorations of every id which no longer exists
+		std::unordered_set<std::uint32_t> existingIds;
+		auto RegisterIds = [&](const std::vector<Instruction>& instructions)
+		{
+			for (const Instruction& instruction : instructions)
+			{
+				if (!instruction.removed && instruction.resultId != 0)
+					existingIds.insert(instruction.resultId);
+			}
+		};
+
+		RegisterIds(state.globals);
+		RegisterIds(state.undefs);
+		for (const Function& function : state.functions)
+		{
+			RegisterIds(function.declaration);
+			for (const Function::Block& block : function.blocks)
+			{
+				existingIds.insert(block.labelId);
+				RegisterIds(block.instructions);
+			}
+		}
+
+		for (Instruction& instruction : state.globals)
+		{
+			if (IsAnnotationOrDebugInstruction(instruction.op) && existingIds.find(instruction.operands[0]) == existingIds.end())
+				instruction.removed = true;
+		}
+	}
+
+	void SpirvOptimizer::EliminateDeadInstructions(Function& function)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::unordered_map<std::uint32_t, const Instruction*> definitions;
+		for (const Function::Block& block : function.blocks)
+		{
+			for (const Instruction& instruction : block.instructions)
+			{
+				if (instruction.resultId != 0)
+					definitions[instruction.resultId] = &instruction;
+			}
+		}
+
+		// Mark every instruction contributing to a side effect (stores, branches, calls...), the remaining pure instructions are dead
+		std::unordered_set<std::uint32_t> liveIds;
+		std::vector<const Instruction*> worklist;
+		auto MarkOperands = [&](const Instruction& instruction)
+		{
+			ForEachUsedId(instruction, [&](std::uint32_t id)
+			{
+				if (!liveIds.insert(id).second)
+					return;
+
+				if (auto it = definitions.find(id); it != definitions.end())
+					worklist.push_back(it->second);
+			});
+		};
+
+		for (const Function::Block& block : function.blocks)
+		{
+			for (const Instruction& instruction : block.instructions)
+			{
+				if (!IsPureInstruction(instruction))
+					MarkOperands(instruction);
+			}
+		}
+
+		while (!worklist.empty())
+		{
+			const Instruction* instruction = worklist.back();
+			worklist.pop_back();
+
+			MarkOperands(*instruction);
+		}
+
+		for (Function::Block& block : function.blocks)
+		{
+			for (Instruction& instruction : block.instructions)
+			{
+				if (instruction.resultId != 0 && IsPureInstruction(instruction) && liveIds.find(instruction.resultId) == liveIds.end())
+					instruction.removed = true;
+			}
+		}
+
+		EraseRemovedInstructions(function);
+	}
+
+	void SpirvOptimizer::ForwardLoadStores(Function& function)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State& state = *m_currentState;
+
+		std::unordered_map<std::uint32_t, std::uint32_t> pointerTypeIds; //< pointer id => pointer type id
+		std::unordered_map<std::uint32_t, std::uint32_t> pointerRoots; //< access chain id => accessed variable
+		std::unordered_set<std::uint32_t> variableIds;
+
+		for (const Instruction& instruction : state.globals)
+		{
+			if (instruction.op == SpirvOp::OpVariable)
+			{
+				pointerTypeIds[instruction.resultId] = instruction.resultTypeId;
+				variableIds.insert(instruction.resultId);
+			}
+		}
+
+		for (const Instruction& instruction : function.declaration)
+		{
+			if (instruction.op == SpirvOp::OpFunctionParameter && state.pointerTypes.find(instruction.resultTypeId) != state.pointerTypes.end())
+				pointerTypeIds[instruction.resultId] = instruction.resultTypeId;
+		}
+
+		auto GetRoot = [&](std::uint32_t pointerId)
+		{
+			auto it = pointerRoots.find(pointerId);
+			return (it != pointerRoots.end()) ? it->second : pointerId;
+		};
+
+		// Blocks are ordered so that dominators come first, bases are registered before the access chains using them
+		for (const Function::Block& block : function.blocks)
+		{
+			for (const Instruction& instruction : block.instructions)
+			{
+				switch (instruction.op)
+				{
+					case SpirvOp::OpAccessChain:
+					case SpirvOp::OpInBoundsAccessChain:
+						pointerTypeIds[instruction.resultId] = instruction.resultTypeId;
+						pointerRoots[instruction.resultId] = GetRoot(instruction.operands[2]);
+						break;
+
+					case SpirvOp::OpVariable:
+						pointerTypeIds[instruction.resultId] = instruction.resultTypeId;
+						variableIds.insert(instruction.resultId);
+						break;
+
+					default:
+						break;
+				}
+			}
+		}
+
+		// Pointers to different variables never alias, function parameters may point anywhere
+		auto MayAlias = [&](std::uint32_t lhsPointer, std::uint32_t rhsPointer)
+		{
+			std::uint32_t lhsRoot = GetRoot(lhsPointer);
+			std::uint32_t rhsRoot = GetRoot(rhsPointer);
+			if (lhsRoot == rhsRoot)
+				return true;
+
+			return variableIds.find(lhsRoot) == variableIds.end() || variableIds.find(rhsRoot) == variableIds.end();
+		};
+
+		// Read-only memory keeps its value during the whole invocation, loads can be reused in every dominated block
+		auto IsReadOnly = [&](std::uint32_t pointerId)
+		{
+			auto typeIt = pointerTypeIds.find(pointerId);
+			if (typeIt == pointerTypeIds.end())
+				return false;
+
+			auto pointerIt = state.pointerTypes.find(typeIt->second);
+			if (pointerIt == state.pointerTypes.end())
+				return false;
+
+			switch (pointerIt->second.storageClass)
+			{
+				case SpirvStorageClass::Input:
+				case SpirvStorageClass::PushConstant:
+				case SpirvStorageClass::UniformConstant:
+					return true;
+
+				case SpirvStorageClass::Uniform:
+				{
+					// Uniform blocks decorated with BufferBlock are storage buffers
+					std::uint32_t rootId = GetRoot(pointerId);
+					if (variableIds.find(rootId) == variableIds.end())
+						return false;
+
+					auto rootTypeIt = state.pointerTypes.find(pointerTypeIds[rootId]);
+					if (rootTypeIt == state.pointerTypes.end())
+						return false;
+
+					// Descriptor arrays of storage buffers are arrays of BufferBlock structs
+					std::uint32_t blockTypeId = rootTypeIt->second.pointeeTypeId;
+					for (auto it = state.arrayElementTypes.find(blockTypeId); it != state.arrayElementTypes.end(); it = state.arrayElementTypes.find(blockTypeId))
+						blockTypeId = it->second;
+
+					return state.bufferBlockTypes.find(blockTypeId) == state.bufferBlockTypes.end();
+				}
+
+				default:
+					return false;
+			}
+		};
+
+		IdReplacements replacements;
+		std::map<std::vector<std::uint32_t>, std::uint32_t> accessChains;
+		std::unordered_map<std::uint32_t, std::uint32_t> readOnlyLoads;
+
+		// Access chains and read-only loads registered by a block are available in the blocks it dominates
+		struct DominatorScope
+		{
+			std::size_t blockIndex;
+			std::size_t nextDominatedBlock = 0;
+			std::vector<std::vector<std::uint32_t>> registeredAccessChains;
+			std::vector<std::uint32_t> registeredLoads;
+		};
+
+		auto VisitBlock = [&](std::size_t blockIndex, std::vector<std::vector<std::uint32_t>>& registeredAccessChains, std::vector<std::uint32_t>& registeredLoads)
+		{
+			// Values of writable memory, only valid until the end of the block
+			std::unordered_map<std::uint32_t, std::uint32_t> storedValues;
+
+			for (Instruction& instruction : function.blocks[blockIndex].instructions)
+			{
+				ForEachUsedId(instruction, [&](std::uint32_t& id)
+				{
+					id = ResolveId(replacements, id);
+				});
+
+				switch (instruction.op)
+				{
+					case SpirvOp::OpAccessChain:
+					case SpirvOp::OpInBoundsAccessChain:
+					{
+						if (!state.settings.removeRedundantAccessChains)
+							break;
+
+						std::vector<std::uint32_t> key;
+						key.reserve(instruction.operands.size());
+						key.push_back(static_cast<std::uint32_t>(instruction.op));
+						key.push_back(instruction.resultTypeId);
+						key.insert(key.end(), instruction.operands.begin() + 2, instruction.operands.end());
+
+						if (auto it = accessChains.find(key); it != accessChains.end())
+						{
+							// Replacing the access chain would drop (or add) a decoration such as NonUniform, keep it
+							if (GetValueDecorations(instruction.resultId) != GetValueDecorations(it->second))
+								break;
+
+							replacements[instruction.resultId] = it->second;
+							instruction.removed = true;
+						}
+						else
+						{
+							accessChains.emplace(key, instruction.resultId);
+							registeredAccessChains.push_back(std::move(key));
+						}
+						break;
+					}
+
+					case SpirvOp::OpLoad:
+					{
+						if (!state.settings.forwardLoadStores || instruction.operands.size() != 3)
+							break;
+
+						std::uint32_t pointerId = instruction.operands[2];
+						if (IsReadOnly(pointerId))
+						{
+							if (auto it = readOnlyLoads.find(pointerId); it != readOnlyLoads.end())
+							{
+								// Loads decorated differently (RelaxedPrecision, NonUniform) are kept
+								if (GetValueDecorations(instruction.resultId) != GetValueDecorations(it->second))
+									break;
+
+								replacements[instruction.resultId] = it->second;
+								instruction.removed = true;
+							}
+							else
+							{
+								readOnlyLoads.emplace(pointerId, instruction.resultId);
+								registeredLoads.push_back(pointerId);
+							}
+						}
+						else
+						{
+							if (auto it = storedValues.find(pointerId); it != storedValues.end())
+							{
+								if (GetValueDecorations(instruction.resultId) != GetValueDecorations(it->second))
+									break;
+
+								replacements[instruction.resultId] = it->second;
+								instruction.removed = true;
+							}
+							else
+								storedValues.emplace(pointerId, instruction.resultId);
+						}
+						break;
+					}
+
+					case SpirvOp::OpStore:
+					{
+						if (!state.settings.forwardLoadStores)
+							break;
+
+						std::uint32_t pointerId = instruction.operands[0];
+						for (auto it = storedValues.begin(); it != storedValues.end();)
+						{
+							if (MayAlias(it->first, pointerId))
+								it = storedValues.erase(it);
+							else
+								++it;
+						}
+
+						if (instruction.operands.size() == 2)
+							storedValues[pointerId] = instruction.operands[1];
+
+						break;
+					}
+
+					default:
+					{
+						if (!IsPureInstruction(instruction))
+							storedValues.clear();
+
+						break;
+					}
+				}
+			}
+
+		};
+
+		// Walk the dominator tree with an explicit stack, as deeply nested control flow could overflow the call stack
+		std::vector<DominatorScope> scopeStack;
+		auto EnterBlock = [&](std::size_t blockIndex)
+		{
+			DominatorScope& scope = scopeStack.emplace_back();
+			scope.blockIndex = blockIndex;
+
+			VisitBlock(blockIndex, scope.registeredAccessChains, scope.registeredLoads);
+		};
+
+		EnterBlock(0);
+		while (!scopeStack.empty())
+		{
+			DominatorScope& scope = scopeStack.back();
+
+			const auto& dominatedBlocks = function.blocks[scope.blockIndex].dominatedBlocks;
+			if (scope.nextDominatedBlock < dominatedBlocks.size())
+			{
+				EnterBlock(dominatedBlocks[scope.nextDominatedBlock++]);
+				continue;
+			}
+
+			for (const auto& key : scope.registeredAccessChains)
+				accessChains.erase(key);
+
+			for (std::uint32_t pointerId : scope.registeredLoads)
+				readOnlyLoads.erase(pointerId);
+
+			scopeStack.pop_back();
+		}
+
+		ApplyReplacements(function, replacements);
+		EraseRemovedInstructions(function);
+	}
+
+	std::uint32_t SpirvOptimizer::GetValueDecorations(std::uint32_t id) const
+	{
+		auto it = m_currentState->valueDecorations.find(id);
+		if (it == m_currentState->valueDecorations.end())
+			return 0;
+
+		return it->second;
+	}
+
+	std::uint32_t SpirvOptimizer::GetUndefId(std::uint32_t typeId)
+	{
+		auto it = m_currentState->undefIds.find(typeId);
+		if (it != m_currentState->undefIds.end())
+			return it->second;
+
+		Instruction& undef = m_currentState->undefs.emplace_back();
+		undef.op = SpirvOp::OpUndef;
+		undef.resultId = AllocateResultId();
+		undef.resultTypeId = typeId;
+		undef.operands = { typeId, undef.resultId };
+
+		m_currentState->undefIds.emplace(typeId, undef.resultId);
+
+		return undef.resultId;
+	}
+
+	bool SpirvOptimizer::IsPureInstruction(const Instruction& instruction) const
+	{
+		switch (instruction.op)
+		{
+			case SpirvOp::OpAccessChain:
+			case SpirvOp::OpAll:
+			case SpirvOp::OpAny:
+			case SpirvOp::OpBitCount:
+			case SpirvOp::OpBitFieldInsert:
+			case SpirvOp::OpBitFieldSExtract:
+			case SpirvOp::OpBitFieldUExtract:
+			case SpirvOp::OpBitReverse:
+			case SpirvOp::OpBitcast:
+			case SpirvOp::OpBitwiseAnd:
+			case SpirvOp::OpBitwiseOr:
+			case SpirvOp::OpBitwiseXor:
+			case SpirvOp::OpCompositeConstruct:
+			case SpirvOp::OpCompositeExtract:
+			case SpirvOp::OpCompositeInsert:
+			case SpirvOp::OpConvertFToS:
+			case SpirvOp::OpConvertFToU:
+			case SpirvOp::OpConvertSToF:
+			case SpirvOp::OpConvertUToF:
+			case SpirvOp::OpCopyObject:
+			case SpirvOp::OpDPdx:
+			case SpirvOp::OpDPdxCoarse:
+			case SpirvOp::OpDPdxFine:
+			case SpirvOp::OpDPdy:
+			case SpirvOp::OpDPdyCoarse:
+			case SpirvOp::OpDPdyFine:
+			case SpirvOp::OpDot:
+			case SpirvOp::OpFAdd:
+			case SpirvOp::OpFConvert:
+			case SpirvOp::OpFDiv:
+			case SpirvOp::OpFMod:
+			case SpirvOp::OpFMul:
+			case SpirvOp::OpFNegate:
+			case SpirvOp::OpFOrdEqual:
+			case SpirvOp::OpFOrdGreaterThan:
+			case SpirvOp::OpFOrdGreaterThanEqual:
+			case SpirvOp::OpFOrdLessThan:
+			case SpirvOp::OpFOrdLessThanEqual:
+			case SpirvOp::OpFOrdNotEqual:
+			case SpirvOp::OpFRem:
+			case SpirvOp::OpFSub:
+			case SpirvOp::OpFUnordEqual:
+			case SpirvOp::OpFUnordGreaterThan:
+			case SpirvOp::OpFUnordGreaterThanEqual:
+			case SpirvOp::OpFUnordLessThan:
+			case SpirvOp::OpFUnordLessThanEqual:
+			case SpirvOp::OpFUnordNotEqual:
+			case SpirvOp::OpFwidth:
+			case SpirvOp::OpFwidthCoarse:
+			case SpirvOp::OpFwidthFine:
+			case SpirvOp::OpIAdd:
+			case SpirvOp::OpIEqual:
+			case SpirvOp::OpIMul:
+			case SpirvOp::OpINotEqual:
+			case SpirvOp::OpISub:
+			case SpirvOp::OpImage:
+			case SpirvOp::OpImageDrefGather:
+			case SpirvOp::OpImageFetch:
+			case SpirvOp::OpImageGather:
+			case SpirvOp::OpImageQueryLevels:
+			case SpirvOp::OpImageQueryLod:
+			case SpirvOp::OpImageQuerySamples:
+			case SpirvOp::OpImageQuerySize:
+			case SpirvOp::OpImageQuerySizeLod:
+			case SpirvOp::OpImageRead:
+			case SpirvOp::OpImageSampleDrefExplicitLod:
+			case SpirvOp::OpImageSampleDrefImplicitLod:
+			case SpirvOp::OpImageSampleExplicitLod:
+			case SpirvOp::OpImageSampleImplicitLod:
+			case SpirvOp::OpImageSampleProjDrefExplicitLod:
+			case SpirvOp::OpImageSampleProjDrefImplicitLod:
+			case SpirvOp::OpImageSampleProjExplicitLod:
+			case SpirvOp::OpImageSampleProjImplicitLod:
+			case SpirvOp::OpInBoundsAccessChain:
+			case SpirvOp::OpIsInf:
+			case SpirvOp::OpIsNan:
+			case SpirvOp::OpLogicalAnd:
+			case SpirvOp::OpLogicalEqual:
+			case SpirvOp::OpLogicalNot:
+			case SpirvOp::OpLogicalNotEqual:
+			case SpirvOp::OpLogicalOr:
+			case SpirvOp::OpMatrixTimesMatrix:
+			case SpirvOp::OpMatrixTimesScalar:
+			case SpirvOp::OpMatrixTimesVector:
+			case SpirvOp::OpNot:
+			case SpirvOp::OpOuterProduct:
+			case SpirvOp::OpPhi:
+			case SpirvOp::OpQuantizeToF16:
+			case SpirvOp::OpSConvert:
+			case SpirvOp::OpSDiv:
+			case SpirvOp::OpSGreaterThan:
+			case SpirvOp::OpSGreaterThanEqual:
+			case SpirvOp::OpSLessThan:
+			case SpirvOp::OpSLessThanEqual:
+			case SpirvOp::OpSMod:
+			case SpirvOp::OpSNegate:
+			case SpirvOp::OpSRem:
+			case SpirvOp::OpSampledImage:
+			case SpirvOp::OpSelect:
+			case SpirvOp::OpShiftLeftLogical:
+			case SpirvOp::OpShiftRightArithmetic:
+			case SpirvOp::OpShiftRightLogical:
+			case SpirvOp::OpTranspose:
+			case SpirvOp::OpUConvert:
+			case SpirvOp::OpUDiv:
+			case SpirvOp::OpUGreaterThan:
+			case SpirvOp::OpUGreaterThanEqual:
+			case SpirvOp::OpULessThan:
+			case SpirvOp::OpULessThanEqual:
+			case SpirvOp::OpUMod:
+			case SpirvOp::OpUndef:
+			case SpirvOp::OpVariable:
+			case SpirvOp::OpVectorExtractDynamic:
+			case SpirvOp::OpVectorInsertDynamic:
+			case SpirvOp::OpVectorShuffle:
+			case SpirvOp::OpVectorTimesMatrix:
+			case SpirvOp::OpVectorTimesScalar:
+				return true;
+
+			case SpirvOp::OpExtInst:
+			{
+				// GLSL.std.450 instructions are pure except for the ones writing through a pointer
+				if (instruction.operands[2] != m_currentState->glslStd450Id)
+					return false;
+
+				auto extOp = static_cast<SpirvGlslStd450Op>(instruction.operands[3]);
+				return extOp != SpirvGlslStd450Op::Frexp && extOp != SpirvGlslStd450Op::Modf;
+			}
+
+			case SpirvOp::OpLoad:
+				return instruction.operands.size() == 3; //< memory operands (such as Volatile) must be preserved
+
+			default:
+				return false;
+		}
+	}
+
+	void SpirvOptimizer::PromoteVariables(Function& function)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State& state = *m_currentState;
+
+		struct Variable
+		{
+			std::uint32_t typeId;
+			std::vector<std::size_t> storeBlocks;
+			bool isPromotable = true;
+		};
+
+		// Only function variables accessed as a whole through loads and stores can be turned into SSA values
+		std::unordered_map<std::uint32_t, std::size_t> variableIndices;
+		std::vector<Variable> variables;
+		for (const Instruction& instruction : function.blocks.front().instructions)
+		{
+			if (instruction.op != SpirvOp::OpVariable || instruction.operands.size() != 3)
+				continue;
+
+			if (static_cast<SpirvStorageClass>(instruction.operands[2]) != SpirvStorageClass::Function)
+				continue;
+
+			auto it = state.pointerTypes.find(instruction.resultTypeId);
+			if (it == state.pointerTypes.end())
+				continue;
+
+			variableIndices.emplace(instruction.resultId, variables.size());
+
+			auto& variable = variables.emplace_back();
+			variable.typeId = it->second.pointeeTypeId;
+		}
+
+		if (variables.empty())
+			return;
+
+		for (std::size_t blockIndex = 0; blockIndex < function.blocks.size(); ++blockIndex)
+		{
+			for (Instruction& instruction : function.blocks[blockIndex].instructions)
+			{
+				ForEachUsedId(instruction, [&](std::uint32_t& id)
+				{
+					auto it = variableIndices.find(id);
+					if (it == variableIndices.end())
+						return;
+
+					Variable& variable = variables[it->second];
+
+					// Loads are replaced by stored values (or phis), which wouldn't carry decorations such as RelaxedPrecision or NonUniform
+					std::size_t wordIndex = static_cast<std::size_t>(&id - instruction.operands.data());
+					if (instruction.op == SpirvOp::OpLoad && instruction.operands.size() == 3 && wordIndex == 2)
+					{
+						if (GetValueDecorations(instruction.resultId) != 0)
+							variable.isPromotable = false;
+
+						return;
+					}
+
+					if (instruction.op == SpirvOp::OpStore && instruction.operands.size() == 2 && wordIndex == 0)
+					{
+						if (GetValueDecorations(instruction.operands[1]) != 0)
+							variable.isPromotable = false;
+
+						if (function.blocks[blockIndex].isReachable)
+							variable.storeBlocks.push_back(blockIndex);
+
+						return;
+					}
+
+					variable.isPromotable = false;
+				});
+			}
+		}
+
+		auto IsPromoted = [&](std::uint32_t pointerId) -> Variable*
+		{
+			auto it = variableIndices.find(pointerId);
+			if (it == variableIndices.end() || !variables[it->second].isPromotable)
+				return nullptr;
+
+			return &variables[it->second];
+		};
+
+		if (std::none_of(variables.begin(), variables.end(), [](const Variable& variable) { return variable.isPromotable; }))
+			return;
+
+		// Place phi nodes on the iterated dominance frontier of the blocks storing to the variables
+		std::vector<std::vector<std::size_t>> dominanceFrontiers(function.blocks.size());
+		for (std::size_t blockIndex = 0; blockIndex < function.blocks.size(); ++blockIndex)
+		{
+			const auto& block = function.blocks[blockIndex];
+			if (!block.isReachable || block.predecessors.size() < 2)
+				continue;
+
+			for (std::size_t predecessor : block.predecessors)
+			{
+				if (!function.blocks[predecessor].isReachable)
+					continue;
+
+				std::size_t runner = predecessor;
+				while (runner != block.immediateDominator)
+				{
+					auto& frontier = dominanceFrontiers[runner];
+					if (std::find(frontier.begin(), frontier.end(), blockIndex) == frontier.end())
+						frontier.push_back(blockIndex);
+
+					runner = function.blocks[runner].immediateDominator;
+				}
+			}
+		}
+
+		struct Phi
+		{
+			std::size_t variableIndex;
+			std::uint32_t resultId;
+			std::vector<std::uint32_t> incomingValues; //< one per predecessor
+		};
+
+		std::vector<std::vector<Phi>> blockPhis(function.blocks.size());
+		std::vector<std::uint32_t> undefValues(variables.size(), 0);
+
+		for (std::size_t variableIndex = 0; variableIndex < variables.size(); ++variableIndex)
+		{
+			Variable& variable = variables[variableIndex];
+			if (!variable.isPromotable)
+				continue;
+
+			undefValues[variableIndex] = GetUndefId(variable.typeId);
+
+			std::vector<bool> hasPhi(function.blocks.size(), false);
+			std::vector<bool> isQueued(function.blocks.size(), false);
+			std::vector<std::size_t> worklist;
+			for (std::size_t blockIndex : variable.storeBlocks)
+			{
+				if (!isQueued[blockIndex])
+				{
+					isQueued[blockIndex] = true;
+					worklist.push_back(blockIndex);
+				}
+			}
+
+			while (!worklist.empty())
+			{
+				std::size_t blockIndex = worklist.back();
+				worklist.pop_back();
+
+				for (std::size_t frontierBlock : dominanceFrontiers[blockIndex])
+				{
+					if (hasPhi[frontierBlock])
+						continue;
+
+					hasPhi[frontierBlock] = true;
+
+					auto& phi = blockPhis[frontierBlock].emplace_back();
+					phi.variableIndex = variableIndex;
+					phi.resultId = AllocateResultId();
+					phi.incomingValues.resize(function.blocks[frontierBlock].predecessors.size(), undefValues[variableIndex]);
+
+					if (!isQueued[frontierBlock])
+					{
+						isQueued[frontierBlock] = true;
+						worklist.push_back(frontierBlock);
+					}
+				}
+			}
+		}
+
+		// Rename loads and stores by walking the dominator tree
+		IdReplacements replacements;
+
+		auto PromoteAccess = [&](Instruction& instruction, std::vector<std::uint32_t>& currentValues)
+		{
+			if (instruction.op == SpirvOp::OpLoad && instruction.operands.size() == 3 && IsPromoted(instruction.operands[2]))
+			{
+				replacements[instruction.resultId] = currentValues[variableIndices[instruction.operands[2]]];
+				instruction.removed = true;
+			}
+			else if (instruction.op == SpirvOp::OpStore && instruction.operands.size() == 2 && IsPromoted(instruction.operands[0]))
+			{
+				currentValues[variableIndices[instruction.operands[0]]] = ResolveId(replacements, instruction.operands[1]);
+				instruction.removed = true;
+			}
+		};
+
+		std::vector<std::uint32_t> currentValues = undefValues;
+
+		// Walk the dominator tree with an explicit stack (deeply nested control flow could overflow the call stack), each block restores the values it was entered with when left
+		struct RenameScope
+		{
+			std::size_t blockIndex;
+			std::size_t nextDominatedBlock = 0;
+			std::vector<std::uint32_t> savedValues;
+		};
+
+		std::vector<RenameScope> scopeStack;
+		auto RenameBlock = [&](std::size_t blockIndex)
+		{
+			RenameScope& scope = scopeStack.emplace_back();
+			scope.blockIndex = blockIndex;
+			scope.savedValues = currentValues;
+
+			for (const Phi& phi : blockPhis[blockIndex])
+				currentValues[phi.variableIndex] = phi.resultId;
+
+			for (Instruction& instruction : function.blocks[blockIndex].instructions)
+				PromoteAccess(instruction, currentValues);
+
+			for (std::size_t successor : function.blocks[blockIndex].successors)
+			{
+				const auto& predecessors = function.blocks[successor].predecessors;
+				std::size_t predecessorIndex = static_cast<std::size_t>(std::find(predecessors.begin(), predecessors.end(), blockIndex) - predecessors.begin());
+
+				for (Phi& phi : blockPhis[successor])
+					phi.incomingValues[predecessorIndex] = currentValues[phi.variableIndex];
+			}
+		};
+
+		RenameBlock(0);
+		while (!scopeStack.empty())
+		{
+			RenameScope& scope = scopeStack.back();
+
+			const auto& dominatedBlocks = function.blocks[scope.blockIndex].dominatedBlocks;
+			if (scope.nextDominatedBlock < dominatedBlocks.size())
+			{
+				RenameBlock(dominatedBlocks[scope.nextDominatedBlock++]);
+				continue;
+			}
+
+			currentValues = std::move(scope.savedValues);
+			scopeStack.pop_back();
+		}
+
+		// Unreachable blocks are not part of the dominator tree, loads there can only read undefined values
+		for (auto& block : function.blocks)
+		{
+			if (block.isReachable)
+				continue;
+
+			std::vector<std::uint32_t> blockValues = undefValues;
+			for (Instruction& instruction : block.instructions)
+				PromoteAccess(instruction, blockValues);
+		}
+
+		for (std::size_t blockIndex = 0; blockIndex < function.blocks.size(); ++blockIndex)
+		{
+			if (blockPhis[blockIndex].empty())
+				continue;
+
+			auto& block = function.blocks[blockIndex];
+
+			std::vector<Instruction> phiInstructions;
+			for (const Phi& phi : blockPhis[blockIndex])
+			{
+				Instruction& instruction = phiInstructions.emplace_back();
+				instruction.op = SpirvOp::OpPhi;
+				instruction.resultId = phi.resultId;
+				instruction.resultTypeId = variables[phi.variableIndex].typeId;
+				instruction.operands = { instruction.resultTypeId, instruction.resultId };
+
+				for (std::size_t i = 0; i < block.predecessors.size(); ++i)
+				{
+					instruction.operands.push_back(phi.incomingValues[i]);
+					instruction.operands.push_back(function.blocks[block.predecessors[i]].labelId);
+				}
+			}
+
+			block.instructions.insert(block.instructions.begin(), std::make_move_iterator(phiInstructions.begin()), std::make_move_iterator(phiInstructions.end()));
+		}
+
+		for (Instruction& instruction : function.blocks.front().instructions)
+		{
+			if (instruction.op == SpirvOp::OpVariable && IsPromoted(instruction.resultId))
+				instruction.removed = true;
+		}
+
+		ApplyReplacements(function, replacements);
+		EraseRemovedInstructions(function);
+	}
+
+	SpirvOptimizer::OutputSink::~OutputSink() = default;
+}
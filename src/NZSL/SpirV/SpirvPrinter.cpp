@@ -5,43 +5,101 @@
 #include <NZSL/SpirV/SpirvPrinter.hpp>
 #include <Nazara/Utils/Algorithm.hpp>
 #include <Nazara/Utils/CallOnExit.hpp>
-#include <Nazara/Utils/StackArray.hpp>
 #include <NZSL/SpirV/SpirvData.hpp>
+#include <NZSL/SpirV/SpirvUtils.hpp>
+#include <fmt/format.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <iomanip>
-#include <sstream>
+#include <iterator>
 #include <stdexcept>
 #include <unordered_map>
 
 namespace nzsl
 {
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Printed text is forwarded to the output sink in chunks of at least this size
+		constexpr std::size_t FlushThreshold = 64 * 1024;
+
+		class StringSink : public SpirvPrinter::OutputSink
+		{
+			public:
+				StringSink(std::string& str) :
+				m_str(str)
+				{
+				}
+
+				void Write(std::string_view text) override
+				{
+					m_str.append(text);
+				}
+
+			private:
+				std::string& m_str;
+		};
+	}
+
 	struct SpirvPrinter::State
 	{
-		State(const Settings& s) :
+		State(const Settings& s, OutputSink& o) :
+		output(o),
 		settings(s)
 		{
 		}
 
-		std::ostringstream stream;
+		void Flush()
+		{
+			output.Write(std::string_view(buffer.data(), buffer.size()));
+			buffer.clear();
+		}
+
+		template<typename... Args>
+		void Print(fmt::format_string<Args...> format, Args&&... args)
+		{
+			fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+		}
+
+		void Print(std::string_view str)
+		{
+			buffer.append(str.data(), str.data() + str.size());
+		}
+
+		fmt::memory_buffer buffer;
 		std::size_t resultOffset;
 		std::unordered_map<std::uint32_t, ExtensionSet> extensionSets;
+		std::unordered_map<std::uint32_t, std::string> names;
 		std::unordered_map<std::uint32_t, std::uint32_t /*Width*/> floatingPointTypes;
 		std::unordered_map<std::uint32_t, std::uint32_t /*Width*/> integerTypes;
 		std::unordered_map<std::uint32_t, std::uint32_t /*Width*/> unsignedIntegerTypes;
+		OutputSink& output;
 		const Settings& settings;
+		bool isInsideFunction = false;
+		bool printCurrentFunction = true;
 	};
 
 	std::string SpirvPrinter::Print(const std::uint32_t* codepoints, std::size_t count, const Settings& settings)
 	{
-		State state(settings);
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::string str;
+		StringSink sink(str);
+		Print(codepoints, count, settings, sink);
+
+		return str;
+	}
+
+	void SpirvPrinter::Print(const std::uint32_t* codepoints, std::size_t count, const Settings& settings, OutputSink& output)
+	{
+		State state(settings, output);
 
 		m_currentState = &state;
 		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
 
 		Decode(codepoints, count);
 
-		return m_currentState->stream.str();
+		if (state.buffer.size() > 0)
+			state.Flush();
 	}
 
 	bool SpirvPrinter::HandleHeader(const SpirvHeader& header)
@@ -49,14 +107,14 @@ namespace nzsl
 		std::uint8_t majorVersion = ((header.versionNumber) >> 16) & 0xFF;
 		std::uint8_t minorVersion = ((header.versionNumber) >> 8) & 0xFF;
 
-		m_currentState->resultOffset = std::snprintf(nullptr, 0, "%%%u = ", header.bound);
+		m_currentState->resultOffset = fmt::formatted_size("%{} = ", header.bound);
 
 		if (m_currentState->settings.printHeader)
 		{
-			m_currentState->stream << "Version " + std::to_string(+majorVersion) << "." << std::to_string(+minorVersion) << "\n";
-			m_currentState->stream << "Generator: " << std::to_string(header.generatorId) << "\n";
-			m_currentState->stream << "Bound: " << std::to_string(header.bound) << "\n";
-			m_currentState->stream << "Schema: " << std::to_string(header.schema) << "\n";
+			m_currentState->Print("Version {}.{}\n", +majorVersion, +minorVersion);
+			m_currentState->Print("Generator: {}\n", header.generatorId);
+			m_currentState->Print("Bound: {}\n", header.bound);
+			m_currentState->Print("Schema: {}\n", header.schema);
 		}
 
 		return true;
@@ -64,136 +122,169 @@ namespace nzsl
 
 	bool SpirvPrinter::HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		State& state = *m_currentState;
+		const Settings& settings = state.settings;
+
 		const std::uint32_t* startPtr = GetCurrentPtr();
+		const std::uint32_t* endPtr = startPtr + wordCount - 1;
 
-		if (m_currentState->settings.printParameters)
+		// Gather informations required to print the following instructions, even if this one is not printed
+		switch (instruction.op)
 		{
-			std::ostringstream instructionStream;
-			instructionStream << instruction.name;
+			case SpirvOp::OpExtInstImport:
+			{
+				std::uint32_t set = ReadWord();
+				std::string str = ReadString();
+				if (str == "GLSL.std.450")
+					state.extensionSets[set] = ExtensionSet::GLSLstd450;
 
-			const std::uint32_t* endPtr = startPtr + wordCount - 1;
+				break;
+			}
 
-			std::uint32_t resultId = 0;
-			auto PrintParameter = [&](const SpirvOperand* operands, std::size_t minOperandCount)
+			case SpirvOp::OpFunction:
 			{
-				std::size_t currentOperand = 0;
-				while (GetCurrentPtr() < endPtr)
-				{
-					const SpirvOperand* operand = &operands[currentOperand];
+				ReadWord(); //< result type
+				std::uint32_t resultId = ReadWord();
 
-					if (operand->kind != SpirvOperandKind::IdResult)
-						PrintOperand(instructionStream, operand);
-					else
-						resultId = ReadWord();
-
-					if (currentOperand < minOperandCount - 1)
-						currentOperand++;
+				state.isInsideFunction = true;
+				if (!settings.functions.empty())
+				{
+					auto it = state.names.find(resultId);
+					state.printCurrentFunction = (it != state.names.end() && std::find(settings.functions.begin(), settings.functions.end(), it->second) != settings.functions.end());
 				}
-			};
+				break;
+			}
 
-			switch (instruction.op)
+			case SpirvOp::OpName:
 			{
-				case SpirvOp::OpExtInstImport:
+				if (!settings.functions.empty())
 				{
-					const std::uint32_t* savedPtr = GetCurrentPtr();
+					std::uint32_t targetId = ReadWord();
+					state.names[targetId] = ReadString();
+				}
+				break;
+			}
 
-					std::uint32_t set = ReadWord();
-					std::string str = ReadString();
-					if (str == "GLSL.std.450")
-						m_currentState->extensionSets[set] = ExtensionSet::GLSLstd450;
+			case SpirvOp::OpTypeFloat:
+			{
+				std::uint32_t resultId = ReadWord();
+				std::uint32_t width = ReadWord();
 
-					ResetPtr(savedPtr);
+				state.floatingPointTypes[resultId] = width;
+				break;
+			}
 
-					PrintParameter(instruction.operands, instruction.minOperandCount);
-					break;
-				}
+			case SpirvOp::OpTypeInt:
+			{
+				std::uint32_t resultId = ReadWord();
+				std::uint32_t width = ReadWord();
+				std::uint32_t signedness = ReadWord();
+
+				if (signedness == 0)
+					state.unsignedIntegerTypes[resultId] = width;
+				else
+					state.integerTypes[resultId] = width;
+
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		ResetPtr(startPtr);
+
+		SpirvLogicalSection section = (state.isInsideFunction) ? SpirvLogicalSection::Function : GetLogicalSection(instruction.op);
+		if (instruction.op == SpirvOp::OpFunctionEnd)
+			state.isInsideFunction = false;
+
+		bool printInstruction = true;
+		switch (section)
+		{
+			case SpirvLogicalSection::Capability:
+			case SpirvLogicalSection::Extension:
+			case SpirvLogicalSection::ExtInstImport:
+			case SpirvLogicalSection::MemoryModel:
+			case SpirvLogicalSection::EntryPoint:
+			case SpirvLogicalSection::ExecutionMode:
+				printInstruction = settings.printPreamble;
+				break;
+
+			case SpirvLogicalSection::DebugSource:
+			case SpirvLogicalSection::DebugName:
+			case SpirvLogicalSection::DebugModuleProcessed:
+				printInstruction = settings.printDebug;
+				break;
+
+			case SpirvLogicalSection::Annotation:
+				printInstruction = settings.printAnnotations;
+				break;
+
+			case SpirvLogicalSection::Global:
+				printInstruction = settings.printGlobals;
+				break;
+
+			case SpirvLogicalSection::Function:
+				printInstruction = settings.printFunctions && state.printCurrentFunction;
+				break;
+		}
+
+		if (!printInstruction)
+			return true;
+
+		if (settings.printParameters)
+		{
+			if (std::uint32_t resultId = GetResultId(instruction, startPtr, wordCount - 1); resultId != 0)
+				state.Print("{:>{}}", fmt::format("%{} = ", resultId), state.resultOffset);
+			else
+				state.Print("{:{}}", "", state.resultOffset);
 
+			state.Print(instruction.name);
+
+			switch (instruction.op)
+			{
 				case SpirvOp::OpExtInst:
 				{
-					const std::uint32_t* savedPtr = GetCurrentPtr();
-
 					std::uint32_t resultType = ReadWord();
-					resultId = ReadWord();
+					ReadWord(); //< result id
 					std::uint32_t set = ReadWord();
 					std::uint32_t instructionId = ReadWord();
 
-					if (auto it = m_currentState->extensionSets.find(set); it != m_currentState->extensionSets.end())
+					const SpirvGlslStd450Instruction* extInst = nullptr;
+					if (auto it = state.extensionSets.find(set); it != state.extensionSets.end())
 					{
 						switch (it->second)
 						{
 							case ExtensionSet::GLSLstd450:
-							{
-								const SpirvGlslStd450Instruction* extInst = GetSpirvGlslStd450Instruction(Nz::SafeCast<std::uint16_t>(instructionId));
-								if (extInst)
-								{
-									instructionStream << " %" << resultType;
-									instructionStream << " GLSLstd450 ";
-									instructionStream << extInst->name;
-									PrintParameter(extInst->operands, extInst->minOperandCount);
-								}
-								else
-								{
-									ResetPtr(savedPtr);
-									PrintParameter(instruction.operands, instruction.minOperandCount);
-								}
-
+								extInst = GetSpirvGlslStd450Instruction(Nz::SafeCast<std::uint16_t>(instructionId));
 								break;
-							}
 						}
 					}
-					else
+
+					if (extInst)
 					{
-						ResetPtr(savedPtr);
-						PrintParameter(instruction.operands, instruction.minOperandCount);
+						state.Print(" %{} GLSLstd450 {}", resultType, extInst->name);
+						PrintOperands(extInst->operands, extInst->minOperandCount, endPtr);
 					}
-
-					break;
-				}
-
-				case SpirvOp::OpTypeFloat:
-				{
-					const std::uint32_t* savedPtr = GetCurrentPtr();
-
-					resultId = ReadWord();
-					std::uint32_t width = ReadWord();
-
-					m_currentState->floatingPointTypes[resultId] = width;
-
-					ResetPtr(savedPtr);
-					PrintParameter(instruction.operands, instruction.minOperandCount);
-					break;
-				}
-
-				case SpirvOp::OpTypeInt:
-				{
-					const std::uint32_t* savedPtr = GetCurrentPtr();
-
-					resultId = ReadWord();
-					std::uint32_t width = ReadWord();
-					std::uint32_t signedness = ReadWord();
-
-					if (signedness == 0)
-						m_currentState->unsignedIntegerTypes[resultId] = width;
 					else
-						m_currentState->integerTypes[resultId] = width;
+					{
+						ResetPtr(startPtr);
+						PrintOperands(instruction.operands, instruction.minOperandCount, endPtr);
+					}
 
-					ResetPtr(savedPtr);
-					PrintParameter(instruction.operands, instruction.minOperandCount);
 					break;
 				}
 
 				case SpirvOp::OpConstant:
 				{
-					const std::uint32_t* savedPtr = GetCurrentPtr();
-
-					PrintOperand(instructionStream, &instruction.operands[0]);
+					PrintOperand(&instruction.operands[0]);
 
-					ResetPtr(savedPtr);
-
-					std::uint32_t resultType = ReadWord();
-					resultId = ReadWord();
+					std::uint32_t resultType = startPtr[0];
+					ReadWord(); //< result id
 
-					if (auto floatIt = m_currentState->floatingPointTypes.find(resultType); floatIt != m_currentState->floatingPointTypes.end())
+					if (auto floatIt = state.floatingPointTypes.find(resultType); floatIt != state.floatingPointTypes.end())
 					{
 						std::uint32_t width = floatIt->second;
 						//TODO: Add support for half constants
@@ -203,7 +294,7 @@ namespace nzsl
 							float f32;
 							std::memcpy(&f32, &floatVal, sizeof(floatVal));
 
-							instructionStream << " f32(" << f32 << ")";
+							state.Print(" f32({:g})", f32);
 						}
 						else if (width == 64)
 						{
@@ -214,12 +305,12 @@ namespace nzsl
 							double f64;
 							std::memcpy(&f64, &doubleVal, sizeof(doubleVal));
 
-							instructionStream << " f64(" << f64 << ")";
+							state.Print(" f64({:g})", f64);
 						}
 						else
-							PrintOperand(instructionStream, &instruction.operands[2]);
+							PrintOperand(&instruction.operands[2]);
 					}
-					else if (auto intIt = m_currentState->integerTypes.find(resultType); intIt != m_currentState->integerTypes.end())
+					else if (auto intIt = state.integerTypes.find(resultType); intIt != state.integerTypes.end())
 					{
 						std::uint32_t width = intIt->second;
 						if (width >= 16 && width <= 32)
@@ -228,7 +319,7 @@ namespace nzsl
 							std::int32_t iVal;
 							std::memcpy(&iVal, &value, sizeof(value));
 
-							instructionStream << " i" << width << "(" << iVal << ")";
+							state.Print(" i{}({})", width, iVal);
 						}
 						else if (width <= 64)
 						{
@@ -239,62 +330,57 @@ namespace nzsl
 							std::int64_t iVal;
 							std::memcpy(&iVal, &value, sizeof(value));
 
-							instructionStream << " i" << width << "(" << iVal << ")";
+							state.Print(" i{}({})", width, iVal);
 						}
 						else
-							PrintOperand(instructionStream, &instruction.operands[2]);
+							PrintOperand(&instruction.operands[2]);
 					}
-					else if (auto uintIt = m_currentState->unsignedIntegerTypes.find(resultType); uintIt != m_currentState->unsignedIntegerTypes.end())
+					else if (auto uintIt = state.unsignedIntegerTypes.find(resultType); uintIt != state.unsignedIntegerTypes.end())
 					{
 						std::uint32_t width = uintIt->second;
 						if (width >= 16 && width <= 32)
 						{
 							std::uint32_t value = ReadWord();
-							instructionStream << " u" << width << "(" << value << ")";
+							state.Print(" u{}({})", width, value);
 						}
 						else if (width <= 64)
 						{
 							std::uint64_t low = ReadWord();
 							std::uint64_t high = ReadWord();
 							std::uint64_t value = (high << 32) | low;
-							instructionStream << " u" << width << "(" << value << ")";
+							state.Print(" u{}({})", width, value);
 						}
 						else
-							PrintOperand(instructionStream, &instruction.operands[2]);
+							PrintOperand(&instruction.operands[2]);
 					}
 					else
-						PrintOperand(instructionStream, &instruction.operands[2]);
+						PrintOperand(&instruction.operands[2]);
 
 					break;
 				}
 
 				default:
-					PrintParameter(instruction.operands, instruction.minOperandCount);
+					PrintOperands(instruction.operands, instruction.minOperandCount, endPtr);
 					break;
 			}
 
-			if (resultId != 0)
-			{
-				std::string resultInfo = "%" + std::to_string(resultId) + " = ";
-				m_currentState->stream << std::setw(m_currentState->resultOffset) << resultInfo;
-			}
-			else
-				m_currentState->stream << std::string(m_currentState->resultOffset, ' ');
-
-			m_currentState->stream << instructionStream.str();
-
-			assert(GetCurrentPtr() == startPtr + wordCount - 1);
+			assert(GetCurrentPtr() == endPtr);
 		}
 		else
-			m_currentState->stream << instruction.name;
+			state.Print(instruction.name);
+
+		state.Print("\n");
 
-		m_currentState->stream << "\n";
+		if (state.buffer.size() >= FlushThreshold)
+			state.Flush();
 
 		return true;
 	}
 	
-	void SpirvPrinter::PrintOperand(std::ostream& instructionStream, const SpirvOperand* operand)
+	void SpirvPrinter::PrintOperand(const SpirvOperand* operand)
 	{
+		State& state = *m_currentState;
+
 		switch (operand->kind)
 		{
 			case SpirvOperandKind::IdRef:
@@ -303,7 +389,7 @@ namespace nzsl
 			case SpirvOperandKind::IdScope:
 			{
 				std::uint32_t value = ReadWord();
-				instructionStream << " %" << value;
+				state.Print(" %{}", value);
 				break;
 			}
 
@@ -311,12 +397,12 @@ namespace nzsl
 			case SpirvOperandKind:: Kind : \
 			{ \
 				Spirv##Kind value = static_cast<Spirv##Kind>(ReadWord()); \
-				instructionStream << " " #Kind "(" << ToString(value) << ")"; \
+				state.Print(" " #Kind "({})", ToString(value)); \
 \
 				/* handle extra operands */ \
 				auto [operandPtr, operandCount] = GetSpirvExtraOperands(value); \
 				for (std::size_t i = 0; i < operandCount; ++i) \
-					PrintOperand(instructionStream, operandPtr + i); \
+					PrintOperand(operandPtr + i); \
 \
 				break; \
 			} \
@@ -367,71 +453,69 @@ namespace nzsl
 			case SpirvOperandKind::LiteralContextDependentNumber: //< FIXME
 			{
 				std::uint32_t value = ReadWord();
-				instructionStream << " " << operand->name << "(" << value << ")";
+				state.Print(" {}({})", operand->name, value);
 				break;
 			}
 
 			case SpirvOperandKind::LiteralInteger:
 			{
 				std::uint32_t value = ReadWord();
-				instructionStream << " " << value;
+				state.Print(" {}", value);
 				break;
 			}
 
 			case SpirvOperandKind::LiteralString:
 			{
 				std::string str = ReadString();
-				instructionStream << " \"" << str << "\"";
-
-				/*
-				std::size_t offset = GetOutputOffset();
-
-				std::size_t size4 = CountWord(str);
-				for (std::size_t i = 0; i < size4; ++i)
-				{
-					std::uint32_t codepoint = 0;
-					for (std::size_t j = 0; j < 4; ++j)
-					{
-						std::size_t pos = i * 4 + j;
-						if (pos < str.size())
-							codepoint |= std::uint32_t(str[pos]) << (j * 8);
-					}
-
-					Append(codepoint);
-				}
-				*/
+				state.Print(" \"{}\"", str);
 				break;
 			}
 
-
 			case SpirvOperandKind::PairLiteralIntegerIdRef:
 			{
-				ReadWord();
-				ReadWord();
+				std::uint32_t value = ReadWord();
+				std::uint32_t id = ReadWord();
+				state.Print(" {} %{}", value, id);
 				break;
 			}
 
 			case SpirvOperandKind::PairIdRefLiteralInteger:
 			{
-				ReadWord();
-				ReadWord();
+				std::uint32_t id = ReadWord();
+				std::uint32_t value = ReadWord();
+				state.Print(" %{} {}", id, value);
 				break;
 			}
 
 			case SpirvOperandKind::PairIdRefIdRef:
 			{
-				ReadWord();
-				ReadWord();
+				std::uint32_t firstId = ReadWord();
+				std::uint32_t secondId = ReadWord();
+				state.Print(" %{} %{}", firstId, secondId);
 				break;
 			}
 
-			/*case SpirvOperandKind::LiteralContextDependentNumber:
-			{
-				throw std::runtime_error("not yet implemented");
-			}*/
-
 			default:
 				break;
 		}
 	}
+
+	void SpirvPrinter::PrintOperands(const SpirvOperand* operands, std::size_t minOperandCount, const std::uint32_t* endPtr)
+	{
+		std::size_t currentOperand = 0;
+		while (GetCurrentPtr() < endPtr)
+		{
+			const SpirvOperand* operand = &operands[currentOperand];
+
+			if (operand->kind != SpirvOperandKind::IdResult)
+				PrintOperand(operand);
+			else
+				ReadWord(); //< printed before the instruction
+
+			if (currentOperand < minOperandCount - 1)
+				currentOperand++;
+		}
+	}
+
+	SpirvPrinter::OutputSink::~OutputSink() = default;
 }
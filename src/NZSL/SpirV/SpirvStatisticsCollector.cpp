@@ -0,0 +1,127 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvStatisticsCollector.hpp>
+#include <Nazara/Utils/CallOnExit.hpp>
+#include <NZSL/SpirV/SpirvData.hpp>
+#include <string_view>
+#include <unordered_map>
+
+namespace nzsl
+{
+	struct SpirvStatisticsCollector::State
+	{
+		std::unordered_map<std::uint32_t, std::string> names;
+		Statistics statistics;
+		bool isInsideFunction = false;
+	};
+
+	auto SpirvStatisticsCollector::Collect(const std::uint32_t* codepoints, std::size_t count) -> Statistics
+	{
+		State state;
+		state.statistics.wordCount = count;
+
+		m_currentState = &state;
+		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
+
+		Decode(codepoints, count);
+
+		// OpName usually appears before the function it names but it's not required
+		for (FunctionStatistics& function : state.statistics.functions)
+		{
+			if (auto it = state.names.find(function.id); it != state.names.end())
+				function.name = it->second;
+		}
+
+		return std::move(state.statistics);
+	}
+
+	bool SpirvStatisticsCollector::HandleHeader(const SpirvHeader& header)
+	{
+		m_currentState->statistics.idBound = header.bound;
+		m_currentState->statistics.versionNumber = header.versionNumber;
+
+		return true;
+	}
+
+	bool SpirvStatisticsCollector::HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount)
+	{
+		State& state = *m_currentState;
+
+		switch (instruction.op)
+		{
+			case SpirvOp::OpFunction:
+			{
+				ReadWord(); //< result type
+
+				FunctionStatistics& function = state.statistics.functions.emplace_back();
+				function.id = ReadWord();
+
+				state.isInsideFunction = true;
+				break;
+			}
+
+			case SpirvOp::OpName:
+			{
+				std::uint32_t targetId = ReadWord();
+				state.names[targetId] = ReadString();
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		Count(state.statistics.module, instruction, wordCount);
+		if (state.isInsideFunction)
+			Count(state.statistics.functions.back().counters, instruction, wordCount);
+
+		if (instruction.op == SpirvOp::OpFunctionEnd)
+			state.isInsideFunction = false;
+
+		return true;
+	}
+
+	void SpirvStatisticsCollector::Count(Counters& counters, const SpirvInstruction& instruction, std::uint32_t wordCount)
+	{
+		counters.opCounts[instruction.op]++;
+		counters.instructionCount++;
+		counters.wordCount += wordCount;
+
+		switch (instruction.op)
+		{
+			case SpirvOp::OpAccessChain:
+			case SpirvOp::OpInBoundsAccessChain:
+			case SpirvOp::OpPtrAccessChain:
+			case SpirvOp::OpInBoundsPtrAccessChain:
+				counters.accessChainCount++;
+				break;
+
+			case SpirvOp::OpBranch:
+			case SpirvOp::OpBranchConditional:
+			case SpirvOp::OpSwitch:
+				counters.branchCount++;
+				break;
+
+			case SpirvOp::OpLoad:
+				counters.loadCount++;
+				break;
+
+			case SpirvOp::OpStore:
+				counters.storeCount++;
+				break;
+
+			default:
+			{
+				std::string_view name = instruction.name;
+				if (name.substr(0, 6) == "OpType")
+					counters.typeCount++;
+				else if (name.substr(0, 10) == "OpConstant" || name.substr(0, 14) == "OpSpecConstant")
+					counters.constantCount++;
+
+				break;
+			}
+		}
+	}
+}
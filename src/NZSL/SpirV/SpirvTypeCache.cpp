@@ -0,0 +1,41 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvTypeCache.hpp>
+#include <mutex>
+
+namespace nzsl
+{
+	void SpirvTypeCache::Clear()
+	{
+		std::unique_lock lock(m_mutex);
+		m_structs.clear();
+	}
+
+	std::size_t SpirvTypeCache::GetStructCount() const
+	{
+		std::shared_lock lock(m_mutex);
+		return m_structs.size();
+	}
+
+	auto SpirvTypeCache::FindStruct(const std::string& key) const -> SpirvConstantCache::TypePtr
+	{
+		std::shared_lock lock(m_mutex);
+
+		auto it = m_structs.find(key);
+		if (it == m_structs.end())
+			return nullptr;
+
+		return it->second;
+	}
+
+	auto SpirvTypeCache::RegisterStruct(std::string key, SpirvConstantCache::TypePtr type) -> SpirvConstantCache::TypePtr
+	{
+		std::unique_lock lock(m_mutex);
+
+		// Another thread may have registered the same struct in the meantime, keep the first one so the type is shared
+		auto it = m_structs.try_emplace(std::move(key), std::move(type)).first;
+		return it->second;
+	}
+}
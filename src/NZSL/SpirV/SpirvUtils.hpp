@@ -0,0 +1,170 @@
+// Copyright (C) 2022 Jérôme "Lynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVUTILS_HPP
+#define NZSL_SPIRV_SPIRVUTILS_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvData.hpp>
+#include <cstdint>
+
+namespace nzsl
+{
+	// Logical layout of a SPIR-V module (every instruction between OpFunction and OpFunctionEnd belongs to the Function section, which GetLogicalSection cannot know)
+	enum class SpirvLogicalSection
+	{
+		Capability,
+		Extension,
+		ExtInstImport,
+		MemoryModel,
+		EntryPoint,
+		ExecutionMode,
+		DebugSource,
+		DebugName,
+		DebugModuleProcessed,
+		Annotation,
+		Global,
+		Function
+	};
+
+	inline SpirvLogicalSection GetLogicalSection(SpirvOp op)
+	{
+		switch (op)
+		{
+			case SpirvOp::OpCapability:
+				return SpirvLogicalSection::Capability;
+
+			case SpirvOp::OpExtension:
+				return SpirvLogicalSection::Extension;
+
+			case SpirvOp::OpExtInstImport:
+				return SpirvLogicalSection::ExtInstImport;
+
+			case SpirvOp::OpMemoryModel:
+				return SpirvLogicalSection::MemoryModel;
+
+			case SpirvOp::OpEntryPoint:
+				return SpirvLogicalSection::EntryPoint;
+
+			case SpirvOp::OpExecutionMode:
+			case SpirvOp::OpExecutionModeId:
+				return SpirvLogicalSection::ExecutionMode;
+
+			case SpirvOp::OpString:
+			case SpirvOp::OpSource:
+			case SpirvOp::OpSourceContinued:
+			case SpirvOp::OpSourceExtension:
+				return SpirvLogicalSection::DebugSource;
+
+			case SpirvOp::OpName:
+			case SpirvOp::OpMemberName:
+				return SpirvLogicalSection::DebugName;
+
+			case SpirvOp::OpModuleProcessed:
+				return SpirvLogicalSection::DebugModuleProcessed;
+
+			case SpirvOp::OpDecorate:
+			case SpirvOp::OpDecorateId:
+			case SpirvOp::OpDecorateString:
+			case SpirvOp::OpDecorationGroup:
+			case SpirvOp::OpGroupDecorate:
+			case SpirvOp::OpGroupMemberDecorate:
+			case SpirvOp::OpMemberDecorate:
+			case SpirvOp::OpMemberDecorateString:
+				return SpirvLogicalSection::Annotation;
+
+			default:
+				return SpirvLogicalSection::Global;
+		}
+	}
+
+	// Calls callback on every id operand of an instruction (including its result and result type ids)
+	template<typename Word, typename F>
+	void ForEachIdOperand(const SpirvInstruction& instructionData, Word* operands, std::size_t operandCount, F&& callback)
+	{
+		if (instructionData.minOperandCount == 0)
+			return;
+
+		std::size_t operandIndex = 0;
+		std::size_t wordIndex = 0;
+		while (wordIndex < operandCount)
+		{
+			switch (instructionData.operands[operandIndex].kind)
+			{
+				case SpirvOperandKind::IdMemorySemantics:
+				case SpirvOperandKind::IdRef:
+				case SpirvOperandKind::IdResult:
+				case SpirvOperandKind::IdResultType:
+				case SpirvOperandKind::IdScope:
+					callback(operands[wordIndex++]);
+					break;
+
+				case SpirvOperandKind::ImageOperands:
+				{
+					// Every word following the image operands mask is an id
+					for (wordIndex++; wordIndex < operandCount; ++wordIndex)
+						callback(operands[wordIndex]);
+
+					break;
+				}
+
+				case SpirvOperandKind::LiteralString:
+				{
+					// Strings are null-terminated and the terminator is in the last word
+					while (wordIndex < operandCount)
+					{
+						std::uint32_t word = operands[wordIndex++];
+						if ((word & 0x000000FF) == 0 || (word & 0x0000FF00) == 0 || (word & 0x00FF0000) == 0 || (word & 0xFF000000) == 0)
+							break;
+					}
+					break;
+				}
+
+				case SpirvOperandKind::PairIdRefIdRef:
+					callback(operands[wordIndex]);
+					if (wordIndex + 1 < operandCount)
+						callback(operands[wordIndex + 1]);
+
+					wordIndex += 2;
+					break;
+
+				case SpirvOperandKind::PairIdRefLiteralInteger:
+					callback(operands[wordIndex]);
+					wordIndex += 2;
+					break;
+
+				case SpirvOperandKind::PairLiteralIntegerIdRef:
+					if (wordIndex + 1 < operandCount)
+						callback(operands[wordIndex + 1]);
+
+					wordIndex += 2;
+					break;
+
+				default:
+					wordIndex++;
+					break;
+			}
+
+			// The last operand kind repeats
+			if (operandIndex < instructionData.minOperandCount - 1)
+				operandIndex++;
+		}
+	}
+
+	// Returns the result id of an instruction (or 0 if it has none)
+	inline std::uint32_t GetResultId(const SpirvInstruction& instructionData, const std::uint32_t* operands, std::size_t operandCount)
+	{
+		for (std::size_t i = 0; i < 2 && i < instructionData.minOperandCount && i < operandCount; ++i)
+		{
+			if (instructionData.operands[i].kind == SpirvOperandKind::IdResult)
+				return operands[i];
+		}
+
+		return 0;
+	}
+}
+
+#endif // NZSL_SPIRV_SPIRVUTILS_HPP
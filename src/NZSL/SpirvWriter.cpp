@@ -3,12 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <NZSL/SpirvWriter.hpp>
+#include <Nazara/Utils/Algorithm.hpp>
 #include <Nazara/Utils/CallOnExit.hpp>
 #include <Nazara/Utils/StackVector.hpp>
 #include <NZSL/Enums.hpp>
 #include <NZSL/Ast/Cloner.hpp>
-#include <NZSL/Ast/ConstantPropagationVisitor.hpp>
-#include <NZSL/Ast/EliminateUnusedPassVisitor.hpp>
+#include <NZSL/Ast/OptimizationPipeline.hpp>
 #include <NZSL/Ast/RecursiveVisitor.hpp>
 #include <NZSL/Ast/SanitizeVisitor.hpp>
 #include <NZSL/Lang/LangData.hpp>
@@ -16,15 +16,24 @@
 #include <NZSL/SpirV/SpirvBlock.hpp>
 #include <NZSL/SpirV/SpirvConstantCache.hpp>
 #include <NZSL/SpirV/SpirvData.hpp>
+#include <NZSL/SpirV/SpirvOptimizer.hpp>
 #include <NZSL/SpirV/SpirvSection.hpp>
+#include <NZSL/SpirV/SpirvUtils.hpp>
 #include <fmt/format.h>
 #include <frozen/unordered_map.h>
 #include <tsl/ordered_map.h>
 #include <tsl/ordered_set.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <map>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
+#include <unordered_set>
+#include <variant>
 #include <vector>
 
 namespace nzsl
@@ -45,14 +54,20 @@ namespace nzsl
 		};
 
 		constexpr auto s_spirvBuiltinMapping = frozen::make_unordered_map<Ast::BuiltinEntry, SpirvBuiltin>({
-			{ Ast::BuiltinEntry::BaseInstance,   { SpirvBuiltIn::BaseInstance,  SpirvCapability::DrawParameters, SpirvVersion{ 1, 3 } } },
-			{ Ast::BuiltinEntry::BaseVertex,     { SpirvBuiltIn::BaseVertex,    SpirvCapability::DrawParameters, SpirvVersion{ 1, 3 } } },
-			{ Ast::BuiltinEntry::DrawIndex,      { SpirvBuiltIn::DrawIndex,     SpirvCapability::DrawParameters, SpirvVersion{ 1, 3 } } },
-			{ Ast::BuiltinEntry::FragCoord,      { SpirvBuiltIn::FragCoord,     SpirvCapability::Shader,         SpirvVersion{ 1, 0 } } },
-			{ Ast::BuiltinEntry::FragDepth,      { SpirvBuiltIn::FragDepth,     SpirvCapability::Shader,         SpirvVersion{ 1, 0 } } },
-			{ Ast::BuiltinEntry::InstanceIndex,  { SpirvBuiltIn::InstanceIndex, SpirvCapability::Shader,         SpirvVersion{ 1, 0 } } },
-			{ Ast::BuiltinEntry::VertexIndex,    { SpirvBuiltIn::VertexIndex,   SpirvCapability::Shader,         SpirvVersion{ 1, 0 } } },
-			{ Ast::BuiltinEntry::VertexPosition, { SpirvBuiltIn::Position,      SpirvCapability::Shader,         SpirvVersion{ 1, 0 } } }
+			{ Ast::BuiltinEntry::BaseInstance,              { SpirvBuiltIn::BaseInstance,              SpirvCapability::DrawParameters,  SpirvVersion{ 1, 3 } } },
+			{ Ast::BuiltinEntry::BaseVertex,                { SpirvBuiltIn::BaseVertex,                SpirvCapability::DrawParameters,  SpirvVersion{ 1, 3 } } },
+			{ Ast::BuiltinEntry::DrawIndex,                 { SpirvBuiltIn::DrawIndex,                 SpirvCapability::DrawParameters,  SpirvVersion{ 1, 3 } } },
+			{ Ast::BuiltinEntry::FragCoord,                 { SpirvBuiltIn::FragCoord,                 SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::FragDepth,                 { SpirvBuiltIn::FragDepth,                 SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::GlobalInvocationId,        { SpirvBuiltIn::GlobalInvocationId,        SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::InstanceIndex,             { SpirvBuiltIn::InstanceIndex,             SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::LocalInvocationId,         { SpirvBuiltIn::LocalInvocationId,         SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::LocalInvocationIndex,      { SpirvBuiltIn::LocalInvocationIndex,      SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::SubgroupLocalInvocationId, { SpirvBuiltIn::SubgroupLocalInvocationId, SpirvCapability::GroupNonUniform, SpirvVersion{ 1, 3 } } },
+			{ Ast::BuiltinEntry::SubgroupSize,              { SpirvBuiltIn::SubgroupSize,              SpirvCapability::GroupNonUniform, SpirvVersion{ 1, 3 } } },
+			{ Ast::BuiltinEntry::VertexIndex,               { SpirvBuiltIn::VertexIndex,               SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::VertexPosition,            { SpirvBuiltIn::Position,                  SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } },
+			{ Ast::BuiltinEntry::WorkgroupId,               { SpirvBuiltIn::WorkgroupId,               SpirvCapability::Shader,          SpirvVersion{ 1, 0 } } }
 		});
 
 		template<typename T>
@@ -60,6 +75,206 @@ namespace nzsl
 
 		template<typename T>
 		struct IsVector<std::vector<T>> : std::bool_constant<true> {};
+
+		class VectorOutputSink : public SpirvWriter::OutputSink
+		{
+			public:
+				std::uint32_t* Allocate(std::size_t wordCount) override
+				{
+					words.resize(wordCount);
+					return words.data();
+				}
+
+				std::vector<std::uint32_t> words;
+		};
+
+		// Lets the optimizer write the optimized module directly in the writer output
+		class OptimizerOutputSink : public SpirvOptimizer::OutputSink
+		{
+			public:
+				OptimizerOutputSink(SpirvWriter::OutputSink& output) :
+				m_output(output)
+				{
+				}
+
+				std::uint32_t* Allocate(std::size_t wordCount) override
+				{
+					outputWords = m_output.Allocate(wordCount);
+					outputWordCount = wordCount;
+
+					return outputWords;
+				}
+
+				std::uint32_t* outputWords = nullptr;
+				std::size_t outputWordCount = 0;
+
+			private:
+				SpirvWriter::OutputSink& m_output;
+		};
+
+		// Function bodies generated on worker threads use placeholder ids (starting at the first id available after global declarations)
+		// id allocations and new types/constants are recorded, to be replayed in function order so ids match a serial generation
+		struct FunctionGenerationContext
+		{
+			struct Registration
+			{
+				std::variant<SpirvConstantCache::Constant, SpirvConstantCache::Type> value;
+				std::uint32_t placeholderId;
+			};
+
+			using Event = std::variant<std::uint32_t /*allocated placeholder id*/, Registration>;
+
+			FunctionGenerationContext(const SpirvConstantCache& cache, std::uint32_t firstPlaceholderId) :
+			nextPlaceholderId(firstPlaceholderId),
+			localCache(nextPlaceholderId),
+			sharedCache(cache)
+			{
+			}
+
+			std::uint32_t AllocateId()
+			{
+				std::uint32_t placeholderId = nextPlaceholderId++;
+				events.emplace_back(placeholderId);
+
+				return placeholderId;
+			}
+
+			template<typename T>
+			std::uint32_t GetId(const T& value)
+			{
+				if (std::optional<std::uint32_t> id = sharedCache.FindId(value))
+					return *id;
+
+				return Record(value, localCache.GetId(value));
+			}
+
+			template<typename T>
+			std::uint32_t Register(const T& value)
+			{
+				if (std::optional<std::uint32_t> id = sharedCache.FindId(value))
+					return *id;
+
+				return Record(value, localCache.Register(value));
+			}
+
+			template<typename T>
+			std::uint32_t Record(const T& value, std::uint32_t placeholderId)
+			{
+				// Dependencies get a placeholder id without being recorded, until they're used by the function
+				if (recordedIds.insert(placeholderId).second)
+					events.emplace_back(Registration{ value, placeholderId });
+
+				return placeholderId;
+			}
+
+			std::exception_ptr exception;
+			std::uint32_t nextPlaceholderId;
+			std::unordered_set<std::uint32_t> recordedIds;
+			std::vector<Event> events;
+			SpirvAstVisitor::FunctionCode code;
+			SpirvConstantCache localCache; //< init after nextPlaceholderId
+			const SpirvConstantCache& sharedCache; //< not modified while functions are generated
+		};
+
+		thread_local FunctionGenerationContext* s_functionContext = nullptr;
+
+		template<typename T>
+		std::uint32_t GetCachedId(SpirvConstantCache& cache, const T& value)
+		{
+			if (s_functionContext)
+				return s_functionContext->GetId(value);
+
+			return cache.GetId(value);
+		}
+
+		template<typename T>
+		std::uint32_t RegisterCached(SpirvConstantCache& cache, T value)
+		{
+			if (s_functionContext)
+				return s_functionContext->Register(value);
+
+			return cache.Register(std::move(value));
+		}
+
+		// Embeds source code with OpSource, continued by OpSourceContinued since instructions are limited to 65535 words
+		void AppendSource(SpirvSection& section, std::uint32_t shaderLangVersion, std::uint32_t fileId, std::string_view source)
+		{
+			auto ExtractChunk = [&](std::size_t operandWordCount)
+			{
+				std::size_t maxSize = (0xFFFF - 1 - operandWordCount) * sizeof(std::uint32_t) - 1; //< opcode, other operands and null terminator
+				std::size_t size = std::min(maxSize, source.size());
+
+				// Don't split UTF-8 sequences
+				while (size < source.size() && size > 0 && (static_cast<unsigned char>(source[size]) & 0xC0) == 0x80)
+					size--;
+
+				std::string_view chunk = source.substr(0, size);
+				source.remove_prefix(size);
+
+				return chunk;
+			};
+
+			section.Append(SpirvOp::OpSource, SpirvSourceLanguage::Unknown, shaderLangVersion, fileId, ExtractChunk(3));
+			while (!source.empty())
+				section.Append(SpirvOp::OpSourceContinued, ExtractChunk(0));
+		}
+
+		// Renumbers result ids in order of appearance so the bound is minimal
+		void CompactIds(std::uint32_t* words, std::size_t wordCount)
+		{
+			assert(wordCount >= 5);
+
+			std::vector<std::uint32_t> newIds(words[3], 0); //< header bound
+			std::uint32_t nextResultId = 1;
+
+			const std::uint32_t* end = words + wordCount;
+			for (std::uint32_t* instructionWords = words + 5; instructionWords < end;)
+			{
+				std::uint32_t instructionWordCount = *instructionWords >> 16;
+				assert(instructionWordCount > 0);
+
+				const SpirvInstruction* instructionData = GetSpirvInstruction(static_cast<std::uint16_t>(*instructionWords & 0xFFFF));
+				assert(instructionData);
+
+				ForEachIdOperand(*instructionData, instructionWords + 1, instructionWordCount - 1, [&](std::uint32_t& id)
+				{
+					assert(id < newIds.size());
+
+					std::uint32_t& newId = newIds[id];
+					if (newId == 0)
+						newId = nextResultId++;
+
+					id = newId;
+				});
+
+				instructionWords += instructionWordCount;
+			}
+
+			words[3] = nextResultId;
+		}
+
+		void RemapPlaceholderIds(std::uint32_t* words, const std::uint32_t* end, std::uint32_t firstPlaceholderId, const std::vector<std::uint32_t>& ids)
+		{
+			while (words < end)
+			{
+				std::uint32_t wordCount = *words >> 16;
+				assert(wordCount > 0);
+
+				const SpirvInstruction* instructionData = GetSpirvInstruction(static_cast<std::uint16_t>(*words & 0xFFFF));
+				assert(instructionData);
+
+				ForEachIdOperand(*instructionData, words + 1, wordCount - 1, [&](std::uint32_t& id)
+				{
+					if (id >= firstPlaceholderId)
+					{
+						assert(id - firstPlaceholderId < ids.size());
+						id = ids[id - firstPlaceholderId];
+					}
+				});
+
+				words += wordCount;
+			}
+		}
 	}
 
 	class SpirvWriter::PreVisitor : public Ast::RecursiveVisitor
@@ -70,15 +285,23 @@ namespace nzsl
 				std::uint32_t bindingIndex;
 				std::uint32_t descriptorSet;
 				std::uint32_t pointerId;
+				std::optional<SpirvCapability> nonUniformIndexingCapability; //< set for descriptor arrays
+				bool isNonReadable = false;
+				bool isNonWritable = false;
+				bool isPushConstant = false;
+				bool isRestrict = false;
+				bool isWorkgroupShared = false;
 			};
 
 			using BuiltinDecoration = tsl::ordered_map<std::uint32_t, SpirvBuiltIn>;
 			using ConstantVariables = std::unordered_map<std::size_t /*constIndex*/, SpirvVariable /*variable*/>;
 			using LocationDecoration = tsl::ordered_map<std::uint32_t, std::uint32_t>;
+			using RelaxedPrecisionDecoration = tsl::ordered_set<std::uint32_t>;
 			using ExtInstList = tsl::ordered_set<std::string>;
 			using ExtVarContainer = std::unordered_map<std::size_t /*varIndex*/, UniformVar>;
 			using FunctionContainer = tsl::ordered_map<std::size_t, SpirvAstVisitor::FuncData>;
 			using LocalContainer = tsl::ordered_set<Ast::ExpressionType>;
+			using SourceFileList = tsl::ordered_set<std::string>;
 			using StructContainer = std::vector<Ast::StructDescription*>;
 
 			PreVisitor(const SpirvWriter& writer, SpirvConstantCache& constantCache) :
@@ -91,6 +314,29 @@ namespace nzsl
 					return *declaredStructs[structIndex];
 				});
 
+				m_constantCache.SetCapabilityCallback([this](SpirvCapability capability)
+				{
+					spirvCapabilities.insert(capability);
+
+					switch (capability)
+					{
+						case SpirvCapability::StorageBuffer16BitAccess:
+						case SpirvCapability::StorageInputOutput16:
+						case SpirvCapability::StoragePushConstant16:
+						case SpirvCapability::UniformAndStorageBuffer16BitAccess:
+						{
+							// 16-bit storage is core since SPIR-V 1.3
+							if (!m_writer.IsVersionGreaterOrEqual(1, 3))
+								spirvExtensions.insert("SPV_KHR_16bit_storage");
+
+							break;
+						}
+
+						default:
+							break;
+					}
+				});
+
 				spirvCapabilities.insert(SpirvCapability::Shader);
 			}
 
@@ -98,6 +344,14 @@ namespace nzsl
 			{
 				RecursiveVisitor::Visit(node);
 
+				// Indexing a descriptor array with a non-uniform index
+				if (node.expr->GetType() == Ast::NodeType::VariableValueExpression && IsNonUniformIndex(node))
+				{
+					auto it = extVars.find(static_cast<Ast::VariableValueExpression&>(*node.expr).variableId);
+					if (it != extVars.end() && it->second.nonUniformIndexingCapability)
+						RequireDescriptorIndexing(*it->second.nonUniformIndexingCapability);
+				}
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
@@ -105,6 +359,20 @@ namespace nzsl
 			{
 				RecursiveVisitor::Visit(node);
 
+				// vector << scalar splats the shift amount to a vector of its own type
+				if (node.op == Ast::BinaryType::ShiftLeft || node.op == Ast::BinaryType::ShiftRight)
+				{
+					const Ast::ExpressionType& leftType = *GetExpressionType(*node.left);
+					const Ast::ExpressionType& rightType = *GetExpressionType(*node.right);
+					if (IsVectorType(leftType) && IsPrimitiveType(rightType))
+						m_constantCache.Register(*m_constantCache.BuildType(Ast::VectorType{ std::get<Ast::VectorType>(leftType).componentCount, std::get<Ast::PrimitiveType>(rightType) }));
+				}
+
+				// Comparisons of 16-bit values have a boolean result, check operands as well
+				Require16BitArithmetic(*GetExpressionType(*node.left));
+				Require16BitArithmetic(*GetExpressionType(*node.right));
+				Require16BitArithmetic(node.cachedExpressionType.value());
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
@@ -131,6 +399,14 @@ namespace nzsl
 			{
 				RecursiveVisitor::Visit(node);
 
+				// Converting between 16 and 32-bit values of the same kind is allowed by the storage capabilities alone
+				if (!IsWidthConversion(node))
+				{
+					Require16BitArithmetic(node.cachedExpressionType.value());
+					for (const auto& expr : node.expressions)
+						Require16BitArithmetic(*GetExpressionType(*expr));
+				}
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
@@ -204,14 +480,65 @@ namespace nzsl
 					variable.debugName = extVar.name;
 
 					const Ast::ExpressionType& extVarType = extVar.type.GetResultingValue();
+					bool isWorkgroupShared = extVar.isWorkgroupShared.HasValue() && extVar.isWorkgroupShared.GetResultingValue();
 
-					if (Ast::IsStorageType(extVarType) || Ast::IsUniformType(extVarType))
+					if (isWorkgroupShared)
+					{
+						variable.storageClass = SpirvStorageClass::Workgroup;
+						variable.type = m_constantCache.BuildPointerType(extVarType, variable.storageClass);
+
+						assert(extVar.varIndex);
+						UniformVar& uniformVar = extVars[*extVar.varIndex];
+						uniformVar.pointerId = m_constantCache.Register(variable);
+						uniformVar.bindingIndex = 0;
+						uniformVar.descriptorSet = 0;
+						uniformVar.isWorkgroupShared = true;
+						continue;
+					}
+
+					if (Ast::IsPushConstantType(extVarType))
+					{
+						const auto& structType = std::get<Ast::PushConstantType>(extVarType).containedType;
+						assert(structType.structIndex < declaredStructs.size());
+
+						variable.storageClass = SpirvStorageClass::PushConstant;
+
+						const auto& type = m_constantCache.BuildType(*declaredStructs[structType.structIndex], { SpirvDecoration::Block });
+						variable.type = m_constantCache.BuildPointerType(type, variable.storageClass);
+
+						assert(extVar.varIndex);
+						UniformVar& uniformVar = extVars[*extVar.varIndex];
+						uniformVar.pointerId = m_constantCache.Register(variable);
+						uniformVar.bindingIndex = 0;
+						uniformVar.descriptorSet = 0;
+						uniformVar.isPushConstant = true;
+						continue;
+					}
+
+					// Arrays of samplers, images and buffers (descriptor arrays) are declared as arrays of their element
+					const Ast::ExpressionType* descriptorType = &extVarType;
+					std::optional<std::uint32_t> descriptorArrayLength; //< 0 for runtime arrays
+					if (Ast::IsArrayType(extVarType))
+					{
+						const auto& arrayType = std::get<Ast::ArrayType>(extVarType);
+						descriptorType = &arrayType.containedType->type;
+						descriptorArrayLength = arrayType.length;
+					}
+					else if (Ast::IsDynArrayType(extVarType))
+					{
+						descriptorType = &std::get<Ast::DynArrayType>(extVarType).containedType->type;
+						descriptorArrayLength = 0;
+					}
+
+					SpirvConstantCache::TypePtr descriptorTypePtr;
+					std::optional<SpirvCapability> nonUniformIndexingCapability;
+					if (Ast::IsStorageType(*descriptorType) || Ast::IsUniformType(*descriptorType))
 					{
 						SpirvDecoration decoration;
 						std::size_t structIndex;
-						if (Ast::IsStorageType(extVarType))
+						if (Ast::IsStorageType(*descriptorType))
 						{
-							const auto& storageType = std::get<Ast::StorageType>(extVarType);
+							const auto& storageType = std::get<Ast::StorageType>(*descriptorType);
 							const auto& structType = storageType.containedType;
 							assert(structType.structIndex < declaredStructs.size());
 
@@ -227,29 +554,69 @@ namespace nzsl
 							}
 
 							structIndex = structType.structIndex;
+							nonUniformIndexingCapability = SpirvCapability::StorageBufferArrayNonUniformIndexing;
 						}
 						else
 						{
-							const auto& uniformType = std::get<Ast::UniformType>(extVarType);
+							const auto& uniformType = std::get<Ast::UniformType>(*descriptorType);
 							const auto& structType = uniformType.containedType;
 							assert(structType.structIndex < declaredStructs.size());
 
 							decoration = SpirvDecoration::Block;
 							structIndex = structType.structIndex;
 							variable.storageClass = SpirvStorageClass::Uniform;
+							nonUniformIndexingCapability = SpirvCapability::UniformBufferArrayNonUniformIndexing;
 						}
 
-						const auto& type = m_constantCache.BuildType(*declaredStructs[structIndex], { decoration });
-						variable.type = m_constantCache.BuildPointerType(type, variable.storageClass);
+						descriptorTypePtr = m_constantCache.BuildType(*declaredStructs[structIndex], { decoration });
 					}
-					else if (Ast::IsSamplerType(extVarType))
+					else if (Ast::IsSamplerType(*descriptorType))
 					{
 						variable.storageClass = SpirvStorageClass::UniformConstant;
-						variable.type = m_constantCache.BuildPointerType(extVarType, variable.storageClass);
+						descriptorTypePtr = m_constantCache.BuildType(*descriptorType);
+						nonUniformIndexingCapability = SpirvCapability::SampledImageArrayNonUniformIndexing;
+					}
+					else if (Ast::IsStorageImageType(*descriptorType))
+					{
+						variable.storageClass = SpirvStorageClass::UniformConstant;
+						descriptorTypePtr = m_constantCache.BuildType(*descriptorType);
+						nonUniformIndexingCapability = SpirvCapability::StorageImageArrayNonUniformIndexing;
+
+						// Formats outside of the base set supported by the Shader capability
+						switch (std::get<Ast::StorageImageType>(*descriptorType).format)
+						{
+							case ImageFormat::R8:
+							case ImageFormat::R16f:
+							case ImageFormat::Rg8:
+							case ImageFormat::Rg16f:
+							case ImageFormat::Rg32f:
+								spirvCapabilities.insert(SpirvCapability::StorageImageExtendedFormats);
+								break;
+
+							default:
+								break;
+						}
 					}
 					else
 						throw std::runtime_error("unsupported type used in external block (SPIR-V doesn't allow primitive types as uniforms)");
 
+					if (descriptorArrayLength)
+					{
+						if (*descriptorArrayLength == 0)
+							RequireDescriptorIndexing(SpirvCapability::RuntimeDescriptorArray);
+
+						descriptorTypePtr = std::make_shared<SpirvConstantCache::Type>(SpirvConstantCache::Array{
+							descriptorTypePtr,
+							(*descriptorArrayLength > 0) ? m_constantCache.BuildConstant(*descriptorArrayLength) : nullptr,
+							std::nullopt
+						});
+
+						// The AST type of the variable is used to load the whole array
+						m_constantCache.Register(*m_constantCache.BuildType(extVarType));
+					}
+
+					variable.type = m_constantCache.BuildPointerType(descriptorTypePtr, variable.storageClass);
+
 					assert(extVar.bindingIndex.IsResultingValue());
 
 					assert(extVar.varIndex);
@@ -257,6 +624,20 @@ namespace nzsl
 					uniformVar.pointerId = m_constantCache.Register(variable);
 					uniformVar.bindingIndex = extVar.bindingIndex.GetResultingValue();
 					uniformVar.descriptorSet = (extVar.bindingSet.HasValue()) ? extVar.bindingSet.GetResultingValue() : 0;
+
+					if (descriptorArrayLength)
+						uniformVar.nonUniformIndexingCapability = nonUniformIndexingCapability;
+
+					if (extVar.accessPolicy.HasValue())
+					{
+						uniformVar.isNonReadable = extVar.accessPolicy.GetResultingValue() == Ast::AccessPolicy::Write;
+						uniformVar.isNonWritable = extVar.accessPolicy.GetResultingValue() == Ast::AccessPolicy::Read;
+					}
+
+					uniformVar.isRestrict = extVar.isRestrict.HasValue() && extVar.isRestrict.GetResultingValue();
+
+					if (extVar.precision.IsResultingValue() && extVar.precision.GetResultingValue() == Ast::Precision::Medium)
+						relaxedPrecisionDecorations.insert(uniformVar.pointerId);
 				}
 			}
 
@@ -266,6 +647,12 @@ namespace nzsl
 				if (node.entryStage.HasValue())
 					entryPointType = node.entryStage.GetResultingValue();
 
+				bool isExported = node.isExported.HasValue() && node.isExported.GetResultingValue();
+
+				// Other functions of imported modules can only be called by exported ones, which won't be generated
+				if (isImportedModule && m_writer.m_environment.importModuleFunctions && !isExported)
+					return;
+
 				assert(node.funcIndex);
 				std::size_t funcIndex = *node.funcIndex;
 
@@ -273,6 +660,28 @@ namespace nzsl
 				funcData.name = node.name;
 				funcData.funcIndex = funcIndex;
 
+				if (isExported && !entryPointType)
+				{
+					if (isImportedModule)
+					{
+						if (m_writer.m_environment.importModuleFunctions)
+							funcData.linkageType = SpirvLinkageType::Import;
+					}
+					else if (m_writer.m_environment.exportFunctions)
+						funcData.linkageType = SpirvLinkageType::Export;
+
+					if (funcData.linkageType)
+					{
+						// Functions are identified by their module name
+						funcData.linkageName = (!moduleName.empty()) ? fmt::format("{}.{}", moduleName, node.name) : node.name;
+						spirvCapabilities.insert(SpirvCapability::Linkage);
+					}
+				}
+
+				// Imported functions have no body to attribute lines to
+				if (m_writer.m_environment.debugLineInfo && funcData.linkageType != SpirvLinkageType::Import)
+					sourceFiles.insert((node.sourceLocation.file) ? *node.sourceLocation.file : std::string{});
+
 				if (!entryPointType)
 				{
 					std::vector<Ast::ExpressionType> parameterTypes;
@@ -326,6 +735,10 @@ namespace nzsl
 						}
 					}
 
+					std::optional<Vector3u32> workgroupSize;
+					if (node.workgroupSize[0].HasValue())
+						workgroupSize = Vector3u32(node.workgroupSize[0].GetResultingValue(), node.workgroupSize[1].GetResultingValue(), node.workgroupSize[2].GetResultingValue());
+
 					funcData.returnTypeId = m_constantCache.Register(*m_constantCache.BuildType(Ast::NoType{}));
 					funcData.funcTypeId = m_constantCache.Register(*m_constantCache.BuildFunctionType(Ast::NoType{}, {}));
 
@@ -404,10 +817,14 @@ namespace nzsl
 						outputStructId,
 						std::move(inputs),
 						std::move(outputs),
-						std::move(executionModes)
+						std::move(executionModes),
+						workgroupSize
 					};
 				}
 
+				if (funcData.linkageType == SpirvLinkageType::Import)
+					return;
+
 				m_funcIndex = funcIndex;
 				RecursiveVisitor::Visit(node);
 				m_funcIndex.reset();
@@ -459,24 +876,138 @@ namespace nzsl
 					// Require GLSL.std.450
 					case Ast::IntrinsicType::CrossProduct:
 					case Ast::IntrinsicType::Exp:
+					case Ast::IntrinsicType::FirstBitHigh:
+					case Ast::IntrinsicType::FirstBitLow:
 					case Ast::IntrinsicType::Inverse:
 					case Ast::IntrinsicType::Length:
 					case Ast::IntrinsicType::Max:
 					case Ast::IntrinsicType::Min:
 					case Ast::IntrinsicType::Normalize:
+					case Ast::IntrinsicType::PackHalf2x16:
+					case Ast::IntrinsicType::PackUnorm4x8:
 					case Ast::IntrinsicType::Pow:
 					case Ast::IntrinsicType::Reflect:
+					case Ast::IntrinsicType::UnpackHalf2x16:
+					case Ast::IntrinsicType::UnpackUnorm4x8:
 						extInsts.emplace("GLSL.std.450");
 						break;
 
 					// Part of SPIR-V core
 					case Ast::IntrinsicType::ArraySize:
+					case Ast::IntrinsicType::BitCount:
+					case Ast::IntrinsicType::BitFieldExtract:
+					case Ast::IntrinsicType::BitFieldInsert:
 					case Ast::IntrinsicType::DotProduct:
 					case Ast::IntrinsicType::SampleTexture:
+					case Ast::IntrinsicType::SampleTextureGrad:
+					case Ast::IntrinsicType::SampleTextureLod:
+					case Ast::IntrinsicType::TextureFetch:
 					case Ast::IntrinsicType::Transpose:
 						break;
+
+					// Part of SPIR-V core, gathers default to the red component
+					case Ast::IntrinsicType::TextureGather:
+						if (node.parameters.size() < 3)
+							m_constantCache.Register(*m_constantCache.BuildConstant(std::int32_t(0)));
+
+						break;
+
+					// Part of SPIR-V 1.5 core (or SPV_EXT_descriptor_indexing)
+					case Ast::IntrinsicType::NonUniform:
+						RequireDescriptorIndexing(SpirvCapability::ShaderNonUniform);
+						break;
+
+					// Part of SPIR-V core, requires the ImageQuery capability
+					case Ast::IntrinsicType::TextureSize:
+						spirvCapabilities.insert(SpirvCapability::ImageQuery);
+						break;
+
+					// Part of SPIR-V 1.3 core, require the subgroup scope constant
+					case Ast::IntrinsicType::SubgroupAdd:
+					case Ast::IntrinsicType::SubgroupBallot:
+					case Ast::IntrinsicType::SubgroupBroadcastFirst:
+					case Ast::IntrinsicType::SubgroupElect:
+					case Ast::IntrinsicType::SubgroupMax:
+					case Ast::IntrinsicType::SubgroupMin:
+					case Ast::IntrinsicType::SubgroupShuffle:
+					{
+						if (!m_writer.IsVersionGreaterOrEqual(1, 3))
+							throw std::runtime_error("subgroup operations require SPIR-V 1.3");
+
+						spirvCapabilities.insert(SpirvCapability::GroupNonUniform);
+						switch (node.intrinsic)
+						{
+							case Ast::IntrinsicType::SubgroupAdd:
+							case Ast::IntrinsicType::SubgroupMax:
+							case Ast::IntrinsicType::SubgroupMin:
+								spirvCapabilities.insert(SpirvCapability::GroupNonUniformArithmetic);
+								break;
+
+							case Ast::IntrinsicType::SubgroupBallot:
+							case Ast::IntrinsicType::SubgroupBroadcastFirst:
+								spirvCapabilities.insert(SpirvCapability::GroupNonUniformBallot);
+								break;
+
+							case Ast::IntrinsicType::SubgroupShuffle:
+								spirvCapabilities.insert(SpirvCapability::GroupNonUniformShuffle);
+								break;
+
+							default:
+								break;
+						}
+
+						m_constantCache.Register(*m_constantCache.BuildConstant(static_cast<std::uint32_t>(SpirvScope::Subgroup)));
+						break;
+					}
+
+					// Part of SPIR-V core
+					case Ast::IntrinsicType::ImageLoad:
+					case Ast::IntrinsicType::ImageStore:
+						break;
+
+					// Part of SPIR-V core, atomics go through a texel pointer and require scope and memory semantics constants
+					case Ast::IntrinsicType::ImageAtomicAdd:
+					case Ast::IntrinsicType::ImageAtomicAnd:
+					case Ast::IntrinsicType::ImageAtomicExchange:
+					case Ast::IntrinsicType::ImageAtomicMax:
+					case Ast::IntrinsicType::ImageAtomicMin:
+					case Ast::IntrinsicType::ImageAtomicOr:
+					case Ast::IntrinsicType::ImageAtomicXor:
+					{
+						const Ast::ExpressionType* imageType = GetExpressionType(*node.parameters[0]);
+						assert(imageType && IsStorageImageType(*imageType));
+
+						m_constantCache.Register(*m_constantCache.BuildPointerType(std::get<Ast::StorageImageType>(*imageType).sampledType, SpirvStorageClass::Image));
+						m_constantCache.Register(*m_constantCache.BuildConstant(std::uint32_t(0))); //< sample index
+						m_constantCache.Register(*m_constantCache.BuildConstant(static_cast<std::uint32_t>(SpirvAstVisitor::GetIntrinsicMemoryScope(node.intrinsic))));
+						m_constantCache.Register(*m_constantCache.BuildConstant(SpirvAstVisitor::GetIntrinsicMemorySemantics(node.intrinsic)));
+						break;
+					}
+
+					// Part of SPIR-V core, require scope and memory semantics constants
+					case Ast::IntrinsicType::AtomicAdd:
+					case Ast::IntrinsicType::AtomicAnd:
+					case Ast::IntrinsicType::AtomicCompareExchange:
+					case Ast::IntrinsicType::AtomicExchange:
+					case Ast::IntrinsicType::AtomicMax:
+					case Ast::IntrinsicType::AtomicMin:
+					case Ast::IntrinsicType::AtomicOr:
+					case Ast::IntrinsicType::AtomicXor:
+					case Ast::IntrinsicType::Barrier:
+					case Ast::IntrinsicType::MemoryBarrier:
+					case Ast::IntrinsicType::MemoryBarrierBuffer:
+					case Ast::IntrinsicType::MemoryBarrierImage:
+					case Ast::IntrinsicType::MemoryBarrierShared:
+						m_constantCache.Register(*m_constantCache.BuildConstant(static_cast<std::uint32_t>(SpirvAstVisitor::GetIntrinsicMemoryScope(node.intrinsic))));
+						m_constantCache.Register(*m_constantCache.BuildConstant(SpirvAstVisitor::GetIntrinsicMemorySemantics(node.intrinsic)));
+						break;
 				}
 
+				for (const auto& parameter : node.parameters)
+					Require16BitArithmetic(*GetExpressionType(*parameter));
+
+				Require16BitArithmetic(node.cachedExpressionType.value());
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
@@ -490,6 +1021,8 @@ namespace nzsl
 					m_constantCache.Register(*m_constantCache.BuildConstant(indexCount));
 				}
 
+				Require16BitArithmetic(node.cachedExpressionType.value());
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
@@ -497,9 +1030,100 @@ namespace nzsl
 			{
 				RecursiveVisitor::Visit(node);
 
+				Require16BitArithmetic(node.cachedExpressionType.value());
+
 				m_constantCache.Register(*m_constantCache.BuildType(node.cachedExpressionType.value()));
 			}
 
+			static bool IsNonUniformIndex(const Ast::AccessIndexExpression& node)
+			{
+				if (node.indices.size() != 1 || node.indices.front()->GetType() != Ast::NodeType::IntrinsicExpression)
+					return false;
+
+				return static_cast<const Ast::IntrinsicExpression&>(*node.indices.front()).intrinsic == Ast::IntrinsicType::NonUniform;
+			}
+
+			// Matches f32(f16), vec3[u16](vec3[u32]) and such (OpFConvert, OpSConvert and OpUConvert)
+			static bool IsWidthConversion(const Ast::CastExpression& node)
+			{
+				if (node.expressions.size() != 1)
+					return false;
+
+				const Ast::ExpressionType& targetType = node.cachedExpressionType.value();
+				const Ast::ExpressionType& exprType = *GetExpressionType(*node.expressions.front());
+
+				std::optional<Ast::PrimitiveType> targetBaseType;
+				std::optional<Ast::PrimitiveType> exprBaseType;
+				if (IsPrimitiveType(targetType) && IsPrimitiveType(exprType))
+				{
+					targetBaseType = std::get<Ast::PrimitiveType>(targetType);
+					exprBaseType = std::get<Ast::PrimitiveType>(exprType);
+				}
+				else if (IsVectorType(targetType) && IsVectorType(exprType))
+				{
+					const auto& targetVecType = std::get<Ast::VectorType>(targetType);
+					const auto& exprVecType = std::get<Ast::VectorType>(exprType);
+					if (targetVecType.componentCount != exprVecType.componentCount)
+						return false;
+
+					targetBaseType = targetVecType.type;
+					exprBaseType = exprVecType.type;
+				}
+				else
+					return false;
+
+				auto GetWideType = [](Ast::PrimitiveType primitiveType)
+				{
+					switch (primitiveType)
+					{
+						case Ast::PrimitiveType::Float16: return Ast::PrimitiveType::Float32;
+						case Ast::PrimitiveType::Int16:   return Ast::PrimitiveType::Int32;
+						case Ast::PrimitiveType::UInt16:  return Ast::PrimitiveType::UInt32;
+						default:                          return primitiveType;
+					}
+				};
+
+				return GetWideType(*targetBaseType) == GetWideType(*exprBaseType);
+			}
+
+			// 16-bit values can be loaded, stored and converted with the storage capabilities only, computing on them requires Float16/Int16
+			void Require16BitArithmetic(const Ast::ExpressionType& type)
+			{
+				Ast::PrimitiveType primitiveType;
+				if (IsPrimitiveType(type))
+					primitiveType = std::get<Ast::PrimitiveType>(type);
+				else if (IsVectorType(type))
+					primitiveType = std::get<Ast::VectorType>(type).type;
+				else if (IsMatrixType(type))
+					primitiveType = std::get<Ast::MatrixType>(type).type;
+				else
+					return;
+
+				switch (primitiveType)
+				{
+					case Ast::PrimitiveType::Float16:
+						spirvCapabilities.insert(SpirvCapability::Float16);
+						break;
+
+					case Ast::PrimitiveType::Int16:
+					case Ast::PrimitiveType::UInt16:
+						spirvCapabilities.insert(SpirvCapability::Int16);
+						break;
+
+					default:
+						break;
+				}
+			}
+
+			void RequireDescriptorIndexing(SpirvCapability capability)
+			{
+				spirvCapabilities.insert(capability);
+
+				// Descriptor indexing is core since SPIR-V 1.5
+				if (!m_writer.IsVersionGreaterOrEqual(1, 5))
+					spirvExtensions.insert("SPV_EXT_descriptor_indexing");
+			}
+
 			std::uint32_t HandleEntryInOutType(ShaderStageType entryPointType, std::size_t funcIndex, const Ast::StructDescription::StructMember& member, SpirvStorageClass storageClass)
 			{
 				NAZARA_USE_ANONYMOUS_NAMESPACE
@@ -548,6 +1172,9 @@ namespace nzsl
 					std::uint32_t varId = m_constantCache.Register(variable);
 					locationDecorations[varId] = member.locationIndex.GetResultingValue();
 
+					if (member.precision.IsResultingValue() && member.precision.GetResultingValue() == Ast::Precision::Medium)
+						relaxedPrecisionDecorations.insert(varId);
+
 					return varId;
 				}
 
@@ -560,8 +1187,13 @@ namespace nzsl
 			ExtVarContainer extVars;
 			FunctionContainer funcs;
 			LocationDecoration locationDecorations;
+			RelaxedPrecisionDecoration relaxedPrecisionDecorations;
+			SourceFileList sourceFiles;
 			StructContainer declaredStructs;
 			tsl::ordered_set<SpirvCapability> spirvCapabilities;
+			tsl::ordered_set<std::string> spirvExtensions;
+			std::string moduleName;
+			bool isImportedModule = false;
 
 		private:
 			SpirvConstantCache& m_constantCache;
@@ -584,6 +1216,7 @@ namespace nzsl
 		};
 
 		std::unordered_map<std::string, std::uint32_t> extensionInstructionSet;
+		std::unordered_map<std::string, std::uint32_t> sourceFileIds;
 		std::unordered_map<std::size_t, SpirvAstVisitor::FuncData> funcs;
 		std::vector<std::uint32_t> resultIds;
 		std::uint32_t nextResultId = 1;
@@ -593,9 +1226,14 @@ namespace nzsl
 		// Output
 		SpirvSection header;
 		SpirvSection constants;
+		SpirvSection debugSources;
 		SpirvSection debugInfo;
 		SpirvSection annotations;
-		SpirvSection instructions;
+		std::vector<SpirvAstVisitor::FunctionCode> functions;
+
+		// Functions generated in parallel are written with placeholder ids which are remapped in the output
+		std::uint32_t firstPlaceholderId = 0;
+		std::vector<std::vector<std::uint32_t>> functionIdRemaps;
 	};
 
 	SpirvWriter::SpirvWriter() :
@@ -605,6 +1243,18 @@ namespace nzsl
 
 	std::vector<std::uint32_t> SpirvWriter::Generate(const Ast::Module& module, const States& states)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		VectorOutputSink output;
+		Generate(module, states, output);
+
+		return std::move(output.words);
+	}
+
+	void SpirvWriter::Generate(const Ast::Module& module, const States& states, OutputSink& output)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		Ast::ModulePtr sanitizedModule;
 		const Ast::Module* targetModule;
 		if (!states.sanitized)
@@ -628,16 +1278,21 @@ namespace nzsl
 		else
 			targetModule = &module;
 
-		if (states.optimize)
-		{
-			sanitizedModule = Ast::PropagateConstants(*targetModule);
-			
-			Ast::DependencyCheckerVisitor::Config dependencyConfig;
-			dependencyConfig.usedShaderStages = ShaderStageType_All;
+		OptimizationLevel optimizationLevel = states.optimizationLevel;
+		if (optimizationLevel == OptimizationLevel::O0 && states.optimize)
+			optimizationLevel = OptimizationLevel::O1;
 
-			sanitizedModule = Ast::EliminateUnusedPass(*sanitizedModule, dependencyConfig);
+		if (optimizationLevel != OptimizationLevel::O0)
+		{
+			Ast::OptimizationPipeline::Options optimizationOptions;
+			optimizationOptions.dependencyConfig.usedShaderStages = ShaderStageType_All;
 
-			targetModule = sanitizedModule.get();
+			Ast::OptimizationPipeline optimizationPipeline(optimizationLevel, optimizationOptions);
+			if (Ast::ModulePtr optimizedModule = optimizationPipeline.Process(*targetModule))
+			{
+				sanitizedModule = std::move(optimizedModule);
+				targetModule = sanitizedModule.get();
+			}
 		}
 
 		// Previsitor
@@ -645,6 +1300,8 @@ namespace nzsl
 		m_context.states = &states;
 
 		State state;
+		state.constantTypeCache.SetTypeCache(m_environment.typeCache);
+
 		m_currentState = &state;
 		Nz::CallOnExit onExit([this]()
 		{
@@ -653,9 +1310,15 @@ namespace nzsl
 
 		// Register all extended instruction sets
 		PreVisitor previsitor(*this, state.constantTypeCache);
+		previsitor.isImportedModule = true;
 		for (const auto& importedModule : targetModule->importedModules)
+		{
+			previsitor.moduleName = (importedModule.module->metadata) ? importedModule.module->metadata->moduleName : std::string{};
 			importedModule.module->rootNode->Visit(previsitor);
+		}
 
+		previsitor.isImportedModule = false;
+		previsitor.moduleName = (targetModule->metadata) ? targetModule->metadata->moduleName : std::string{};
 		targetModule->rootNode->Visit(previsitor);
 
 		m_currentState->previsitor = &previsitor;
@@ -663,6 +1326,20 @@ namespace nzsl
 		for (const std::string& extInst : previsitor.extInsts)
 			state.extensionInstructionSet[extInst] = AllocateResultId();
 
+		std::uint32_t shaderLangVersion = (targetModule->metadata) ? targetModule->metadata->shaderLangVersion : 0;
+		for (const std::string& sourceFile : previsitor.sourceFiles)
+		{
+			std::uint32_t fileId = AllocateResultId();
+			state.sourceFileIds[sourceFile] = fileId;
+
+			state.debugSources.Append(SpirvOp::OpString, fileId, sourceFile);
+
+			if (auto it = m_environment.debugSourceContents.find(sourceFile); it != m_environment.debugSourceContents.end())
+				AppendSource(state.debugSources, shaderLangVersion, fileId, it->second);
+			else
+				state.debugSources.Append(SpirvOp::OpSource, SpirvSourceLanguage::Unknown, shaderLangVersion, fileId);
+		}
+
 		// Assign function ID (required for forward declaration)
 		for (auto it = previsitor.funcs.begin(); it != previsitor.funcs.end(); ++it)
 		{
@@ -672,18 +1349,42 @@ namespace nzsl
 		}
 		previsitor.funcs.clear(); //< since we moved every value, prevent further usage
 
-		SpirvAstVisitor visitor(*this, state.instructions, state.funcs);
+		unsigned int threadCount = m_environment.functionThreadCount;
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+		std::vector<Ast::DeclareFunctionStatement*> deferredFunctions;
+
+		SpirvAstVisitor visitor(*this, state.functions, state.funcs);
+		if (threadCount > 1)
+			visitor.SetDeferredFunctions(&deferredFunctions);
+
 		for (const auto& importedModule : targetModule->importedModules)
 			importedModule.module->rootNode->Visit(visitor);
 
 		targetModule->rootNode->Visit(visitor);
 
+		if (!deferredFunctions.empty())
+			GenerateFunctions(visitor, deferredFunctions, threadCount);
+
 		AppendHeader();
 
 		for (auto&& [varIndex, extVar] : previsitor.extVars)
 		{
+			if (extVar.isPushConstant || extVar.isWorkgroupShared)
+				continue;
+
 			state.annotations.Append(SpirvOp::OpDecorate, extVar.pointerId, SpirvDecoration::Binding, extVar.bindingIndex);
 			state.annotations.Append(SpirvOp::OpDecorate, extVar.pointerId, SpirvDecoration::DescriptorSet, extVar.descriptorSet);
+
+			if (extVar.isNonReadable)
+				state.annotations.Append(SpirvOp::OpDecorate, extVar.pointerId, SpirvDecoration::NonReadable);
+
+			if (extVar.isNonWritable)
+				state.annotations.Append(SpirvOp::OpDecorate, extVar.pointerId, SpirvDecoration::NonWritable);
+
+			if (extVar.isRestrict)
+				state.annotations.Append(SpirvOp::OpDecorate, extVar.pointerId, SpirvDecoration::Restrict);
 		}
 
 		for (auto&& [varId, builtin] : previsitor.builtinDecorations)
@@ -692,16 +1393,40 @@ namespace nzsl
 		for (auto&& [varId, location] : previsitor.locationDecorations)
 			state.annotations.Append(SpirvOp::OpDecorate, varId, SpirvDecoration::Location, location);
 
-		m_currentState->constantTypeCache.Write(m_currentState->annotations, m_currentState->constants, m_currentState->debugInfo);
+		for (std::uint32_t varId : previsitor.relaxedPrecisionDecorations)
+			state.annotations.Append(SpirvOp::OpDecorate, varId, SpirvDecoration::RelaxedPrecision);
+
+		for (auto&& [funcIndex, func] : state.funcs)
+		{
+			if (func.linkageType)
+				state.annotations.Append(SpirvOp::OpDecorate, func.funcId, SpirvDecoration::LinkageAttributes, func.linkageName, *func.linkageType);
+		}
+
+		m_currentState->constantTypeCache.Write(m_currentState->annotations, m_currentState->constants, (m_environment.debugNames == DebugNames::All) ? &m_currentState->debugInfo : nullptr);
+
+		std::size_t wordCount = ComputeOutputSize();
+		if (m_environment.optimizeSpirv)
+		{
+			// The optimizer decodes the generated module, it writes the optimized module directly in the output
+			std::vector<std::uint32_t> spirv(wordCount);
+			WriteOutput(spirv.data());
+
+			OptimizerOutputSink optimizerOutput(output);
 
-		std::vector<std::uint32_t> ret;
-		MergeSections(ret, state.header);
-		MergeSections(ret, state.debugInfo);
-		MergeSections(ret, state.annotations);
-		MergeSections(ret, state.constants);
-		MergeSections(ret, state.instructions);
+			SpirvOptimizer optimizer;
+			optimizer.Optimize(spirv.data(), spirv.size(), SpirvOptimizer::Settings{}, optimizerOutput);
 
-		return ret;
+			if (m_environment.compactIds)
+				CompactIds(optimizerOutput.outputWords, optimizerOutput.outputWordCount);
+		}
+		else
+		{
+			std::uint32_t* outputWords = output.Allocate(wordCount);
+			WriteOutput(outputWords);
+
+			if (m_environment.compactIds)
+				CompactIds(outputWords, wordCount);
+		}
 	}
 
 	const SpirvVariable& SpirvWriter::GetConstantVariable(std::size_t constIndex) const
@@ -731,6 +1456,11 @@ namespace nzsl
 
 	std::uint32_t SpirvWriter::AllocateResultId()
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		if (s_functionContext)
+			return s_functionContext->AllocateId();
+
 		return m_currentState->nextResultId++;
 	}
 
@@ -749,6 +1479,9 @@ namespace nzsl
 		for (SpirvCapability capability : m_currentState->previsitor->spirvCapabilities)
 			m_currentState->header.Append(SpirvOp::OpCapability, capability);
 
+		for (const std::string& extension : m_currentState->previsitor->spirvExtensions)
+			m_currentState->header.Append(SpirvOp::OpExtension, extension);
+
 		for (const auto& [extInst, resultId] : m_currentState->extensionInstructionSet)
 			m_currentState->header.Append(SpirvOp::OpExtInstImport, resultId, extInst);
 
@@ -756,7 +1489,8 @@ namespace nzsl
 
 		for (auto&& [funcIndex, func] : m_currentState->funcs)
 		{
-			m_currentState->debugInfo.Append(SpirvOp::OpName, func.funcId, func.name);
+			if (m_environment.debugNames == DebugNames::All || (m_environment.debugNames == DebugNames::EntryPoints && func.entryPointData))
+				m_currentState->debugInfo.Append(SpirvOp::OpName, func.funcId, func.name);
 
 			if (func.entryPointData)
 			{
@@ -770,6 +1504,10 @@ namespace nzsl
 						execModel = SpirvExecutionModel::Fragment;
 						break;
 
+					case ShaderStageType::Compute:
+						execModel = SpirvExecutionModel::GLCompute;
+						break;
+
 					case ShaderStageType::Vertex:
 						execModel = SpirvExecutionModel::Vertex;
 						break;
@@ -801,6 +1539,9 @@ namespace nzsl
 			{
 				for (SpirvExecutionMode executionMode : func.entryPointData->executionModes)
 					m_currentState->header.Append(SpirvOp::OpExecutionMode, func.funcId, executionMode);
+
+				if (const auto& workgroupSize = func.entryPointData->workgroupSize)
+					m_currentState->header.Append(SpirvOp::OpExecutionMode, func.funcId, SpirvExecutionMode::LocalSize, workgroupSize->x(), workgroupSize->y(), workgroupSize->z());
 			}
 		}
 	}
@@ -819,14 +1560,133 @@ namespace nzsl
 			return m_currentState->constantTypeCache.BuildFunctionType(Ast::NoType{}, parameterTypes);
 	}
 	
+	void SpirvWriter::GenerateFunctions(const SpirvAstVisitor& globalVisitor, const std::vector<Ast::DeclareFunctionStatement*>& functions, unsigned int threadCount)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Global declarations don't allocate ids, so the first function starts with the same id as in a serial generation
+		std::uint32_t firstPlaceholderId = m_currentState->nextResultId;
+
+		std::vector<std::unique_ptr<FunctionGenerationContext>> contexts;
+		contexts.reserve(functions.size());
+		for (std::size_t i = 0; i < functions.size(); ++i)
+			contexts.push_back(std::make_unique<FunctionGenerationContext>(m_currentState->constantTypeCache, firstPlaceholderId));
+
+		std::atomic_size_t nextFunctionIndex = 0;
+		auto GenerateFunctionBodies = [&]
+		{
+			std::vector<SpirvAstVisitor::FunctionCode> functionCodes;
+
+			SpirvAstVisitor visitor(*this, functionCodes, m_currentState->funcs);
+			visitor.CopyGlobals(globalVisitor);
+
+			std::size_t functionIndex;
+			while ((functionIndex = nextFunctionIndex++) < functions.size())
+			{
+				FunctionGenerationContext& context = *contexts[functionIndex];
+
+				s_functionContext = &context;
+				Nz::CallOnExit resetContext([] { s_functionContext = nullptr; });
+
+				try
+				{
+					visitor.Visit(*functions[functionIndex]);
+
+					context.code = std::move(functionCodes.back());
+					functionCodes.clear();
+				}
+				catch (...)
+				{
+					// Functions are dispatched in order, every function before this one has already been picked by a thread
+					context.exception = std::current_exception();
+					nextFunctionIndex = functions.size();
+				}
+			}
+		};
+
+		{
+			std::vector<std::thread> threads;
+			Nz::CallOnExit joinThreads([&]
+			{
+				for (std::thread& thread : threads)
+					thread.join();
+			});
+
+			threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, functions.size()));
+			for (unsigned int i = 1; i < threadCount; ++i)
+				threads.emplace_back(GenerateFunctionBodies);
+
+			GenerateFunctionBodies();
+		}
+
+		// Replay id allocations and registrations in function order
+		m_currentState->firstPlaceholderId = firstPlaceholderId;
+		for (auto& contextPtr : contexts)
+		{
+			FunctionGenerationContext& context = *contextPtr;
+			if (context.exception)
+				std::rethrow_exception(context.exception);
+
+			std::vector<std::uint32_t>& idRemap = m_currentState->functionIdRemaps.emplace_back();
+			idRemap.resize(context.nextPlaceholderId - firstPlaceholderId);
+
+			for (auto& event : context.events)
+			{
+				std::visit([&](auto&& arg)
+				{
+					using T = std::decay_t<decltype(arg)>;
+
+					if constexpr (std::is_same_v<T, std::uint32_t>)
+						idRemap[arg - firstPlaceholderId] = AllocateResultId();
+					else if constexpr (std::is_same_v<T, FunctionGenerationContext::Registration>)
+					{
+						idRemap[arg.placeholderId - firstPlaceholderId] = std::visit([&](auto&& value)
+						{
+							return m_currentState->constantTypeCache.Register(std::move(value));
+						}, arg.value);
+					}
+					else
+						static_assert(Nz::AlwaysFalse<T>(), "non-exhaustive visitor");
+				}, event);
+			}
+
+			m_currentState->functions.push_back(std::move(context.code));
+		}
+	}
+
+	std::size_t SpirvWriter::ComputeOutputSize() const
+	{
+		std::size_t wordCount = m_currentState->header.GetOutputOffset()
+		                      + m_currentState->debugSources.GetOutputOffset()
+		                      + m_currentState->debugInfo.GetOutputOffset()
+		                      + m_currentState->annotations.GetOutputOffset()
+		                      + m_currentState->constants.GetOutputOffset();
+
+		for (const SpirvAstVisitor::FunctionCode& functionCode : m_currentState->functions)
+		{
+			wordCount += functionCode.decorations.GetOutputOffset();
+			wordCount += functionCode.declaration.GetOutputOffset();
+			for (const auto& block : functionCode.blocks)
+				wordCount += block->GetOutputOffset();
+
+			wordCount += 1; //< OpFunctionEnd
+		}
+
+		return wordCount;
+	}
+
 	std::uint32_t SpirvWriter::GetArrayConstantId(const Ast::ConstantArrayValue& values) const
 	{
-		return m_currentState->constantTypeCache.GetId(*m_currentState->constantTypeCache.BuildArrayConstant(values));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetCachedId(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildArrayConstant(values));
 	}
 
 	std::uint32_t SpirvWriter::GetSingleConstantId(const Ast::ConstantSingleValue& value) const
 	{
-		return m_currentState->constantTypeCache.GetId(*m_currentState->constantTypeCache.BuildConstant(value));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetCachedId(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildConstant(value));
 	}
 
 	std::uint32_t SpirvWriter::GetExtendedInstructionSet(const std::string& instructionSetName) const
@@ -847,17 +1707,46 @@ namespace nzsl
 
 	std::uint32_t SpirvWriter::GetFunctionTypeId(const Ast::DeclareFunctionStatement& functionNode)
 	{
-		return m_currentState->constantTypeCache.GetId({ *BuildFunctionType(functionNode) });
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetCachedId(m_currentState->constantTypeCache, SpirvConstantCache::Type{ *BuildFunctionType(functionNode) });
+	}
+
+	std::uint32_t SpirvWriter::GetImageTypeId(const Ast::SamplerType& samplerType) const
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		// Samplers are sampled images, retrieve the image type they wrap
+		SpirvConstantCache::TypePtr sampledImageType = m_currentState->constantTypeCache.BuildType(samplerType);
+		const auto& sampledImage = std::get<SpirvConstantCache::SampledImage>(sampledImageType->type);
+
+		return GetCachedId(m_currentState->constantTypeCache, *sampledImage.image);
 	}
 
 	std::uint32_t SpirvWriter::GetPointerTypeId(const Ast::ExpressionType& type, SpirvStorageClass storageClass) const
 	{
-		return m_currentState->constantTypeCache.GetId(*m_currentState->constantTypeCache.BuildPointerType(type, storageClass));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetCachedId(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildPointerType(type, storageClass));
+	}
+
+	std::uint32_t SpirvWriter::GetSourceFileId(const std::shared_ptr<const std::string>& filePath) const
+	{
+		if (!m_environment.debugLineInfo)
+			return 0;
+
+		auto it = m_currentState->sourceFileIds.find((filePath) ? *filePath : std::string{});
+		if (it == m_currentState->sourceFileIds.end())
+			return 0;
+
+		return it->second;
 	}
 
 	std::uint32_t SpirvWriter::GetTypeId(const Ast::ExpressionType& type) const
 	{
-		return m_currentState->constantTypeCache.GetId(*m_currentState->constantTypeCache.BuildType(type));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return GetCachedId(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildType(type));
 	}
 
 	bool SpirvWriter::IsVersionGreaterOrEqual(std::uint32_t spvMajor, std::uint32_t spvMinor) const
@@ -872,36 +1761,82 @@ namespace nzsl
 	
 	std::uint32_t SpirvWriter::RegisterArrayConstant(const Ast::ConstantArrayValue& value)
 	{
-		return m_currentState->constantTypeCache.Register(*m_currentState->constantTypeCache.BuildArrayConstant(value));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return RegisterCached(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildArrayConstant(value));
 	}
 
 	std::uint32_t SpirvWriter::RegisterSingleConstant(const Ast::ConstantSingleValue& value)
 	{
-		return m_currentState->constantTypeCache.Register(*m_currentState->constantTypeCache.BuildConstant(value));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return RegisterCached(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildConstant(value));
 	}
 
 	std::uint32_t SpirvWriter::RegisterFunctionType(const Ast::DeclareFunctionStatement& functionNode)
 	{
-		return m_currentState->constantTypeCache.Register({ *BuildFunctionType(functionNode) });
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return RegisterCached(m_currentState->constantTypeCache, SpirvConstantCache::Type{ *BuildFunctionType(functionNode) });
 	}
 
 	std::uint32_t SpirvWriter::RegisterPointerType(Ast::ExpressionType type, SpirvStorageClass storageClass)
 	{
-		return m_currentState->constantTypeCache.Register(*m_currentState->constantTypeCache.BuildPointerType(type, storageClass));
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		return RegisterCached(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildPointerType(type, storageClass));
 	}
 
 	std::uint32_t SpirvWriter::RegisterType(Ast::ExpressionType type)
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		assert(m_currentState);
-		return m_currentState->constantTypeCache.Register(*m_currentState->constantTypeCache.BuildType(type));
+		return RegisterCached(m_currentState->constantTypeCache, *m_currentState->constantTypeCache.BuildType(type));
 	}
 
-	void SpirvWriter::MergeSections(std::vector<std::uint32_t>& output, const SpirvSection& from)
+	void SpirvWriter::WriteOutput(std::uint32_t* output) const
 	{
-		const std::vector<std::uint32_t>& bytecode = from.GetBytecode();
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		output = WriteSection(output, m_currentState->header);
+		output = WriteSection(output, m_currentState->debugSources);
+		output = WriteSection(output, m_currentState->debugInfo);
+		output = WriteSection(output, m_currentState->annotations);
+
+		// Function decorations may reference placeholder ids
+		for (std::size_t i = 0; i < m_currentState->functions.size(); ++i)
+		{
+			std::uint32_t* decorationOutput = output;
+			output = WriteSection(output, m_currentState->functions[i].decorations);
+
+			if (!m_currentState->functionIdRemaps.empty())
+				RemapPlaceholderIds(decorationOutput, output, m_currentState->firstPlaceholderId, m_currentState->functionIdRemaps[i]);
+		}
+
+		output = WriteSection(output, m_currentState->constants);
+
+		for (std::size_t i = 0; i < m_currentState->functions.size(); ++i)
+		{
+			const SpirvAstVisitor::FunctionCode& functionCode = m_currentState->functions[i];
+
+			std::uint32_t* functionOutput = output;
+			output = WriteSection(output, functionCode.declaration);
+			for (const auto& block : functionCode.blocks)
+				output = WriteSection(output, *block);
+
+			if (!m_currentState->functionIdRemaps.empty())
+				RemapPlaceholderIds(functionOutput, output, m_currentState->firstPlaceholderId, m_currentState->functionIdRemaps[i]);
 
-		std::size_t prevSize = output.size();
-		output.resize(prevSize + bytecode.size());
-		std::copy(bytecode.begin(), bytecode.end(), output.begin() + prevSize);
+			*output++ = SpirvSectionBase::BuildOpcode(SpirvOp::OpFunctionEnd, 1);
+		}
 	}
+
+	std::uint32_t* SpirvWriter::WriteSection(std::uint32_t* output, const SpirvSectionBase& section)
+	{
+		const std::vector<std::uint32_t>& bytecode = section.GetBytecode();
+		return std::copy(bytecode.begin(), bytecode.end(), output);
+	}
+
+	SpirvWriter::OutputSink::~OutputSink() = default;
 }
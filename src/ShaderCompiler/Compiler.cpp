@@ -11,9 +11,11 @@
 #include <NZSL/Lexer.hpp>
 #include <NZSL/Parser.hpp>
 #include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/SpirV/SpirvStatisticsCollector.hpp>
 #include <NZSL/SpirvWriter.hpp>
 #include <NZSL/Serializer.hpp>
 #include <NZSL/Ast/AstSerializer.hpp>
+#include <NZSL/Ast/OptimizationPipeline.hpp>
 #include <NZSL/Ast/ReflectVisitor.hpp>
 #include <NZSL/Ast/SanitizeVisitor.hpp>
 #include <fmt/color.h>
@@ -39,7 +41,9 @@ namespace nzslc
 	
 	Compiler::Compiler(cxxopts::ParseResult& options) :
 	m_logFormat(LogFormat::Classic),
+	m_optimizationLevel(nzsl::OptimizationLevel::O0),
 	m_options(options),
+	m_isModuleOptimized(false),
 	m_profiling(false),
 	m_outputToStdout(false),
 	m_verbose(false),
@@ -91,6 +95,44 @@ namespace nzslc
 		if (m_options.count("measure") > 0)
 			m_profiling = m_options["measure"].as<bool>();
 
+		if (m_options.count("optimize-level") > 0)
+		{
+			const std::string& levelStr = m_options["optimize-level"].as<std::string>();
+			if (levelStr == "0")
+				m_optimizationLevel = nzsl::OptimizationLevel::O0;
+			else if (levelStr == "1")
+				m_optimizationLevel = nzsl::OptimizationLevel::O1;
+			else if (levelStr == "2")
+				m_optimizationLevel = nzsl::OptimizationLevel::O2;
+			else if (levelStr == "s")
+				m_optimizationLevel = nzsl::OptimizationLevel::Os;
+			else
+				throw cxxopts::OptionException(fmt::format("{} is not a valid optimization level", levelStr));
+		}
+		else if (m_options.count("optimize") > 0)
+			m_optimizationLevel = nzsl::OptimizationLevel::O1;
+
+		if (m_options.count("stats") > 0)
+		{
+			const std::string& statsFormat = m_options["stats"].as<std::string>();
+			if (statsFormat != "text" && statsFormat != "json")
+				throw cxxopts::OptionException(fmt::format("{} is not a valid statistics format", statsFormat));
+		}
+
+		if (m_options.count("spv-strip") > 0)
+		{
+			const std::string& stripMode = m_options["spv-strip"].as<std::string>();
+			if (stripMode != "all" && stripMode != "keep-entry-names")
+				throw cxxopts::OptionException(fmt::format("{} is not a valid SPIR-V strip mode", stripMode));
+		}
+
+		if (m_options.count("spv-line-info") > 0)
+		{
+			const std::string& lineInfoMode = m_options["spv-line-info"].as<std::string>();
+			if (lineInfoMode != "path" && lineInfoMode != "source")
+				throw cxxopts::OptionException(fmt::format("{} is not a valid SPIR-V line info mode", lineInfoMode));
+		}
+
 		m_verbose = m_options.count("verbose") > 0;
 	}
 	
@@ -172,11 +214,16 @@ namespace nzslc
 	{
 		using namespace std::literals;
 
+		m_isModuleOptimized = false;
+
 		Step("Full processing"sv, [&]
 		{
 			Step("Read input file"sv, &Compiler::ReadInput);
 			Step("Processing"sv, &Compiler::Sanitize);
 
+			if (m_optimizationLevel != nzsl::OptimizationLevel::O0 && m_options.count("partial") == 0)
+				Step("Optimization"sv, &Compiler::Optimize);
+
 			if (m_options.count("compile") > 0)
 				Step("Compiling"sv, &Compiler::Compile);
 		});
@@ -212,19 +259,25 @@ Multiple values can be specified using commas (ex: --compile=glsl,nzslb).
 You can also specify -header as a suffix (ex: --compile=glsl-header) to generate an includable header file.
 )", cxxopts::value<std::vector<std::string>>()->implicit_value("nzslb"))
 			("m,module", "Module file or directory", cxxopts::value<std::vector<std::string>>())
-			("optimize", "Optimize shader code")
+			("optimize", "Optimize shader code (same as -O1)")
+			("O,optimize-level", "Optimization level (0: none, 1: run every pass once, 2: run passes until nothing changes, s: same as 2 without passes increasing code size, such as vectorization)", cxxopts::value<std::string>(), "[0|1|2|s]")
+			("optimize-stats", "Print statistics about every optimization pass")
 			("p,partial", "Allow partial compilation");
 
 		options.add_options("glsl output")
 			("gl-es", "Generate GLSL ES instead of GLSL", cxxopts::value<bool>()->default_value("false"))
 			("gl-version", "OpenGL version (310 being 3.1)", cxxopts::value<std::uint32_t>(), "version")
-			("gl-entry", "Shader entry point (required for files having multiple entry points)", cxxopts::value<std::string>(), "[frag|vert]")
+			("gl-entry", "Shader entry point (required for files having multiple entry points)", cxxopts::value<std::string>(), "[compute|frag|vert]")
 			("gl-flipy", "Add code to conditionally flip gl_Position Y value")
 			("gl-remapz", "Add code to remap gl_Position Z value from [0;1] to [-1;1]")
 			("gl-bindingmap", "Add binding support (generates a .binding.json mapping file)");
 
 		options.add_options("spirv output")
-			("spv-version", "SPIR-V version (110 being 1.1)", cxxopts::value<std::uint32_t>(), "version");
+			("spv-version", "SPIR-V version (110 being 1.1)", cxxopts::value<std::uint32_t>(), "version")
+			("spv-strip", "Strip debug names (all of them or all but entry point names) and compact result ids of generated SPIR-V", cxxopts::value<std::string>()->implicit_value("all"), "[all|keep-entry-names]")
+			("spv-line-info", "Emit source lines (OpLine) in generated SPIR-V for profilers and debuggers, along with the source file path or its whole content", cxxopts::value<std::string>()->implicit_value("source"), "[path|source]")
+			("spv-dis-functions", "Only output the functions having these names when generating textual SPIR-V", cxxopts::value<std::vector<std::string>>(), "names")
+			("stats", "Output statistics about the generated SPIR-V (text is printed to stderr, json generates a .spv.stats.json file)", cxxopts::value<std::string>()->implicit_value("text"), "[text|json]");
 
 		options.parse_positional("input");
 		options.positional_help("shader path");
@@ -232,6 +285,17 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 		return options;
 	}
 
+	nzsl::ShaderWriter::States Compiler::BuildWriterStates() const
+	{
+		nzsl::ShaderWriter::States states;
+
+		// Don't let writers run the optimization pipeline again if the optimization step already did
+		if (!m_isModuleOptimized)
+			states.optimizationLevel = m_optimizationLevel;
+
+		return states;
+	}
+
 	void Compiler::Compile()
 	{
 		using namespace std::literals;
@@ -274,8 +338,7 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 
 	void Compiler::CompileToGLSL(std::filesystem::path outputPath, const nzsl::Ast::Module& module)
 	{
-		nzsl::ShaderWriter::States states;
-		states.optimize = (m_options.count("optimize") > 0);
+		nzsl::ShaderWriter::States states = BuildWriterStates();
 
 		nzsl::GlslWriter::Environment env;
 		if (m_options.count("gl-es") > 0)
@@ -317,6 +380,13 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 
 				for (auto& extVar : extDecl.externalVars)
 				{
+					// Workgroup-shared variables and push constants don't use bindings
+					if (extVar.isWorkgroupShared.IsResultingValue() && extVar.isWorkgroupShared.GetResultingValue())
+						continue;
+
+					if (extVar.type.IsResultingValue() && nzsl::Ast::IsPushConstantType(extVar.type.GetResultingValue()))
+						continue;
+
 					std::uint64_t bindingSet = extSet;
 					if (extVar.bindingSet.HasValue())
 					{
@@ -367,7 +437,9 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 		if (m_options.count("gl-entry") > 0)
 		{
 			std::string entryName = m_options["gl-entry"].as<std::string>();
-			if (entryName == "frag")
+			if (entryName == "compute")
+				entryType = nzsl::ShaderStageType::Compute;
+			else if (entryName == "frag")
 				entryType = nzsl::ShaderStageType::Fragment;
 			else if (entryName == "vert")
 				entryType = nzsl::ShaderStageType::Vertex;
@@ -389,8 +461,7 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 
 	void Compiler::CompileToNZSL(std::filesystem::path outputPath, const nzsl::Ast::Module& module)
 	{
-		nzsl::ShaderWriter::States states;
-		states.optimize = (m_options.count("optimize") > 0);
+		nzsl::ShaderWriter::States states = BuildWriterStates();
 
 		nzsl::LangWriter nzslWriter;
 		std::string nzsl = nzslWriter.Generate(module, states);
@@ -428,8 +499,7 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 
 	void Compiler::CompileToSPV(std::filesystem::path outputPath, const nzsl::Ast::Module& module, bool textual)
 	{
-		nzsl::ShaderWriter::States states;
-		states.optimize = (m_options.count("optimize") > 0);
+		nzsl::ShaderWriter::States states = BuildWriterStates();
 
 		nzsl::SpirvWriter::Environment env;
 		if (m_options.count("spv-version"))
@@ -444,16 +514,70 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 			env.spvMinorVersion = (version % 100) / 10;
 		}
 
+		bool strip = m_options.count("spv-strip") > 0;
+		if (strip)
+		{
+			env.compactIds = true;
+			env.debugNames = (m_options["spv-strip"].as<std::string>() == "keep-entry-names") ? nzsl::SpirvWriter::DebugNames::EntryPoints : nzsl::SpirvWriter::DebugNames::None;
+		}
+
+		if (m_options.count("spv-line-info") > 0)
+		{
+			env.debugLineInfo = true;
+
+			// Only the input file content is available (imported modules are referenced by their path)
+			if (m_options["spv-line-info"].as<std::string>() == "source" && m_inputFilePath.extension() == ".nzsl")
+				env.debugSourceContents[m_inputFilePath.generic_u8string()] = ReadSourceFileContent(m_inputFilePath);
+		}
+
 		nzsl::SpirvWriter writer;
 		writer.SetEnv(env);
 
 		std::vector<std::uint32_t> spirv = writer.Generate(module, states);
 		std::size_t size = spirv.size() * sizeof(std::uint32_t);
 
+		if (m_options.count("stats") > 0)
+		{
+			// Generate the module a second time without stripping to report how much was saved
+			std::optional<std::size_t> unstrippedWordCount;
+			if (strip)
+			{
+				nzsl::SpirvWriter::Environment unstrippedEnv = env;
+				unstrippedEnv.compactIds = false;
+				unstrippedEnv.debugNames = nzsl::SpirvWriter::DebugNames::All;
+
+				writer.SetEnv(unstrippedEnv);
+				unstrippedWordCount = writer.Generate(module, states).size();
+			}
+
+			OutputSpirvStatistics(outputPath, spirv, unstrippedWordCount);
+		}
+
 		if (textual)
 		{
+			nzsl::SpirvPrinter::Settings printSettings;
+			if (m_options.count("spv-dis-functions") > 0)
+				printSettings.functions = m_options["spv-dis-functions"].as<std::vector<std::string>>();
+
 			nzsl::SpirvPrinter printer;
-			std::string spirvTxt = printer.Print(spirv);
+
+			if (m_outputToStdout && !m_outputHeader)
+			{
+				// Stream text as it's generated
+				struct StdoutSink : nzsl::SpirvPrinter::OutputSink
+				{
+					void Write(std::string_view text) override
+					{
+						fmt::print("{}", text);
+					}
+				};
+
+				StdoutSink stdoutSink;
+				printer.Print(spirv.data(), spirv.size(), printSettings, stdoutSink);
+				return;
+			}
+
+			std::string spirvTxt = printer.Print(spirv, printSettings);
 
 			if (m_outputToStdout)
 			{
@@ -575,6 +699,123 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 			throw std::runtime_error(fmt::format("{} has unknown extension \"{}\"", m_inputFilePath.filename().generic_u8string(), extension.generic_u8string()));
 	}
 
+	void Compiler::Optimize()
+	{
+		// Entry points of every stage are kept, like the writers do
+		nzsl::Ast::OptimizationPipeline::Options optimizationOptions;
+		optimizationOptions.dependencyConfig.usedShaderStages = nzsl::ShaderStageType_All;
+
+		nzsl::Ast::OptimizationPipeline optimizationPipeline(m_optimizationLevel, optimizationOptions);
+
+		bool printStatistics = m_options.count("optimize-stats") > 0;
+
+		nzsl::Ast::OptimizationPipeline::Statistics statistics;
+		if (nzsl::Ast::ModulePtr optimizedModule = optimizationPipeline.Process(*m_shaderModule, (printStatistics) ? &statistics : nullptr))
+			m_shaderModule = std::move(optimizedModule);
+
+		m_isModuleOptimized = true;
+
+		if (!printStatistics)
+			return;
+
+		// Statistics are printed to stderr, stdout may receive the generated code
+		fmt::print(stderr, "Optimization passes ({} iteration(s){}):\n", statistics.iterationCount, (statistics.reachedFixedPoint) ? ", fixed point reached" : "");
+		for (const auto& passStats : statistics.passes)
+		{
+			long long time = std::chrono::duration_cast<std::chrono::microseconds>(passStats.duration).count();
+
+			fmt::print(stderr, "- #{} {}: {} -> {} nodes{} in {}\n", passStats.iteration + 1, optimizationPipeline.GetPassName(passStats.passIndex), passStats.nodeCountBefore, passStats.nodeCountAfter, (passStats.changed) ? "" : " (unchanged)", fmt::format(fg(fmt::color::dark_golden_rod), "{}us", time));
+		}
+	}
+
+	void Compiler::OutputSpirvStatistics(std::filesystem::path outputPath, const std::vector<std::uint32_t>& spirv, std::optional<std::size_t> unstrippedWordCount)
+	{
+		nzsl::SpirvStatisticsCollector statisticsCollector;
+		nzsl::SpirvStatisticsCollector::Statistics statistics = statisticsCollector.Collect(spirv);
+
+		auto GetOpName = [](nzsl::SpirvOp op) -> std::string_view
+		{
+			const nzsl::SpirvInstruction* instruction = nzsl::GetSpirvInstruction(static_cast<std::uint16_t>(op));
+			return (instruction) ? instruction->name : "<unknown>";
+		};
+
+		if (m_options["stats"].as<std::string>() == "json")
+		{
+			auto CountersToJson = [&](const nzsl::SpirvStatisticsCollector::Counters& counters)
+			{
+				nlohmann::json doc;
+				doc["instructions"] = counters.instructionCount;
+				doc["words"] = counters.wordCount;
+				doc["types"] = counters.typeCount;
+				doc["constants"] = counters.constantCount;
+				doc["loads"] = counters.loadCount;
+				doc["stores"] = counters.storeCount;
+				doc["access_chains"] = counters.accessChainCount;
+				doc["branches"] = counters.branchCount;
+
+				nlohmann::json& opcodes = doc["opcodes"];
+				opcodes = nlohmann::json::object();
+				for (auto&& [op, count] : counters.opCounts)
+					opcodes[std::string(GetOpName(op))] = count;
+
+				return doc;
+			};
+
+			nlohmann::json finalDoc;
+			finalDoc["version"] = fmt::format("{}.{}", (statistics.versionNumber >> 16) & 0xFF, (statistics.versionNumber >> 8) & 0xFF);
+			finalDoc["id_bound"] = statistics.idBound;
+			finalDoc["words"] = statistics.wordCount;
+			finalDoc["module"] = CountersToJson(statistics.module);
+
+			if (unstrippedWordCount)
+			{
+				nlohmann::json& stripDoc = finalDoc["strip"];
+				stripDoc["unstripped_words"] = *unstrippedWordCount;
+				stripDoc["saved_words"] = *unstrippedWordCount - statistics.wordCount;
+			}
+
+			nlohmann::json& functionArray = finalDoc["functions"];
+			functionArray = nlohmann::json::array();
+			for (const auto& function : statistics.functions)
+			{
+				nlohmann::json functionDoc = CountersToJson(function.counters);
+				functionDoc["id"] = function.id;
+				functionDoc["name"] = function.name;
+
+				functionArray.push_back(std::move(functionDoc));
+			}
+
+			std::string statsStr = finalDoc.dump(4);
+			// Don't mix statistics with the generated code
+			if (m_outputToStdout)
+			{
+				fmt::print(stderr, "{}\n", statsStr);
+				return;
+			}
+
+			outputPath.replace_extension("spv.stats.json");
+			OutputFile(std::move(outputPath), statsStr.data(), statsStr.size());
+		}
+		else
+		{
+			// Statistics are printed to stderr, stdout may receive the generated code
+			auto PrintCounters = [&](std::string_view title, const nzsl::SpirvStatisticsCollector::Counters& counters)
+			{
+				fmt::print(stderr, "{}: {} instructions, {} words ({} types, {} constants, {} loads, {} stores, {} access chains, {} branches)\n", title, counters.instructionCount, counters.wordCount, counters.typeCount, counters.constantCount, counters.loadCount, counters.storeCount, counters.accessChainCount, counters.branchCount);
+				for (auto&& [op, count] : counters.opCounts)
+					fmt::print(stderr, "    {}: {}\n", GetOpName(op), count);
+			};
+
+			fmt::print(stderr, "SPIR-V statistics ({} words, id bound: {}):\n", statistics.wordCount, statistics.idBound);
+			if (unstrippedWordCount)
+				fmt::print(stderr, "- stripping saved {} words ({} words before, -{}%)\n", *unstrippedWordCount - statistics.wordCount, *unstrippedWordCount, 100 * (*unstrippedWordCount - statistics.wordCount) / std::max<std::size_t>(*unstrippedWordCount, 1));
+
+			PrintCounters("- module", statistics.module);
+			for (const auto& function : statistics.functions)
+				PrintCounters(fmt::format("- function {} (%{})", (!function.name.empty()) ? function.name : "<unnamed>", function.id), function.counters);
+		}
+	}
+
 	void Compiler::Sanitize()
 	{
 		using namespace std::literals;
@@ -8,10 +8,13 @@
 #define NZSLC_COMPILER_HPP
 
 #include <NZSL/Config.hpp>
+#include <NZSL/Enums.hpp>
+#include <NZSL/ShaderWriter.hpp>
 #include <NZSL/Lang/Errors.hpp>
 #include <NZSL/Ast/Module.hpp>
 #include <cxxopts.hpp>
 #include <filesystem>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -47,11 +50,14 @@ namespace nzslc
 			};
 
 		private:
+			nzsl::ShaderWriter::States BuildWriterStates() const;
 			void Compile();
 			void CompileToGLSL(std::filesystem::path outputPath, const nzsl::Ast::Module& module);
 			void CompileToNZSL(std::filesystem::path outputPath, const nzsl::Ast::Module& module);
 			void CompileToNZSLB(std::filesystem::path outputPath, const nzsl::Ast::Module& module);
 			void CompileToSPV(std::filesystem::path outputPath, const nzsl::Ast::Module& module, bool textual);
+			void Optimize();
+			void OutputSpirvStatistics(std::filesystem::path outputPath, const std::vector<std::uint32_t>& spirv, std::optional<std::size_t> unstrippedWordCount);
 			void PrintTime();
 			void OutputFile(std::filesystem::path filePath, const void* data, std::size_t size);
 			void OutputToStdout(std::string_view str);
@@ -80,7 +86,9 @@ namespace nzslc
 			std::vector<StepTime> m_steps;
 			LogFormat m_logFormat;
 			nzsl::Ast::ModulePtr m_shaderModule;
+			nzsl::OptimizationLevel m_optimizationLevel;
 			cxxopts::ParseResult& m_options;
+			bool m_isModuleOptimized;
 			bool m_profiling;
 			bool m_outputHeader;
 			bool m_outputToStdout;
@@ -0,0 +1,205 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/Parser.hpp>
+#include <catch2/catch.hpp>
+#include <cctype>
+
+TEST_CASE("Bitwise", "[Shader]")
+{
+	SECTION("Bitwise operators")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let x = 5;
+	let y = 3;
+
+	let r = x & y;
+	let r = x | y;
+	let r = x ^ y;
+	let r = x << y;
+	let r = x >> y;
+	let r = ~x;
+	let r = ~(x | y);
+	let r = x & y == x;
+
+	let v = vec2[i32](5, 7);
+	let r = v & v;
+	let r = v >> y;
+
+	let z = x;
+	z &= y;
+	z |= y;
+	z ^= y;
+	z <<= y;
+	z >>= y;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		ExpectGLSL(*shaderModule, R"(
+void main()
+{
+	int x = 5;
+	int y = 3;
+	int r = x & y;
+	int r_2 = x | y;
+	int r_3 = x ^ y;
+	int r_4 = x << y;
+	int r_5 = x >> y;
+	int r_6 = ~x;
+	int r_7 = ~(x | y);
+	bool r_8 = (x & y) == x;
+	ivec2 v = ivec2(5, 7);
+	ivec2 r_9 = v & v;
+	ivec2 r_10 = v >> y;
+	int z = x;
+	z &= y;
+	z |= y;
+	z ^= y;
+	z <<= y;
+	z >>= y;
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+[entry(frag)]
+fn main()
+{
+	let x: i32 = 5;
+	let y: i32 = 3;
+	let r: i32 = x & y;
+	let r: i32 = x | y;
+	let r: i32 = x ^ y;
+	let r: i32 = x << y;
+	let r: i32 = x >> y;
+	let r: i32 = ~x;
+	let r: i32 = ~(x | y);
+	let r: bool = (x & y) == x;
+	let v: vec2[i32] = vec2[i32](5, 7);
+	let r: vec2[i32] = v & v;
+	let r: vec2[i32] = v >> y;
+	let z: i32 = x;
+	z &= y;
+	z |= y;
+	z ^= y;
+	z <<= y;
+	z >>= y;
+}
+)");
+
+		ExpectSPIRV(*shaderModule, "OpBitwiseAnd");
+		ExpectSPIRV(*shaderModule, "OpBitwiseOr");
+		ExpectSPIRV(*shaderModule, "OpBitwiseXor");
+		ExpectSPIRV(*shaderModule, "OpShiftLeftLogical");
+		ExpectSPIRV(*shaderModule, "OpShiftRightArithmetic");
+		ExpectSPIRV(*shaderModule, "OpNot");
+		ExpectSPIRV(*shaderModule, "OpCompositeConstruct");
+	}
+
+	SECTION("Bit manipulation intrinsics")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	value: u32,
+	color: vec4[f32],
+	pair: vec2[f32]
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let r = count_bits(data.value);
+	let r = first_bit_high(data.value);
+	let r = first_bit_low(data.value);
+	let r = bitfield_extract(data.value, 4, 8);
+	let r = bitfield_insert(data.value, data.value, 0, 4);
+	let r = pack_unorm4x8(data.color);
+	let r = pack_half2x16(data.pair);
+	let r = unpack_unorm4x8(data.value);
+	let r = unpack_half2x16(data.value);
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 3;
+		glslEnv.glMinorVersion = 1;
+		glslEnv.glES = true;
+
+		ExpectGLSL(*shaderModule, R"(
+void main()
+{
+	int r = bitCount(data.value);
+	int r_2 = findMSB(data.value);
+	int r_3 = findLSB(data.value);
+	uint r_4 = bitfieldExtract(data.value, 4, 8);
+	uint r_5 = bitfieldInsert(data.value, data.value, 0, 4);
+	uint r_6 = packUnorm4x8(data.color);
+	uint r_7 = packHalf2x16(data.pair);
+	vec4 r_8 = unpackUnorm4x8(data.value);
+	vec2 r_9 = unpackHalf2x16(data.value);
+}
+)", glslEnv);
+
+		WHEN("Targeting OpenGL 3.3")
+		{
+			nzsl::GlslWriter::Environment desktopEnv;
+			desktopEnv.glMajorVersion = 3;
+			desktopEnv.glMinorVersion = 3;
+			desktopEnv.glES = false;
+			desktopEnv.extCallback = [](std::string_view extName)
+			{
+				return extName == "GL_ARB_gpu_shader5" || extName == "GL_ARB_shading_language_packing";
+			};
+
+			ExpectGLSL(*shaderModule, R"(
+#extension GL_ARB_gpu_shader5 : require
+)", desktopEnv, false);
+
+			ExpectGLSL(*shaderModule, R"(
+#extension GL_ARB_shading_language_packing : require
+)", desktopEnv, false);
+		}
+
+		ExpectNZSL(*shaderModule, R"(
+	let r: i32 = count_bits(data.value);
+	let r: i32 = first_bit_high(data.value);
+	let r: i32 = first_bit_low(data.value);
+	let r: u32 = bitfield_extract(data.value, 4, 8);
+	let r: u32 = bitfield_insert(data.value, data.value, 0, 4);
+	let r: u32 = pack_unorm4x8(data.color);
+	let r: u32 = pack_half2x16(data.pair);
+	let r: vec4[f32] = unpack_unorm4x8(data.value);
+	let r: vec2[f32] = unpack_half2x16(data.value);
+)");
+
+		ExpectSPIRV(*shaderModule, "OpBitCount");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 FindUMsb");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 FindILsb");
+		ExpectSPIRV(*shaderModule, "OpBitFieldUExtract");
+		ExpectSPIRV(*shaderModule, "OpBitFieldInsert");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 PackUnorm4x8");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 PackHalf2x16");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 UnpackUnorm4x8");
+		ExpectSPIRV(*shaderModule, "GLSLstd450 UnpackHalf2x16");
+	}
+}
@@ -0,0 +1,404 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/Ast/ConstantPropagationVisitor.hpp>
+#include <catch2/catch.hpp>
+
+TEST_CASE("compute", "[Shader]")
+{
+	WHEN("using a compute shader with workgroup-shared memory")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	counter: i32,
+	values: array[f32, 64]
+}
+
+external
+{
+	[set(0), binding(0)] data: storage[Data],
+	[workgroup] tile: array[f32, 64]
+}
+
+struct CompIn
+{
+	[builtin(global_invocation_id)] globalId: vec3[u32],
+	[builtin(local_invocation_index)] localIndex: u32
+}
+
+[entry(compute), workgroup(64, 1, 1)]
+fn main(input: CompIn)
+{
+	tile[input.localIndex] = data.values[input.globalId.x];
+	barrier();
+	atomic_add(data.counter, 1);
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 3;
+		glslEnv.glMinorVersion = 1;
+		glslEnv.glES = true;
+
+		ExpectGLSL(*shaderModule, R"(
+shared float tile[64];
+)", glslEnv);
+
+		ExpectGLSL(*shaderModule, R"(
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+	CompIn input_;
+	input_.globalId = gl_GlobalInvocationID;
+	input_.localIndex = gl_LocalInvocationIndex;
+
+	tile[input_.localIndex] = data.values[input_.globalId.x];
+	barrier();
+	atomicAdd(data.counter, 1);
+}
+)", glslEnv);
+
+		ExpectNZSL(*shaderModule, R"(
+external
+{
+	[set(0), binding(0)] data: storage[Data],
+	[workgroup] tile: array[f32, 64]
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+[entry(compute), workgroup(64, 1, 1)]
+fn main(input: CompIn)
+{
+	tile[input.localIndex] = data.values[input.globalId.x];
+	barrier();
+	atomic_add(data.counter, 1);
+}
+)");
+
+		ExpectSPIRV(*shaderModule, R"(
+OpControlBarrier
+OpAccessChain
+OpAtomicIAdd
+OpReturn
+OpFunctionEnd)");
+	}
+
+	WHEN("using subgroup operations")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+[feature(subgroups)]
+module;
+
+[layout(std430)]
+struct Data
+{
+	values: dyn_array[u32]
+}
+
+external
+{
+	[set(0), binding(0)] data: storage[Data]
+}
+
+struct CompIn
+{
+	[builtin(global_invocation_id)] globalId: vec3[u32],
+	[builtin(subgroup_local_invocation_id)] laneId: u32,
+	[builtin(subgroup_size)] laneCount: u32
+}
+
+[entry(compute), workgroup(64, 1, 1)]
+fn main(input: CompIn)
+{
+	let value = data.values[input.globalId.x];
+	let isFirst = subgroup_elect();
+	let mask = subgroup_ballot(isFirst);
+	let first = subgroup_broadcast_first(value);
+	let sum = subgroup_add(value);
+	let highest = subgroup_max(value);
+	let lowest = subgroup_min(value);
+	let neighbor = subgroup_shuffle(value, input.laneCount - input.laneId);
+	data.values[input.globalId.x] = neighbor;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 4;
+		glslEnv.glMinorVersion = 5;
+		glslEnv.extCallback = [](std::string_view extName)
+		{
+			return extName.substr(0, 22) == "GL_KHR_shader_subgroup";
+		};
+
+		ExpectGLSL(*shaderModule, R"(
+#extension GL_KHR_shader_subgroup_basic : require
+#extension GL_KHR_shader_subgroup_ballot : require
+#extension GL_KHR_shader_subgroup_arithmetic : require
+#extension GL_KHR_shader_subgroup_shuffle : require
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	input_.laneId = gl_SubgroupInvocationID;
+	input_.laneCount = gl_SubgroupSize;
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	uint value = data.values[input_.globalId.x];
+	bool isFirst = subgroupElect();
+	uvec4 mask = subgroupBallot(isFirst);
+	uint first = subgroupBroadcastFirst(value);
+	uint sum = subgroupAdd(value);
+	uint highest = subgroupMax(value);
+	uint lowest = subgroupMin(value);
+	uint neighbor = subgroupShuffle(value, input_.laneCount - input_.laneId);
+	data.values[input_.globalId.x] = neighbor;
+)", glslEnv, false);
+
+		WHEN("the extensions are not supported")
+		{
+			nzsl::GlslWriter::Environment unsupportedEnv;
+			unsupportedEnv.glMajorVersion = 4;
+			unsupportedEnv.glMinorVersion = 5;
+
+			nzsl::GlslWriter writer;
+			writer.SetEnv(unsupportedEnv);
+			CHECK_THROWS_WITH(writer.Generate(*shaderModule), "this version of OpenGL does not support subgroup operations");
+		}
+
+		ExpectNZSL(*shaderModule, R"(
+[feature(subgroups)]
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+	let value: u32 = data.values[input.globalId.x];
+	let isFirst: bool = subgroup_elect();
+	let mask: vec4[u32] = subgroup_ballot(isFirst);
+	let first: u32 = subgroup_broadcast_first(value);
+	let sum: u32 = subgroup_add(value);
+	let highest: u32 = subgroup_max(value);
+	let lowest: u32 = subgroup_min(value);
+	let neighbor: u32 = subgroup_shuffle(value, input.laneCount - input.laneId);
+	data.values[input.globalId.x] = neighbor;
+)");
+
+		WHEN("Generating SPIR-V 1.0")
+		{
+			nzsl::SpirvWriter spirvWriter;
+			CHECK_THROWS_WITH(spirvWriter.Generate(*shaderModule), "subgroup operations require SPIR-V 1.3");
+		}
+
+		nzsl::SpirvWriter::Environment spirvEnv;
+		spirvEnv.spvMajorVersion = 1;
+		spirvEnv.spvMinorVersion = 3;
+
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(GroupNonUniform)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(GroupNonUniformArithmetic)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(GroupNonUniformBallot)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(GroupNonUniformShuffle)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "BuiltIn(SubgroupLocalInvocationId)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "BuiltIn(SubgroupSize)", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformBallot", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformBroadcastFirst", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformIAdd", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformUMax", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformUMin", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformShuffle", spirvEnv);
+		ExpectSPIRV(*shaderModule, "OpGroupNonUniformElect", spirvEnv);
+	}
+
+	WHEN("using storage images")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0), access(readonly)] inputImage: image2D[f32, rgba16f],
+	[binding(1), access(writeonly)] outputImage: image2D[f32, rgba16f],
+	[binding(2)] histogram: image2D[u32, r32ui]
+}
+
+struct CompIn
+{
+	[builtin(global_invocation_id)] globalId: vec3[u32]
+}
+
+[entry(compute), workgroup(8, 8, 1)]
+fn main(input: CompIn)
+{
+	let coords = vec2[i32](4, 2);
+	let color = inputImage.Load(coords);
+	outputImage.Store(coords, color);
+	histogram.AtomicAdd(vec2[i32](0, 0), input.globalId.x);
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 4;
+		glslEnv.glMinorVersion = 5;
+
+		ExpectGLSL(*shaderModule, R"(
+layout(rgba16f) readonly uniform image2D inputImage;
+layout(rgba16f) writeonly uniform image2D outputImage;
+layout(r32ui) uniform uimage2D histogram;
+)", glslEnv);
+
+		ExpectGLSL(*shaderModule, R"(
+	ivec2 coords = ivec2(4, 2);
+	vec4 color = imageLoad(inputImage, coords);
+	imageStore(outputImage, coords, color);
+	imageAtomicAdd(histogram, ivec2(0, 0), input_.globalId.x);
+)", glslEnv);
+
+		WHEN("image load/store is not supported")
+		{
+			nzsl::GlslWriter::Environment unsupportedEnv;
+			unsupportedEnv.glMajorVersion = 3;
+			unsupportedEnv.glMinorVersion = 3;
+
+			nzsl::GlslWriter writer;
+			writer.SetEnv(unsupportedEnv);
+			CHECK_THROWS_WITH(writer.Generate(*shaderModule), "this version of OpenGL does not support image load/store");
+		}
+
+		ExpectNZSL(*shaderModule, R"(
+external
+{
+	[set(0), binding(0), access(readonly)] inputImage: image2D[f32, rgba16f],
+	[set(0), binding(1), access(writeonly)] outputImage: image2D[f32, rgba16f],
+	[set(0), binding(2)] histogram: image2D[u32, r32ui]
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+	let coords: vec2[i32] = vec2[i32](4, 2);
+	let color: vec4[f32] = inputImage.Load(coords);
+	outputImage.Store(coords, color);
+	histogram.AtomicAdd(vec2[i32](0, 0), input.globalId.x);
+)");
+
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpVariable
+OpVariable
+OpAccessChain
+OpCopyMemory
+OpCompositeConstruct
+OpStore
+OpLoad
+OpLoad
+OpImageRead
+OpStore
+OpLoad
+OpLoad
+OpLoad
+OpImageWrite
+OpCompositeConstruct
+OpAccessChain
+OpLoad
+OpCompositeExtract
+OpImageTexelPointer
+OpAtomicIAdd
+OpReturn
+OpFunctionEnd)");
+	}
+
+	WHEN("propagating constants around workgroup variables and atomics")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	first: i32,
+	second: i32
+}
+
+external
+{
+	[set(0), binding(0)] data: storage[Data],
+	[workgroup] counter: i32
+}
+
+[entry(compute), workgroup(64, 1, 1)]
+fn main()
+{
+	counter = 0;
+	barrier();
+	let v = counter;
+	atomic_add(counter, 1);
+	data.first = v;
+	data.second = counter;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+		REQUIRE_NOTHROW(shaderModule = nzsl::Ast::PropagateConstants(*shaderModule));
+
+		// Workgroup variables may be written by other invocations, their value must not be propagated
+		ExpectNZSL(*shaderModule, R"(
+[entry(compute), workgroup(64, 1, 1)]
+fn main()
+{
+	counter = 0;
+	barrier();
+	let v: i32 = counter;
+	atomic_add(counter, 1);
+	data.first = v;
+	data.second = counter;
+}
+)");
+
+		ExpectSPIRV(*shaderModule, "OpAtomicIAdd");
+	}
+
+	WHEN("propagating constants through a local variable modified by an atomic operation")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[entry(compute), workgroup(64, 1, 1)]
+fn main()
+{
+	let value = 0;
+	let before = value;
+	atomic_add(value, 1);
+	let after = value;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+		REQUIRE_NOTHROW(shaderModule = nzsl::Ast::PropagateConstants(*shaderModule));
+
+		ExpectNZSL(*shaderModule, R"(
+	let value: i32 = 0;
+	let before: i32 = 0;
+	atomic_add(value, 1);
+	let after: i32 = value;
+)");
+	}
+}
@@ -310,7 +310,27 @@ external
 {
 	[binding(0)] data: mat4[f32]
 }
-)"), "(7,15 -> 29): CExtTypeNotAllowed error: external variable data has unauthorized type (mat4[f32]): only storage buffers, samplers and uniform buffers (and primitives, vectors and matrices if primitive external feature is enabled) are allowed in external blocks");
+)"), "(7,15 -> 29): CExtTypeNotAllowed error: external variable data has unauthorized type (mat4[f32]): only storage buffers, storage images, samplers and uniform buffers (and primitives, vectors and matrices if primitive external feature is enabled) are allowed in external blocks");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+fn main()
+{
+	let b = subgroup_elect();
+}
+)"), "(7,10 -> 25): CFeatureRequired error: this requires the subgroups feature to be enabled");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Input
+{
+	[builtin(subgroup_size)] size: u32
+}
+)"), "(7,27 -> 30): CFeatureRequired error: this requires the subgroups feature to be enabled");
 		}
 
 		/************************************************************************/
@@ -356,6 +376,101 @@ fn main()
 	let b = inverse(a);
 }
 )"), "(8, 18): CIntrinsicExpectedType error: expected type square matrix for parameter #0, got mat2x3[f32]");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] tex: samplerCube[f32]
+}
+
+fn main()
+{
+	let texel = tex.Fetch(vec3[i32](0, 0, 0), 0);
+}
+)"), "(12,14 -> 16): CSamplerUnexpectedDim error: sampler type samplerCube[f32] does not support this operation");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] tex: sampler2D[f32]
+}
+
+fn main()
+{
+	let component = 1;
+	let texel = tex.Gather(vec2[f32](0.0, 0.0), component);
+}
+)"), "(13,46 -> 54): CConstantExpressionRequired error: a constant expression is required in this context");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] tex: sampler2D[f32]
+}
+
+fn main()
+{
+	let texel = tex.Gather(vec2[f32](0.0, 0.0), 4);
+}
+)"), "(12, 46): CSamplerGatherComponentOutOfRange error: gathered component must be between 0 and 3 (got 4)");
+		}
+
+		/************************************************************************/
+
+		SECTION("Layouts")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	flag: bool
+}
+)"), "(8,2 -> 5): CStructLayoutTypeNotAllowed error: bool type is not allowed in std430 layout");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Inner
+{
+	value: f32
+}
+
+[layout(std140)]
+struct Outer
+{
+	inner: Inner
+}
+)"), "(14,2 -> 6): CStructLayoutInnerMismatch error: inner struct layout mismatch, struct is declared with std140 but field has layout std430");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+)"), "(13,15 -> 33): CExtUniformLayoutNotAllowed error: uniform buffer data cannot use std430 layout, which is only allowed for storage buffers");
 		}
 
 		/************************************************************************/
@@ -462,6 +577,230 @@ option test: bool = 42;
 		}
 		/************************************************************************/
 
+		SECTION("Compute")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[entry(compute)]
+fn main()
+{
+}
+)"), "(6 -> 8,1 -> 1): CWorkgroupSizeMissing error: compute entry-points require the workgroup attribute");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[entry(frag), workgroup(8, 8, 1)]
+fn main()
+{
+}
+)"), "(6 -> 8,1 -> 1): CWorkgroupAttribute error: only compute entry-points can have the workgroup attribute");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+[entry(compute), workgroup(8, 8)]
+fn main()
+{
+}
+)"), "(5,18 -> 32): PAttributeUnexpectedParameterCount error: attribute workgroup expects 3 parameter(s), got 2");
+		}
+
+		/************************************************************************/
+
+		SECTION("Precision")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+fn main()
+{
+	[precision(medium)] let a: i32 = 42;
+}
+)"), "(7,22 -> 37): CPrecisionUnexpectedType error: precision can only be set on floating-point types and samplers (got i32)");
+		}
+
+		/************************************************************************/
+
+		SECTION("Push constants")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0)] data: push_constant[Data]
+}
+)"), "(12,15 -> 39): CExtPushConstantBinding error: push constant external variable data cannot have a binding");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	values: array[vec4[f32], 16]
+}
+
+external
+{
+	data: push_constant[Data]
+}
+)"), "(12,2 -> 26): CExtPushConstantTooLarge error: push constant external variable data takes 256 bytes, which exceeds the limit of 128 bytes");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	data: push_constant[Data],
+	other: push_constant[Data]
+}
+)"), "(13,2 -> 27): CExtPushConstantAlreadyDeclared error: push constant external variable other cannot be declared, data is already the push constant block");
+		}
+
+		/************************************************************************/
+
+		SECTION("Storage access")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0), access(readonly)] data: uniform[Data]
+}
+)"), "(12,33 -> 51): CExtAccessNotAllowed error: external variable data cannot have access or restrict attributes, which are only allowed for storage buffers and storage images (got uniform[Data])");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0), access(readonly)] data: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	data.value = 42.0;
+}
+)"), "(18,2 -> 18): CStorageReadOnlyStore error: read-only storage buffers and images cannot be written to");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0), access(writeonly)] data: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = data.value;
+}
+)"), "(18,14 -> 17): CStorageWriteOnlyLoad error: write-only storage buffers and images cannot be read from");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	value: vec4[f32]
+}
+
+external
+{
+	[binding(0), access(writeonly)] data: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	data.value.xy = vec2[f32](1.0, 2.0);
+}
+)"), "(18,2 -> 36): CStorageWriteOnlySwizzleStore error: write-only storage buffers cannot be written through a multi-component swizzle");
+		}
+
+		/************************************************************************/
+
+		SECTION("Storage images")
+		{
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] img: image2D[f32, rgb9]
+}
+)"), "(7,33 -> 36): CStorageImageUnknownFormat error: unknown image format rgb9");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] img: image2D[f32, rgba16f]
+}
+
+[entry(compute), workgroup(1, 1, 1)]
+fn main()
+{
+	img.AtomicAdd(vec2[i32](0, 0), 1.0);
+}
+)"), "(12,2 -> 4): CStorageImageAtomicFormat error: atomic operations on storage images require a r32i or r32ui format (got image2D[f32, rgba16f])");
+
+			CHECK_THROWS_WITH(Compile(R"(
+[nzsl_version("1.0")]
+module;
+
+fn store(img: image2D[f32, rgba16f])
+{
+}
+)"), "(5,10 -> 35): CFunctionParameterStorageImage error: function parameter img cannot be a storage image, which must be accessed through its external variable (got image2D[f32, rgba16f])");
+		}
+
+		/************************************************************************/
+
 		SECTION("Variables")
 		{
 			CHECK_THROWS_WITH(Compile(R"(
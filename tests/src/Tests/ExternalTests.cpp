@@ -70,6 +70,89 @@ fn main()
       OpReturn
       OpFunctionEnd)", {}, true);
 	}
+
+	SECTION("Texture fetch, gather, LOD and gradients")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+external
+{
+	[binding(0)] tex: sampler2D[f32]
+}
+
+[entry(frag)]
+fn main()
+{
+	let uv = vec2[f32](0.5, 0.5);
+	let lod = tex.SampleLod(uv, 2.0);
+	let grad = tex.SampleGrad(uv, vec2[f32](0.25, 0.0), vec2[f32](0.0, 0.25));
+	let texel = tex.Fetch(vec2[i32](4, 2), 0);
+	let taps = tex.Gather(uv);
+	let alphaTaps = tex.Gather(uv, 3);
+	let size = tex.Size(0);
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 3;
+		glslEnv.glMinorVersion = 1;
+		glslEnv.glES = true;
+
+		ExpectGLSL(*shaderModule, R"(
+void main()
+{
+	vec2 uv = vec2(0.5, 0.5);
+	vec4 lod = textureLod(tex, uv, 2.0);
+	vec4 grad = textureGrad(tex, uv, vec2(0.25, 0.0), vec2(0.0, 0.25));
+	vec4 texel = texelFetch(tex, ivec2(4, 2), 0);
+	vec4 taps = textureGather(tex, uv);
+	vec4 alphaTaps = textureGather(tex, uv, 3);
+	ivec2 size = textureSize(tex, 0);
+}
+)", glslEnv);
+
+		WHEN("Targeting OpenGL 3.3")
+		{
+			nzsl::GlslWriter::Environment desktopEnv;
+			desktopEnv.glMajorVersion = 3;
+			desktopEnv.glMinorVersion = 3;
+			desktopEnv.glES = false;
+			desktopEnv.extCallback = [](std::string_view extName)
+			{
+				return extName == "GL_ARB_gpu_shader5" || extName == "GL_ARB_texture_gather";
+			};
+
+			ExpectGLSL(*shaderModule, R"(
+#extension GL_ARB_gpu_shader5 : require
+)", desktopEnv, false);
+
+			ExpectGLSL(*shaderModule, R"(
+#extension GL_ARB_texture_gather : require
+)", desktopEnv, false);
+		}
+
+		ExpectNZSL(*shaderModule, R"(
+	let uv: vec2[f32] = vec2[f32](0.5, 0.5);
+	let lod: vec4[f32] = tex.SampleLod(uv, 2.0);
+	let grad: vec4[f32] = tex.SampleGrad(uv, vec2[f32](0.25, 0.0), vec2[f32](0.0, 0.25));
+	let texel: vec4[f32] = tex.Fetch(vec2[i32](4, 2), 0);
+	let taps: vec4[f32] = tex.Gather(uv);
+	let alphaTaps: vec4[f32] = tex.Gather(uv, 3);
+	let size: vec2[i32] = tex.Size(0);
+)");
+
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(ImageQuery)");
+		ExpectSPIRV(*shaderModule, "OpImageSampleExplicitLod");
+		ExpectSPIRV(*shaderModule, "OpImage ");
+		ExpectSPIRV(*shaderModule, "OpImageFetch");
+		ExpectSPIRV(*shaderModule, "OpImageGather");
+		ExpectSPIRV(*shaderModule, "OpImageQuerySizeLod");
+	}
 	
 	SECTION("Uniform buffers")
 	{
@@ -295,6 +378,64 @@ fn main()
       OpFunctionEnd)", spirvEnv, true);
 			}
 		}
+
+
+		SECTION("With std430 layout")
+		{
+			std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	values: array[f32, 47]
+}
+
+external
+{
+	[binding(0)] data: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = data.values[42];
+}
+)";
+
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+			shaderModule = SanitizeModule(*shaderModule);
+
+			nzsl::GlslWriter::Environment glslEnv;
+			glslEnv.glMajorVersion = 3;
+			glslEnv.glMinorVersion = 1;
+
+			ExpectGLSL(*shaderModule, R"(
+layout(std430) buffer _nzslBinding_data
+{
+	float values[47];
+} data;
+)", glslEnv);
+
+			ExpectNZSL(*shaderModule, R"(
+[layout(std430)]
+struct Data
+{
+	values: array[f32, 47]
+}
+)");
+
+			nzsl::SpirvWriter::Environment spirvEnv;
+			spirvEnv.spvMajorVersion = 1;
+			spirvEnv.spvMinorVersion = 3;
+
+			ExpectSPIRV(*shaderModule, R"(
+      OpMemberDecorate %5 0 Decoration(Offset) 0
+      OpDecorate %6 Decoration(ArrayStride) 4
+      OpDecorate %7 Decoration(Block)
+      OpMemberDecorate %7 0 Decoration(Offset) 0)", spirvEnv, true);
+		}
 		
 		SECTION("With dynamically sized arrays")
 		{
@@ -450,6 +591,237 @@ fn main()
       OpFunctionEnd)", spirvEnv, true);
 			}
 		}
+
+		SECTION("With access qualifiers")
+		{
+			std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+struct Data
+{
+	values: array[f32, 47]
+}
+
+external
+{
+	[binding(0), access(readonly), restrict] inData: storage[Data],
+	[binding(1), access(writeonly)] outData: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	outData.values[0] = inData.values[42];
+}
+)";
+
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+			shaderModule = SanitizeModule(*shaderModule);
+
+			nzsl::GlslWriter::Environment glslEnv;
+			glslEnv.glMajorVersion = 3;
+			glslEnv.glMinorVersion = 1;
+
+			ExpectGLSL(*shaderModule, R"(
+readonly restrict buffer _nzslBinding_inData
+{
+	float values[47];
+} inData;
+
+writeonly buffer _nzslBinding_outData
+{
+	float values[47];
+} outData;
+
+void main()
+{
+	outData.values[0] = inData.values[42];
+}
+)", glslEnv);
+
+			ExpectNZSL(*shaderModule, R"(
+external
+{
+	[set(0), binding(0), access(readonly), restrict] inData: storage[Data],
+	[set(0), binding(1), access(writeonly)] outData: storage[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	outData.values[0] = inData.values[42];
+})");
+
+			ExpectSPIRV(*shaderModule, "Decoration(NonWritable)");
+			ExpectSPIRV(*shaderModule, "Decoration(NonReadable)");
+			ExpectSPIRV(*shaderModule, "Decoration(Restrict)");
+		}
+	}
+
+	SECTION("Descriptor arrays")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	values: array[f32, 4]
+}
+
+external
+{
+	[binding(0)] textures: dyn_array[sampler2D[f32]],
+	[binding(1)] buffers: array[storage[Data], 4]
+}
+
+struct FragIn
+{
+	[location(0)] uv: vec2[f32]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+[entry(frag)]
+fn main(input: FragIn) -> FragOut
+{
+	let index = u32(input.uv.x * 4.0);
+	let value = buffers[non_uniform(index)].values[2];
+
+	let output: FragOut;
+	output.color = textures[non_uniform(index)].Sample(input.uv) * value;
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.glMajorVersion = 3;
+		glslEnv.glMinorVersion = 1;
+		glslEnv.extCallback = [](std::string_view extName)
+		{
+			return extName == "GL_EXT_nonuniform_qualifier";
+		};
+
+		ExpectGLSL(*shaderModule, R"(
+#extension GL_EXT_nonuniform_qualifier : require
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+uniform sampler2D textures[];
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+layout(std430) buffer _nzslBinding_buffers
+{
+	float values[4];
+} buffers[4];
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	float value = buffers[nonuniformEXT(index)].values[2];
+)", glslEnv, false);
+
+		ExpectNZSL(*shaderModule, R"(
+external
+{
+	[set(0), binding(0)] textures: dyn_array[sampler2D[f32]],
+	[set(0), binding(1)] buffers: array[storage[Data], 4]
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+	let value: f32 = buffers[non_uniform(index)].values[2];
+)");
+
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(ShaderNonUniform)");
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(RuntimeDescriptorArray)");
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(SampledImageArrayNonUniformIndexing)");
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(StorageBufferArrayNonUniformIndexing)");
+		ExpectSPIRV(*shaderModule, R"(OpExtension "SPV_EXT_descriptor_indexing")");
+		ExpectSPIRV(*shaderModule, "OpTypeRuntimeArray");
+		ExpectSPIRV(*shaderModule, "OpCopyObject");
+		ExpectSPIRV(*shaderModule, "Decoration(NonUniform)");
+	}
+
+	SECTION("Push constants")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	color: vec4[f32],
+	scale: f32
+}
+
+external
+{
+	data: push_constant[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = data.color * data.scale;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		ExpectGLSL(*shaderModule, R"(
+layout(std140) uniform _nzslPushConstant_data
+{
+	vec4 color;
+	float scale;
+} data;
+
+void main()
+{
+	vec4 value = data.color * data.scale;
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+external
+{
+	data: push_constant[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value: vec4[f32] = data.color * data.scale;
+})");
+
+		ExpectSPIRV(*shaderModule, R"(
+      OpMemberDecorate %3 0 Decoration(Offset) 0
+      OpMemberDecorate %3 1 Decoration(Offset) 16
+      OpDecorate %4 Decoration(Block)
+      OpMemberDecorate %4 0 Decoration(Offset) 0
+      OpMemberDecorate %4 1 Decoration(Offset) 16
+ %1 = OpTypeFloat 32
+ %2 = OpTypeVector %1 4
+ %3 = OpTypeStruct %2 %1
+ %4 = OpTypeStruct %2 %1
+ %5 = OpTypePointer StorageClass(PushConstant) %4)", {}, true);
+
+		WHEN("Generating GLSL")
+		{
+			nzsl::GlslWriter writer;
+			nzsl::GlslWriter::Output output = writer.Generate(*shaderModule);
+			CHECK(output.pushConstantBlockName == "_nzslPushConstant_data");
+		}
 	}
 
 	SECTION("Primitive external")
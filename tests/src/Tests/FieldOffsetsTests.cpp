@@ -18,4 +18,62 @@ TEST_CASE("Field offsets", "[FieldOffsets]")
 		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float3) == 400);
 		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float3) == 416);
 	}
+
+	GIVEN("Std140 arrays")
+	{
+		// Array elements and matrix columns are rounded up to vec4 alignment
+		nzsl::FieldOffsets fieldOffsets(nzsl::StructLayout::Std140);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 0);
+		REQUIRE(fieldOffsets.AddFieldArray(nzsl::StructFieldType::Float1, 4) == 16);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 80);
+		REQUIRE(fieldOffsets.AddMatrix(nzsl::StructFieldType::Float1, 3, 3, true) == 96);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 144);
+		REQUIRE(fieldOffsets.GetAlignedSize() == 160);
+	}
+
+	GIVEN("Std430 fields")
+	{
+		nzsl::FieldOffsets fieldOffsets(nzsl::StructLayout::Std430);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 0);
+		REQUIRE(fieldOffsets.AddFieldArray(nzsl::StructFieldType::Float1, 4) == 4);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float3) == 32);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 44);
+		REQUIRE(fieldOffsets.AddFieldArray(nzsl::StructFieldType::Float3, 2) == 48);
+		REQUIRE(fieldOffsets.AddMatrix(nzsl::StructFieldType::Float1, 2, 2, true) == 80);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 96);
+
+		nzsl::FieldOffsets innerStruct(nzsl::StructLayout::Std430);
+		REQUIRE(innerStruct.AddField(nzsl::StructFieldType::Float1) == 0);
+		REQUIRE(innerStruct.AddField(nzsl::StructFieldType::Float3) == 16);
+		REQUIRE(innerStruct.GetAlignedSize() == 32);
+
+		REQUIRE(fieldOffsets.AddStruct(innerStruct) == 112);
+	}
+
+	GIVEN("Scalar fields")
+	{
+		nzsl::FieldOffsets fieldOffsets(nzsl::StructLayout::Scalar);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float1) == 0);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float3) == 4);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Double1) == 16);
+		REQUIRE(fieldOffsets.AddFieldArray(nzsl::StructFieldType::Float3, 2) == 24);
+		REQUIRE(fieldOffsets.AddMatrix(nzsl::StructFieldType::Float1, 3, 3, true) == 48);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Float2) == 84);
+		REQUIRE(fieldOffsets.GetSize() == 92);
+		REQUIRE(fieldOffsets.GetAlignedSize() == 96);
+	}
+
+	GIVEN("16-bit fields")
+	{
+		nzsl::FieldOffsets fieldOffsets(nzsl::StructLayout::Std430);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Half1) == 0);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Half1) == 2);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Half3) == 8);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::UShort2) == 16);
+		REQUIRE(fieldOffsets.AddField(nzsl::StructFieldType::Short1) == 20);
+		REQUIRE(fieldOffsets.AddFieldArray(nzsl::StructFieldType::Half1, 3) == 22);
+		REQUIRE(fieldOffsets.AddMatrix(nzsl::StructFieldType::Half1, 2, 2, true) == 28);
+		REQUIRE(fieldOffsets.GetSize() == 36);
+		REQUIRE(fieldOffsets.GetAlignedSize() == 40);
+	}
 }
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string_view>
 
 void CheckHeaderMatch(const std::filesystem::path& originalFilepath)
@@ -54,7 +55,7 @@ void CheckHeaderMatch(const std::filesystem::path& originalFilepath)
 	CHECK(headerFile.eof());
 }
 
-void ExecuteCommand(const std::string& command, const std::string& pattern = {})
+void ExecuteCommand(const std::string& command, const std::string& pattern = {}, const std::string& errPattern = {})
 {
 	std::string output;
 	auto ReadStdout = [&](const char* str, std::size_t size)
@@ -85,6 +86,15 @@ void ExecuteCommand(const std::string& command, const std::string& pattern = {})
 
 		CHECK_THAT(output, Catch::Matchers::Matches(pattern));
 	}
+
+	if (!errPattern.empty())
+	{
+		INFO("Full error output: " << errOutput);
+		if (std::size_t i = errOutput.find_first_of("\r\n"); i != errOutput.npos)
+			errOutput.resize(i);
+
+		CHECK_THAT(errOutput, Catch::Matchers::Matches(errPattern));
+	}
 }
 
 TEST_CASE("Standalone compiler", "[NZSLC]")
@@ -130,6 +140,36 @@ TEST_CASE("Standalone compiler", "[NZSLC]")
 		ExecuteCommand("glslangValidator -S frag test_files/Shader.glsl");
 		ExecuteCommand("spirv-val test_files/Shader.spv");
 
+		// Output SPIR-V statistics
+		ExecuteCommand("./nzslc --compile=spv --stats -o test_files -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb", {}, R"(SPIR-V statistics \(\d+ words, id bound: \d+\):)");
+		ExecuteCommand("./nzslc --compile=spv --stats=json -o test_files -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb");
+		CHECK(std::filesystem::exists("test_files/Shader.spv.stats.json"));
+
+		// Strip debug names and compact ids
+		ExecuteCommand("./nzslc --compile=spv --spv-strip=keep-entry-names --stats -o test_files/stripped -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb", {}, R"(SPIR-V statistics \(\d+ words, id bound: \d+\):)");
+		ExecuteCommand("spirv-val test_files/stripped/Shader.spv");
+
+		// Emit source line info
+		ExecuteCommand("./nzslc --compile=spv --spv-line-info -o test_files/lineinfo -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzsl");
+		ExecuteCommand("spirv-val test_files/lineinfo/Shader.spv");
+
+		// Optimizing a module must keep its entry points
+		ExecuteCommand("./nzslc --compile=nzsl,spv -O2 -o test_files/optimized -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb");
+		ExecuteCommand("spirv-val test_files/optimized/Shader.spv");
+		{
+			std::ifstream optimizedFile("test_files/optimized/Shader.nzsl");
+			REQUIRE(optimizedFile);
+
+			std::string optimizedCode((std::istreambuf_iterator<char>(optimizedFile)), std::istreambuf_iterator<char>());
+			CHECK(optimizedCode.find("[entry(frag)]") != std::string::npos);
+		}
+
+		// Statistics don't end up in the generated code when outputting to stdout
+		ExecuteCommand("./nzslc --compile=spv-dis --stats -o @stdout -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb", R"(Version \d\.\d)", R"(SPIR-V statistics \(\d+ words, id bound: \d+\):)");
+
+		// Disassemble a single function
+		ExecuteCommand("./nzslc --compile=spv-dis --spv-dis-functions=main -o @stdout -m ../resources/modules/Color.nzslb -m ../resources/modules/Data/OutputStruct.nzslb -m ../resources/modules/Data/DataStruct.nzslb ../resources/Shader.nzslb", R"(Version \d\.\d)");
+
 		// Check that header version matches original files
 		CheckHeaderMatch("test_files/Shader.glsl");
 		CheckHeaderMatch("test_files/Shader.nzsl");
@@ -3,16 +3,18 @@
 #include <NZSL/Parser.hpp>
 #include <NZSL/Ast/ConstantPropagationVisitor.hpp>
 #include <NZSL/Ast/EliminateUnusedPassVisitor.hpp>
+#include <NZSL/Ast/OptimizationPipeline.hpp>
 #include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <NZSL/Ast/VectorizationVisitor.hpp>
 #include <catch2/catch.hpp>
 #include <cctype>
 
-void PropagateConstantAndExpect(std::string_view sourceCode, std::string_view expectedOptimizedResult)
+void PropagateConstantAndExpect(std::string_view sourceCode, std::string_view expectedOptimizedResult, const nzsl::Ast::ConstantPropagationVisitor::Options& options = {})
 {
 	nzsl::Ast::ModulePtr shaderModule;
 	REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
 	shaderModule = SanitizeModule(*shaderModule);
-	REQUIRE_NOTHROW(shaderModule = nzsl::Ast::PropagateConstants(*shaderModule));
+	REQUIRE_NOTHROW(shaderModule = nzsl::Ast::PropagateConstants(*shaderModule, options));
 
 	ExpectNZSL(*shaderModule, expectedOptimizedResult);
 }
@@ -30,6 +32,24 @@ void EliminateUnusedAndExpect(std::string_view sourceCode, std::string_view expe
 	ExpectNZSL(*shaderModule, expectedOptimizedResult);
 }
 
+void VectorizeAndExpect(std::string_view sourceCode, std::string_view expectedOptimizedResult)
+{
+	nzsl::Ast::ModulePtr shaderModule;
+	REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+	shaderModule = SanitizeModule(*shaderModule);
+	REQUIRE_NOTHROW(shaderModule = nzsl::Ast::Vectorize(*shaderModule));
+
+	ExpectNZSL(*shaderModule, expectedOptimizedResult);
+
+	// Vectorized operations must be supported by every backend
+	nzsl::GlslWriter::Environment glslEnv;
+	glslEnv.glMajorVersion = 3;
+	glslEnv.glMinorVersion = 1;
+
+	ExpectGLSL(*shaderModule, "", glslEnv);
+	ExpectSPIRV(*shaderModule, "");
+}
+
 TEST_CASE("optimizations", "[Shader]")
 {
 	WHEN("propagating constants")
@@ -175,6 +195,122 @@ fn main()
 )");
 	}
 
+	WHEN("propagating constants through local variables")
+	{
+		PropagateConstantAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	value: f32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let x = 2.0;
+	let y = x * 3.0;
+
+	let mode: i32;
+	if (data.value > 0.0)
+		mode = 1;
+	else
+		mode = 1;
+
+	let color = 0.0;
+	if (mode == 1)
+		color = y;
+	else
+		color = data.value;
+
+	let counter = 0;
+	let sum = y;
+	while (counter < 4)
+	{
+		sum += data.value;
+		counter += 1;
+	}
+
+	let z = sum * x;
+	x += 1.0;
+	let w = x;
+
+	let unused = 0;
+	while (w < 0.0)
+		unused = 1;
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	let x: f32 = 2.0;
+	let y: f32 = 6.0;
+	let mode: i32;
+	if (data.value > (0.0))
+	{
+		mode = 1;
+	}
+	else
+	{
+		mode = 1;
+	}
+
+	let color: f32 = 0.0;
+	color = 6.0;
+	let counter: i32 = 0;
+	let sum: f32 = 6.0;
+	while (counter < (4))
+	{
+		sum += data.value;
+		counter += 1;
+	}
+
+	let z: f32 = sum * (2.0);
+	x += 1.0;
+	let w: f32 = 3.0;
+	let unused: i32 = 0;
+}
+)");
+	}
+
+	WHEN("propagating constants through a loop which may not run")
+	{
+		PropagateConstantAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	count: i32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let x = 1.0;
+	for i in 0 -> data.count
+	{
+		x = 2.0;
+	}
+
+	let y = x * 3.0;
+}
+)", R"(
+	let y: f32 = x * (3.0);
+)");
+	}
+
 	WHEN("optimizing out scalar swizzle")
 	{
 		PropagateConstantAndExpect(R"(
@@ -305,6 +441,107 @@ fn main()
 )");
 	}
 
+	WHEN("simplifying algebraic identities")
+	{
+		PropagateConstantAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	fValue: f32,
+	iValue: i32,
+	uValue: u32,
+	vValue: vec3[f32]
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let a = data.fValue * 1.0;
+	let b = 1 * data.iValue + 0;
+	let c = data.iValue * 0;
+	let d = data.vValue - vec3[f32](0.0, 0.0, 0.0);
+	let e = data.fValue + 0.0;
+	let f = -(-data.fValue);
+	let g = pow(data.vValue, vec3[f32](2.0, 2.0, 2.0));
+	let h = normalize(normalize(data.vValue));
+	let i = data.vValue.zyx.zyx;
+	let j = vec3[f32](vec2[f32](1.0, 2.0), 3.0);
+	let k = 2.0 < 1.0;
+	let l = data.uValue % u32(8);
+	let m = data.iValue % 8;
+	let n = data.fValue - (-0.0);
+	let o = data.fValue + (-0.0);
+	let p = -0.0 + data.fValue;
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	let a: f32 = data.fValue;
+	let b: i32 = data.iValue;
+	let c: i32 = 0;
+	let d: vec3[f32] = data.vValue;
+	let e: f32 = data.fValue + (0.0);
+	let f: f32 = data.fValue;
+	let g: vec3[f32] = data.vValue * data.vValue;
+	let h: vec3[f32] = normalize(data.vValue);
+	let i: vec3[f32] = data.vValue;
+	let j: vec3[f32] = vec3[f32](1.0, 2.0, 3.0);
+	let k: bool = false;
+	let l: u32 = data.uValue & (7);
+	let m: i32 = data.iValue % (8);
+	let n: f32 = data.fValue - (-0.0);
+	let o: f32 = data.fValue;
+	let p: f32 = data.fValue;
+}
+)");
+	}
+
+	WHEN("simplifying algebraic identities with unsafe math optimizations")
+	{
+		nzsl::Ast::ConstantPropagationVisitor::Options options;
+		options.allowUnsafeMathOptimizations = true;
+
+		PropagateConstantAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	fValue: f32,
+	vValue: vec3[f32]
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let a = data.fValue + 0.0;
+	let b = data.vValue / 4.0;
+	let c = data.fValue / vec2[f32](2.0, 0.5);
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	let a: f32 = data.fValue;
+	let b: vec3[f32] = data.vValue * (0.25);
+	let c: vec2[f32] = data.fValue * (vec2[f32](0.5, 2.0));
+}
+)", options);
+	}
+
 	WHEN("eliminating unused code")
 	{
 		EliminateUnusedAndExpect(R"(
@@ -372,4 +609,455 @@ fn main() -> Output
 	return output;
 })");
 	}
+
+	WHEN("vectorizing component-wise operations")
+	{
+		VectorizeAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	a: vec4[f32],
+	b: vec4[f32],
+	s: f32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let r: vec4[f32];
+	r.x = data.a.x * data.b.x;
+	r.y = data.a.y * data.b.y;
+	r.z = data.a.z * data.b.z;
+	r.w = data.a.w * data.b.w;
+
+	let v: vec3[f32];
+	v.x = data.a.x * data.s + 1.0;
+	v.y = data.a.y * data.s + 2.0;
+	v.z = -data.b.z;
+
+	let c = vec2[f32](data.a.z - data.b.x, data.a.w - data.b.y);
+
+	let d: vec2[f32];
+	d.x = data.a.x;
+	d.y = d.x * 2.0;
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	let r: vec4[f32];
+	r = data.a * data.b;
+	let v: vec3[f32];
+	v.xy = (data.a.xy * data.s) + (vec2[f32](1.0, 2.0));
+	v.z = -data.b.z;
+	let c: vec2[f32] = data.a.zw - data.b.xy;
+	let d: vec2[f32];
+	d.x = data.a.x;
+	d.y = d.x * (2.0);
+}
+)");
+	}
+
+	WHEN("vectorizing operations mixing scalars and vectors")
+	{
+		VectorizeAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	a: vec4[f32],
+	iv: vec4[i32],
+	s: f32,
+	k: i32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let m: vec2[i32];
+	m.x = data.k * data.iv.x;
+	m.y = data.k * data.iv.y;
+
+	let q: vec2[f32];
+	q.x = data.s / data.a.x;
+	q.y = data.s / data.a.y;
+
+	let r: vec2[i32];
+	r.x = data.iv.z % data.k;
+	r.y = data.iv.w % data.k;
+
+	let f: vec2[f32];
+	f.x = data.s * data.a.z;
+	f.y = data.s * data.a.w;
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	let m: vec2[i32];
+	m = (vec2[i32](data.k, data.k)) * data.iv.xy;
+	let q: vec2[f32];
+	q = (vec2[f32](data.s, data.s)) / data.a.xy;
+	let r: vec2[i32];
+	r = data.iv.zw % (vec2[i32](data.k, data.k));
+	let f: vec2[f32];
+	f = data.s * data.a.zw;
+}
+)");
+	}
+
+	WHEN("vectorizing stores to storage buffers")
+	{
+		VectorizeAndExpect(R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	a: vec4[f32],
+	b: vec4[f32],
+	r: vec4[f32],
+	v: vec3[f32]
+}
+
+external
+{
+	[set(0), binding(0), access(writeonly)] result: storage[Data],
+	[set(0), binding(1)] data: uniform[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	result.r.x = data.a.x * data.b.x;
+	result.r.y = data.a.y * data.b.y;
+	result.r.z = data.a.z * data.b.z;
+	result.r.w = data.a.w * data.b.w;
+
+	result.v.x = data.a.x + data.b.x;
+	result.v.y = data.a.y + data.b.y;
+}
+)", R"(
+[entry(frag)]
+fn main()
+{
+	result.r = data.a * data.b;
+	result.v.x = data.a.x + data.b.x;
+	result.v.y = data.a.y + data.b.y;
+}
+)");
+	}
+
+	WHEN("running the optimization pipeline")
+	{
+		std::string_view sourceCode = R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	value: vec4[f32]
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+fn helper() -> vec4[f32]
+{
+	return data.value * 2.0;
+}
+
+struct Output
+{
+	value: vec4[f32]
+}
+
+[entry(frag)]
+fn main() -> Output
+{
+	let output: Output;
+	if (1.0 > 2.0)
+		output.value = helper();
+	else
+		output.value = data.value * (1.0 + 1.0);
+
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::Ast::DependencyCheckerVisitor::Config depConfig;
+		depConfig.usedShaderStages = nzsl::ShaderStageType_All;
+
+		nzsl::Ast::OptimizationPipeline::Options options;
+		options.dependencyConfig = depConfig;
+
+		nzsl::Ast::OptimizationPipeline pipeline(nzsl::OptimizationLevel::O2, options);
+		REQUIRE(pipeline.GetPassCount() == 3);
+		CHECK(pipeline.GetPassName(0) == "constant-propagation");
+		CHECK(pipeline.GetPassName(1) == "eliminate-unused");
+		CHECK(pipeline.GetPassName(2) == "vectorization");
+
+		// Os skips passes which may increase code size
+		nzsl::Ast::OptimizationPipeline sizePipeline(nzsl::OptimizationLevel::Os, options);
+		REQUIRE(sizePipeline.GetPassCount() == 2);
+		CHECK(sizePipeline.GetPassName(0) == "constant-propagation");
+		CHECK(sizePipeline.GetPassName(1) == "eliminate-unused");
+
+		nzsl::Ast::OptimizationPipeline::Statistics stats;
+		nzsl::Ast::ModulePtr optimizedModule = pipeline.Process(*shaderModule, &stats);
+		REQUIRE(optimizedModule);
+
+		// constant propagation removes the branch calling helper, which is then eliminated, a second iteration doesn't change anything
+		CHECK(stats.reachedFixedPoint);
+		CHECK(stats.iterationCount == 2);
+		REQUIRE(stats.passes.size() == 5);
+		CHECK(stats.passes[0].changed);
+		CHECK(stats.passes[0].nodeCountAfter < stats.passes[0].nodeCountBefore);
+		CHECK(stats.passes[0].nodeCountBefore == nzsl::Ast::OptimizationPipeline::CountNodes(*shaderModule));
+		CHECK(stats.passes[1].changed);
+		CHECK(stats.passes[1].nodeCountAfter < stats.passes[1].nodeCountBefore);
+		CHECK_FALSE(stats.passes[2].changed);
+		CHECK_FALSE(stats.passes[3].changed);
+		CHECK_FALSE(stats.passes[4].changed);
+		CHECK(stats.passes[4].iteration == 1);
+		CHECK(stats.passes[4].nodeCountAfter == nzsl::Ast::OptimizationPipeline::CountNodes(*optimizedModule));
+
+		ExpectNZSL(*optimizedModule, R"(
+[entry(frag)]
+fn main() -> Output
+{
+	let output: Output;
+	output.value = data.value * (2.0);
+	return output;
+}
+)");
+
+		// Optimizing an already optimized module doesn't produce a new module
+		nzsl::Ast::OptimizationPipeline::Statistics secondStats;
+		CHECK_FALSE(pipeline.Process(*optimizedModule, &secondStats));
+		CHECK(secondStats.reachedFixedPoint);
+		CHECK(secondStats.iterationCount == 1);
+		CHECK(secondStats.passes.size() == 3);
+
+		// O1 only runs passes once
+		nzsl::Ast::OptimizationPipeline o1Pipeline(nzsl::OptimizationLevel::O1, options);
+
+		nzsl::Ast::OptimizationPipeline::Statistics o1Stats;
+		CHECK(o1Pipeline.Process(*shaderModule, &o1Stats));
+		CHECK(o1Stats.iterationCount == 1);
+		CHECK_FALSE(o1Stats.reachedFixedPoint);
+
+		// O0 doesn't do anything
+		nzsl::Ast::OptimizationPipeline o0Pipeline(nzsl::OptimizationLevel::O0);
+		CHECK(o0Pipeline.GetPassCount() == 0);
+		CHECK_FALSE(o0Pipeline.Process(*shaderModule));
+
+		WHEN("the module contains a NaN constant")
+		{
+			std::string_view nanSourceCode = R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	value: f32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = data.value * (0.0 / 0.0);
+}
+)";
+
+			nzsl::Ast::ModulePtr nanModule;
+			REQUIRE_NOTHROW(nanModule = nzsl::Parse(nanSourceCode));
+			nanModule = SanitizeModule(*nanModule);
+
+			// Passes report their changes, a NaN constant (which isn't equal to itself) doesn't prevent reaching a fixed point
+			nzsl::Ast::OptimizationPipeline::Statistics nanStats;
+			REQUIRE(pipeline.Process(*nanModule, &nanStats));
+			CHECK(nanStats.reachedFixedPoint);
+			CHECK(nanStats.iterationCount == 2);
+		}
+	}
+
+	WHEN("optimizing SPIR-V")
+	{
+		std::string_view sourceCode = R"(
+[nzsl_version("1.0")]
+module;
+
+struct inputStruct
+{
+	value: f32,
+	count: i32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[inputStruct]
+}
+
+struct Output
+{
+	[location(0)] color: vec4[f32]
+}
+
+[entry(frag)]
+fn main() -> Output
+{
+	let value: f32;
+	if (data.value > 42.0)
+		value = 1.0;
+	else
+		value = data.value * 2.0;
+
+	let acc = 0.0;
+	let i = 0;
+	while (i < data.count)
+	{
+		acc += value * data.value;
+		i += 1;
+	}
+
+	let output: Output;
+	output.color = vec4[f32](acc, value, data.value, data.value);
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::SpirvWriter::Environment env;
+		env.optimizeSpirv = true;
+
+		// local variables are promoted to phis and uniform loads are reused
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpAccessChain
+OpLoad
+OpFOrdGreaterThanEqual
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpFMul
+OpBranch
+OpLabel
+OpPhi
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpAccessChain
+OpLoad
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpFMul
+OpFAdd
+OpIAdd
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpCompositeConstruct
+OpAccessChain
+OpStore
+OpLoad
+OpCompositeExtract
+OpStore
+OpReturn
+OpFunctionEnd)", env);
+	}
+
+	WHEN("optimizing SPIR-V with writable storage buffer arrays")
+	{
+		std::string_view sourceCode = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[set(0), binding(0)] buffers: array[storage[Data], 4]
+}
+
+struct Output
+{
+	[location(0)] color: f32
+}
+
+[entry(frag)]
+fn main() -> Output
+{
+	let before = buffers[1].value;
+	if (before > 0.0)
+		buffers[1].value = 2.0;
+
+	let after = buffers[1].value;
+
+	let output: Output;
+	output.color = after;
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+		shaderModule = SanitizeModule(*shaderModule);
+
+		// SPIR-V 1.0 declares storage buffers as Uniform BufferBlock arrays, which must not be considered read-only
+		nzsl::SpirvWriter::Environment env;
+		env.spvMajorVersion = 1;
+		env.spvMinorVersion = 0;
+		env.optimizeSpirv = true;
+
+		// the value is reloaded after the branch which may have written to it
+		ExpectSPIRV(*shaderModule, R"(
+OpBranchConditional
+OpLabel
+OpStore
+OpBranch
+OpLabel
+OpLoad
+)", env);
+	}
 }
@@ -0,0 +1,153 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <catch2/catch.hpp>
+
+TEST_CASE("precision", "[Shader]")
+{
+	WHEN("using medium precision values")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Light
+{
+	[precision(medium)] color: vec3[f32],
+	intensity: f32
+}
+
+external
+{
+	[set(0), binding(0)] light: uniform[Light],
+	[set(0), binding(1), precision(medium)] albedo: sampler2D[f32]
+}
+
+struct FragIn
+{
+	[location(0), precision(medium)] uv: vec2[f32]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+fn Shade([precision(medium)] color: vec3[f32], intensity: f32) -> vec3[f32]
+{
+	return color * intensity;
+}
+
+[entry(frag)]
+fn main(input: FragIn) -> FragOut
+{
+	[precision(medium)] let diffuse = albedo.Sample(input.uv).rgb * light.color;
+
+	let output: FragOut;
+	output.color = vec4[f32](Shade(diffuse, light.intensity), 1.0);
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		ExpectGLSL(*shaderModule, R"(
+layout(std140) uniform _nzslBinding_light
+{
+	mediump vec3 color;
+	float intensity;
+} light;
+
+uniform mediump sampler2D albedo;
+
+struct FragIn
+{
+	mediump vec2 uv;
+};
+
+struct FragOut
+{
+	vec4 color;
+};
+
+vec3 Shade(mediump vec3 color, float intensity)
+{
+	return color * intensity;
+}
+
+/**************** Inputs ****************/
+in mediump vec2 _nzslVarying_0; // _nzslIn_uv
+
+/*************** Outputs ***************/
+layout(location = 0) out vec4 _nzslOut_color;
+
+void main()
+{
+	FragIn input_;
+	input_.uv = _nzslVarying_0;
+
+	mediump vec3 diffuse = ((texture(albedo, input_.uv)).xyz) * light.color;
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+[layout(std140)]
+struct Light
+{
+	[precision(medium)] color: vec3[f32],
+	intensity: f32
+}
+
+external
+{
+	[set(0), binding(0)] light: uniform[Light],
+	[set(0), binding(1), precision(medium)] albedo: sampler2D[f32]
+}
+
+struct FragIn
+{
+	[location(0), precision(medium)] uv: vec2[f32]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+fn Shade([precision(medium)] color: vec3[f32], intensity: f32) -> vec3[f32]
+{
+	return color * intensity;
+}
+
+[entry(frag)]
+fn main(input: FragIn) -> FragOut
+{
+	[precision(medium)] let diffuse: vec3[f32] = ((albedo.Sample(input.uv)).xyz) * light.color;
+)");
+
+		ExpectSPIRV(*shaderModule, R"(
+      OpDecorate %10 Decoration(RelaxedPrecision)
+      OpDecorate %21 Decoration(RelaxedPrecision)
+      OpMemberDecorate %3 0 Decoration(Offset) 0
+      OpMemberDecorate %3 0 Decoration(RelaxedPrecision)
+      OpMemberDecorate %3 1 Decoration(Offset) 12
+      OpDecorate %4 Decoration(Block)
+      OpMemberDecorate %4 0 Decoration(Offset) 0
+      OpMemberDecorate %4 0 Decoration(RelaxedPrecision)
+      OpMemberDecorate %4 1 Decoration(Offset) 12
+      OpMemberDecorate %12 0 Decoration(Offset) 0
+      OpMemberDecorate %12 0 Decoration(RelaxedPrecision)
+      OpMemberDecorate %14 0 Decoration(Offset) 0
+      OpDecorate %34 Decoration(RelaxedPrecision)
+      OpDecorate %37 Decoration(RelaxedPrecision)
+      OpDecorate %41 Decoration(RelaxedPrecision)
+      OpDecorate %47 Decoration(RelaxedPrecision)
+      OpDecorate %49 Decoration(RelaxedPrecision)
+      OpDecorate %50 Decoration(RelaxedPrecision)
+      OpDecorate %51 Decoration(RelaxedPrecision)
+      OpDecorate %54 Decoration(RelaxedPrecision)
+      OpDecorate %55 Decoration(RelaxedPrecision)
+      OpDecorate %56 Decoration(RelaxedPrecision)
+)", {}, true);
+	}
+}
@@ -186,6 +186,10 @@ void ExpectGLSL(const nzsl::Ast::Module& shaderModule, std::string_view expected
 			EShLanguage stage = EShLangVertex;
 			switch (*entryShaderStage)
 			{
+				case nzsl::ShaderStageType::Compute:
+					stage = EShLangCompute;
+					break;
+
 				case nzsl::ShaderStageType::Fragment:
 					stage = EShLangFragment;
 					break;
@@ -304,6 +308,44 @@ void ExpectSPIRV(const nzsl::Ast::Module& shaderModule, std::string_view expecte
 
 			REQUIRE(spirvTools.Validate(spirv));
 		}
+
+		SECTION("Generating SPIR-V into caller-provided storage")
+		{
+			struct BufferSink : nzsl::SpirvWriter::OutputSink
+			{
+				std::uint32_t* Allocate(std::size_t wordCount) override
+				{
+					CHECK(allocationCount++ == 0);
+
+					buffer = std::make_unique<std::uint32_t[]>(wordCount);
+					bufferSize = wordCount;
+
+					return buffer.get();
+				}
+
+				std::unique_ptr<std::uint32_t[]> buffer;
+				std::size_t allocationCount = 0;
+				std::size_t bufferSize = 0;
+			};
+
+			BufferSink sink;
+			writer.Generate(targetModule, {}, sink);
+
+			REQUIRE(sink.bufferSize == spirv.size());
+			CHECK(std::equal(spirv.begin(), spirv.end(), sink.buffer.get()));
+		}
+
+		SECTION("Generating function bodies in parallel")
+		{
+			nzsl::SpirvWriter::Environment parallelEnv = env;
+			parallelEnv.functionThreadCount = 4;
+
+			nzsl::SpirvWriter parallelWriter;
+			parallelWriter.SetEnv(parallelEnv);
+
+			// Output must be identical to a serial generation
+			CHECK(parallelWriter.Generate(targetModule) == spirv);
+		}
 	}
 }
 
@@ -0,0 +1,197 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvConstantCache.hpp>
+#include <NZSL/SpirV/SpirvSection.hpp>
+#include <NZSL/SpirV/SpirvTypeCache.hpp>
+#include <catch2/catch.hpp>
+#include <set>
+#include <thread>
+
+namespace
+{
+	constexpr std::size_t ObjectCount = 10'000;
+
+	void RegisterObjects(nzsl::SpirvConstantCache& cache, std::vector<std::uint32_t>& constantIds, std::vector<std::uint32_t>& typeIds)
+	{
+		nzsl::SpirvConstantCache::TypePtr floatType = cache.BuildType(nzsl::Ast::PrimitiveType::Float32);
+
+		constantIds.clear();
+		typeIds.clear();
+		for (std::size_t i = 0; i < ObjectCount; ++i)
+		{
+			constantIds.push_back(cache.Register(*cache.BuildConstant(nzsl::Vector2f32(float(i), -float(i)))));
+
+			// Arrays of different lengths are different types
+			typeIds.push_back(cache.Register(nzsl::SpirvConstantCache::Type{
+				nzsl::SpirvConstantCache::Array{ floatType, cache.BuildConstant(std::uint32_t(i + 1)), std::nullopt }
+			}));
+		}
+	}
+}
+
+TEST_CASE("SPIR-V constant cache", "[SpirvConstantCache]")
+{
+	GIVEN("Many distinct constants and types")
+	{
+		std::uint32_t nextResultId = 1;
+		nzsl::SpirvConstantCache cache(nextResultId);
+
+		std::vector<std::uint32_t> constantIds;
+		std::vector<std::uint32_t> typeIds;
+		RegisterObjects(cache, constantIds, typeIds);
+
+		std::set<std::uint32_t> uniqueIds(constantIds.begin(), constantIds.end());
+		uniqueIds.insert(typeIds.begin(), typeIds.end());
+		CHECK(uniqueIds.size() == 2 * ObjectCount);
+
+		WHEN("Registering them again")
+		{
+			std::uint32_t expectedNextResultId = nextResultId;
+
+			std::vector<std::uint32_t> newConstantIds;
+			std::vector<std::uint32_t> newTypeIds;
+			RegisterObjects(cache, newConstantIds, newTypeIds);
+
+			CHECK(newConstantIds == constantIds);
+			CHECK(newTypeIds == typeIds);
+			CHECK(nextResultId == expectedNextResultId);
+		}
+
+		WHEN("Querying their ids")
+		{
+			CHECK(cache.GetId(*cache.BuildConstant(nzsl::Vector2f32(42.f, -42.f))) == constantIds[42]);
+			CHECK_THROWS(cache.GetId(*cache.BuildConstant(nzsl::Vector2f32(-1.f, 1.f))));
+		}
+
+		WHEN("Writing them")
+		{
+			nzsl::SpirvSection annotations;
+			nzsl::SpirvSection constants;
+			nzsl::SpirvSection debugInfos;
+			cache.Write(annotations, constants, &debugInfos);
+
+			CHECK(constants.GetOutputOffset() > 2 * ObjectCount);
+		}
+	}
+}
+
+// Hidden from the default run, use the [!benchmark] tag to run it
+TEST_CASE("SPIR-V constant cache benchmark", "[SpirvConstantCache][!benchmark]")
+{
+	BENCHMARK("Registering 10k distinct constants and types")
+	{
+		std::uint32_t nextResultId = 1;
+		nzsl::SpirvConstantCache cache(nextResultId);
+
+		std::vector<std::uint32_t> constantIds;
+		std::vector<std::uint32_t> typeIds;
+		RegisterObjects(cache, constantIds, typeIds);
+
+		return nextResultId;
+	};
+}
+
+TEST_CASE("SPIR-V type cache", "[SpirvConstantCache]")
+{
+	std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+struct Light
+{
+	color: vec3[f32],
+	factors: array[f32, 3]
+}
+
+[layout(std140)]
+struct LightData
+{
+	lights: array[Light, 4],
+	lightCount: u32,
+	ambient: vec4[f32]
+}
+
+external
+{
+	[set(0), binding(0)] lightData: uniform[LightData]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+fn ComputeColor(index: u32) -> vec3[f32]
+{
+	return lightData.lights[index].color * lightData.lights[index].factors[1];
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let color = lightData.ambient.rgb;
+	for i in u32(0) -> lightData.lightCount
+		color += ComputeColor(i);
+
+	let output: FragOut;
+	output.color = vec4[f32](color, 1.0);
+	return output;
+}
+)";
+
+	nzsl::Ast::ModulePtr shaderModule;
+	REQUIRE_NOTHROW(shaderModule = nzsl::Parse(nzslSource));
+
+	nzsl::SpirvWriter referenceWriter;
+	std::vector<std::uint32_t> referenceSpirv = referenceWriter.Generate(*shaderModule);
+
+	auto typeCache = std::make_shared<nzsl::SpirvTypeCache>();
+
+	nzsl::SpirvWriter::Environment env;
+	env.typeCache = typeCache;
+
+	WHEN("Generating multiple times with the same type cache")
+	{
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(env);
+
+		CHECK(writer.Generate(*shaderModule) == referenceSpirv);
+
+		std::size_t structCount = typeCache->GetStructCount();
+		CHECK(structCount >= 3);
+
+		// Structs are reused by other writers
+		nzsl::SpirvWriter otherWriter;
+		otherWriter.SetEnv(env);
+
+		CHECK(otherWriter.Generate(*shaderModule) == referenceSpirv);
+		CHECK(typeCache->GetStructCount() == structCount);
+
+		typeCache->Clear();
+		CHECK(typeCache->GetStructCount() == 0);
+	}
+
+	WHEN("Sharing the type cache between threads")
+	{
+		std::vector<std::vector<std::uint32_t>> outputs(4);
+		std::vector<std::thread> threads;
+		for (auto& output : outputs)
+		{
+			threads.emplace_back([&]
+			{
+				nzsl::SpirvWriter writer;
+				writer.SetEnv(env);
+
+				output = writer.Generate(*shaderModule);
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (const auto& output : outputs)
+			CHECK(output == referenceSpirv);
+	}
+}
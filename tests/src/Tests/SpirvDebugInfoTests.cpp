@@ -0,0 +1,159 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <catch2/catch.hpp>
+
+TEST_CASE("SPIR-V debug line info", "[SpirvWriter]")
+{
+	std::string nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+fn Compute(value: f32) -> f32
+{
+	let result = value;
+	if (data.value > 0.0)
+		result *= data.value;
+
+	return result;
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Compute(data.value);
+	return output;
+}
+)";
+
+	auto Generate = [&](const std::string& source, const nzsl::SpirvWriter::Environment& env)
+	{
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Ast::Sanitize(*nzsl::Parse(source, "Shader.nzsl"));
+
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(env);
+
+		return writer.Generate(*shaderModule);
+	};
+
+	// Returns the printed result id of the OpString naming the file
+	auto GetFileId = [](const std::string& output)
+	{
+		std::size_t stringPos = output.find(" = OpString \"Shader.nzsl\"");
+		REQUIRE(stringPos != std::string::npos);
+
+		std::size_t idPos = output.rfind('%', stringPos);
+		return output.substr(idPos, stringPos - idPos);
+	};
+
+	nzsl::SpirvPrinter printer;
+	nzsl::SpirvPrinter::Settings printerSettings;
+	printerSettings.printHeader = false;
+
+	WHEN("Debug line info is disabled")
+	{
+		std::string output = printer.Print(Generate(nzslSource, {}), printerSettings);
+		CHECK(output.find("OpLine") == std::string::npos);
+		CHECK(output.find("OpString") == std::string::npos);
+		CHECK(output.find("OpSource") == std::string::npos);
+	}
+
+	WHEN("Debug line info is enabled")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.debugLineInfo = true;
+
+		std::vector<std::uint32_t> spirv = Generate(nzslSource, env);
+		std::string output = printer.Print(spirv, printerSettings);
+		INFO(output);
+
+		std::string fileId = GetFileId(output);
+		CHECK(output.find("OpSource SourceLanguage(Unknown) 100 " + fileId + "\n") != std::string::npos);
+
+		// let result = value; / if (data.value > 0.0) / result *= data.value; / output.value = Compute(data.value);
+		CHECK(output.find("OpLine " + fileId + " 18 ") != std::string::npos);
+		CHECK(output.find("OpLine " + fileId + " 19 ") != std::string::npos);
+		CHECK(output.find("OpLine " + fileId + " 20 ") != std::string::npos);
+		CHECK(output.find("OpLine " + fileId + " 35 ") != std::string::npos);
+
+		// Line info doesn't change the generated code (ids are shifted by OpString, only compare instructions)
+		nzsl::SpirvPrinter::Settings codeSettings = printerSettings;
+		codeSettings.printDebug = false;
+		codeSettings.printParameters = false;
+
+		std::string code = printer.Print(spirv, codeSettings);
+		CHECK(code.find("OpLine") != std::string::npos);
+
+		std::string::size_type pos;
+		while ((pos = code.find("OpLine")) != std::string::npos)
+			code.erase(pos, code.find('\n', pos) - pos + 1);
+
+		CHECK(code == printer.Print(Generate(nzslSource, {}), codeSettings));
+
+		ExpectSPIRV(*nzsl::Ast::Sanitize(*nzsl::Parse(nzslSource, "Shader.nzsl")), R"(
+OpFunction
+OpLabel
+OpVariable
+OpVariable
+OpLine
+OpAccessChain
+OpLoad
+OpLine
+OpStore
+OpFunctionCall)", env);
+	}
+
+	WHEN("Embedding source code")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.debugLineInfo = true;
+		env.debugSourceContents["Shader.nzsl"] = nzslSource;
+
+		std::string output = printer.Print(Generate(nzslSource, env), printerSettings);
+		CHECK(output.find("OpSource SourceLanguage(Unknown) 100 " + GetFileId(output) + " \"\n[nzsl_version(\"1.0\")]") != std::string::npos);
+		CHECK(output.find("OpSourceContinued") == std::string::npos);
+
+		// Sources longer than an instruction are continued
+		std::string longSource = nzslSource + "\n// " + std::string(300'000, 'a') + "\n";
+		env.debugSourceContents["Shader.nzsl"] = longSource;
+
+		std::vector<std::uint32_t> spirv = Generate(longSource, env);
+		output = printer.Print(spirv, printerSettings);
+		CHECK(output.find("OpSourceContinued") != std::string::npos);
+		CHECK(spirv.size() > longSource.size() / sizeof(std::uint32_t));
+	}
+
+	WHEN("Generating functions in parallel and optimizing")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.debugLineInfo = true;
+
+		std::vector<std::uint32_t> serialSpirv = Generate(nzslSource, env);
+
+		env.functionThreadCount = 4;
+		CHECK(Generate(nzslSource, env) == serialSpirv);
+
+		env.optimizeSpirv = true;
+		std::string output = printer.Print(Generate(nzslSource, env), printerSettings);
+		CHECK(output.find("OpLine " + GetFileId(output) + " 35 ") != std::string::npos);
+	}
+}
@@ -0,0 +1,185 @@
+#include <NZSL/FilesystemModuleResolver.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvLinker.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/SpirV/SpirvSectionBase.hpp>
+#include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <catch2/catch.hpp>
+#include <spirv-tools/libspirv.hpp>
+
+namespace
+{
+	void ValidateSpirv(const std::vector<std::uint32_t>& spirv, spv_target_env targetEnv)
+	{
+		spvtools::SpirvTools spirvTools(targetEnv);
+		spirvTools.SetMessageConsumer([&](spv_message_level_t /*level*/, const char* /*source*/, const spv_position_t& /*position*/, const char* message)
+		{
+			std::string fullSpirv;
+			if (!spirvTools.Disassemble(spirv, &fullSpirv))
+				fullSpirv = "<failed to disassemble SPIR-V>";
+
+			UNSCOPED_INFO(fullSpirv + "\n" + message);
+		});
+
+		REQUIRE(spirvTools.Validate(spirv));
+	}
+}
+
+TEST_CASE("SPIR-V linker", "[SpirvLinker]")
+{
+	std::string_view librarySource = R"(
+[nzsl_version("1.0")]
+module SimpleModule;
+
+[export]
+[layout(std140)]
+struct Data
+{
+	value: f32
+}
+
+fn Square(value: f32) -> f32
+{
+	return value * value;
+}
+
+[export]
+fn GetDataValue(data: Data) -> f32
+{
+	return Square(data.value) + 1.0;
+}
+
+[export]
+fn Unused(value: f32) -> f32
+{
+	return value * 2.0;
+}
+)";
+
+	std::string_view shaderSource = R"(
+[nzsl_version("1.0")]
+module;
+
+import GetDataValue, Data from SimpleModule;
+
+[layout(std140)]
+struct Block
+{
+	data: Data
+}
+
+external
+{
+	[binding(0)] block: uniform[Block]
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = GetDataValue(block.data);
+	return output;
+}
+)";
+
+	nzsl::SpirvPrinter::Settings printerSettings;
+	printerSettings.printHeader = false;
+
+	nzsl::SpirvWriter::Environment libraryEnv;
+	libraryEnv.exportFunctions = true;
+
+	nzsl::SpirvWriter libraryWriter;
+	libraryWriter.SetEnv(libraryEnv);
+
+	std::vector<std::uint32_t> librarySpirv = libraryWriter.Generate(*nzsl::Ast::Sanitize(*nzsl::Parse(librarySource)));
+	ValidateSpirv(librarySpirv, SPV_ENV_UNIVERSAL_1_0);
+
+	auto moduleResolver = std::make_shared<nzsl::FilesystemModuleResolver>();
+	moduleResolver->RegisterModule(librarySource);
+
+	nzsl::Ast::SanitizeVisitor::Options sanitizeOpt;
+	sanitizeOpt.moduleResolver = moduleResolver;
+
+	nzsl::Ast::ModulePtr shaderModule = nzsl::Ast::Sanitize(*nzsl::Parse(shaderSource), sanitizeOpt);
+
+	nzsl::SpirvWriter::Environment shaderEnv;
+	shaderEnv.importModuleFunctions = true;
+
+	nzsl::SpirvWriter shaderWriter;
+	shaderWriter.SetEnv(shaderEnv);
+
+	std::vector<std::uint32_t> shaderSpirv = shaderWriter.Generate(*shaderModule);
+	ValidateSpirv(shaderSpirv, SPV_ENV_UNIVERSAL_1_0);
+
+	nzsl::SpirvPrinter printer;
+
+	WHEN("Compiling modules separately")
+	{
+		std::string libraryOutput = printer.Print(librarySpirv.data(), librarySpirv.size(), printerSettings);
+		CHECK(libraryOutput.find("Capability(Linkage)") != std::string::npos);
+		CHECK(libraryOutput.find("\"SimpleModule.GetDataValue\" LinkageType(Export)") != std::string::npos);
+		CHECK(libraryOutput.find("\"SimpleModule.Unused\" LinkageType(Export)") != std::string::npos);
+
+		// Import declarations have no body and the module functions they call aren't generated
+		std::string shaderOutput = printer.Print(shaderSpirv.data(), shaderSpirv.size(), printerSettings);
+		CHECK(shaderOutput.find("\"SimpleModule.GetDataValue\" LinkageType(Import)") != std::string::npos);
+		CHECK(shaderOutput.find("Square") == std::string::npos);
+	}
+
+	WHEN("Linking the shader with the library")
+	{
+		nzsl::SpirvLinker linker;
+		std::vector<std::uint32_t> linkedSpirv = linker.Link({ shaderSpirv, librarySpirv });
+
+		ValidateSpirv(linkedSpirv, SPV_ENV_VULKAN_1_0);
+
+		std::string output = printer.Print(linkedSpirv.data(), linkedSpirv.size(), printerSettings);
+		INFO("linked SPIR-V:\n" << output);
+
+		CHECK(output.find("Linkage") == std::string::npos);
+		CHECK(output.find("\"Square\"") != std::string::npos);
+		CHECK(output.find("\"GetDataValue\"") != std::string::npos);
+		CHECK(output.find("\"Unused\"") == std::string::npos);
+		CHECK(output.find("\"main\"") != std::string::npos);
+	}
+
+	WHEN("Linking modules without any entry point")
+	{
+		nzsl::SpirvLinker linker;
+		std::vector<std::uint32_t> linkedSpirv = linker.Link({ librarySpirv });
+
+		// exported functions are kept, but not exported anymore
+		std::string output = printer.Print(linkedSpirv.data(), linkedSpirv.size(), printerSettings);
+		CHECK(output.find("Linkage") == std::string::npos);
+		CHECK(output.find("\"Unused\"") != std::string::npos);
+	}
+
+	WHEN("Linking the shader without the library")
+	{
+		nzsl::SpirvLinker linker;
+		CHECK_THROWS_WITH(linker.Link({ shaderSpirv }), "unresolved import \"SimpleModule.GetDataValue\"");
+	}
+
+	WHEN("Linking the same library twice")
+	{
+		nzsl::SpirvLinker linker;
+		CHECK_THROWS_WITH(linker.Link({ shaderSpirv, librarySpirv, librarySpirv }), Catch::Contains("is exported by multiple modules"));
+	}
+
+	WHEN("Linking a module with instructions outside of a function")
+	{
+		std::vector<std::uint32_t> invalidSpirv = {
+			nzsl::SpirvMagicNumber, 0x00010000, 0, 2, 0,
+			nzsl::SpirvSectionBase::BuildOpcode(nzsl::SpirvOp::OpLabel, 2), 1
+		};
+
+		nzsl::SpirvLinker linker;
+		CHECK_THROWS_WITH(linker.Link({ invalidSpirv }), "unexpected OpLabel outside of a function");
+	}
+}
@@ -0,0 +1,146 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <catch2/catch.hpp>
+
+namespace
+{
+	std::vector<std::uint32_t> GenerateTestModule()
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+fn Compute(value: f32) -> f32
+{
+	let result = value;
+	if (data.value > 0.0)
+		result *= data.value;
+
+	return result;
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Compute(data.value);
+	return output;
+}
+)";
+
+		nzsl::SpirvWriter::Environment env;
+		env.optimizeSpirv = true;
+
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(env);
+
+		return writer.Generate(*nzsl::Ast::Sanitize(*nzsl::Parse(nzslSource)));
+	}
+}
+
+TEST_CASE("SPIR-V printer", "[SpirvPrinter]")
+{
+	std::vector<std::uint32_t> spirv = GenerateTestModule();
+
+	nzsl::SpirvPrinter printer;
+	std::string fullOutput = printer.Print(spirv);
+
+	WHEN("Printing to a sink")
+	{
+		struct ChunkSink : nzsl::SpirvPrinter::OutputSink
+		{
+			void Write(std::string_view text) override
+			{
+				CHECK(!text.empty());
+				CHECK(text.back() == '\n');
+
+				output.append(text);
+			}
+
+			std::string output;
+		};
+
+		ChunkSink sink;
+		printer.Print(spirv.data(), spirv.size(), nzsl::SpirvPrinter::Settings{}, sink);
+
+		CHECK(sink.output == fullOutput);
+	}
+
+	WHEN("Printing phi instructions")
+	{
+		// pair operands (value, parent block) are printed
+		CHECK_THAT(fullOutput, Catch::Matches(R"([\s\S]*OpPhi %\d+( %\d+ %\d+){2}\n[\s\S]*)"));
+	}
+
+	WHEN("Printing only some sections")
+	{
+		nzsl::SpirvPrinter::Settings settings;
+		settings.printHeader = false;
+		settings.printPreamble = false;
+		settings.printDebug = false;
+		settings.printAnnotations = false;
+		settings.printFunctions = false;
+
+		std::string output = printer.Print(spirv, settings);
+		CHECK(output.find("OpTypeFloat") != std::string::npos);
+		CHECK(output.find("OpVariable") != std::string::npos);
+		CHECK(output.find("OpCapability") == std::string::npos);
+		CHECK(output.find("OpName") == std::string::npos);
+		CHECK(output.find("OpDecorate") == std::string::npos);
+		CHECK(output.find("OpFunction") == std::string::npos);
+		CHECK(output.find("Bound") == std::string::npos);
+	}
+
+	WHEN("Printing only some functions")
+	{
+		nzsl::SpirvPrinter::Settings settings;
+		settings.functions = { "Compute" };
+		settings.printHeader = false;
+		settings.printPreamble = false;
+		settings.printDebug = false;
+		settings.printAnnotations = false;
+		settings.printGlobals = false;
+
+		std::string output = printer.Print(spirv, settings);
+		CHECK(output.find("OpPhi") != std::string::npos);
+		CHECK(output.find("OpFunctionCall") == std::string::npos);
+
+		std::size_t functionCount = 0;
+		for (std::size_t pos = output.find("OpFunctionEnd"); pos != std::string::npos; pos = output.find("OpFunctionEnd", pos + 1))
+			functionCount++;
+
+		CHECK(functionCount == 1);
+	}
+}
+
+// Hidden from the default run, use the [!benchmark] tag to run it
+TEST_CASE("SPIR-V printer benchmark", "[SpirvPrinter][!benchmark]")
+{
+	std::vector<std::uint32_t> spirv = GenerateTestModule();
+
+	nzsl::SpirvPrinter printer;
+	BENCHMARK("Printing a module")
+	{
+		return printer.Print(spirv);
+	};
+}
@@ -0,0 +1,90 @@
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvStatisticsCollector.hpp>
+#include <NZSL/Ast/SanitizeVisitor.hpp>
+#include <catch2/catch.hpp>
+#include <algorithm>
+
+TEST_CASE("SPIR-V statistics", "[SpirvStatistics]")
+{
+	std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	values: array[f32, 4]
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+fn Sum() -> f32
+{
+	let sum = 0.0;
+	for i in 0 -> 4
+		sum += data.values[i];
+
+	return sum;
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Sum();
+	return output;
+}
+)";
+
+	nzsl::SpirvWriter writer;
+	std::vector<std::uint32_t> spirv = writer.Generate(*nzsl::Ast::Sanitize(*nzsl::Parse(nzslSource)));
+
+	nzsl::SpirvStatisticsCollector statisticsCollector;
+	nzsl::SpirvStatisticsCollector::Statistics statistics = statisticsCollector.Collect(spirv);
+
+	CHECK(statistics.wordCount == spirv.size());
+	CHECK(statistics.idBound == spirv[3]);
+	CHECK(statistics.module.wordCount + 5 == spirv.size());
+
+	std::size_t instructionCount = 0;
+	for (auto&& [op, count] : statistics.module.opCounts)
+		instructionCount += count;
+
+	CHECK(statistics.module.instructionCount == instructionCount);
+	CHECK(statistics.module.opCounts[nzsl::SpirvOp::OpEntryPoint] == 1);
+	CHECK(statistics.module.opCounts[nzsl::SpirvOp::OpFunction] == 2);
+	CHECK(statistics.module.typeCount > 0);
+	CHECK(statistics.module.constantCount > 0);
+
+	REQUIRE(statistics.functions.size() == 2);
+
+	auto sumIt = std::find_if(statistics.functions.begin(), statistics.functions.end(), [](const auto& function) { return function.name == "Sum"; });
+	REQUIRE(sumIt != statistics.functions.end());
+
+	const nzsl::SpirvStatisticsCollector::Counters& sumCounters = sumIt->counters;
+	CHECK(sumCounters.opCounts.at(nzsl::SpirvOp::OpFunction) == 1);
+	CHECK(sumCounters.opCounts.at(nzsl::SpirvOp::OpFunctionEnd) == 1);
+	CHECK(sumCounters.opCounts.at(nzsl::SpirvOp::OpLoopMerge) == 1);
+	CHECK(sumCounters.accessChainCount > 0);
+	CHECK(sumCounters.branchCount >= 3);
+	CHECK(sumCounters.loadCount > 0);
+	CHECK(sumCounters.storeCount > 0);
+	CHECK(sumCounters.typeCount == 0);
+
+	// every function instruction is part of the module counters
+	std::size_t functionWordCount = 0;
+	for (const auto& function : statistics.functions)
+		functionWordCount += function.counters.wordCount;
+
+	CHECK(functionWordCount < statistics.module.wordCount);
+	CHECK(statistics.module.loadCount == statistics.functions[0].counters.loadCount + statistics.functions[1].counters.loadCount);
+}
@@ -0,0 +1,142 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/SpirV/SpirvStatisticsCollector.hpp>
+#include <catch2/catch.hpp>
+#include <set>
+
+TEST_CASE("SPIR-V stripping", "[SpirvWriter]")
+{
+	std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+fn Compute(value: f32) -> f32
+{
+	let result = value;
+	if (data.value > 0.0)
+		result *= data.value;
+
+	return result;
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Compute(data.value);
+	return output;
+}
+)";
+
+	nzsl::Ast::ModulePtr shaderModule = SanitizeModule(*nzsl::Parse(nzslSource));
+
+	auto Generate = [&](const nzsl::SpirvWriter::Environment& env)
+	{
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(env);
+
+		return writer.Generate(*shaderModule);
+	};
+
+	nzsl::SpirvWriter::Environment defaultEnv;
+	std::vector<std::uint32_t> defaultSpirv = Generate(defaultEnv);
+
+	nzsl::SpirvStatisticsCollector statisticsCollector;
+	nzsl::SpirvStatisticsCollector::Statistics defaultStats = statisticsCollector.Collect(defaultSpirv);
+
+	nzsl::SpirvPrinter printer;
+	nzsl::SpirvPrinter::Settings debugOnlySettings;
+	debugOnlySettings.printHeader = false;
+	debugOnlySettings.printPreamble = false;
+	debugOnlySettings.printAnnotations = false;
+	debugOnlySettings.printGlobals = false;
+	debugOnlySettings.printFunctions = false;
+
+	WHEN("Stripping every debug name")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.debugNames = nzsl::SpirvWriter::DebugNames::None;
+
+		std::vector<std::uint32_t> spirv = Generate(env);
+		nzsl::SpirvStatisticsCollector::Statistics stats = statisticsCollector.Collect(spirv);
+
+		CHECK(printer.Print(spirv, debugOnlySettings).empty());
+		CHECK(stats.wordCount < defaultStats.wordCount);
+		CHECK(stats.module.instructionCount == defaultStats.module.instructionCount - defaultStats.module.opCounts[nzsl::SpirvOp::OpName] - defaultStats.module.opCounts[nzsl::SpirvOp::OpMemberName]);
+	}
+
+	WHEN("Keeping entry point names")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.debugNames = nzsl::SpirvWriter::DebugNames::EntryPoints;
+
+		std::vector<std::uint32_t> spirv = Generate(env);
+
+		std::string debugOutput = printer.Print(spirv, debugOnlySettings);
+		CHECK(debugOutput.find("\"main\"") != std::string::npos);
+		CHECK(debugOutput.find("\"Compute\"") == std::string::npos);
+		CHECK(debugOutput.find("OpMemberName") == std::string::npos);
+	}
+
+	WHEN("Compacting ids")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.compactIds = true;
+		env.debugNames = nzsl::SpirvWriter::DebugNames::None;
+		env.optimizeSpirv = true;
+
+		std::vector<std::uint32_t> spirv = Generate(env);
+
+		// Every id below the bound is used
+		std::set<std::uint32_t> resultIds;
+		std::string output = printer.Print(spirv);
+		for (std::size_t pos = output.find('%'); pos != std::string::npos; pos = output.find('%', pos + 1))
+			resultIds.insert(static_cast<std::uint32_t>(std::stoul(output.substr(pos + 1))));
+
+		CHECK(*resultIds.begin() == 1);
+		CHECK(*resultIds.rbegin() == resultIds.size());
+		CHECK(spirv[3] == resultIds.size() + 1);
+	}
+
+	WHEN("Validating stripped and compacted output")
+	{
+		nzsl::SpirvWriter::Environment env;
+		env.compactIds = true;
+		env.debugNames = nzsl::SpirvWriter::DebugNames::EntryPoints;
+
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpVariable
+OpAccessChain
+OpLoad
+OpStore
+OpFunctionCall
+OpAccessChain
+OpStore
+OpLoad
+OpCompositeExtract
+OpStore
+OpReturn
+OpFunctionEnd)", env);
+	}
+}
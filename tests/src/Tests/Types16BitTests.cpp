@@ -0,0 +1,211 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <catch2/catch.hpp>
+
+TEST_CASE("16-bit types", "[Shader]")
+{
+	WHEN("using 16-bit types in a uniform buffer")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std140)]
+struct Data
+{
+	color: vec4[f16],
+	index: u16
+}
+
+external
+{
+	[binding(0)] data: uniform[Data]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let scale = f16(0.5);
+	let color = data.color * scale;
+	let index = u32(data.index);
+
+	let output: FragOut;
+	output.color = vec4[f32](color);
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::GlslWriter::Environment glslEnv;
+		glslEnv.extCallback = [](std::string_view extName)
+		{
+			return extName == "GL_EXT_shader_explicit_arithmetic_types_float16" || extName == "GL_EXT_shader_explicit_arithmetic_types_int16";
+		};
+
+		ExpectGLSL(*shaderModule, R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16 : require
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_int16 : require
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+layout(std140) uniform _nzslBinding_data
+{
+	f16vec4 color;
+	uint16_t index;
+} data;
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	float16_t scale = float16_t(0.5);
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	uint index = uint(data.index);
+)", glslEnv, false);
+
+		ExpectGLSL(*shaderModule, R"(
+	output_.color = vec4(color);
+)", glslEnv, false);
+
+		ExpectNZSL(*shaderModule, R"(
+[layout(std140)]
+struct Data
+{
+	color: vec4[f16],
+	index: u16
+}
+)");
+
+		ExpectNZSL(*shaderModule, R"(
+	let scale: f16 = f16(0.5);
+	let color: vec4[f16] = data.color * scale;
+	let index: u32 = u32(data.index);
+	let output: FragOut;
+	output.color = vec4[f32](color);
+	return output;
+)");
+
+		// index is only loaded and converted, computing on it isn't required
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(Float16)");
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(UniformAndStorageBuffer16BitAccess)");
+		ExpectSPIRV(*shaderModule, R"(OpExtension "SPV_KHR_16bit_storage")");
+		ExpectSPIRV(*shaderModule, "OpTypeFloat 16");
+		ExpectSPIRV(*shaderModule, "OpTypeInt 16 0");
+		ExpectSPIRV(*shaderModule, "OpVectorTimesScalar");
+		ExpectSPIRV(*shaderModule, "OpFConvert");
+		ExpectSPIRV(*shaderModule, "OpUConvert");
+
+		nzsl::SpirvWriter writer;
+		nzsl::SpirvPrinter printer;
+		std::string output = printer.Print(writer.Generate(*shaderModule));
+		CHECK(output.find("Capability(Int16)") == std::string::npos);
+	}
+
+	WHEN("only loading, storing and converting 16-bit values")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	values: array[f16, 4],
+	indices: vec2[u16]
+}
+
+external
+{
+	[binding(0)] data: storage[Data]
+}
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	data.values[1] = data.values[0];
+	data.values[2] = f16(f32(data.values[3]) * 2.0);
+
+	let output: FragOut;
+	output.value = f32(data.values[1]) + f32(vec2[u32](data.indices).x);
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		nzsl::SpirvWriter::Environment spirvEnv;
+		spirvEnv.spvMajorVersion = 1;
+		spirvEnv.spvMinorVersion = 3;
+
+		// storage capabilities are enough when no computation happens on 16-bit values
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(StorageBuffer16BitAccess)", spirvEnv);
+
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(spirvEnv);
+
+		nzsl::SpirvPrinter printer;
+		std::string output = printer.Print(writer.Generate(*shaderModule));
+		CHECK(output.find("Capability(Float16)") == std::string::npos);
+		CHECK(output.find("Capability(Int16)") == std::string::npos);
+	}
+
+	WHEN("using 16-bit types in an array of storage buffers")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.0")]
+module;
+
+[layout(std430)]
+struct Data
+{
+	values: array[f16, 4]
+}
+
+external
+{
+	[binding(0)] buffers: array[storage[Data], 2]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = buffers[1].values[2];
+	buffers[0].values[1] = value;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		shaderModule = SanitizeModule(*shaderModule);
+
+		// Member pointers into storage buffers don't require uniform buffer 16-bit access
+		nzsl::SpirvWriter::Environment spirvEnv;
+		spirvEnv.spvMajorVersion = 1;
+		spirvEnv.spvMinorVersion = 0;
+
+		ExpectSPIRV(*shaderModule, "OpCapability Capability(StorageBuffer16BitAccess)", spirvEnv);
+
+		nzsl::SpirvWriter writer;
+		writer.SetEnv(spirvEnv);
+
+		nzsl::SpirvPrinter printer;
+		std::string output = printer.Print(writer.Generate(*shaderModule));
+		CHECK(output.find("UniformAndStorageBuffer16BitAccess") == std::string::npos);
+	}
+}
@@ -89,6 +89,15 @@ on_run(function()
 
 		grammarData.InstructionCount = #instructions - grammarData.InstructionStart
 
+		-- Low opcodes are almost contiguous and can be indexed directly, extension opcodes are sparse
+		grammarData.DirectLookupSize = 0
+		for i = 1, grammarData.InstructionCount do
+			local opcode = instructions[grammarData.InstructionStart + i].opcode
+			if opcode < 1024 and opcode >= grammarData.DirectLookupSize then
+				grammarData.DirectLookupSize = opcode + 1
+			end
+		end
+
 		if grammarData.Name == "Core" then
 			assert(core == nil)
 			core = grammarData
@@ -523,6 +532,21 @@ namespace nzsl
 
 	const Spirv]] .. grammarData.Prefix .. [[Instruction* GetSpirv]] .. grammarData.Prefix .. [[Instruction(std::uint16_t op)
 	{
+		static const std::array<const Spirv]] .. grammarData.Prefix .. [[Instruction*, ]] .. grammarData.DirectLookupSize .. [[> s_instructionLookup = []
+		{
+			std::array<const Spirv]] .. grammarData.Prefix .. [[Instruction*, ]] .. grammarData.DirectLookupSize .. [[> lookup = {};
+			for (const Spirv]] .. grammarData.Prefix .. [[Instruction& inst : s_instructions]] .. grammarData.Prefix .. [[)
+			{
+				if (std::uint16_t(inst.op) < lookup.size())
+					lookup[std::uint16_t(inst.op)] = &inst;
+			}
+
+			return lookup;
+		}();
+
+		if (op < s_instructionLookup.size())
+			return s_instructionLookup[op];
+
 		auto it = std::lower_bound(std::begin(s_instructions]] .. grammarData.Prefix .. [[), std::end(s_instructions]] .. grammarData.Prefix .. [[), op, [](const Spirv]] .. grammarData.Prefix .. [[Instruction& inst, std::uint16_t op) { return std::uint16_t(inst.op) < op; });
 		if (it != std::end(s_instructions]] .. grammarData.Prefix .. [[) && std::uint16_t(it->op) == op)
 			return &*it;